@@ -125,11 +125,12 @@ type Satellite struct {
 	}
 
 	Audit struct {
-		Queues   *audit.Queues
-		Worker   *audit.Worker
-		Chore    *audit.Chore
-		Verifier *audit.Verifier
-		Reporter *audit.Reporter
+		Queues      *audit.Queues
+		VerifyQueue audit.VerifyQueue
+		Worker      *audit.Worker
+		Chore       *audit.Chore
+		Verifier    *audit.Verifier
+		Reporter    *audit.Reporter
 	}
 
 	Reputation struct {
@@ -586,6 +587,7 @@ func createNewSystem(name string, log *zap.Logger, config satellite.Config, peer
 	system.Repair.Repairer = repairerPeer.Repairer
 
 	system.Audit.Queues = peer.Audit.Queues
+	system.Audit.VerifyQueue = peer.Audit.VerifyQueue
 	system.Audit.Worker = peer.Audit.Worker
 	system.Audit.Chore = peer.Audit.Chore
 	system.Audit.Verifier = peer.Audit.Verifier
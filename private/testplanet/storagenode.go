@@ -170,6 +170,7 @@ func (planet *Planet) newStorageNode(ctx context.Context, prefix string, index,
 				NotifyLowDiskCooldown:     defaultInterval,
 				VerifyDirReadableInterval: defaultInterval,
 				VerifyDirWritableInterval: defaultInterval,
+				SpaceRefreshInterval:      defaultInterval,
 			},
 			Trust: trust.Config{
 				Sources:         sources,
@@ -187,7 +188,8 @@ func (planet *Planet) newStorageNode(ctx context.Context, prefix string, index,
 		},
 		Version: planet.NewVersionConfig(),
 		Bandwidth: bandwidth.Config{
-			Interval: defaultInterval,
+			Interval:        defaultInterval,
+			PersistInterval: defaultInterval,
 		},
 		Contact: contact.Config{
 			Interval: defaultInterval,
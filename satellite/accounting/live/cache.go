@@ -26,6 +26,10 @@ type Config struct {
 	StorageBackend     string        `help:"what to use for storing real-time accounting data"`
 	BandwidthCacheTTL  time.Duration `default:"5m" help:"bandwidth cache key time to live"`
 	AsOfSystemInterval time.Duration `default:"-10s" help:"as of system interval"`
+
+	LocalEnabled       bool          `default:"false" help:"keep an in-process write-back tier of the usage in front of the storage backend"`
+	LocalFlushInterval time.Duration `default:"1s" help:"how often the in-process tier sends the accumulated usage to the storage backend"`
+	LocalMaxStaleness  time.Duration `default:"5s" help:"how long the in-process tier serves the usage without reading it again from the storage backend"`
 }
 
 // OpenCache creates a new accounting.Cache instance using the type specified backend in
@@ -49,7 +53,14 @@ func OpenCache(ctx context.Context, log *zap.Logger, config Config) (accounting.
 	backendType = parts[0]
 	switch backendType {
 	case "redis":
-		return openRedisLiveAccounting(ctx, config.StorageBackend)
+		cache, err := openRedisLiveAccounting(ctx, config.StorageBackend)
+		if cache == nil {
+			return nil, err
+		}
+		if config.LocalEnabled {
+			return newLocalCache(log.Named("local"), cache, config), err
+		}
+		return cache, err
 	default:
 		return nil, Error.New("unrecognized live accounting backend specifier %q. Currently only redis is supported", backendType)
 	}
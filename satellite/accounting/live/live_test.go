@@ -266,3 +266,81 @@ func populateCache(ctx context.Context, cache accounting.Cache) ([]populateCache
 
 	return populatedData, errg.Wait()
 }
+
+func TestLocalCache(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	redis, err := testredis.Start(ctx)
+	require.NoError(t, err)
+	defer ctx.Check(redis.Close)
+
+	backendConfig := live.Config{
+		StorageBackend: "redis://" + redis.Addr() + "?db=0",
+	}
+	backend, err := live.OpenCache(ctx, zaptest.NewLogger(t).Named("live-accounting"), backendConfig)
+	require.NoError(t, err)
+	defer ctx.Check(backend.Close)
+
+	localConfig := backendConfig
+	localConfig.LocalEnabled = true
+	localConfig.LocalFlushInterval = time.Hour
+	localConfig.LocalMaxStaleness = time.Hour
+	local, err := live.OpenCache(ctx, zaptest.NewLogger(t).Named("live-accounting"), localConfig)
+	require.NoError(t, err)
+
+	var (
+		projectID = testrand.UUID()
+		now       = time.Now()
+	)
+
+	_, err = local.GetProjectStorageUsage(ctx, projectID)
+	require.True(t, accounting.ErrKeyNotFound.Has(err))
+	_, err = local.GetProjectBandwidthUsage(ctx, projectID, now)
+	require.True(t, accounting.ErrKeyNotFound.Has(err))
+
+	require.NoError(t, local.AddProjectStorageUsage(ctx, projectID, 100))
+	require.NoError(t, local.UpdateProjectBandwidthUsage(ctx, projectID, 200, time.Hour, now))
+
+	// the updates are visible locally before they are flushed.
+	storage, err := local.GetProjectStorageUsage(ctx, projectID)
+	require.NoError(t, err)
+	assert.EqualValues(t, 100, storage)
+	bandwidth, err := local.GetProjectBandwidthUsage(ctx, projectID, now)
+	require.NoError(t, err)
+	assert.EqualValues(t, 200, bandwidth)
+
+	_, err = backend.GetProjectStorageUsage(ctx, projectID)
+	require.True(t, accounting.ErrKeyNotFound.Has(err))
+
+	// getting all the totals flushes the pending storage usage.
+	totals, err := local.GetAllProjectTotals(ctx)
+	require.NoError(t, err)
+	assert.EqualValues(t, 100, totals[projectID])
+
+	require.NoError(t, local.AddProjectStorageUsage(ctx, projectID, -30))
+	require.NoError(t, local.UpdateProjectBandwidthUsage(ctx, projectID, 50, time.Hour, now))
+
+	// the missing bandwidth usage is inserted only once.
+	otherProjectID := testrand.UUID()
+	inserted, err := local.InsertProjectBandwidthUsage(ctx, otherProjectID, 1000, time.Hour, now)
+	require.NoError(t, err)
+	require.True(t, inserted)
+	inserted, err = backend.InsertProjectBandwidthUsage(ctx, otherProjectID, 1000, time.Hour, now)
+	require.NoError(t, err)
+	require.False(t, inserted)
+
+	bandwidth, err = local.GetProjectBandwidthUsage(ctx, otherProjectID, now)
+	require.NoError(t, err)
+	assert.EqualValues(t, 1000, bandwidth)
+
+	// closing flushes everything which is still pending.
+	require.NoError(t, local.Close())
+
+	storage, err = backend.GetProjectStorageUsage(ctx, projectID)
+	require.NoError(t, err)
+	assert.EqualValues(t, 70, storage)
+	bandwidth, err = backend.GetProjectBandwidthUsage(ctx, projectID, now)
+	require.NoError(t, err)
+	assert.EqualValues(t, 250, bandwidth)
+}
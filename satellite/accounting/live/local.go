@@ -0,0 +1,495 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package live
+
+import (
+	"context"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/zeebo/errs"
+	"go.uber.org/zap"
+	"golang.org/x/sync/errgroup"
+
+	"storj.io/common/errs2"
+	"storj.io/common/sync2"
+	"storj.io/common/uuid"
+	"storj.io/storj/satellite/accounting"
+)
+
+// projectUsageDelta is a pending storage usage change for a project.
+type projectUsageDelta struct {
+	ProjectID uuid.UUID
+	Delta     int64
+}
+
+// bandwidthUsageDelta is a pending bandwidth usage change for a project on
+// the day of Now.
+type bandwidthUsageDelta struct {
+	ProjectID uuid.UUID
+	Delta     int64
+	TTL       time.Duration
+	Now       time.Time
+}
+
+// batchBackend is implemented by backends which are able to apply many usage
+// deltas with a single round trip. A batch is applied at most once for an id,
+// so a batch which may have been applied before failing can be sent again.
+type batchBackend interface {
+	addUsageBatch(ctx context.Context, id uuid.UUID, storage []projectUsageDelta, bandwidth []bandwidthUsageDelta) error
+}
+
+// flushBatch is a batch of deltas which is sent to the backend.
+type flushBatch struct {
+	id                uuid.UUID
+	storage           []projectUsageDelta
+	storageCounters   []*localCounter
+	bandwidth         []bandwidthUsageDelta
+	bandwidthCounters []*localCounter
+}
+
+// bandwidthKey identifies a bandwidth counter; it matches the granularity of
+// the keys used by the backend.
+type bandwidthKey struct {
+	projectID uuid.UUID
+	month     time.Month
+	day       int
+}
+
+// localCounter is a single write-back counter.
+//
+// The int64 fields are accessed atomically.
+type localCounter struct {
+	// pending is the delta which hasn't been taken by a flush yet.
+	pending int64
+	// sending is the delta which has been taken by a flush, but which isn't
+	// known to be applied by the backend yet.
+	sending int64
+	// base is the last known backend value, including the flushed deltas.
+	base int64
+	// flushes is increased whenever a delta is taken or applied, so a read of
+	// the backend value can tell whether it raced with a flush.
+	flushes int64
+	// fetched is the time, in unix nanoseconds, when base was read from the
+	// backend; zero means that it was never read.
+	fetched int64
+	// exists is 1 when the backend is known to contain the key.
+	exists int32
+
+	// mu serializes the updates of base.
+	mu sync.Mutex
+
+	// ttl and now are only used by bandwidth counters and they are protected
+	// by localCache.mu.
+	ttl time.Duration
+	now time.Time
+}
+
+// localCache is an in-process write-back tier in front of another
+// accounting.Cache.
+//
+// Usage updates are accumulated in memory with atomic adds and they are sent
+// to the backend in batches every flush interval. Reads are served from
+// memory as long as the backend value has been read in the last
+// maxStaleness, hence the values returned by this cache may differ from the
+// global value by the updates which other processes did in that window.
+type localCache struct {
+	log          *zap.Logger
+	backend      accounting.Cache
+	maxStaleness time.Duration
+	nowFn        func() time.Time
+
+	// mu protects the maps; counters are only updated while holding a read
+	// lock, so eviction, which requires the write lock, never loses a delta.
+	mu        sync.RWMutex
+	storage   map[uuid.UUID]*localCounter
+	bandwidth map[bandwidthKey]*localCounter
+
+	// flushMu is held by Flush. unsent is the batch of the last flush, when
+	// it failed; it's sent again with the same id before any other deltas,
+	// so a batch which was partially applied isn't applied twice.
+	flushMu sync.Mutex
+	unsent  *flushBatch
+
+	loop   *sync2.Cycle
+	cancel context.CancelFunc
+	group  errgroup.Group
+}
+
+// newLocalCache wraps backend with an in-process write-back tier and starts
+// flushing it every config.LocalFlushInterval.
+func newLocalCache(log *zap.Logger, backend accounting.Cache, config Config) *localCache {
+	cache := &localCache{
+		log:          log,
+		backend:      backend,
+		maxStaleness: config.LocalMaxStaleness,
+		nowFn:        time.Now,
+		storage:      make(map[uuid.UUID]*localCounter),
+		bandwidth:    make(map[bandwidthKey]*localCounter),
+		loop:         sync2.NewCycle(config.LocalFlushInterval),
+	}
+
+	var ctx context.Context
+	ctx, cache.cancel = context.WithCancel(context.Background())
+	cache.loop.Start(ctx, &cache.group, func(ctx context.Context) error {
+		if err := cache.Flush(ctx); err != nil {
+			cache.log.Warn("unable to flush live accounting deltas", zap.Error(err))
+		}
+		return nil
+	})
+
+	return cache
+}
+
+// GetProjectStorageUsage gets inline and remote storage totals for a given
+// project, back to the time of the last accounting tally.
+func (cache *localCache) GetProjectStorageUsage(ctx context.Context, projectID uuid.UUID) (totalUsed int64, err error) {
+	defer mon.Task()(&ctx, projectID)(&err)
+
+	counter := cache.storageCounter(projectID)
+	return cache.get(ctx, counter, func(ctx context.Context) (int64, error) {
+		return cache.backend.GetProjectStorageUsage(ctx, projectID)
+	})
+}
+
+// GetProjectBandwidthUsage returns the current bandwidth usage from specific
+// project.
+func (cache *localCache) GetProjectBandwidthUsage(ctx context.Context, projectID uuid.UUID, now time.Time) (currentUsed int64, err error) {
+	defer mon.Task()(&ctx, projectID, now)(&err)
+
+	counter := cache.bandwidthCounter(projectID, now)
+	return cache.get(ctx, counter, func(ctx context.Context) (int64, error) {
+		return cache.backend.GetProjectBandwidthUsage(ctx, projectID, now)
+	})
+}
+
+// UpdateProjectBandwidthUsage increments the bandwidth usage of the project
+// locally; the increment is sent to the backend on the next flush.
+func (cache *localCache) UpdateProjectBandwidthUsage(ctx context.Context, projectID uuid.UUID, increment int64, ttl time.Duration, now time.Time) (err error) {
+	defer mon.Task()(&ctx, projectID, increment, ttl, now)(&err)
+
+	key := bandwidthKey{projectID: projectID, month: now.Month(), day: now.Day()}
+
+	cache.mu.RLock()
+	counter, ok := cache.bandwidth[key]
+	if ok && counter.ttl == ttl {
+		atomic.AddInt64(&counter.pending, increment)
+		cache.mu.RUnlock()
+		return nil
+	}
+	cache.mu.RUnlock()
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	counter, ok = cache.bandwidth[key]
+	if !ok {
+		counter = &localCounter{now: now}
+		cache.bandwidth[key] = counter
+	}
+	counter.ttl = ttl
+	atomic.AddInt64(&counter.pending, increment)
+	return nil
+}
+
+// InsertProjectBandwidthUsage sets the bandwidth usage of the project in the
+// backend, when it isn't set yet. The value isn't kept as a local delta, so
+// the processes which insert it at the same time don't add it up.
+func (cache *localCache) InsertProjectBandwidthUsage(ctx context.Context, projectID uuid.UUID, value int64, ttl time.Duration, now time.Time) (inserted bool, err error) {
+	defer mon.Task()(&ctx, projectID, value, ttl, now)(&err)
+
+	inserted, err = cache.backend.InsertProjectBandwidthUsage(ctx, projectID, value, ttl, now)
+	if err != nil {
+		return false, err
+	}
+
+	// the next read gets the inserted value from the backend.
+	counter := cache.bandwidthCounter(projectID, now)
+	atomic.StoreInt64(&counter.fetched, 0)
+	return inserted, nil
+}
+
+// AddProjectStorageUsage adds spaceUsed to the project storage usage locally;
+// the change is sent to the backend on the next flush.
+func (cache *localCache) AddProjectStorageUsage(ctx context.Context, projectID uuid.UUID, spaceUsed int64) (err error) {
+	defer mon.Task()(&ctx, projectID, spaceUsed)(&err)
+
+	cache.mu.RLock()
+	counter, ok := cache.storage[projectID]
+	if ok {
+		atomic.AddInt64(&counter.pending, spaceUsed)
+		cache.mu.RUnlock()
+		return nil
+	}
+	cache.mu.RUnlock()
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	counter, ok = cache.storage[projectID]
+	if !ok {
+		counter = &localCounter{}
+		cache.storage[projectID] = counter
+	}
+	atomic.AddInt64(&counter.pending, spaceUsed)
+	return nil
+}
+
+// GetAllProjectTotals flushes the pending deltas and returns the totals of
+// the backend, so the tally always sees the changes made by this process.
+func (cache *localCache) GetAllProjectTotals(ctx context.Context) (_ map[uuid.UUID]int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := cache.Flush(ctx); err != nil {
+		return nil, err
+	}
+
+	return cache.backend.GetAllProjectTotals(ctx)
+}
+
+// Close stops the flushing loop, flushes the pending deltas and closes the
+// backend.
+func (cache *localCache) Close() error {
+	cache.cancel()
+	cache.loop.Close()
+	err := errs2.IgnoreCanceled(cache.group.Wait())
+
+	return errs.Combine(err, cache.Flush(context.Background()), cache.backend.Close())
+}
+
+// Flush sends all the pending deltas to the backend and evicts the counters
+// which haven't been used recently.
+func (cache *localCache) Flush(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	cache.flushMu.Lock()
+	defer cache.flushMu.Unlock()
+
+	if cache.unsent != nil {
+		if err := cache.sendBatch(ctx, cache.unsent); err != nil {
+			return Error.Wrap(err)
+		}
+		cache.unsent = nil
+	}
+
+	id, err := uuid.New()
+	if err != nil {
+		return Error.Wrap(err)
+	}
+	batch := &flushBatch{id: id}
+
+	cache.mu.RLock()
+	for projectID, counter := range cache.storage {
+		if delta := counter.takePending(); delta != 0 {
+			batch.storage = append(batch.storage, projectUsageDelta{ProjectID: projectID, Delta: delta})
+			batch.storageCounters = append(batch.storageCounters, counter)
+		}
+	}
+	for key, counter := range cache.bandwidth {
+		if delta := counter.takePending(); delta != 0 {
+			batch.bandwidth = append(batch.bandwidth, bandwidthUsageDelta{
+				ProjectID: key.projectID,
+				Delta:     delta,
+				TTL:       counter.ttl,
+				Now:       counter.now,
+			})
+			batch.bandwidthCounters = append(batch.bandwidthCounters, counter)
+		}
+	}
+	cache.mu.RUnlock()
+
+	mon.IntVal("live_accounting_local_flush_size").Observe(int64(len(batch.storage) + len(batch.bandwidth)))
+
+	if len(batch.storage) > 0 || len(batch.bandwidth) > 0 {
+		if err := cache.sendBatch(ctx, batch); err != nil {
+			// the batch is kept as it is, because the backend may have
+			// applied a part of it.
+			cache.unsent = batch
+			return Error.Wrap(err)
+		}
+	}
+
+	cache.evictIdle()
+	return nil
+}
+
+// sendBatch sends the deltas to the backend, in a single round trip when the
+// backend supports it, and marks the sent deltas as applied. When a backend
+// without batches fails, only the deltas which weren't sent are left in batch.
+func (cache *localCache) sendBatch(ctx context.Context, batch *flushBatch) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if backend, ok := cache.backend.(batchBackend); ok {
+		if err := backend.addUsageBatch(ctx, batch.id, batch.storage, batch.bandwidth); err != nil {
+			return err
+		}
+		for i, counter := range batch.storageCounters {
+			counter.applied(batch.storage[i].Delta)
+		}
+		for i, counter := range batch.bandwidthCounters {
+			counter.applied(batch.bandwidth[i].Delta)
+		}
+		return nil
+	}
+
+	for len(batch.storage) > 0 {
+		usage := batch.storage[0]
+		if err := cache.backend.AddProjectStorageUsage(ctx, usage.ProjectID, usage.Delta); err != nil {
+			return err
+		}
+		batch.storageCounters[0].applied(usage.Delta)
+		batch.storage, batch.storageCounters = batch.storage[1:], batch.storageCounters[1:]
+	}
+	for len(batch.bandwidth) > 0 {
+		usage := batch.bandwidth[0]
+		if err := cache.backend.UpdateProjectBandwidthUsage(ctx, usage.ProjectID, usage.Delta, usage.TTL, usage.Now); err != nil {
+			return err
+		}
+		batch.bandwidthCounters[0].applied(usage.Delta)
+		batch.bandwidth, batch.bandwidthCounters = batch.bandwidth[1:], batch.bandwidthCounters[1:]
+	}
+	return nil
+}
+
+// evictIdle removes the counters without pending deltas whose backend value
+// is stale, so memory doesn't grow with the number of projects and days.
+func (cache *localCache) evictIdle() {
+	cutoff := cache.nowFn().Add(-cache.maxStaleness).UnixNano()
+	idle := func(counter *localCounter) bool {
+		return atomic.LoadInt64(&counter.pending) == 0 && atomic.LoadInt64(&counter.sending) == 0 &&
+			atomic.LoadInt64(&counter.fetched) < cutoff
+	}
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	for projectID, counter := range cache.storage {
+		if idle(counter) {
+			delete(cache.storage, projectID)
+		}
+	}
+	for key, counter := range cache.bandwidth {
+		if idle(counter) {
+			delete(cache.bandwidth, key)
+		}
+	}
+}
+
+// get returns the value of counter, reading the backend value with fetch
+// when the one in memory is older than maxStaleness.
+func (cache *localCache) get(ctx context.Context, counter *localCounter, fetch func(context.Context) (int64, error)) (_ int64, err error) {
+	now := cache.nowFn().UnixNano()
+	if fetched := atomic.LoadInt64(&counter.fetched); fetched != 0 && now-fetched < int64(cache.maxStaleness) {
+		mon.Counter("live_accounting_local_hit").Inc(1)
+		return counter.value()
+	}
+	mon.Counter("live_accounting_local_miss").Inc(1)
+
+	// the backend value may or may not include a delta which is flushed
+	// while it's read, so it's only kept when no flush of the counter was
+	// in progress.
+	flushes := atomic.LoadInt64(&counter.flushes)
+	idle := atomic.LoadInt64(&counter.sending) == 0
+
+	value, err := fetch(ctx)
+	switch {
+	case err == nil:
+		atomic.StoreInt32(&counter.exists, 1)
+	case accounting.ErrKeyNotFound.Has(err):
+		value = 0
+	default:
+		return 0, err
+	}
+
+	counter.mu.Lock()
+	if idle && atomic.LoadInt64(&counter.flushes) == flushes {
+		atomic.StoreInt64(&counter.base, value)
+		atomic.StoreInt64(&counter.fetched, now)
+		counter.mu.Unlock()
+		return counter.value()
+	}
+	counter.mu.Unlock()
+
+	// the deltas being sent are counted on top of the backend value, so the
+	// usage may be larger than the global one, but never smaller.
+	return value + atomic.LoadInt64(&counter.sending) + atomic.LoadInt64(&counter.pending), nil
+}
+
+// value returns the current value of the counter or accounting.ErrKeyNotFound
+// when neither the backend nor this process have any usage for it.
+func (counter *localCounter) value() (int64, error) {
+	pending := atomic.LoadInt64(&counter.pending) + atomic.LoadInt64(&counter.sending)
+	if pending == 0 && atomic.LoadInt32(&counter.exists) == 0 {
+		return 0, accounting.ErrKeyNotFound.New("no usage")
+	}
+	return atomic.LoadInt64(&counter.base) + pending, nil
+}
+
+// takePending moves the pending delta to the deltas being sent and returns
+// it.
+//
+// sending is increased before pending is decreased, so concurrent readers may
+// briefly see a larger usage, but never a smaller one.
+func (counter *localCounter) takePending() int64 {
+	delta := atomic.LoadInt64(&counter.pending)
+	if delta == 0 {
+		return 0
+	}
+	atomic.AddInt64(&counter.flushes, 1)
+	atomic.AddInt64(&counter.sending, delta)
+	atomic.AddInt64(&counter.pending, -delta)
+	return delta
+}
+
+// applied moves a delta which the backend has applied into base.
+func (counter *localCounter) applied(delta int64) {
+	counter.mu.Lock()
+	defer counter.mu.Unlock()
+
+	atomic.AddInt64(&counter.flushes, 1)
+	atomic.AddInt64(&counter.base, delta)
+	atomic.AddInt64(&counter.sending, -delta)
+	atomic.StoreInt32(&counter.exists, 1)
+}
+
+func (cache *localCache) storageCounter(projectID uuid.UUID) *localCounter {
+	cache.mu.RLock()
+	counter, ok := cache.storage[projectID]
+	cache.mu.RUnlock()
+	if ok {
+		return counter
+	}
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	counter, ok = cache.storage[projectID]
+	if !ok {
+		counter = &localCounter{}
+		cache.storage[projectID] = counter
+	}
+	return counter
+}
+
+func (cache *localCache) bandwidthCounter(projectID uuid.UUID, now time.Time) *localCounter {
+	key := bandwidthKey{projectID: projectID, month: now.Month(), day: now.Day()}
+
+	cache.mu.RLock()
+	counter, ok := cache.bandwidth[key]
+	cache.mu.RUnlock()
+	if ok {
+		return counter
+	}
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	counter, ok = cache.bandwidth[key]
+	if !ok {
+		counter = &localCounter{now: now}
+		cache.bandwidth[key] = counter
+	}
+	return counter
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package live
+
+import (
+	"context"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"github.com/zeebo/errs"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/common/uuid"
+	"storj.io/storj/satellite/accounting"
+)
+
+// batchCache is an accounting.Cache which applies the batches by id, and
+// can lose the response of a batch after applying it.
+type batchCache struct {
+	accounting.Cache
+
+	mu       sync.Mutex
+	storage  map[uuid.UUID]int64
+	applied  map[uuid.UUID]bool
+	failNext bool
+}
+
+func (cache *batchCache) addUsageBatch(ctx context.Context, id uuid.UUID, storage []projectUsageDelta, bandwidth []bandwidthUsageDelta) error {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	if !cache.applied[id] {
+		cache.applied[id] = true
+		for _, usage := range storage {
+			cache.storage[usage.ProjectID] += usage.Delta
+		}
+	}
+
+	if cache.failNext {
+		cache.failNext = false
+		return errs.New("response lost")
+	}
+	return nil
+}
+
+func (cache *batchCache) GetProjectStorageUsage(ctx context.Context, projectID uuid.UUID) (int64, error) {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	value, ok := cache.storage[projectID]
+	if !ok {
+		return 0, accounting.ErrKeyNotFound.New("%s", projectID)
+	}
+	return value, nil
+}
+
+func (cache *batchCache) Close() error { return nil }
+
+func TestLocalCacheFlushRetry(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	backend := &batchCache{
+		storage: map[uuid.UUID]int64{},
+		applied: map[uuid.UUID]bool{},
+	}
+	local := newLocalCache(zaptest.NewLogger(t), backend, Config{
+		LocalFlushInterval: time.Hour,
+		LocalMaxStaleness:  time.Hour,
+	})
+	defer ctx.Check(local.Close)
+
+	projectID := testrand.UUID()
+
+	// the batch is applied, but its response is lost.
+	require.NoError(t, local.AddProjectStorageUsage(ctx, projectID, 100))
+	backend.failNext = true
+	require.Error(t, local.Flush(ctx))
+
+	// the batch is sent again, without applying it twice, before the deltas
+	// added later.
+	require.NoError(t, local.AddProjectStorageUsage(ctx, projectID, 10))
+	require.NoError(t, local.Flush(ctx))
+
+	usage, err := backend.GetProjectStorageUsage(ctx, projectID)
+	require.NoError(t, err)
+	require.EqualValues(t, 110, usage)
+
+	usage, err = local.GetProjectStorageUsage(ctx, projectID)
+	require.NoError(t, err)
+	require.EqualValues(t, 110, usage)
+}
@@ -6,7 +6,6 @@ package live
 import (
 	"context"
 	"errors"
-	"fmt"
 	"net/url"
 	"strconv"
 	"strings"
@@ -18,6 +17,47 @@ import (
 	"storj.io/storj/satellite/accounting"
 )
 
+// bandwidthIncrScript increments the cache key KEYS[1] by ARGV[1]. If the
+// key does not exist, it is set to 0 before performing the operation.
+// The key expiration, ARGV[2] seconds, will be set only in the first
+// iteration. To achieve this we compare the increment and key value, if they
+// are equal its the first iteration.
+// More details on rate limiter section: https://redis.io/commands/incr
+const bandwidthIncrScript = `local current
+current = redis.call("incrby", KEYS[1], ARGV[1])
+if tonumber(current) == tonumber(ARGV[1]) then
+	redis.call("expire", KEYS[1], ARGV[2])
+end
+return current
+`
+
+// usageBatchScript applies a batch of usage deltas, unless the batch with the
+// id KEYS[1] has been applied already. The id is kept for ARGV[1] seconds.
+// The deltas of the keys KEYS[2], KEYS[3], ... are ARGV[2], ARGV[4], ... and
+// their expirations ARGV[3], ARGV[5], ..., which are set when the key is
+// created; zero means no expiration.
+const usageBatchScript = `if not redis.call("set", KEYS[1], 1, "nx", "ex", ARGV[1]) then
+	return 0
+end
+for i = 2, #KEYS do
+	local current = redis.call("incrby", KEYS[i], ARGV[2*i-2])
+	local ttl = tonumber(ARGV[2*i-1])
+	if ttl > 0 and tonumber(current) == tonumber(ARGV[2*i-2]) then
+		redis.call("expire", KEYS[i], ttl)
+	end
+end
+return 1
+`
+
+const (
+	// usageBatchKeyPrefix is the prefix of the keys, which remember the
+	// applied usage batches.
+	usageBatchKeyPrefix = "usage-batch:"
+	// usageBatchKeyTTL is how long an applied batch is remembered, which is
+	// how long a failed batch can be sent again without applying it twice.
+	usageBatchKeyTTL = 24 * time.Hour
+)
+
 type redisLiveAccounting struct {
 	client *redis.Client
 }
@@ -90,23 +130,8 @@ func (cache *redisLiveAccounting) GetProjectBandwidthUsage(ctx context.Context,
 func (cache *redisLiveAccounting) UpdateProjectBandwidthUsage(ctx context.Context, projectID uuid.UUID, increment int64, ttl time.Duration, now time.Time) (err error) {
 	mon.Task()(&ctx, projectID, increment, ttl, now)(&err)
 
-	// The following script will increment the cache key
-	// by a specific value. If the key does not exist, it is
-	// set to 0 before performing the operation.
-	// The key expiration will be set only in the first iteration.
-	// To achieve this we compare the increment and key value,
-	// if they are equal its the first iteration.
-	// More details on rate limiter section: https://redis.io/commands/incr
-	script := fmt.Sprintf(`local current
-	current = redis.call("incrby", KEYS[1], "%d")
-	if tonumber(current) == %d then
-		redis.call("expire",KEYS[1], %d)
-	end
-	return current
-	`, increment, increment, int(ttl.Seconds()))
-
 	key := createBandwidthProjectIDKey(projectID, now)
-	err = cache.client.Eval(ctx, script, []string{key}).Err()
+	err = cache.client.Eval(ctx, bandwidthIncrScript, []string{key}, increment, int(ttl.Seconds())).Err()
 	if err != nil {
 		return accounting.ErrSystemOrNetError.New("Redis eval failed: %w", err)
 	}
@@ -128,6 +153,50 @@ func (cache *redisLiveAccounting) AddProjectStorageUsage(ctx context.Context, pr
 	return nil
 }
 
+// InsertProjectBandwidthUsage sets the bandwidth usage of the project, when
+// the key doesn't exist yet.
+func (cache *redisLiveAccounting) InsertProjectBandwidthUsage(ctx context.Context, projectID uuid.UUID, value int64, ttl time.Duration, now time.Time) (inserted bool, err error) {
+	defer mon.Task()(&ctx, projectID, value, ttl, now)(&err)
+
+	inserted, err = cache.client.SetNX(ctx, createBandwidthProjectIDKey(projectID, now), value, ttl).Result()
+	if err != nil {
+		return false, accounting.ErrSystemOrNetError.New("Redis setnx failed: %w", err)
+	}
+
+	return inserted, nil
+}
+
+// addUsageBatch applies all the storage and bandwidth deltas using a single
+// script, which is atomic and applies the batch with id only once.
+func (cache *redisLiveAccounting) addUsageBatch(ctx context.Context, id uuid.UUID, storage []projectUsageDelta, bandwidth []bandwidthUsageDelta) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	keys := make([]string, 0, 1+len(storage)+len(bandwidth))
+	args := make([]interface{}, 0, 1+2*(len(storage)+len(bandwidth)))
+
+	keys = append(keys, usageBatchKeyPrefix+id.String())
+	args = append(args, int(usageBatchKeyTTL.Seconds()))
+	for _, usage := range storage {
+		keys = append(keys, string(usage.ProjectID[:]))
+		args = append(args, usage.Delta, 0)
+	}
+	for _, usage := range bandwidth {
+		ttl := int(usage.TTL.Seconds())
+		if ttl < 1 {
+			ttl = 1
+		}
+		keys = append(keys, createBandwidthProjectIDKey(usage.ProjectID, usage.Now))
+		args = append(args, usage.Delta, ttl)
+	}
+
+	err = cache.client.Eval(ctx, usageBatchScript, keys, args...).Err()
+	if err != nil {
+		return accounting.ErrSystemOrNetError.New("Redis eval failed: %w", err)
+	}
+
+	return nil
+}
+
 // GetAllProjectTotals iterates through the live accounting DB and returns a map of project IDs and totals.
 //
 // TODO (https://storjlabs.atlassian.net/browse/IN-173): see if it possible to
@@ -140,8 +209,8 @@ func (cache *redisLiveAccounting) GetAllProjectTotals(ctx context.Context) (_ ma
 	for it.Next(ctx) {
 		key := it.Val()
 
-		// skip bandwidth keys
-		if strings.HasSuffix(key, "bandwidth") {
+		// skip bandwidth keys and the applied usage batches
+		if strings.HasSuffix(key, "bandwidth") || strings.HasPrefix(key, usageBatchKeyPrefix) {
 			continue
 		}
 
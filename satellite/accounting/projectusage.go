@@ -81,8 +81,9 @@ func (usage *Service) ExceedsBandwidthUsage(ctx context.Context, projectID uuid.
 					return err
 				}
 
-				// Create cache key with database value.
-				err = usage.liveAccounting.UpdateProjectBandwidthUsage(ctx, projectID, bandwidthGetTotal, usage.bandwidthCacheTTL, usage.nowFn())
+				// Create cache key with database value, unless another
+				// request has created it in the meantime.
+				_, err = usage.liveAccounting.InsertProjectBandwidthUsage(ctx, projectID, bandwidthGetTotal, usage.bandwidthCacheTTL, now)
 				if err != nil {
 					return err
 				}
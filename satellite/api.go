@@ -267,6 +267,7 @@ func NewAPI(log *zap.Logger, full *identity.FullIdentity, db DB,
 
 		peer.Services.Add(lifecycle.Item{
 			Name:  "reputation",
+			Run:   peer.Reputation.Service.Run,
 			Close: peer.Reputation.Service.Close,
 		})
 	}
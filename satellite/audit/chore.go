@@ -18,22 +18,25 @@ import (
 //
 // architecture: Chore
 type Chore struct {
-	log    *zap.Logger
-	rand   *rand.Rand
-	queues *Queues
-	Loop   *sync2.Cycle
+	log         *zap.Logger
+	rand        *rand.Rand
+	queues      *Queues
+	verifyQueue VerifyQueue
+	Loop        *sync2.Cycle
 
 	segmentLoop *segmentloop.Service
 	config      Config
 }
 
-// NewChore instantiates Chore.
-func NewChore(log *zap.Logger, queues *Queues, loop *segmentloop.Service, config Config) *Chore {
+// NewChore instantiates Chore. When verifyQueue is not nil, the segments are
+// pushed to it instead of queues.
+func NewChore(log *zap.Logger, queues *Queues, verifyQueue VerifyQueue, loop *segmentloop.Service, config Config) *Chore {
 	return &Chore{
-		log:    log,
-		rand:   rand.New(rand.NewSource(time.Now().Unix())),
-		queues: queues,
-		Loop:   sync2.NewCycle(config.ChoreInterval),
+		log:         log,
+		rand:        rand.New(rand.NewSource(time.Now().Unix())),
+		queues:      queues,
+		verifyQueue: verifyQueue,
+		Loop:        sync2.NewCycle(config.ChoreInterval),
 
 		segmentLoop: loop,
 		config:      config,
@@ -47,9 +50,11 @@ func (chore *Chore) Run(ctx context.Context) (err error) {
 		defer mon.Task()(&ctx)(&err)
 
 		// If the previously pushed queue is still waiting to be swapped in, wait.
-		err = chore.queues.WaitForSwap(ctx)
-		if err != nil {
-			return err
+		if chore.verifyQueue == nil {
+			err = chore.queues.WaitForSwap(ctx)
+			if err != nil {
+				return err
+			}
 		}
 
 		collector := NewCollector(chore.config.Slots, chore.rand)
@@ -80,6 +85,16 @@ func (chore *Chore) Run(ctx context.Context) (err error) {
 			}
 		}
 
+		if chore.verifyQueue != nil {
+			// Segments which are already in the verify queue are kept, so
+			// the workers don't run out of work between loop passes.
+			err = chore.verifyQueue.Push(ctx, newQueue, chore.config.VerifyQueueBatchSize)
+			if err != nil {
+				chore.log.Error("error pushing segments to the verify queue", zap.Error(err))
+			}
+			return nil
+		}
+
 		// Push new queue to queues struct so it can be fetched by worker.
 		return chore.queues.Push(newQueue)
 	})
@@ -129,60 +129,44 @@ func (reporter *Reporter) RecordAudits(ctx context.Context, req Report) (_ Repor
 func (reporter *Reporter) recordAuditFailStatus(ctx context.Context, failedAuditNodeIDs storj.NodeIDList) (failed storj.NodeIDList, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	var errors error
-	for _, nodeID := range failedAuditNodeIDs {
-		err = reporter.reputations.ApplyAudit(ctx, nodeID, reputation.AuditFailure)
-		if err != nil {
-			failed = append(failed, nodeID)
-			errors = errs.Combine(Error.New("failed to record some audit fail statuses in overlay"), err)
-		}
+	failed, err = reporter.reputations.ApplyAudits(ctx, failedAuditNodeIDs, reputation.AuditFailure)
+	if err != nil {
+		return failed, errs.Combine(Error.New("failed to record some audit fail statuses in overlay"), err)
 	}
-	return failed, errors
+	return nil, nil
 }
 
 // recordAuditUnknownStatus updates nodeIDs in overlay with isup=true, auditoutcome=unknown.
 func (reporter *Reporter) recordAuditUnknownStatus(ctx context.Context, unknownAuditNodeIDs storj.NodeIDList) (failed storj.NodeIDList, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	var errors error
-	for _, nodeID := range unknownAuditNodeIDs {
-		err = reporter.reputations.ApplyAudit(ctx, nodeID, reputation.AuditUnknown)
-		if err != nil {
-			failed = append(failed, nodeID)
-			errors = errs.Combine(Error.New("failed to record some audit unknown statuses in overlay"), err)
-		}
+	failed, err = reporter.reputations.ApplyAudits(ctx, unknownAuditNodeIDs, reputation.AuditUnknown)
+	if err != nil {
+		return failed, errs.Combine(Error.New("failed to record some audit unknown statuses in overlay"), err)
 	}
-	return failed, errors
+	return nil, nil
 }
 
 // recordOfflineStatus updates nodeIDs in overlay with isup=false, auditoutcome=offline.
 func (reporter *Reporter) recordOfflineStatus(ctx context.Context, offlineNodeIDs storj.NodeIDList) (failed storj.NodeIDList, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	var errors error
-	for _, nodeID := range offlineNodeIDs {
-		err = reporter.reputations.ApplyAudit(ctx, nodeID, reputation.AuditOffline)
-		if err != nil {
-			failed = append(failed, nodeID)
-			errors = errs.Combine(Error.New("failed to record some audit offline statuses in overlay"), err)
-		}
+	failed, err = reporter.reputations.ApplyAudits(ctx, offlineNodeIDs, reputation.AuditOffline)
+	if err != nil {
+		return failed, errs.Combine(Error.New("failed to record some audit offline statuses in overlay"), err)
 	}
-	return failed, errors
+	return nil, nil
 }
 
 // recordAuditSuccessStatus updates nodeIDs in overlay with isup=true, auditoutcome=success.
 func (reporter *Reporter) recordAuditSuccessStatus(ctx context.Context, successNodeIDs storj.NodeIDList) (failed storj.NodeIDList, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	var errors error
-	for _, nodeID := range successNodeIDs {
-		err = reporter.reputations.ApplyAudit(ctx, nodeID, reputation.AuditSuccess)
-		if err != nil {
-			failed = append(failed, nodeID)
-			errors = errs.Combine(Error.New("failed to record some audit success statuses in overlay"), err)
-		}
+	failed, err = reporter.reputations.ApplyAudits(ctx, successNodeIDs, reputation.AuditSuccess)
+	if err != nil {
+		return failed, errs.Combine(Error.New("failed to record some audit success statuses in overlay"), err)
 	}
-	return failed, errors
+	return nil, nil
 }
 
 // recordPendingAudits updates the containment status of nodes with pending audits.
@@ -87,6 +87,27 @@ func NewVerifier(log *zap.Logger, metabase *metabase.DB, dialer rpc.Dialer, over
 func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[storj.NodeID]bool) (report Report, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	report, stragglers, err := verifier.VerifyEarly(ctx, segment, skip)
+	if stragglers != nil {
+		lateReport, lateErr := stragglers.Wait(ctx)
+		report.Successes = append(report.Successes, lateReport.Successes...)
+		report.Fails = append(report.Fails, lateReport.Fails...)
+		report.Offlines = append(report.Offlines, lateReport.Offlines...)
+		report.PendingAudits = append(report.PendingAudits, lateReport.PendingAudits...)
+		report.Unknown = append(report.Unknown, lateReport.Unknown...)
+		err = errs.Combine(err, lateErr)
+	}
+
+	return report, err
+}
+
+// VerifyEarly works like Verify, except that it returns as soon as the
+// correct stripe is known, without waiting for the slowest downloads. The
+// downloads still running are returned as stragglers, their audit outcomes
+// are available with Stragglers.Wait.
+func (verifier *Verifier) VerifyEarly(ctx context.Context, segment Segment, skip map[storj.NodeID]bool) (report Report, stragglers *Stragglers, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	var segmentInfo metabase.Segment
 	defer func() {
 		recordStats(report, len(segmentInfo.Pieces), err)
@@ -94,7 +115,7 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 
 	if segment.Expired(verifier.nowFn()) {
 		verifier.log.Debug("segment expired before Verify")
-		return Report{}, nil
+		return Report{}, nil, nil
 	}
 
 	segmentInfo, err = verifier.metabase.GetSegmentByPosition(ctx, metabase.GetSegmentByPosition{
@@ -104,14 +125,14 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 	if err != nil {
 		if metabase.ErrSegmentNotFound.Has(err) {
 			verifier.log.Debug("segment deleted before Verify")
-			return Report{}, nil
+			return Report{}, nil, nil
 		}
-		return Report{}, err
+		return Report{}, nil, err
 	}
 
 	randomIndex, err := GetRandomStripe(ctx, segmentInfo)
 	if err != nil {
-		return Report{}, err
+		return Report{}, nil, err
 	}
 
 	var offlineNodes storj.NodeIDList
@@ -126,7 +147,7 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 			mon.Counter("not_enough_shares_for_audit").Inc(1)
 			err = ErrNotEnoughShares.Wrap(err)
 		}
-		return Report{}, err
+		return Report{}, nil, err
 	}
 
 	// NOTE offlineNodes will include disqualified nodes because they aren't in
@@ -138,94 +159,78 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 			zap.String("Segment", segmentInfoString(segment)))
 	}
 
-	shares, err := verifier.DownloadShares(ctx, orderLimits, privateKey, cachedIPsAndPorts, randomIndex, segmentInfo.Redundancy.ShareSize)
-	if err != nil {
-		return Report{
-			Offlines: offlineNodes,
-		}, err
+	required := segmentInfo.Redundancy.RequiredShares
+	total := segmentInfo.Redundancy.TotalShares
+
+	downloads, remaining := verifier.downloadShares(ctx, orderLimits, privateKey, cachedIPsAndPorts, randomIndex, segmentInfo.Redundancy.ShareSize)
+	threshold := earlyFinishThreshold(int(required), remaining)
+
+	// collect the shares, and check them as soon as enough of them have
+	// been downloaded to decide which one is the correct stripe.
+	shares := make(map[int]Share, remaining)
+	var decided bool
+	var pieceNums []int
+	var correctedShares []infectious.Share
+	for remaining > 0 {
+		share := <-downloads
+		remaining--
+
+		shares[share.PieceNum] = share
+		if share.Error == nil {
+			sharesToAudit[share.PieceNum] = share
+		}
+
+		if threshold > 0 && remaining > 0 && len(sharesToAudit) >= threshold {
+			// only try once, otherwise wait for all the shares.
+			threshold = 0
+
+			// the early shares have a smaller correction margin, so they
+			// are only trusted when no share had to be corrected.
+			var altered []int
+			altered, correctedShares, err = auditShares(ctx, required, total, sharesToAudit)
+			if err == nil && len(altered) == 0 {
+				decided = true
+				break
+			}
+			mon.Counter("verify_early_finish_skipped").Inc(1)
+			correctedShares, err = nil, nil
+		}
 	}
 
 	err = verifier.checkIfSegmentAltered(ctx, segmentInfo)
 	if err != nil {
 		if ErrSegmentDeleted.Has(err) {
 			verifier.log.Debug("segment deleted during Verify")
-			return Report{}, nil
+			return Report{}, nil, nil
 		}
 		if ErrSegmentModified.Has(err) {
 			verifier.log.Debug("segment modified during Verify")
-			return Report{}, nil
+			return Report{}, nil, nil
 		}
 		return Report{
 			Offlines: offlineNodes,
-		}, err
+		}, nil, err
 	}
 
 	for pieceNum, share := range shares {
 		if share.Error == nil {
 			// no error -- share downloaded successfully
-			sharesToAudit[pieceNum] = share
-			continue
-		}
-		if rpc.Error.Has(share.Error) {
-			if errs.Is(share.Error, context.DeadlineExceeded) {
-				// dial timeout
-				offlineNodes = append(offlineNodes, share.NodeID)
-				verifier.log.Debug("Verify: dial timeout (offline)",
-					zap.Stringer("Node ID", share.NodeID),
-					zap.String("Segment", segmentInfoString(segment)),
-					zap.Error(share.Error))
-				continue
-			}
-			if errs2.IsRPC(share.Error, rpcstatus.Unknown) {
-				// dial failed -- offline node
-				offlineNodes = append(offlineNodes, share.NodeID)
-				verifier.log.Debug("Verify: dial failed (offline)",
-					zap.Stringer("Node ID", share.NodeID),
-					zap.String("Segment", segmentInfoString(segment)),
-					zap.Error(share.Error))
-				continue
-			}
-			// unknown transport error
-			unknownNodes = append(unknownNodes, share.NodeID)
-			verifier.log.Info("Verify: unknown transport error (skipped)",
-				zap.Stringer("Node ID", share.NodeID),
-				zap.String("Segment", segmentInfoString(segment)),
-				zap.Error(share.Error))
 			continue
 		}
 
-		if errs2.IsRPC(share.Error, rpcstatus.NotFound) {
-			// missing share
+		switch verifier.classifyShareError(segment, share) {
+		case shareOffline:
+			offlineNodes = append(offlineNodes, share.NodeID)
+		case shareFailed:
 			failedNodes = append(failedNodes, share.NodeID)
-			verifier.log.Info("Verify: piece not found (audit failed)",
-				zap.Stringer("Node ID", share.NodeID),
-				zap.String("Segment", segmentInfoString(segment)),
-				zap.Error(share.Error))
-			continue
-		}
-
-		if errs2.IsRPC(share.Error, rpcstatus.DeadlineExceeded) {
-			// dial successful, but download timed out
+		case shareContained:
 			containedNodes[pieceNum] = share.NodeID
-			verifier.log.Info("Verify: download timeout (contained)",
-				zap.Stringer("Node ID", share.NodeID),
-				zap.String("Segment", segmentInfoString(segment)),
-				zap.Error(share.Error))
-			continue
+		default:
+			unknownNodes = append(unknownNodes, share.NodeID)
 		}
-
-		// unknown error
-		unknownNodes = append(unknownNodes, share.NodeID)
-		verifier.log.Info("Verify: unknown error (skipped)",
-			zap.Stringer("Node ID", share.NodeID),
-			zap.String("Segment", segmentInfoString(segment)),
-			zap.Error(share.Error))
 	}
 	mon.IntVal("verify_shares_downloaded_successfully").Observe(int64(len(sharesToAudit))) //mon:locked
 
-	required := segmentInfo.Redundancy.RequiredShares
-	total := segmentInfo.Redundancy.TotalShares
-
 	if len(sharesToAudit) < int(required) {
 		mon.Counter("not_enough_shares_for_audit").Inc(1)
 		// if we have reached this point, most likely something went wrong
@@ -235,22 +240,24 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 			Offlines: offlineNodes,
 			Unknown:  unknownNodes,
 		}
-		return report, ErrNotEnoughShares.New("got: %d, required: %d, failed: %d, offline: %d, unknown: %d, contained: %d",
+		return report, nil, ErrNotEnoughShares.New("got: %d, required: %d, failed: %d, offline: %d, unknown: %d, contained: %d",
 			len(sharesToAudit), required, len(failedNodes), len(offlineNodes), len(unknownNodes), len(containedNodes))
 	}
 	// ensure we get values, even if only zero values, so that redash can have an alert based on this
 	mon.Counter("not_enough_shares_for_audit").Inc(0)
 	mon.Counter("could_not_verify_audit_shares").Inc(0) //mon:locked
 
-	pieceNums, correctedShares, err := auditShares(ctx, required, total, sharesToAudit)
-	if err != nil {
-		mon.Counter("could_not_verify_audit_shares").Inc(1) //mon:locked
-		verifier.log.Error("could not verify shares", zap.Error(err))
-		return Report{
-			Fails:    failedNodes,
-			Offlines: offlineNodes,
-			Unknown:  unknownNodes,
-		}, err
+	if !decided {
+		pieceNums, correctedShares, err = auditShares(ctx, required, total, sharesToAudit)
+		if err != nil {
+			mon.Counter("could_not_verify_audit_shares").Inc(1) //mon:locked
+			verifier.log.Error("could not verify shares", zap.Error(err))
+			return Report{
+				Fails:    failedNodes,
+				Offlines: offlineNodes,
+				Unknown:  unknownNodes,
+			}, nil, err
+		}
 	}
 
 	for _, pieceNum := range pieceNums {
@@ -262,6 +269,19 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 
 	successNodes := getSuccessNodes(ctx, shares, failedNodes, offlineNodes, unknownNodes, containedNodes)
 
+	if remaining > 0 {
+		mon.IntVal("verify_stragglers").Observe(int64(remaining))
+		stragglers = &Stragglers{
+			verifier:        verifier,
+			segment:         segment,
+			segmentInfo:     segmentInfo,
+			randomIndex:     randomIndex,
+			correctedShares: correctedShares,
+			downloads:       downloads,
+			remaining:       remaining,
+		}
+	}
+
 	pendingAudits, err := createPendingAudits(ctx, containedNodes, correctedShares, segment, segmentInfo, randomIndex)
 	if err != nil {
 		return Report{
@@ -269,7 +289,7 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 			Fails:     failedNodes,
 			Offlines:  offlineNodes,
 			Unknown:   unknownNodes,
-		}, err
+		}, stragglers, err
 	}
 
 	return Report{
@@ -278,7 +298,163 @@ func (verifier *Verifier) Verify(ctx context.Context, segment Segment, skip map[
 		Offlines:      offlineNodes,
 		PendingAudits: pendingAudits,
 		Unknown:       unknownNodes,
-	}, nil
+	}, stragglers, nil
+}
+
+// shareOutcome is the audit outcome of a share which couldn't be downloaded.
+type shareOutcome int
+
+const (
+	shareUnknown shareOutcome = iota
+	shareOffline
+	shareFailed
+	shareContained
+)
+
+// classifyShareError returns the audit outcome of a share which couldn't be
+// downloaded.
+func (verifier *Verifier) classifyShareError(segment Segment, share Share) shareOutcome {
+	if rpc.Error.Has(share.Error) {
+		if errs.Is(share.Error, context.DeadlineExceeded) {
+			// dial timeout
+			verifier.log.Debug("Verify: dial timeout (offline)",
+				zap.Stringer("Node ID", share.NodeID),
+				zap.String("Segment", segmentInfoString(segment)),
+				zap.Error(share.Error))
+			return shareOffline
+		}
+		if errs2.IsRPC(share.Error, rpcstatus.Unknown) {
+			// dial failed -- offline node
+			verifier.log.Debug("Verify: dial failed (offline)",
+				zap.Stringer("Node ID", share.NodeID),
+				zap.String("Segment", segmentInfoString(segment)),
+				zap.Error(share.Error))
+			return shareOffline
+		}
+		// unknown transport error
+		verifier.log.Info("Verify: unknown transport error (skipped)",
+			zap.Stringer("Node ID", share.NodeID),
+			zap.String("Segment", segmentInfoString(segment)),
+			zap.Error(share.Error))
+		return shareUnknown
+	}
+
+	if errs2.IsRPC(share.Error, rpcstatus.NotFound) {
+		// missing share
+		verifier.log.Info("Verify: piece not found (audit failed)",
+			zap.Stringer("Node ID", share.NodeID),
+			zap.String("Segment", segmentInfoString(segment)),
+			zap.Error(share.Error))
+		return shareFailed
+	}
+
+	if errs2.IsRPC(share.Error, rpcstatus.DeadlineExceeded) {
+		// dial successful, but download timed out
+		verifier.log.Info("Verify: download timeout (contained)",
+			zap.Stringer("Node ID", share.NodeID),
+			zap.String("Segment", segmentInfoString(segment)),
+			zap.Error(share.Error))
+		return shareContained
+	}
+
+	// unknown error
+	verifier.log.Info("Verify: unknown error (skipped)",
+		zap.Stringer("Node ID", share.NodeID),
+		zap.String("Segment", segmentInfoString(segment)),
+		zap.Error(share.Error))
+	return shareUnknown
+}
+
+// earlyFinishThreshold returns the number of successfully downloaded shares
+// after which the shares are checked without waiting for the remaining
+// downloads, or zero when it's not worth it.
+//
+// Berlekamp-Welch corrects up to (downloads-required)/2 altered shares when
+// all the shares are checked. When the threshold number of shares agree with
+// each other, more than required of them are intact even with that many
+// altered shares, so they determine the same stripe as all the shares would.
+// When any of them disagree, the verifier has to wait for all the shares.
+func earlyFinishThreshold(required, downloads int) int {
+	threshold := required + (downloads-required)/2 + 1
+	if threshold >= downloads {
+		return 0
+	}
+	return threshold
+}
+
+// Stragglers are the share downloads which were still running when the
+// correct stripe of an audit became known.
+type Stragglers struct {
+	verifier        *Verifier
+	segment         Segment
+	segmentInfo     metabase.Segment
+	randomIndex     int32
+	correctedShares []infectious.Share
+
+	downloads <-chan Share
+	remaining int
+}
+
+// Wait waits for the remaining downloads and returns their audit outcomes.
+// The downloaded shares are compared with the ones computed from the
+// correct stripe, so the outcomes are the same as if all the shares had been
+// checked together.
+func (stragglers *Stragglers) Wait(ctx context.Context) (report Report, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	verifier := stragglers.verifier
+	segment := stragglers.segment
+	redundancy := stragglers.segmentInfo.Redundancy
+
+	fec, err := infectious.NewFEC(int(redundancy.RequiredShares), int(redundancy.TotalShares))
+	if err != nil {
+		return Report{}, Error.Wrap(err)
+	}
+	stripeData, err := rebuildStripe(ctx, fec, stragglers.correctedShares, int(redundancy.ShareSize))
+	if err != nil {
+		return Report{}, Error.Wrap(err)
+	}
+	expected := make([]byte, redundancy.ShareSize)
+
+	containedNodes := make(map[int]storj.NodeID)
+	for ; stragglers.remaining > 0; stragglers.remaining-- {
+		var share Share
+		select {
+		case share = <-stragglers.downloads:
+		case <-ctx.Done():
+			return report, ctx.Err()
+		}
+
+		if share.Error != nil {
+			switch verifier.classifyShareError(segment, share) {
+			case shareOffline:
+				report.Offlines = append(report.Offlines, share.NodeID)
+			case shareFailed:
+				report.Fails = append(report.Fails, share.NodeID)
+			case shareContained:
+				containedNodes[share.PieceNum] = share.NodeID
+			default:
+				report.Unknown = append(report.Unknown, share.NodeID)
+			}
+			continue
+		}
+
+		err = fec.EncodeSingle(stripeData, expected, share.PieceNum)
+		if err != nil {
+			return report, Error.Wrap(err)
+		}
+		if !bytes.Equal(expected, share.Data) {
+			verifier.log.Info("Verify: share data altered (audit failed)",
+				zap.Stringer("Node ID", share.NodeID),
+				zap.String("Segment", segmentInfoString(segment)))
+			report.Fails = append(report.Fails, share.NodeID)
+			continue
+		}
+		report.Successes = append(report.Successes, share.NodeID)
+	}
+
+	report.PendingAudits, err = createPendingAudits(ctx, containedNodes, stragglers.correctedShares, segment, stragglers.segmentInfo, stragglers.randomIndex)
+	return report, err
 }
 
 func segmentInfoString(segment Segment) string {
@@ -292,14 +468,29 @@ func segmentInfoString(segment Segment) string {
 func (verifier *Verifier) DownloadShares(ctx context.Context, limits []*pb.AddressedOrderLimit, piecePrivateKey storj.PiecePrivateKey, cachedIPsAndPorts map[storj.NodeID]string, stripeIndex int32, shareSize int32) (shares map[int]Share, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	shares = make(map[int]Share, len(limits))
-	ch := make(chan *Share, len(limits))
+	downloads, count := verifier.downloadShares(ctx, limits, piecePrivateKey, cachedIPsAndPorts, stripeIndex, shareSize)
+
+	shares = make(map[int]Share, count)
+	for i := 0; i < count; i++ {
+		share := <-downloads
+		shares[share.PieceNum] = share
+	}
+
+	return shares, nil
+}
+
+// downloadShares starts downloading the shares from the nodes with a limit.
+// Every share, successful or not, is sent to the returned channel as soon as
+// its download completes. The channel is buffered, so the downloads don't
+// block when nobody is waiting for them anymore.
+func (verifier *Verifier) downloadShares(ctx context.Context, limits []*pb.AddressedOrderLimit, piecePrivateKey storj.PiecePrivateKey, cachedIPsAndPorts map[storj.NodeID]string, stripeIndex int32, shareSize int32) (_ <-chan Share, count int) {
+	ch := make(chan Share, len(limits))
 
 	for i, limit := range limits {
 		if limit == nil {
-			ch <- nil
 			continue
 		}
+		count++
 
 		ip := cachedIPsAndPorts[limit.Limit.StorageNodeId]
 		go func(i int, limit *pb.AddressedOrderLimit) {
@@ -312,18 +503,11 @@ func (verifier *Verifier) DownloadShares(ctx context.Context, limits []*pb.Addre
 					Data:     nil,
 				}
 			}
-			ch <- &share
+			ch <- share
 		}(i, limit)
 	}
 
-	for range limits {
-		share := <-ch
-		if share != nil {
-			shares[share.PieceNum] = *share
-		}
-	}
-
-	return shares, nil
+	return ch, count
 }
 
 // Reverify reverifies the contained nodes in the stripe.
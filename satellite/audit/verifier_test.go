@@ -876,6 +876,74 @@ func TestVerifierSlowDownload(t *testing.T) {
 	})
 }
 
+// TestVerifierEarlyStragglers checks that VerifyEarly doesn't wait for a slow
+// node, and that its outcome is reported once the straggler download has
+// finished.
+func TestVerifierEarlyStragglers(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 5, UplinkCount: 1,
+		Reconfigure: testplanet.Reconfigure{
+			StorageNodeDB: func(index int, db storagenode.DB, log *zap.Logger) (storagenode.DB, error) {
+				return testblobs.NewSlowDB(log.Named("slowdb"), db), nil
+			},
+			Satellite: testplanet.Combine(
+				func(log *zap.Logger, index int, config *satellite.Config) {
+					// These config values are chosen to force the slow node to time out without timing out on the four normal nodes
+					config.Audit.MinBytesPerSecond = 100 * memory.KiB
+					config.Audit.MinDownloadTimeout = 950 * time.Millisecond
+				},
+				testplanet.ReconfigureRS(2, 2, 5, 5),
+			),
+		},
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		satellite := planet.Satellites[0]
+		audits := satellite.Audit
+
+		audits.Worker.Loop.Pause()
+		audits.Chore.Loop.Pause()
+
+		ul := planet.Uplinks[0]
+		testData := testrand.Bytes(8 * memory.KiB)
+
+		err := ul.Upload(ctx, satellite, "testbucket", "test/path", testData)
+		require.NoError(t, err)
+
+		audits.Chore.Loop.TriggerWait()
+		queue := audits.Queues.Fetch()
+		queueSegment, err := queue.Next()
+		require.NoError(t, err)
+
+		segment, err := satellite.Metabase.DB.GetSegmentByPosition(ctx, metabase.GetSegmentByPosition{
+			StreamID: queueSegment.StreamID,
+			Position: queueSegment.Position,
+		})
+		require.NoError(t, err)
+
+		slowNode := planet.FindNode(segment.Pieces[0].StorageNode)
+		slowNodeDB := slowNode.DB.(*testblobs.SlowDB)
+		slowNodeDB.SetLatency(1 * time.Second)
+
+		report, stragglers, err := audits.Verifier.VerifyEarly(ctx, queueSegment, nil)
+		require.NoError(t, err)
+		require.NotNil(t, stragglers)
+
+		assert.Len(t, report.Successes, 4)
+		assert.NotContains(t, report.Successes, slowNode.ID())
+		assert.Len(t, report.Fails, 0)
+		assert.Len(t, report.PendingAudits, 0)
+
+		report, err = stragglers.Wait(ctx)
+		require.NoError(t, err)
+
+		assert.Len(t, report.Successes, 0)
+		assert.Len(t, report.Fails, 0)
+		assert.Len(t, report.Offlines, 0)
+		assert.Len(t, report.Unknown, 0)
+		require.Len(t, report.PendingAudits, 1)
+		assert.Equal(t, report.PendingAudits[0].NodeID, slowNode.ID())
+	})
+}
+
 // TestVerifierUnknownError checks that a node that returns an unknown error in response to an audit request
 // does not get marked as successful, failed, or contained.
 func TestVerifierUnknownError(t *testing.T) {
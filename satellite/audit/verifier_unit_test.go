@@ -152,3 +152,20 @@ func TestCreatePendingAudits(t *testing.T) {
 	assert.Equal(t, pkcrypto.SHA256Hash(shares[1].Data), pending[0].ExpectedShareHash)
 	assert.EqualValues(t, 0, pending[0].ReverifyCount)
 }
+
+func TestEarlyFinishThreshold(t *testing.T) {
+	for _, test := range []struct {
+		required, downloads int
+		threshold           int
+	}{
+		{required: 2, downloads: 5, threshold: 4},
+		{required: 2, downloads: 4, threshold: 0},
+		{required: 29, downloads: 80, threshold: 55},
+		{required: 29, downloads: 35, threshold: 33},
+		{required: 29, downloads: 30, threshold: 0},
+		{required: 29, downloads: 29, threshold: 0},
+		{required: 29, downloads: 10, threshold: 0},
+	} {
+		assert.Equal(t, test.threshold, earlyFinishThreshold(test.required, test.downloads), "%+v", test)
+	}
+}
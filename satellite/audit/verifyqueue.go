@@ -0,0 +1,153 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package audit
+
+import (
+	"context"
+	"sync"
+	"time"
+
+	"storj.io/common/uuid"
+	"storj.io/storj/satellite/metabase"
+)
+
+// VerifyQueue is a persistent queue of segments to audit. Unlike Queues it
+// can be shared by audit workers running in different processes.
+//
+// Segments are leased in batches; a leased segment is not returned to other
+// workers until the lease expires, and it is removed from the queue once it
+// has been audited. Segments which are leased by a worker which goes away, or
+// whose audit failed, are audited again after their lease expires, until they
+// have been leased the maximum number of attempts.
+//
+// architecture: Database
+type VerifyQueue interface {
+	// Push adds segments to the queue, using at most maxBatchSize segments
+	// per insert. Segments which are already in the queue are ignored.
+	Push(ctx context.Context, segments []Segment, maxBatchSize int) error
+	// Lease returns up to limit segments, which are not leased by another
+	// worker, and leases them for the given duration. Segments which have
+	// already been leased maxAttempts times are removed from the queue
+	// instead. When maxAttempts is zero, the segments are leased until they
+	// are removed.
+	Lease(ctx context.Context, limit int, duration time.Duration, maxAttempts int) ([]Segment, error)
+	// Remove removes audited segments from the queue.
+	Remove(ctx context.Context, segments []Segment) error
+}
+
+// verifyQueueKey identifies a segment in the queue.
+type verifyQueueKey struct {
+	StreamID uuid.UUID
+	Position metabase.SegmentPosition
+}
+
+// memoryVerifyQueueEntry is a segment in MemoryVerifyQueue.
+type memoryVerifyQueueEntry struct {
+	segment     Segment
+	leasedUntil time.Time
+	attempts    int
+}
+
+// MemoryVerifyQueue is an in-memory VerifyQueue. It is meant for tests and
+// for satellites which run a single audit worker process.
+type MemoryVerifyQueue struct {
+	mu      sync.Mutex
+	now     func() time.Time
+	order   []verifyQueueKey
+	entries map[verifyQueueKey]*memoryVerifyQueueEntry
+}
+
+var _ VerifyQueue = (*MemoryVerifyQueue)(nil)
+
+// NewMemoryVerifyQueue creates a new in-memory VerifyQueue.
+func NewMemoryVerifyQueue() *MemoryVerifyQueue {
+	return &MemoryVerifyQueue{
+		now:     time.Now,
+		entries: map[verifyQueueKey]*memoryVerifyQueueEntry{},
+	}
+}
+
+// Push adds segments to the queue.
+func (queue *MemoryVerifyQueue) Push(ctx context.Context, segments []Segment, maxBatchSize int) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	queue.mu.Lock()
+	defer queue.mu.Unlock()
+
+	for _, segment := range segments {
+		key := verifyQueueKey{StreamID: segment.StreamID, Position: segment.Position}
+		if _, ok := queue.entries[key]; ok {
+			continue
+		}
+		queue.entries[key] = &memoryVerifyQueueEntry{segment: segment}
+		queue.order = append(queue.order, key)
+	}
+	return nil
+}
+
+// Lease returns up to limit segments, which are not leased, and leases them
+// for the given duration. Segments which have already been leased
+// maxAttempts times are removed.
+func (queue *MemoryVerifyQueue) Lease(ctx context.Context, limit int, duration time.Duration, maxAttempts int) (_ []Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	queue.mu.Lock()
+	defer queue.mu.Unlock()
+
+	now := queue.now()
+
+	var segments []Segment
+	// drop the removed segments from the order while looking for the next
+	// available ones.
+	order := queue.order[:0]
+	for _, key := range queue.order {
+		entry, ok := queue.entries[key]
+		if !ok {
+			continue
+		}
+
+		if len(segments) < limit && !entry.leasedUntil.After(now) {
+			if maxAttempts > 0 && entry.attempts >= maxAttempts {
+				delete(queue.entries, key)
+				continue
+			}
+			entry.attempts++
+			entry.leasedUntil = now.Add(duration)
+			segments = append(segments, entry.segment)
+		}
+		order = append(order, key)
+	}
+	queue.order = order
+
+	return segments, nil
+}
+
+// Remove removes audited segments from the queue.
+func (queue *MemoryVerifyQueue) Remove(ctx context.Context, segments []Segment) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	queue.mu.Lock()
+	defer queue.mu.Unlock()
+
+	for _, segment := range segments {
+		delete(queue.entries, verifyQueueKey{StreamID: segment.StreamID, Position: segment.Position})
+	}
+	return nil
+}
+
+// Size returns the number of segments in the queue, including the leased ones.
+func (queue *MemoryVerifyQueue) Size() int {
+	queue.mu.Lock()
+	defer queue.mu.Unlock()
+
+	return len(queue.entries)
+}
+
+// TestingSetNow sets the function used to get the current time.
+func (queue *MemoryVerifyQueue) TestingSetNow(now func() time.Time) {
+	queue.mu.Lock()
+	defer queue.mu.Unlock()
+
+	queue.now = now
+}
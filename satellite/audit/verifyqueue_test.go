@@ -0,0 +1,282 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package audit_test
+
+import (
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap"
+	"golang.org/x/sync/errgroup"
+
+	"storj.io/common/memory"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/common/uuid"
+	"storj.io/storj/private/testplanet"
+	"storj.io/storj/satellite"
+	"storj.io/storj/satellite/audit"
+	"storj.io/storj/satellite/metabase"
+	"storj.io/storj/satellite/satellitedb/satellitedbtest"
+)
+
+func TestVerifyQueue(t *testing.T) {
+	t.Run("memory", func(t *testing.T) {
+		ctx := testcontext.New(t)
+		defer ctx.Cleanup()
+
+		testVerifyQueue(ctx, t, audit.NewMemoryVerifyQueue())
+	})
+
+	satellitedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db satellite.DB) {
+		testVerifyQueue(ctx, t, db.VerifyQueue())
+	})
+}
+
+func testVerifyQueue(ctx *testcontext.Context, t *testing.T, queue audit.VerifyQueue) {
+	expiresAt := time.Now().Add(time.Hour).Truncate(time.Millisecond)
+	segments := []audit.Segment{newVerifySegment(), newVerifySegment(), newVerifySegment()}
+	segments[0].ExpiresAt = &expiresAt
+
+	// segments which are already in the queue are ignored.
+	require.NoError(t, queue.Push(ctx, segments, 2))
+	require.NoError(t, queue.Push(ctx, segments[:1], 2))
+
+	leased, err := queue.Lease(ctx, 10, time.Hour, 0)
+	require.NoError(t, err)
+	requireSameSegments(t, segments, leased)
+
+	// leased segments aren't returned again.
+	leased, err = queue.Lease(ctx, 10, time.Hour, 0)
+	require.NoError(t, err)
+	require.Empty(t, leased)
+
+	require.NoError(t, queue.Remove(ctx, segments))
+
+	// segments are returned again once their lease has expired.
+	require.NoError(t, queue.Push(ctx, segments, 10))
+
+	leased, err = queue.Lease(ctx, 2, time.Millisecond, 0)
+	require.NoError(t, err)
+	require.Len(t, leased, 2)
+
+	time.Sleep(10 * time.Millisecond)
+
+	leased, err = queue.Lease(ctx, 10, time.Hour, 0)
+	require.NoError(t, err)
+	requireSameSegments(t, segments, leased)
+
+	require.NoError(t, queue.Remove(ctx, leased))
+
+	leased, err = queue.Lease(ctx, 10, time.Millisecond, 0)
+	require.NoError(t, err)
+	require.Empty(t, leased)
+
+	t.Run("concurrent workers", func(t *testing.T) {
+		segments := make([]audit.Segment, 100)
+		for i := range segments {
+			segments[i] = newVerifySegment()
+		}
+		require.NoError(t, queue.Push(ctx, segments, 30))
+
+		var mu sync.Mutex
+		var all []audit.Segment
+
+		var group errgroup.Group
+		for i := 0; i < 4; i++ {
+			group.Go(func() error {
+				for {
+					leased, err := queue.Lease(ctx, 7, time.Hour, 0)
+					if err != nil || len(leased) == 0 {
+						return err
+					}
+
+					mu.Lock()
+					all = append(all, leased...)
+					mu.Unlock()
+
+					if err := queue.Remove(ctx, leased); err != nil {
+						return err
+					}
+				}
+			})
+		}
+		require.NoError(t, group.Wait())
+
+		requireSameSegments(t, segments, all)
+	})
+
+	t.Run("max attempts", func(t *testing.T) {
+		const maxAttempts = 3
+		segments := []audit.Segment{newVerifySegment()}
+		require.NoError(t, queue.Push(ctx, segments, 10))
+
+		// a segment whose audits keep failing is leased maxAttempts times.
+		for i := 0; i < maxAttempts; i++ {
+			leased, err := queue.Lease(ctx, 10, time.Millisecond, maxAttempts)
+			require.NoError(t, err)
+			requireSameSegments(t, segments, leased)
+
+			time.Sleep(10 * time.Millisecond)
+		}
+
+		// and then it's removed from the queue.
+		leased, err := queue.Lease(ctx, 10, time.Millisecond, maxAttempts)
+		require.NoError(t, err)
+		require.Empty(t, leased)
+
+		// it can be queued again by the chore.
+		require.NoError(t, queue.Push(ctx, segments, 10))
+		leased, err = queue.Lease(ctx, 10, time.Hour, maxAttempts)
+		require.NoError(t, err)
+		requireSameSegments(t, segments, leased)
+		require.NoError(t, queue.Remove(ctx, leased))
+	})
+}
+
+func TestVerifyQueueChoreAndWorker(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
+		Reconfigure: testplanet.Reconfigure{
+			Satellite: testplanet.Combine(
+				func(log *zap.Logger, index int, config *satellite.Config) {
+					config.Audit.UseVerifyQueue = true
+				},
+				testplanet.ReconfigureRS(2, 3, 4, 4),
+			),
+		},
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		satellite := planet.Satellites[0]
+		audits := satellite.Audit
+
+		audits.Worker.Loop.Pause()
+		audits.Chore.Loop.Pause()
+
+		err := planet.Uplinks[0].Upload(ctx, satellite, "testbucket", "test/path", testrand.Bytes(8*memory.KiB))
+		require.NoError(t, err)
+
+		segments, err := satellite.Metabase.DB.TestingAllSegments(ctx)
+		require.NoError(t, err)
+		require.Len(t, segments, 1)
+
+		audits.Chore.Loop.TriggerWait()
+
+		// the segment stays in the queue until it has been audited.
+		leased, err := audits.VerifyQueue.Lease(ctx, 10, time.Millisecond, 0)
+		require.NoError(t, err)
+		require.Len(t, leased, 1)
+		require.Equal(t, segments[0].StreamID, leased[0].StreamID)
+		require.Equal(t, segments[0].Position, leased[0].Position)
+
+		time.Sleep(10 * time.Millisecond)
+
+		audits.Worker.Loop.TriggerWait()
+
+		leased, err = audits.VerifyQueue.Lease(ctx, 10, time.Millisecond, 0)
+		require.NoError(t, err)
+		require.Empty(t, leased)
+
+		// nothing is swapped into the in-memory queue.
+		require.Zero(t, audits.Queues.Fetch().Size())
+	})
+}
+
+func BenchmarkVerifyQueue(b *testing.B) {
+	b.Run("memory", func(b *testing.B) {
+		benchmarkVerifyQueue(b, audit.NewMemoryVerifyQueue())
+	})
+
+	satellitedbtest.Bench(b, func(b *testing.B, db satellite.DB) {
+		benchmarkVerifyQueue(b, db.VerifyQueue())
+	})
+}
+
+func benchmarkVerifyQueue(b *testing.B, queue audit.VerifyQueue) {
+	ctx := testcontext.New(b)
+	defer ctx.Cleanup()
+
+	const (
+		pushBatchSize = 1000
+		leaseSize     = 100
+	)
+
+	segments := make([]audit.Segment, pushBatchSize)
+	for i := range segments {
+		segments[i] = newVerifySegment()
+	}
+
+	b.Run("Push", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for k := range segments {
+				segments[k].StreamID = testrand.UUID()
+			}
+			if err := queue.Push(ctx, segments, pushBatchSize); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+
+	b.Run("LeaseRemove", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			b.StopTimer()
+			for k := range segments[:leaseSize] {
+				segments[k].StreamID = testrand.UUID()
+			}
+			if err := queue.Push(ctx, segments[:leaseSize], pushBatchSize); err != nil {
+				b.Fatal(err)
+			}
+			b.StartTimer()
+
+			leased, err := queue.Lease(ctx, leaseSize, time.Hour, 0)
+			if err != nil {
+				b.Fatal(err)
+			}
+			if err := queue.Remove(ctx, leased); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
+func newVerifySegment() audit.Segment {
+	return audit.Segment{
+		StreamID: testrand.UUID(),
+		Position: metabase.SegmentPosition{
+			Index: uint32(testrand.Intn(100)),
+		},
+	}
+}
+
+func requireSameSegments(t *testing.T, expected, actual []audit.Segment) {
+	t.Helper()
+
+	require.Len(t, actual, len(expected))
+
+	type segmentKey struct {
+		StreamID uuid.UUID
+		Position metabase.SegmentPosition
+	}
+
+	byKey := make(map[segmentKey]audit.Segment, len(expected))
+	for _, segment := range expected {
+		byKey[segmentKey{segment.StreamID, segment.Position}] = segment
+	}
+	for _, segment := range actual {
+		key := segmentKey{segment.StreamID, segment.Position}
+		want, ok := byKey[key]
+		require.True(t, ok, "unexpected segment %v", segment)
+		delete(byKey, key)
+
+		require.Equal(t, want.StreamID, segment.StreamID)
+		require.Equal(t, want.Position, segment.Position)
+		if want.ExpiresAt == nil {
+			require.Nil(t, segment.ExpiresAt)
+		} else {
+			require.NotNil(t, segment.ExpiresAt)
+			require.WithinDuration(t, *want.ExpiresAt, *segment.ExpiresAt, time.Millisecond)
+		}
+	}
+}
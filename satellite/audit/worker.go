@@ -5,6 +5,7 @@ package audit
 
 import (
 	"context"
+	"sync"
 	"time"
 
 	"github.com/zeebo/errs"
@@ -29,28 +30,49 @@ type Config struct {
 	QueueInterval     time.Duration `help:"how often to recheck an empty audit queue" releaseDefault:"1h" devDefault:"1m" testDefault:"$TESTINTERVAL"`
 	Slots             int           `help:"number of reservoir slots allotted for nodes, currently capped at 3" default:"3"`
 	WorkerConcurrency int           `help:"number of workers to run audits on segments" default:"2"`
+
+	UseVerifyQueue           bool          `help:"use the audit queue in the database, which can be shared by the audit workers of several satellite processes" default:"false"`
+	VerifyQueueBatchSize     int           `help:"number of segments inserted into the audit queue in the database at once" default:"1000"`
+	VerifyQueueLeaseSize     int           `help:"number of segments an audit worker takes from the audit queue in the database at once" default:"10"`
+	VerifyQueueLeaseDuration time.Duration `help:"how long segments taken by an audit worker are hidden from the other workers" default:"1h0m0s"`
+	VerifyQueueMaxAttempts   int           `help:"number of times a segment is taken from the audit queue in the database, before it's dropped when its audits keep failing" default:"5"`
 }
 
 // Worker contains information for populating audit queue and processing audits.
 type Worker struct {
-	log      *zap.Logger
-	queues   *Queues
-	verifier *Verifier
-	reporter *Reporter
-	Loop     *sync2.Cycle
-	limiter  *sync2.Limiter
+	log         *zap.Logger
+	queues      *Queues
+	verifyQueue VerifyQueue
+	verifier    *Verifier
+	reporter    *Reporter
+	Loop        *sync2.Cycle
+	limiter     *sync2.Limiter
+
+	leaseSize     int
+	leaseDuration time.Duration
+	maxAttempts   int
+
+	// stragglers tracks the audits whose slowest downloads are still
+	// running after their worker slot has been released.
+	stragglers sync.WaitGroup
 }
 
-// NewWorker instantiates Worker.
-func NewWorker(log *zap.Logger, queues *Queues, verifier *Verifier, reporter *Reporter, config Config) (*Worker, error) {
+// NewWorker instantiates Worker. When verifyQueue is not nil, the segments
+// are taken from it instead of queues.
+func NewWorker(log *zap.Logger, queues *Queues, verifyQueue VerifyQueue, verifier *Verifier, reporter *Reporter, config Config) (*Worker, error) {
 	return &Worker{
 		log: log,
 
-		queues:   queues,
-		verifier: verifier,
-		reporter: reporter,
-		Loop:     sync2.NewCycle(config.QueueInterval),
-		limiter:  sync2.NewLimiter(config.WorkerConcurrency),
+		queues:      queues,
+		verifyQueue: verifyQueue,
+		verifier:    verifier,
+		reporter:    reporter,
+		Loop:        sync2.NewCycle(config.QueueInterval),
+		limiter:     sync2.NewLimiter(config.WorkerConcurrency),
+
+		leaseSize:     config.VerifyQueueLeaseSize,
+		leaseDuration: config.VerifyQueueLeaseDuration,
+		maxAttempts:   config.VerifyQueueMaxAttempts,
 	}, nil
 }
 
@@ -59,6 +81,7 @@ func (worker *Worker) Run(ctx context.Context) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
 	// Wait for all audits to run.
+	defer worker.stragglers.Wait()
 	defer worker.limiter.Wait()
 
 	return worker.Loop.Run(ctx, func(ctx context.Context) (err error) {
@@ -81,10 +104,15 @@ func (worker *Worker) Close() error {
 func (worker *Worker) process(ctx context.Context) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	if worker.verifyQueue != nil {
+		return worker.processVerifyQueue(ctx)
+	}
+
 	// get the current queue
 	queue := worker.queues.Fetch()
 
 	worker.limiter.Wait()
+	worker.stragglers.Wait()
 	for {
 		segment, err := queue.Next()
 		if err != nil {
@@ -111,6 +139,59 @@ func (worker *Worker) process(ctx context.Context) (err error) {
 	}
 }
 
+// processVerifyQueue repeatedly leases a batch of segments from the verify
+// queue, audits them and removes them from the queue.
+func (worker *Worker) processVerifyQueue(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	worker.limiter.Wait()
+	worker.stragglers.Wait()
+	for {
+		segments, err := worker.verifyQueue.Lease(ctx, worker.leaseSize, worker.leaseDuration, worker.maxAttempts)
+		if err != nil {
+			return err
+		}
+		if len(segments) == 0 {
+			return nil
+		}
+
+		var mu sync.Mutex
+		audited := make([]Segment, 0, len(segments))
+		for _, segment := range segments {
+			segment := segment
+			started := worker.limiter.Go(ctx, func() {
+				err := worker.work(ctx, segment)
+				if err != nil {
+					worker.log.Error("error(s) during audit",
+						zap.String("Segment StreamID", segment.StreamID.String()),
+						zap.Uint64("Segment Position", segment.Position.Encode()),
+						zap.Error(err))
+					return
+				}
+
+				mu.Lock()
+				audited = append(audited, segment)
+				mu.Unlock()
+			})
+			if !started {
+				break
+			}
+		}
+		worker.limiter.Wait()
+
+		// the segments which weren't started, or whose audit failed, are
+		// audited again once their lease expires, until they have been
+		// leased maxAttempts times.
+		err = worker.verifyQueue.Remove(ctx, audited)
+		if err != nil {
+			return err
+		}
+		if err := ctx.Err(); err != nil {
+			return err
+		}
+	}
+}
+
 func (worker *Worker) work(ctx context.Context, segment Segment) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
@@ -147,7 +228,7 @@ func (worker *Worker) work(ctx context.Context, segment Segment) (err error) {
 	}
 
 	// Next, audit the the remaining nodes that are not in containment mode.
-	report, err = worker.verifier.Verify(ctx, segment, skip)
+	report, stragglers, err := worker.verifier.VerifyEarly(ctx, segment, skip)
 	if err != nil {
 		errlist.Add(err)
 	}
@@ -158,5 +239,40 @@ func (worker *Worker) work(ctx context.Context, segment Segment) (err error) {
 		errlist.Add(err)
 	}
 
+	// The outcome of the slowest nodes is recorded without holding the
+	// worker slot, so the next segment can be audited in the meantime.
+	if stragglers != nil {
+		worker.stragglers.Add(1)
+		go func() {
+			defer worker.stragglers.Done()
+			worker.recordStragglers(ctx, segment, stragglers)
+		}()
+	}
+
 	return errlist.Err()
 }
+
+// recordStragglers waits for the slowest downloads of an audit and records
+// their outcomes.
+func (worker *Worker) recordStragglers(ctx context.Context, segment Segment, stragglers *Stragglers) {
+	defer mon.Task()(&ctx)(nil)
+
+	var errlist errs.Group
+
+	report, err := stragglers.Wait(ctx)
+	if err != nil {
+		errlist.Add(err)
+	}
+
+	_, err = worker.reporter.RecordAudits(ctx, report)
+	if err != nil {
+		errlist.Add(err)
+	}
+
+	if err := errlist.Err(); err != nil {
+		worker.log.Error("error(s) during audit",
+			zap.String("Segment StreamID", segment.StreamID.String()),
+			zap.Uint64("Segment Position", segment.Position.Encode()),
+			zap.Error(err))
+	}
+}
@@ -96,11 +96,12 @@ type Core struct {
 	}
 
 	Audit struct {
-		Queues   *audit.Queues
-		Worker   *audit.Worker
-		Chore    *audit.Chore
-		Verifier *audit.Verifier
-		Reporter *audit.Reporter
+		Queues      *audit.Queues
+		VerifyQueue audit.VerifyQueue
+		Worker      *audit.Worker
+		Chore       *audit.Chore
+		Verifier    *audit.Verifier
+		Reporter    *audit.Reporter
 	}
 
 	ExpiredDeletion struct {
@@ -289,6 +290,7 @@ func New(log *zap.Logger, full *identity.FullIdentity, db DB,
 		)
 		peer.Services.Add(lifecycle.Item{
 			Name:  "reputation",
+			Run:   peer.Reputation.Service.Run,
 			Close: peer.Reputation.Service.Close,
 		})
 	}
@@ -297,6 +299,9 @@ func New(log *zap.Logger, full *identity.FullIdentity, db DB,
 		config := config.Audit
 
 		peer.Audit.Queues = audit.NewQueues()
+		if config.UseVerifyQueue {
+			peer.Audit.VerifyQueue = peer.DB.VerifyQueue()
+		}
 
 		peer.Audit.Verifier = audit.NewVerifier(log.Named("audit:verifier"),
 			peer.Metainfo.Metabase,
@@ -318,6 +323,7 @@ func New(log *zap.Logger, full *identity.FullIdentity, db DB,
 
 		peer.Audit.Worker, err = audit.NewWorker(peer.Log.Named("audit:worker"),
 			peer.Audit.Queues,
+			peer.Audit.VerifyQueue,
 			peer.Audit.Verifier,
 			peer.Audit.Reporter,
 			config,
@@ -336,6 +342,7 @@ func New(log *zap.Logger, full *identity.FullIdentity, db DB,
 
 		peer.Audit.Chore = audit.NewChore(peer.Log.Named("audit:chore"),
 			peer.Audit.Queues,
+			peer.Audit.VerifyQueue,
 			peer.Metainfo.SegmentLoop,
 			config,
 		)
@@ -23,6 +23,8 @@ import (
 	"storj.io/storj/private/lifecycle"
 	version_checker "storj.io/storj/private/version/checker"
 	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/gc/bloomfilter"
+	"storj.io/storj/satellite/gc/sender"
 	"storj.io/storj/satellite/metabase"
 	"storj.io/storj/satellite/metabase/segmentloop"
 	"storj.io/storj/satellite/overlay"
@@ -62,6 +64,14 @@ type GarbageCollection struct {
 	GarbageCollection struct {
 		Service *gc.Service
 	}
+
+	GarbageCollectionBF struct {
+		Service *bloomfilter.Service
+	}
+
+	GarbageCollectionSender struct {
+		Service *sender.Service
+	}
 }
 
 // NewGarbageCollection creates a new satellite garbage collection process.
@@ -160,6 +170,39 @@ func NewGarbageCollection(log *zap.Logger, full *identity.FullIdentity, db DB,
 			debug.Cycle("Garbage Collection", peer.GarbageCollection.Service.Loop))
 	}
 
+	{ // setup offline bloom filter generation
+		// The generator reads a snapshot of the segments by itself, so it
+		// doesn't add load to the segment loop.
+		peer.GarbageCollectionBF.Service = bloomfilter.NewService(
+			peer.Log.Named("garbage-collection-bf"),
+			config.GarbageCollectionBF,
+			metabaseDB,
+		)
+		peer.Services.Add(lifecycle.Item{
+			Name:  "garbage-collection-bf",
+			Run:   peer.GarbageCollectionBF.Service.Run,
+			Close: peer.GarbageCollectionBF.Service.Close,
+		})
+		peer.Debug.Server.Panel.Add(
+			debug.Cycle("Garbage Collection Bloom Filters", peer.GarbageCollectionBF.Service.Loop))
+	}
+
+	{ // setup sending of the pending filters
+		peer.GarbageCollectionSender.Service = sender.NewService(
+			peer.Log.Named("garbage-collection-sender"),
+			config.GarbageCollectionSender,
+			peer.Dialer,
+			peer.Overlay.DB,
+		)
+		peer.Services.Add(lifecycle.Item{
+			Name:  "garbage-collection-sender",
+			Run:   peer.GarbageCollectionSender.Service.Run,
+			Close: peer.GarbageCollectionSender.Service.Close,
+		})
+		peer.Debug.Server.Panel.Add(
+			debug.Cycle("Garbage Collection Sender", peer.GarbageCollectionSender.Service.Loop))
+	}
+
 	return peer, nil
 }
 
@@ -0,0 +1,321 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+// Package bloomfilter generates the garbage collection bloom filters offline,
+// from a snapshot of the segments.
+package bloomfilter
+
+import (
+	"bufio"
+	"context"
+	"errors"
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"time"
+
+	"github.com/spacemonkeygo/monkit/v3"
+	"github.com/zeebo/errs"
+	"go.uber.org/zap"
+
+	"storj.io/common/bloomfilter"
+	"storj.io/common/memory"
+	"storj.io/common/storj"
+	"storj.io/common/sync2"
+	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/metabase"
+)
+
+var (
+	// Error defines the bloom filter generator errors class.
+	Error = errs.Class("gc bloom filter")
+	mon   = monkit.Package()
+)
+
+// spillFileExt is the extension of the files containing the piece ids of a
+// node while the segments are read.
+const spillFileExt = ".pieces"
+
+// maxFilterSize limits the size of a filter to stay under the limit for RPC.
+const maxFilterSize = 2 * memory.MiB
+
+// Config contains configurable values for the bloom filter generator.
+type Config struct {
+	Enabled            bool          `help:"set if the bloom filters are generated from a segments snapshot, instead of the segment loop" default:"false"`
+	Interval           time.Duration `help:"the time between each generation of the bloom filters" releaseDefault:"120h" devDefault:"10m" testDefault:"$TESTINTERVAL"`
+	AsOfSystemInterval time.Duration `help:"how far in the past the segments snapshot is read" releaseDefault:"-5m" devDefault:"-1us" testDefault:"-1us"`
+	BatchSize          int           `help:"how many segments are read from the metabase in a batch" default:"2500"`
+	SpillDir           string        `help:"directory where the piece ids of the nodes are kept while reading the segments; a temporary directory is used when empty" default:""`
+	OutputDir          string        `help:"directory where the generated bloom filters are written to, for the retain sender" default:""`
+	MaxMemoryPieces    int           `help:"how many piece ids are kept in memory before they are moved to the spill directory" default:"4000000"`
+	FalsePositiveRate  float64       `help:"the false positive rate used for creating a garbage collection bloom filter" releaseDefault:"0.1" devDefault:"0.1"`
+}
+
+// Service generates the garbage collection bloom filters from a snapshot of
+// the segments, without joining the segment loop.
+//
+// The segments are read in a first pass and the derived piece ids are
+// appended to a file per node once more than MaxMemoryPieces are held in
+// memory. The filters are built from those files, one node at a time, in a
+// second pass and written to OutputDir, where they are picked up by the
+// retain sender. The filters are sized with the exact piece count of the
+// node.
+//
+// architecture: Chore
+type Service struct {
+	log      *zap.Logger
+	config   Config
+	metabase *metabase.DB
+	Loop     *sync2.Cycle
+}
+
+// NewService creates a new instance of the bloom filter generator.
+func NewService(log *zap.Logger, config Config, metabase *metabase.DB) *Service {
+	return &Service{
+		log:      log,
+		config:   config,
+		metabase: metabase,
+		Loop:     sync2.NewCycle(config.Interval),
+	}
+}
+
+// Run starts the bloom filter generator loop.
+func (service *Service) Run(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if !service.config.Enabled {
+		return nil
+	}
+	if service.config.OutputDir == "" {
+		return Error.New("output directory is required")
+	}
+
+	return service.Loop.Run(ctx, func(ctx context.Context) error {
+		err := service.RunOnce(ctx)
+		if err != nil {
+			service.log.Error("error generating bloom filters", zap.Error(err))
+		}
+		return nil
+	})
+}
+
+// Close stops the bloom filter generator loop.
+func (service *Service) Close() error {
+	service.Loop.Close()
+	return nil
+}
+
+// RunOnce generates the bloom filters of all the nodes which store pieces
+// and writes them to the output directory.
+func (service *Service) RunOnce(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := os.MkdirAll(service.config.OutputDir, 0700); err != nil {
+		return Error.Wrap(err)
+	}
+
+	spillDir := service.config.SpillDir
+	if spillDir == "" {
+		spillDir, err = ioutil.TempDir("", "gc-bloomfilter")
+		if err != nil {
+			return Error.Wrap(err)
+		}
+		defer func() { err = errs.Combine(err, Error.Wrap(os.RemoveAll(spillDir))) }()
+	} else {
+		if err := os.MkdirAll(spillDir, 0700); err != nil {
+			return Error.Wrap(err)
+		}
+		// files left by an interrupted run would be appended to.
+		if err := removeSpillFiles(spillDir); err != nil {
+			return err
+		}
+	}
+
+	collector := newPieceCollector(spillDir, service.config.MaxMemoryPieces)
+	defer func() { err = errs.Combine(err, collector.Remove()) }()
+
+	// pieces uploaded after the snapshot time aren't in the filters, so they
+	// must not be garbage collected.
+	snapshot, err := service.metabase.Now(ctx)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	err = service.metabase.IterateLoopSegments(ctx, metabase.IterateLoopSegments{
+		BatchSize:          service.config.BatchSize,
+		AsOfSystemTime:     snapshot,
+		AsOfSystemInterval: service.config.AsOfSystemInterval,
+	}, func(ctx context.Context, iterator metabase.LoopSegmentsIterator) error {
+		var segment metabase.LoopSegmentEntry
+		for iterator.Next(ctx, &segment) {
+			if err := ctx.Err(); err != nil {
+				return err
+			}
+			for _, piece := range segment.Pieces {
+				pieceID := segment.RootPieceID.Derive(piece.StorageNode, int32(piece.Number))
+				if err := collector.Add(piece.StorageNode, pieceID); err != nil {
+					return err
+				}
+			}
+		}
+		return nil
+	})
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	var written int
+	for nodeID, count := range collector.counts {
+		if err := ctx.Err(); err != nil {
+			return err
+		}
+
+		info := &gc.RetainInfo{
+			Filter:       bloomfilter.NewOptimalMaxSize(count, service.config.FalsePositiveRate, maxFilterSize),
+			CreationDate: snapshot,
+			Count:        count,
+		}
+		err := collector.Each(nodeID, func(pieceID storj.PieceID) {
+			info.Filter.Add(pieceID)
+		})
+		if err != nil {
+			return err
+		}
+
+		if err := gc.WriteRetainFile(service.config.OutputDir, nodeID, info); err != nil {
+			return err
+		}
+		written++
+
+		mon.IntVal("node_piece_count").Observe(int64(count))
+		mon.IntVal("retain_filter_size_bytes").Observe(info.Filter.Size())
+	}
+
+	service.log.Info("Generated bloom filters", zap.Int("nodes", written), zap.Time("snapshot", snapshot))
+	return nil
+}
+
+// pieceCollector keeps the piece ids of every node, in memory up to
+// maxMemoryPieces and in a file per node in dir otherwise.
+type pieceCollector struct {
+	dir             string
+	maxMemoryPieces int
+
+	memory      map[storj.NodeID][]storj.PieceID
+	memoryCount int
+	spilled     map[storj.NodeID]bool
+	counts      map[storj.NodeID]int
+}
+
+func newPieceCollector(dir string, maxMemoryPieces int) *pieceCollector {
+	return &pieceCollector{
+		dir:             dir,
+		maxMemoryPieces: maxMemoryPieces,
+
+		memory:  map[storj.NodeID][]storj.PieceID{},
+		spilled: map[storj.NodeID]bool{},
+		counts:  map[storj.NodeID]int{},
+	}
+}
+
+// Add adds a piece of the node.
+func (collector *pieceCollector) Add(nodeID storj.NodeID, pieceID storj.PieceID) error {
+	collector.memory[nodeID] = append(collector.memory[nodeID], pieceID)
+	collector.memoryCount++
+	collector.counts[nodeID]++
+
+	if collector.memoryCount < collector.maxMemoryPieces {
+		return nil
+	}
+	return collector.spill()
+}
+
+// spill appends the pieces in memory to the files of their nodes.
+func (collector *pieceCollector) spill() error {
+	for nodeID, pieces := range collector.memory {
+		if err := collector.appendFile(nodeID, pieces); err != nil {
+			return err
+		}
+		collector.spilled[nodeID] = true
+	}
+
+	collector.memory = map[storj.NodeID][]storj.PieceID{}
+	collector.memoryCount = 0
+	return nil
+}
+
+func (collector *pieceCollector) appendFile(nodeID storj.NodeID, pieces []storj.PieceID) (err error) {
+	file, err := os.OpenFile(collector.path(nodeID), os.O_CREATE|os.O_WRONLY|os.O_APPEND, 0600)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+	defer func() { err = errs.Combine(err, Error.Wrap(file.Close())) }()
+
+	w := bufio.NewWriter(file)
+	for _, pieceID := range pieces {
+		if _, err := w.Write(pieceID[:]); err != nil {
+			return Error.Wrap(err)
+		}
+	}
+	return Error.Wrap(w.Flush())
+}
+
+// Each calls fn for every piece of the node.
+func (collector *pieceCollector) Each(nodeID storj.NodeID, fn func(storj.PieceID)) (err error) {
+	if collector.spilled[nodeID] {
+		file, err := os.Open(collector.path(nodeID))
+		if err != nil {
+			return Error.Wrap(err)
+		}
+		defer func() { err = errs.Combine(err, Error.Wrap(file.Close())) }()
+
+		r := bufio.NewReader(file)
+		var pieceID storj.PieceID
+		for {
+			_, err := io.ReadFull(r, pieceID[:])
+			if errors.Is(err, io.EOF) {
+				break
+			}
+			if err != nil {
+				return Error.Wrap(err)
+			}
+			fn(pieceID)
+		}
+	}
+
+	for _, pieceID := range collector.memory[nodeID] {
+		fn(pieceID)
+	}
+	return nil
+}
+
+// Remove removes the files of the nodes.
+func (collector *pieceCollector) Remove() error {
+	var group errs.Group
+	for nodeID := range collector.spilled {
+		err := os.Remove(collector.path(nodeID))
+		if err != nil && !os.IsNotExist(err) {
+			group.Add(err)
+		}
+	}
+	return Error.Wrap(group.Err())
+}
+
+func (collector *pieceCollector) path(nodeID storj.NodeID) string {
+	return filepath.Join(collector.dir, nodeID.String()+spillFileExt)
+}
+
+// removeSpillFiles removes the piece files in dir.
+func removeSpillFiles(dir string) error {
+	paths, err := filepath.Glob(filepath.Join(dir, "*"+spillFileExt))
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	var group errs.Group
+	for _, path := range paths {
+		group.Add(os.Remove(path))
+	}
+	return Error.Wrap(group.Err())
+}
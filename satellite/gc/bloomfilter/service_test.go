@@ -0,0 +1,83 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package bloomfilter_test
+
+import (
+	"path/filepath"
+	"strconv"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/memory"
+	"storj.io/common/storj"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/private/testplanet"
+	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/gc/bloomfilter"
+)
+
+func TestServiceRunOnce(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
+		Reconfigure: testplanet.Reconfigure{
+			Satellite: testplanet.ReconfigureRS(2, 2, 4, 4),
+		},
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		satellite := planet.Satellites[0]
+
+		for i := 0; i < 5; i++ {
+			err := planet.Uplinks[0].Upload(ctx, satellite, "testbucket", "test/path/"+strconv.Itoa(i), testrand.Bytes(8*memory.KiB))
+			require.NoError(t, err)
+		}
+
+		segments, err := satellite.Metabase.DB.TestingAllSegments(ctx)
+		require.NoError(t, err)
+
+		expected := map[storj.NodeID][]storj.PieceID{}
+		for _, segment := range segments {
+			for _, piece := range segment.Pieces {
+				pieceID := segment.RootPieceID.Derive(piece.StorageNode, int32(piece.Number))
+				expected[piece.StorageNode] = append(expected[piece.StorageNode], pieceID)
+			}
+		}
+
+		outputDir := ctx.Dir("retain")
+		beforeRun := time.Now()
+
+		// a small memory limit makes the pieces go through the spill files.
+		service := bloomfilter.NewService(zaptest.NewLogger(t), bloomfilter.Config{
+			AsOfSystemInterval: -1 * time.Microsecond,
+			BatchSize:          3,
+			SpillDir:           ctx.Dir("spill"),
+			OutputDir:          outputDir,
+			MaxMemoryPieces:    2,
+			FalsePositiveRate:  0.1,
+		}, satellite.Metabase.DB)
+		require.NoError(t, service.RunOnce(ctx))
+
+		nodes, err := gc.ListRetainFiles(outputDir)
+		require.NoError(t, err)
+		require.Len(t, nodes, len(expected))
+
+		for _, nodeID := range nodes {
+			info, err := gc.ReadRetainFile(outputDir, nodeID)
+			require.NoError(t, err)
+			require.Equal(t, len(expected[nodeID]), info.Count)
+			require.WithinDuration(t, beforeRun, info.CreationDate, time.Minute)
+
+			for _, pieceID := range expected[nodeID] {
+				require.True(t, info.Filter.Contains(pieceID))
+			}
+		}
+
+		// the spill files are removed after the run.
+		spilled, err := filepath.Glob(filepath.Join(ctx.Dir("spill"), "*"))
+		require.NoError(t, err)
+		require.Empty(t, spilled)
+	})
+}
@@ -5,6 +5,8 @@ package gc
 
 import (
 	"context"
+	"encoding/binary"
+	"sync"
 	"time"
 
 	"github.com/zeebo/errs"
@@ -18,8 +20,17 @@ import (
 
 var _ segmentloop.Observer = (*PieceTracker)(nil)
 
+// pieceTrackerBatchSize is the number of pieces which are handed to a filter
+// worker at once.
+const pieceTrackerBatchSize = 4096
+
 // PieceTracker implements the metainfo loop observer interface for garbage collection.
 //
+// When config.FilterWorkers is more than one, the bloom filters are built by
+// that many goroutines. The nodes are split between the workers and every
+// worker owns the filters of its nodes, so the filters don't need locking.
+// In that case Finish must be called after the loop has finished.
+//
 // architecture: Observer
 type PieceTracker struct {
 	log          *zap.Logger
@@ -28,9 +39,26 @@ type PieceTracker struct {
 	// TODO: should we use int or int64 consistently for piece count (db type is int64)?
 	pieceCounts map[storj.NodeID]int
 
+	workers []*filterWorker
+	pending [][]trackedPiece
+	wg      sync.WaitGroup
+
 	RetainInfos map[storj.NodeID]*RetainInfo
 }
 
+// trackedPiece is a piece which has to be added to the filter of its node.
+type trackedPiece struct {
+	nodeID      storj.NodeID
+	rootPieceID storj.PieceID
+	number      int32
+}
+
+// filterWorker builds the filters of a subset of the nodes.
+type filterWorker struct {
+	pieces      chan []trackedPiece
+	retainInfos map[storj.NodeID]*RetainInfo
+}
+
 // NewPieceTracker instantiates a new gc piece tracker to be subscribed to the metainfo loop.
 func NewPieceTracker(log *zap.Logger, config Config, pieceCounts map[storj.NodeID]int) *PieceTracker {
 	return &PieceTracker{
@@ -48,6 +76,10 @@ func (pieceTracker *PieceTracker) LoopStarted(ctx context.Context, info segmentl
 	if pieceTracker.creationDate.After(info.Started) {
 		return errs.New("Creation date after loop starting time.")
 	}
+
+	if pieceTracker.config.FilterWorkers > 1 && pieceTracker.workers == nil {
+		pieceTracker.startWorkers(pieceTracker.config.FilterWorkers)
+	}
 	return nil
 }
 
@@ -55,9 +87,23 @@ func (pieceTracker *PieceTracker) LoopStarted(ctx context.Context, info segmentl
 func (pieceTracker *PieceTracker) RemoteSegment(ctx context.Context, segment *segmentloop.Segment) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	if pieceTracker.workers != nil {
+		for _, piece := range segment.Pieces {
+			err := pieceTracker.enqueue(ctx, trackedPiece{
+				nodeID:      piece.StorageNode,
+				rootPieceID: segment.RootPieceID,
+				number:      int32(piece.Number),
+			})
+			if err != nil {
+				return err
+			}
+		}
+		return nil
+	}
+
 	for _, piece := range segment.Pieces {
 		pieceID := segment.RootPieceID.Derive(piece.StorageNode, int32(piece.Number))
-		pieceTracker.add(piece.StorageNode, pieceID)
+		pieceTracker.add(pieceTracker.RetainInfos, piece.StorageNode, pieceID)
 	}
 
 	return nil
@@ -68,9 +114,83 @@ func (pieceTracker *PieceTracker) InlineSegment(ctx context.Context, segment *se
 	return nil
 }
 
+// Finish waits for the filter workers to add the remaining pieces and
+// collects their filters into RetainInfos. It must be called after the loop,
+// also when joining the loop failed, to stop the workers.
+func (pieceTracker *PieceTracker) Finish() {
+	if pieceTracker.workers == nil {
+		return
+	}
+
+	for i, worker := range pieceTracker.workers {
+		if len(pieceTracker.pending[i]) > 0 {
+			worker.pieces <- pieceTracker.pending[i]
+		}
+		close(worker.pieces)
+	}
+	pieceTracker.wg.Wait()
+
+	// the nodes of the workers don't overlap.
+	for _, worker := range pieceTracker.workers {
+		for nodeID, info := range worker.retainInfos {
+			pieceTracker.RetainInfos[nodeID] = info
+		}
+	}
+
+	pieceTracker.workers = nil
+	pieceTracker.pending = nil
+}
+
+// startWorkers starts the goroutines which build the filters.
+func (pieceTracker *PieceTracker) startWorkers(count int) {
+	pieceTracker.workers = make([]*filterWorker, count)
+	pieceTracker.pending = make([][]trackedPiece, count)
+
+	for i := range pieceTracker.workers {
+		worker := &filterWorker{
+			pieces:      make(chan []trackedPiece, 2),
+			retainInfos: make(map[storj.NodeID]*RetainInfo, len(pieceTracker.pieceCounts)/count),
+		}
+		pieceTracker.workers[i] = worker
+
+		pieceTracker.wg.Add(1)
+		go func() {
+			defer pieceTracker.wg.Done()
+			for batch := range worker.pieces {
+				for _, piece := range batch {
+					pieceID := piece.rootPieceID.Derive(piece.nodeID, piece.number)
+					pieceTracker.add(worker.retainInfos, piece.nodeID, pieceID)
+				}
+			}
+		}()
+	}
+}
+
+// enqueue adds the piece to the batch of the worker which owns the node, and
+// hands the batch to the worker when it's full.
+func (pieceTracker *PieceTracker) enqueue(ctx context.Context, piece trackedPiece) error {
+	index := int(binary.BigEndian.Uint32(piece.nodeID[:4]) % uint32(len(pieceTracker.workers)))
+
+	if pieceTracker.pending[index] == nil {
+		pieceTracker.pending[index] = make([]trackedPiece, 0, pieceTrackerBatchSize)
+	}
+	pieceTracker.pending[index] = append(pieceTracker.pending[index], piece)
+	if len(pieceTracker.pending[index]) < pieceTrackerBatchSize {
+		return nil
+	}
+
+	select {
+	case pieceTracker.workers[index].pieces <- pieceTracker.pending[index]:
+		pieceTracker.pending[index] = nil
+		return nil
+	case <-ctx.Done():
+		return ctx.Err()
+	}
+}
+
 // adds a pieceID to the relevant node's RetainInfo.
-func (pieceTracker *PieceTracker) add(nodeID storj.NodeID, pieceID storj.PieceID) {
-	if _, ok := pieceTracker.RetainInfos[nodeID]; !ok {
+func (pieceTracker *PieceTracker) add(retainInfos map[storj.NodeID]*RetainInfo, nodeID storj.NodeID, pieceID storj.PieceID) {
+	if _, ok := retainInfos[nodeID]; !ok {
 		// If we know how many pieces a node should be storing, use that number. Otherwise use default.
 		numPieces := pieceTracker.config.InitialPieces
 		if pieceTracker.pieceCounts[nodeID] > 0 {
@@ -78,12 +198,12 @@ func (pieceTracker *PieceTracker) add(nodeID storj.NodeID, pieceID storj.PieceID
 		}
 		// limit size of bloom filter to ensure we are under the limit for RPC
 		filter := bloomfilter.NewOptimalMaxSize(numPieces, pieceTracker.config.FalsePositiveRate, 2*memory.MiB)
-		pieceTracker.RetainInfos[nodeID] = &RetainInfo{
+		retainInfos[nodeID] = &RetainInfo{
 			Filter:       filter,
 			CreationDate: pieceTracker.creationDate,
 		}
 	}
 
-	pieceTracker.RetainInfos[nodeID].Filter.Add(pieceID)
-	pieceTracker.RetainInfos[nodeID].Count++
+	retainInfos[nodeID].Filter.Add(pieceID)
+	retainInfos[nodeID].Count++
 }
@@ -0,0 +1,129 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package gc_test
+
+import (
+	"fmt"
+	"math/rand"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap"
+
+	"storj.io/common/storj"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/metabase"
+	"storj.io/storj/satellite/metabase/segmentloop"
+)
+
+func TestPieceTracker_FilterWorkers(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	nodes, segments := generateTrackerSegments(50, 2000, 10)
+	pieceCounts := map[storj.NodeID]int{nodes[0]: 1000}
+
+	build := func(workers int) map[storj.NodeID]*gc.RetainInfo {
+		pieceTracker := gc.NewPieceTracker(zap.NewNop(), gc.Config{
+			FalsePositiveRate: 0.1,
+			InitialPieces:     100,
+			FilterWorkers:     workers,
+		}, pieceCounts)
+
+		require.NoError(t, pieceTracker.LoopStarted(ctx, segmentloop.LoopInfo{Started: time.Now()}))
+		for i := range segments {
+			require.NoError(t, pieceTracker.RemoteSegment(ctx, &segments[i]))
+		}
+		pieceTracker.Finish()
+
+		return pieceTracker.RetainInfos
+	}
+
+	expected := build(0)
+	require.Len(t, expected, len(nodes))
+
+	for _, workers := range []int{2, 7} {
+		retainInfos := build(workers)
+		require.Len(t, retainInfos, len(expected), "workers=%d", workers)
+		for nodeID, info := range expected {
+			got, ok := retainInfos[nodeID]
+			require.True(t, ok, "workers=%d", workers)
+			require.Equal(t, info.Count, got.Count, "workers=%d", workers)
+			require.Equal(t, info.Filter.Bytes(), got.Filter.Bytes(), "workers=%d", workers)
+		}
+	}
+}
+
+// BenchmarkPieceTracker adds the pieces of segments to filters, which are
+// sized for 10k nodes holding 1B pieces in total.
+func BenchmarkPieceTracker(b *testing.B) {
+	const (
+		nodeCount   = 10000
+		totalPieces = 1000000000
+	)
+
+	ctx := testcontext.New(b)
+	defer ctx.Cleanup()
+
+	nodes, segments := generateTrackerSegments(nodeCount, 1000, 80)
+	pieceCounts := make(map[storj.NodeID]int, len(nodes))
+	for _, nodeID := range nodes {
+		pieceCounts[nodeID] = totalPieces / nodeCount
+	}
+
+	for _, workers := range []int{0, 4, 16} {
+		b.Run(fmt.Sprintf("workers=%d", workers), func(b *testing.B) {
+			pieceTracker := gc.NewPieceTracker(zap.NewNop(), gc.Config{
+				FalsePositiveRate: 0.1,
+				InitialPieces:     400000,
+				FilterWorkers:     workers,
+			}, pieceCounts)
+
+			err := pieceTracker.LoopStarted(ctx, segmentloop.LoopInfo{Started: time.Now()})
+			require.NoError(b, err)
+
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				err := pieceTracker.RemoteSegment(ctx, &segments[i%len(segments)])
+				if err != nil {
+					b.Fatal(err)
+				}
+			}
+			pieceTracker.Finish()
+		})
+	}
+}
+
+// generateTrackerSegments generates segments with piecesPerSegment pieces,
+// which are spread randomly over nodeCount nodes.
+func generateTrackerSegments(nodeCount, segmentCount, piecesPerSegment int) ([]storj.NodeID, []segmentloop.Segment) {
+	nodes := make([]storj.NodeID, nodeCount)
+	for i := range nodes {
+		nodes[i] = testrand.NodeID()
+	}
+
+	rng := rand.New(rand.NewSource(1))
+
+	segments := make([]segmentloop.Segment, segmentCount)
+	for i := range segments {
+		pieces := make(metabase.Pieces, piecesPerSegment)
+		for k, index := range rng.Perm(nodeCount)[:piecesPerSegment] {
+			pieces[k] = metabase.Piece{
+				Number:      uint16(k),
+				StorageNode: nodes[index],
+			}
+		}
+		segments[i] = segmentloop.Segment{
+			StreamID:    testrand.UUID(),
+			RootPieceID: testrand.PieceID(),
+			Pieces:      pieces,
+		}
+	}
+
+	return nodes, segments
+}
@@ -0,0 +1,147 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package gc
+
+import (
+	"encoding/binary"
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"strings"
+	"time"
+
+	"github.com/zeebo/errs"
+
+	"storj.io/common/bloomfilter"
+	"storj.io/common/storj"
+)
+
+// RetainFileExt is the extension of the files containing the retain info of
+// a node, which are written by the bloom filter generator.
+const RetainFileExt = ".retain"
+
+// retainFileHeaderSize is the size of the piece count and the creation date
+// which precede the filter in a retain file.
+const retainFileHeaderSize = 16
+
+// WriteRetainFile writes the retain info of the node to dir. The file is
+// written to a temporary file first, so a reader never sees a partial file.
+func WriteRetainFile(dir string, nodeID storj.NodeID, info *RetainInfo) (err error) {
+	filter := info.Filter.Bytes()
+
+	data := make([]byte, retainFileHeaderSize, retainFileHeaderSize+len(filter))
+	binary.BigEndian.PutUint64(data[0:8], uint64(info.Count))
+	binary.BigEndian.PutUint64(data[8:16], uint64(info.CreationDate.UnixNano()))
+	data = append(data, filter...)
+
+	path := RetainFilePath(dir, nodeID)
+	if err := ioutil.WriteFile(path+".tmp", data, 0600); err != nil {
+		return Error.Wrap(err)
+	}
+	return Error.Wrap(os.Rename(path+".tmp", path))
+}
+
+// ReadRetainFile reads the retain info of the node from dir.
+func ReadRetainFile(dir string, nodeID storj.NodeID) (*RetainInfo, error) {
+	data, err := ioutil.ReadFile(RetainFilePath(dir, nodeID))
+	if err != nil {
+		return nil, Error.Wrap(err)
+	}
+	if len(data) < retainFileHeaderSize {
+		return nil, Error.New("retain file of %s is too short", nodeID)
+	}
+
+	filter, err := bloomfilter.NewFromBytes(data[retainFileHeaderSize:])
+	if err != nil {
+		return nil, Error.Wrap(err)
+	}
+
+	return &RetainInfo{
+		Filter:       filter,
+		CreationDate: time.Unix(0, int64(binary.BigEndian.Uint64(data[8:16]))).UTC(),
+		Count:        int(binary.BigEndian.Uint64(data[0:8])),
+	}, nil
+}
+
+// ReadRetainFileHeader reads the piece count and the creation date of the
+// retain file of the node from dir, without reading the filter.
+func ReadRetainFileHeader(dir string, nodeID storj.NodeID) (count int, creationDate time.Time, err error) {
+	return readRetainFileHeader(RetainFilePath(dir, nodeID), nodeID)
+}
+
+func readRetainFileHeader(path string, nodeID storj.NodeID) (count int, creationDate time.Time, err error) {
+	file, err := os.Open(path)
+	if err != nil {
+		return 0, time.Time{}, Error.Wrap(err)
+	}
+	defer func() { err = errs.Combine(err, Error.Wrap(file.Close())) }()
+
+	var header [retainFileHeaderSize]byte
+	if _, err := io.ReadFull(file, header[:]); err != nil {
+		return 0, time.Time{}, Error.New("retain file of %s is too short: %v", nodeID, err)
+	}
+
+	count = int(binary.BigEndian.Uint64(header[0:8]))
+	creationDate = time.Unix(0, int64(binary.BigEndian.Uint64(header[8:16]))).UTC()
+	return count, creationDate, nil
+}
+
+// RemoveRetainFile removes the retain file of the node from dir, unless it
+// has been replaced by a file with another creation date. The file is moved
+// away before its creation date is checked, so a file which WriteRetainFile
+// writes in the meantime is never removed.
+func RemoveRetainFile(dir string, nodeID storj.NodeID, creationDate time.Time) (err error) {
+	path := RetainFilePath(dir, nodeID)
+	removed := path + ".removed"
+
+	if err := os.Rename(path, removed); err != nil {
+		if os.IsNotExist(err) {
+			return nil
+		}
+		return Error.Wrap(err)
+	}
+
+	_, removedDate, err := readRetainFileHeader(removed, nodeID)
+	if err != nil {
+		return errs.Combine(err, Error.Wrap(os.Remove(removed)))
+	}
+
+	if !removedDate.Equal(creationDate) {
+		// the file was replaced, so it's put back, unless an even newer file
+		// has been written since.
+		err = os.Link(removed, path)
+		if err != nil && !os.IsExist(err) {
+			return Error.Wrap(err)
+		}
+	}
+	return Error.Wrap(os.Remove(removed))
+}
+
+// ListRetainFiles returns the nodes which have a retain file in dir.
+func ListRetainFiles(dir string) (storj.NodeIDList, error) {
+	entries, err := ioutil.ReadDir(dir)
+	if err != nil {
+		return nil, Error.Wrap(err)
+	}
+
+	var nodes storj.NodeIDList
+	for _, info := range entries {
+		name := info.Name()
+		if info.IsDir() || !strings.HasSuffix(name, RetainFileExt) {
+			continue
+		}
+		nodeID, err := storj.NodeIDFromString(strings.TrimSuffix(name, RetainFileExt))
+		if err != nil {
+			continue
+		}
+		nodes = append(nodes, nodeID)
+	}
+	return nodes, nil
+}
+
+// RetainFilePath returns the path of the retain file of the node in dir.
+func RetainFilePath(dir string, nodeID storj.NodeID) string {
+	return filepath.Join(dir, nodeID.String()+RetainFileExt)
+}
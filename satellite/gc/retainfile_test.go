@@ -0,0 +1,56 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package gc_test
+
+import (
+	"os"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+
+	"storj.io/common/bloomfilter"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/satellite/gc"
+)
+
+func TestRemoveRetainFile(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	dir := ctx.Dir("retain")
+	nodeID := testrand.NodeID()
+
+	sent := time.Now().Add(-time.Hour).UTC()
+	newer := time.Now().UTC()
+	write := func(creationDate time.Time) {
+		require.NoError(t, gc.WriteRetainFile(dir, nodeID, &gc.RetainInfo{
+			Filter:       bloomfilter.NewOptimal(10, 0.1),
+			CreationDate: creationDate,
+			Count:        10,
+		}))
+	}
+
+	// a file which was replaced by a newer one is kept.
+	write(newer)
+	require.NoError(t, gc.RemoveRetainFile(dir, nodeID, sent))
+
+	_, creationDate, err := gc.ReadRetainFileHeader(dir, nodeID)
+	require.NoError(t, err)
+	require.True(t, newer.Equal(creationDate))
+
+	// the sent file is removed.
+	require.NoError(t, gc.RemoveRetainFile(dir, nodeID, newer))
+
+	_, err = os.Stat(gc.RetainFilePath(dir, nodeID))
+	require.True(t, os.IsNotExist(err))
+
+	nodes, err := gc.ListRetainFiles(dir)
+	require.NoError(t, err)
+	require.Empty(t, nodes)
+
+	// removing a missing file isn't an error.
+	require.NoError(t, gc.RemoveRetainFile(dir, nodeID, newer))
+}
@@ -0,0 +1,242 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+// Package sender sends the garbage collection filters, which are pending in
+// the retain directory, to the storage nodes.
+package sender
+
+import (
+	"context"
+	"os"
+	"sort"
+	"time"
+
+	"github.com/spacemonkeygo/monkit/v3"
+	"github.com/zeebo/errs"
+	"go.uber.org/zap"
+
+	"storj.io/common/rpc"
+	"storj.io/common/storj"
+	"storj.io/common/sync2"
+	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/overlay"
+)
+
+var (
+	// Error defines the retain sender errors class.
+	Error = errs.Class("gc retain sender")
+	mon   = monkit.Package()
+)
+
+// Config contains configurable values for the retain sender.
+type Config struct {
+	Enabled           bool          `help:"set if the pending garbage collection filters in the retain directory are sent to the storage nodes" default:"false"`
+	Interval          time.Duration `help:"the time between each attempt to send the pending filters" releaseDefault:"1h" devDefault:"1m" testDefault:"$TESTINTERVAL"`
+	RetainDir         string        `help:"directory where the pending garbage collection filters are kept" default:""`
+	ConcurrentSends   int           `help:"the number of nodes to concurrently send garbage collection bloom filters to" releaseDefault:"100" devDefault:"10"`
+	RetainSendTimeout time.Duration `help:"the amount of time to allow a node to handle a retain request" default:"1m"`
+}
+
+// Service sends the filters in the retain directory to the storage nodes.
+//
+// A filter stays in the directory until it has been delivered, so the
+// filters of offline nodes are retried on the next cycle and no filter is
+// lost when the satellite restarts. The filters are read from disk when
+// they are sent, so at most ConcurrentSends filters are held in memory.
+// Nodes with the largest estimated share of garbage are sent to first.
+//
+// architecture: Chore
+type Service struct {
+	log    *zap.Logger
+	config Config
+	Loop   *sync2.Cycle
+
+	dialer  rpc.Dialer
+	overlay overlay.DB
+}
+
+// NewService creates a new instance of the retain sender.
+func NewService(log *zap.Logger, config Config, dialer rpc.Dialer, overlay overlay.DB) *Service {
+	return &Service{
+		log:    log,
+		config: config,
+		Loop:   sync2.NewCycle(config.Interval),
+
+		dialer:  dialer,
+		overlay: overlay,
+	}
+}
+
+// Run starts the retain sender loop.
+func (service *Service) Run(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if !service.config.Enabled {
+		return nil
+	}
+	if service.config.RetainDir == "" {
+		return Error.New("retain directory is required")
+	}
+
+	return service.Loop.Run(ctx, func(ctx context.Context) error {
+		err := service.RunOnce(ctx)
+		if err != nil {
+			service.log.Error("error sending retain filters", zap.Error(err))
+		}
+		return nil
+	})
+}
+
+// Close stops the retain sender loop.
+func (service *Service) Close() error {
+	service.Loop.Close()
+	return nil
+}
+
+// pendingRetain is a filter in the retain directory, which wasn't sent yet.
+type pendingRetain struct {
+	NodeID       storj.NodeID
+	Count        int
+	CreationDate time.Time
+
+	// GarbageRatio is the estimated share of the pieces stored by the node
+	// which are garbage.
+	GarbageRatio float64
+}
+
+// RunOnce sends all the pending filters.
+func (service *Service) RunOnce(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	pending, err := service.pending(ctx)
+	if err != nil {
+		return err
+	}
+	mon.IntVal("pending_retain_filters").Observe(int64(len(pending)))
+
+	limiter := sync2.NewLimiter(service.config.ConcurrentSends)
+	for _, retain := range pending {
+		retain := retain
+		started := limiter.Go(ctx, func() {
+			err := service.send(ctx, retain)
+			if err != nil {
+				service.log.Debug("error sending retain filter, will retry",
+					zap.Stringer("Node ID", retain.NodeID), zap.Error(err))
+				mon.Counter("retain_send_failed").Inc(1)
+				return
+			}
+			mon.Counter("retain_sent").Inc(1)
+		})
+		if !started {
+			break
+		}
+	}
+	limiter.Wait()
+
+	return ctx.Err()
+}
+
+// pending returns the filters in the retain directory, ordered by the
+// estimated garbage ratio of their nodes.
+func (service *Service) pending(ctx context.Context) (_ []pendingRetain, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	// the generator may not have written any filter yet.
+	if err := os.MkdirAll(service.config.RetainDir, 0700); err != nil {
+		return nil, Error.Wrap(err)
+	}
+
+	nodes, err := gc.ListRetainFiles(service.config.RetainDir)
+	if err != nil {
+		return nil, err
+	}
+
+	// the piece counts are the expected counts of the previously delivered
+	// filters, which approximate what the nodes currently store.
+	storedCounts, err := service.overlay.AllPieceCounts(ctx)
+	if err != nil {
+		return nil, Error.Wrap(err)
+	}
+
+	pending := make([]pendingRetain, 0, len(nodes))
+	for _, nodeID := range nodes {
+		count, creationDate, err := gc.ReadRetainFileHeader(service.config.RetainDir, nodeID)
+		if err != nil {
+			service.log.Warn("error reading retain file", zap.Stringer("Node ID", nodeID), zap.Error(err))
+			continue
+		}
+
+		pending = append(pending, pendingRetain{
+			NodeID:       nodeID,
+			Count:        count,
+			CreationDate: creationDate,
+			GarbageRatio: garbageRatio(storedCounts[nodeID], count),
+		})
+	}
+
+	sort.SliceStable(pending, func(i, k int) bool {
+		return pending[i].GarbageRatio > pending[k].GarbageRatio
+	})
+
+	return pending, nil
+}
+
+// garbageRatio estimates which share of the stored pieces are garbage, when
+// the node is expected to keep only expected pieces.
+func garbageRatio(stored, expected int) float64 {
+	if stored <= expected || stored <= 0 {
+		return 0
+	}
+	return float64(stored-expected) / float64(stored)
+}
+
+// send sends the filter to the node and removes it from the retain
+// directory once it has been delivered.
+func (service *Service) send(ctx context.Context, retain pendingRetain) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	dossier, err := service.overlay.Get(ctx, retain.NodeID)
+	if err != nil {
+		if overlay.ErrNodeNotFound.Has(err) {
+			return service.remove(retain)
+		}
+		return Error.Wrap(err)
+	}
+	if dossier.Disqualified != nil || dossier.ExitStatus.ExitFinishedAt != nil {
+		return service.remove(retain)
+	}
+
+	info, err := gc.ReadRetainFile(service.config.RetainDir, retain.NodeID)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	if service.config.RetainSendTimeout > 0 {
+		var cancel func()
+		ctx, cancel = context.WithTimeout(ctx, service.config.RetainSendTimeout)
+		defer cancel()
+	}
+
+	err = gc.SendRetainRequest(ctx, service.dialer, storj.NodeURL{
+		ID:      retain.NodeID,
+		Address: dossier.Address.Address,
+	}, info)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	// save the piece count, which the node is expected to store after
+	// handling the filter, for the next estimate.
+	err = service.overlay.UpdatePieceCounts(ctx, map[storj.NodeID]int{retain.NodeID: info.Count})
+	if err != nil {
+		service.log.Warn("error updating piece count", zap.Stringer("Node ID", retain.NodeID), zap.Error(err))
+	}
+
+	return service.remove(retain)
+}
+
+// remove removes the filter from the retain directory, unless it has been
+// replaced by a newer filter in the meantime.
+func (service *Service) remove(retain pendingRetain) error {
+	return Error.Wrap(gc.RemoveRetainFile(service.config.RetainDir, retain.NodeID, retain.CreationDate))
+}
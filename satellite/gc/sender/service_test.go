@@ -0,0 +1,71 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package sender_test
+
+import (
+	"os"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/bloomfilter"
+	"storj.io/common/storj"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/private/testplanet"
+	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/gc/sender"
+)
+
+func TestSenderRunOnce(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 2, UplinkCount: 0,
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		satellite := planet.Satellites[0]
+		onlineNode := planet.StorageNodes[0]
+		offlineNode := planet.StorageNodes[1]
+		unknownNode := testrand.NodeID()
+
+		require.NoError(t, planet.StopNodeAndUpdate(ctx, offlineNode))
+
+		retainDir := ctx.Dir("retain")
+		for _, nodeID := range []storj.NodeID{onlineNode.ID(), offlineNode.ID(), unknownNode} {
+			err := gc.WriteRetainFile(retainDir, nodeID, &gc.RetainInfo{
+				Filter:       bloomfilter.NewOptimal(10, 0.1),
+				CreationDate: time.Now().Add(-time.Hour),
+				Count:        10,
+			})
+			require.NoError(t, err)
+		}
+
+		service := sender.NewService(zaptest.NewLogger(t), sender.Config{
+			RetainDir:         retainDir,
+			ConcurrentSends:   2,
+			RetainSendTimeout: 10 * time.Second,
+		}, satellite.Dialer, satellite.Overlay.DB)
+		require.NoError(t, service.RunOnce(ctx))
+
+		// delivered filters and the filters of unknown nodes are removed.
+		requireNoRetainFile(t, retainDir, onlineNode.ID())
+		requireNoRetainFile(t, retainDir, unknownNode)
+
+		// the filter of the offline node is kept for the next attempt.
+		pending, err := gc.ListRetainFiles(retainDir)
+		require.NoError(t, err)
+		require.Equal(t, storj.NodeIDList{offlineNode.ID()}, pending)
+
+		pieceCounts, err := satellite.Overlay.DB.AllPieceCounts(ctx)
+		require.NoError(t, err)
+		require.Equal(t, 10, pieceCounts[onlineNode.ID()])
+	})
+}
+
+func requireNoRetainFile(t *testing.T, dir string, nodeID storj.NodeID) {
+	t.Helper()
+
+	_, err := os.Stat(gc.RetainFilePath(dir, nodeID))
+	require.True(t, os.IsNotExist(err))
+}
@@ -5,6 +5,7 @@ package gc
 
 import (
 	"context"
+	"os"
 	"time"
 
 	"github.com/spacemonkeygo/monkit/v3"
@@ -36,7 +37,9 @@ type Config struct {
 	InitialPieces     int           `help:"the initial number of pieces expected for a storage node to have, used for creating a filter" releaseDefault:"400000" devDefault:"10"`
 	FalsePositiveRate float64       `help:"the false positive rate used for creating a garbage collection bloom filter" releaseDefault:"0.1" devDefault:"0.1"`
 	ConcurrentSends   int           `help:"the number of nodes to concurrently send garbage collection bloom filters to" releaseDefault:"1" devDefault:"1"`
+	FilterWorkers     int           `help:"the number of goroutines building the garbage collection bloom filters, the nodes are split between them" default:"4"`
 	RetainSendTimeout time.Duration `help:"the amount of time to allow a node to handle a retain request" default:"1m"`
+	RetainDir         string        `help:"directory where the filters are written to for the retain sender, instead of sending them directly; filters are sent directly when empty" default:""`
 }
 
 // Service implements the garbage collection service.
@@ -95,6 +98,7 @@ func (service *Service) Run(ctx context.Context) (err error) {
 
 		// collect things to retain
 		err = service.segmentLoop.Join(ctx, pieceTracker)
+		pieceTracker.Finish()
 		if err != nil {
 			service.log.Error("error joining metainfoloop", zap.Error(err))
 			return nil
@@ -108,18 +112,25 @@ func (service *Service) Run(ctx context.Context) (err error) {
 			lastPieceCounts[id] = info.Count
 		}
 
-		// save piece counts to db for next satellite restart
-		err = service.overlay.UpdatePieceCounts(ctx, lastPieceCounts)
-		if err != nil {
-			service.log.Error("error updating piece counts", zap.Error(err))
-		}
-
 		// monitor information
 		for _, info := range pieceTracker.RetainInfos {
 			mon.IntVal("node_piece_count").Observe(int64(info.Count))
 			mon.IntVal("retain_filter_size_bytes").Observe(info.Filter.Size())
 		}
 
+		if service.config.RetainDir != "" {
+			// the retain sender updates the piece counts of the nodes once
+			// their filters are delivered.
+			service.writeRetainFiles(pieceTracker.RetainInfos)
+			return nil
+		}
+
+		// save piece counts to db for next satellite restart
+		err = service.overlay.UpdatePieceCounts(ctx, lastPieceCounts)
+		if err != nil {
+			service.log.Error("error updating piece counts", zap.Error(err))
+		}
+
 		// send retain requests
 		limiter := sync2.NewLimiter(service.config.ConcurrentSends)
 		for id, info := range pieceTracker.RetainInfos {
@@ -137,6 +148,22 @@ func (service *Service) Run(ctx context.Context) (err error) {
 	})
 }
 
+// writeRetainFiles writes the filters to the retain directory, replacing
+// the filters of the nodes which weren't sent yet.
+func (service *Service) writeRetainFiles(retainInfos map[storj.NodeID]*RetainInfo) {
+	if err := os.MkdirAll(service.config.RetainDir, 0700); err != nil {
+		service.log.Error("error creating retain directory", zap.Error(err))
+		return
+	}
+
+	for id, info := range retainInfos {
+		err := WriteRetainFile(service.config.RetainDir, id, info)
+		if err != nil {
+			service.log.Error("error writing retain file", zap.Stringer("Node ID", id), zap.Error(err))
+		}
+	}
+}
+
 func (service *Service) sendRetainRequest(ctx context.Context, id storj.NodeID, info *RetainInfo) (err error) {
 	defer mon.Task()(&ctx, id.String())(&err)
 
@@ -156,7 +183,14 @@ func (service *Service) sendRetainRequest(ctx context.Context, id storj.NodeID,
 		Address: dossier.Address.Address,
 	}
 
-	client, err := piecestore.Dial(ctx, service.dialer, nodeurl, piecestore.DefaultConfig)
+	return SendRetainRequest(ctx, service.dialer, nodeurl, info)
+}
+
+// SendRetainRequest dials the node and sends it the retain info.
+func SendRetainRequest(ctx context.Context, dialer rpc.Dialer, nodeurl storj.NodeURL, info *RetainInfo) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	client, err := piecestore.Dial(ctx, dialer, nodeurl, piecestore.DefaultConfig)
 	if err != nil {
 		return Error.Wrap(err)
 	}
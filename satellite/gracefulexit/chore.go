@@ -100,16 +100,18 @@ func (chore *Chore) Run(ctx context.Context) (err error) {
 		}
 
 		// Populate transfer queue for nodes that have not completed the exit loop yet
-		pathCollector := NewPathCollector(chore.db, exitingNodesLoopIncomplete, chore.log, chore.config.ChoreBatchSize)
+		pathCollector := NewPathCollector(chore.db, exitingNodesLoopIncomplete, chore.log, chore.config.ChoreBatchSize, chore.config.ChoreBufferedBatches)
 		err = chore.segmentLoop.Join(ctx, pathCollector)
+
+		// flushing stops the background writer, so it's done when the loop
+		// failed as well.
+		flushErr := pathCollector.Flush(ctx)
 		if err != nil {
 			chore.log.Error("error joining segment loop.", zap.Error(err))
 			return nil
 		}
-
-		err = pathCollector.Flush(ctx)
-		if err != nil {
-			chore.log.Error("error flushing collector buffer.", zap.Error(err))
+		if flushErr != nil {
+			chore.log.Error("error flushing collector buffer.", zap.Error(flushErr))
 			return nil
 		}
 
@@ -27,10 +27,13 @@ var (
 type Config struct {
 	Enabled bool `help:"whether or not graceful exit is enabled on the satellite side." default:"true"`
 
-	ChoreBatchSize int           `help:"size of the buffer used to batch inserts into the transfer queue." default:"500" testDefault:"10"`
-	ChoreInterval  time.Duration `help:"how often to run the transfer queue chore." releaseDefault:"30s" devDefault:"10s" testDefault:"$TESTINTERVAL"`
+	ChoreBatchSize       int           `help:"size of the buffer used to batch inserts into the transfer queue." default:"500" testDefault:"10"`
+	ChoreBufferedBatches int           `help:"number of batches waiting to be inserted into the transfer queue in the background, before the segment loop is slowed down." default:"10"`
+	ChoreInterval        time.Duration `help:"how often to run the transfer queue chore." releaseDefault:"30s" devDefault:"10s" testDefault:"$TESTINTERVAL"`
 
-	EndpointBatchSize int `help:"size of the buffer used to batch transfer queue reads and sends to the storage node." default:"300" testDefault:"100"`
+	EndpointBatchSize          int           `help:"size of the buffer used to batch transfer queue reads and sends to the storage node." default:"300" testDefault:"100"`
+	EndpointSucceededBatchSize int           `help:"number of succeeded transfers which are applied to their segments together." default:"100" testDefault:"10"`
+	EndpointTransferWindow     time.Duration `help:"new transfers are sent to an exiting node while its pending transfers are less than what it transfers within this duration; when zero, new transfers are only sent once all pending transfers have finished." default:"1m"`
 
 	MaxFailuresPerPiece          int           `help:"maximum number of transfer failures per piece." default:"5"`
 	OverallMaxFailuresPercentage int           `help:"maximum percentage of transfer failures per node." default:"10"`
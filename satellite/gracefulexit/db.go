@@ -53,6 +53,8 @@ type DB interface {
 	UpdateTransferQueueItem(ctx context.Context, item TransferQueueItem) error
 	// DeleteTransferQueueItem deletes a graceful exit transfer queue entry.
 	DeleteTransferQueueItem(ctx context.Context, nodeID storj.NodeID, StreamID uuid.UUID, Position metabase.SegmentPosition, pieceNum int32) error
+	// DeleteTransferQueueItemBatch deletes several graceful exit transfer queue entries of a node at once.
+	DeleteTransferQueueItemBatch(ctx context.Context, nodeID storj.NodeID, items []TransferQueueItem) error
 	// DeleteTransferQueueItem deletes a graceful exit transfer queue entries by nodeID.
 	DeleteTransferQueueItems(ctx context.Context, nodeID storj.NodeID) error
 	// DeleteFinishedTransferQueueItem deletes finished graceful exit transfer queue entries.
@@ -170,6 +170,16 @@ func (endpoint *Endpoint) Process(stream pb.DRPCSatelliteGracefulExit_ProcessStr
 		}
 	}()
 
+	// the pending transfers are refilled before they have finished, as long
+	// as the node transfers them fast enough.
+	window := newTransferWindow(endpoint.config.EndpointTransferWindow)
+
+	// queueMu is held while the transfer queue is read and while finished
+	// transfers are removed from it and from the pending map. Otherwise the
+	// refill could read the queue item of a finished transfer and find it's
+	// no longer pending, then send it again.
+	var queueMu sync.Mutex
+
 	// we cancel this context in all situations where we want to exit the loop
 	ctx, cancel := context.WithCancel(ctx)
 	defer cancel()
@@ -178,40 +188,67 @@ func (endpoint *Endpoint) Process(stream pb.DRPCSatelliteGracefulExit_ProcessStr
 		incompleteLoop := sync2.NewCycle(endpoint.interval)
 
 		loopErr := incompleteLoop.Run(ctx, func(ctx context.Context) error {
-			if pending.Length() == 0 {
-				incomplete, err := endpoint.db.GetIncompleteNotFailed(ctx, nodeID, endpoint.config.EndpointBatchSize, 0)
-				if err != nil {
-					cancel()
-					return pending.DoneSending(err)
-				}
+			if !window.CanSend(pending) {
+				return nil
+			}
 
-				if len(incomplete) == 0 {
-					incomplete, err = endpoint.db.GetIncompleteFailed(ctx, nodeID, endpoint.config.MaxFailuresPerPiece, endpoint.config.EndpointBatchSize, 0)
-					if err != nil {
-						cancel()
-						return pending.DoneSending(err)
-					}
-				}
+			queueMu.Lock()
+			incomplete, err := endpoint.nextIncomplete(ctx, nodeID, pending)
+			queueMu.Unlock()
+			if err != nil {
+				cancel()
+				return pending.DoneSending(err)
+			}
 
-				if len(incomplete) == 0 {
-					endpoint.log.Debug("no more pieces to transfer for node", zap.Stringer("Node ID", nodeID))
-					cancel()
-					return pending.DoneSending(nil)
+			if len(incomplete) == 0 {
+				if pending.Length() > 0 {
+					return nil
 				}
+				endpoint.log.Debug("no more pieces to transfer for node", zap.Stringer("Node ID", nodeID))
+				cancel()
+				return pending.DoneSending(nil)
+			}
 
-				for _, inc := range incomplete {
-					err = endpoint.processIncomplete(ctx, stream, pending, inc)
-					if err != nil {
-						cancel()
-						return pending.DoneSending(err)
-					}
-				}
+			err = endpoint.processIncompleteBatch(ctx, stream, pending, nodeID, incomplete)
+			if err != nil {
+				cancel()
+				return pending.DoneSending(err)
 			}
 			return nil
 		})
 		return errs2.IgnoreCanceled(loopErr)
 	})
 
+	// succeeded transfers are applied to the segments in batches.
+	var succeeded []succeededTransfer
+	batched := make(map[storj.PieceID]struct{})
+
+	// flushSucceeded applies the batch once it's full, or when the node has
+	// reported all of its pending transfers, since no further message
+	// arrives until new transfers are sent.
+	flushSucceeded := func() error {
+		if len(succeeded) == 0 {
+			return nil
+		}
+		if len(succeeded) < endpoint.config.EndpointSucceededBatchSize && len(succeeded) < pending.Length() {
+			return nil
+		}
+
+		queueMu.Lock()
+		transferred, err := endpoint.handleSucceededBatch(ctx, stream, pending, nodeID, succeeded)
+		queueMu.Unlock()
+		if err != nil {
+			return err
+		}
+		window.Transferred(transferred)
+
+		succeeded = succeeded[:0]
+		for pieceID := range batched {
+			delete(batched, pieceID)
+		}
+		return nil
+	}
+
 	for {
 		finishedPromise := pending.IsFinishedPromise()
 		finished, err := finishedPromise.Wait(ctx)
@@ -270,14 +307,13 @@ func (endpoint *Endpoint) Process(stream pb.DRPCSatelliteGracefulExit_ProcessStr
 
 		switch m := request.GetMessage().(type) {
 		case *pb.StorageNodeMessage_Succeeded:
-			err = endpoint.handleSucceeded(ctx, stream, pending, nodeID, m)
-			if err != nil {
-				if metainfo.ErrNodeAlreadyExists.Has(err) {
-					// this will get retried
-					endpoint.log.Warn("node already exists in segment.", zap.Error(err))
+			if _, ok := batched[m.Succeeded.OriginalPieceId]; ok {
+				endpoint.log.Warn("duplicate transfer success message", zap.Stringer("Piece ID", m.Succeeded.OriginalPieceId))
+				continue
+			}
 
-					continue
-				}
+			transfer, err := endpoint.verifySucceeded(ctx, pending, m)
+			if err != nil {
 				if ErrInvalidArgument.Has(err) {
 					messageBytes, marshalErr := pb.Marshal(request)
 					if marshalErr != nil {
@@ -307,11 +343,26 @@ func (endpoint *Endpoint) Process(stream pb.DRPCSatelliteGracefulExit_ProcessStr
 				}
 				return rpcstatus.Error(rpcstatus.Internal, err.Error())
 			}
+
+			succeeded = append(succeeded, transfer)
+			batched[transfer.OriginalPieceID] = struct{}{}
+
+			err = flushSucceeded()
+			if err != nil {
+				return rpcstatus.Error(rpcstatus.Internal, err.Error())
+			}
 		case *pb.StorageNodeMessage_Failed:
+			queueMu.Lock()
 			err = endpoint.handleFailed(ctx, pending, nodeID, m)
+			queueMu.Unlock()
 			if err != nil {
 				return rpcstatus.Error(rpcstatus.Internal, Error.Wrap(err).Error())
 			}
+
+			err = flushSucceeded()
+			if err != nil {
+				return rpcstatus.Error(rpcstatus.Internal, err.Error())
+			}
 		default:
 			return rpcstatus.Error(rpcstatus.Unknown, Error.New("unknown storage node message: %v", m).Error())
 		}
@@ -320,82 +371,164 @@ func (endpoint *Endpoint) Process(stream pb.DRPCSatelliteGracefulExit_ProcessStr
 	return nil
 }
 
-func (endpoint *Endpoint) processIncomplete(ctx context.Context, stream pb.DRPCSatelliteGracefulExit_ProcessStream, pending *PendingMap, incomplete *TransferQueueItem) error {
-	nodeID := incomplete.NodeID
+// nextIncomplete returns the next transfer queue items of the node, which
+// aren't pending already. The items which haven't failed yet come first.
+func (endpoint *Endpoint) nextIncomplete(ctx context.Context, nodeID storj.NodeID, pending *PendingMap) (_ []*TransferQueueItem, err error) {
+	defer mon.Task()(&ctx)(&err)
 
-	if incomplete.OrderLimitSendCount >= endpoint.config.MaxOrderLimitSendCount {
-		err := endpoint.db.IncrementProgress(ctx, nodeID, 0, 0, 1)
-		if err != nil {
-			return Error.Wrap(err)
-		}
-		err = endpoint.db.DeleteTransferQueueItem(ctx, nodeID, incomplete.StreamID, incomplete.Position, incomplete.PieceNum)
-		if err != nil {
-			return Error.Wrap(err)
-		}
+	// pending items are still in the queue, so they are fetched as well.
+	limit := endpoint.config.EndpointBatchSize + pending.Length()
 
-		return nil
+	incomplete, err := endpoint.db.GetIncompleteNotFailed(ctx, nodeID, limit, 0)
+	if err != nil {
+		return nil, err
 	}
+	incomplete = endpoint.skipPending(nodeID, pending, incomplete)
 
-	segment, err := endpoint.getValidSegment(ctx, incomplete.StreamID, incomplete.Position, incomplete.RootPieceID)
-	if err != nil {
-		endpoint.log.Warn("invalid segment", zap.Error(err))
-		err = endpoint.db.DeleteTransferQueueItem(ctx, nodeID, incomplete.StreamID, incomplete.Position, incomplete.PieceNum)
+	if len(incomplete) == 0 {
+		incomplete, err = endpoint.db.GetIncompleteFailed(ctx, nodeID, endpoint.config.MaxFailuresPerPiece, limit, 0)
 		if err != nil {
-			return Error.Wrap(err)
+			return nil, err
 		}
+		incomplete = endpoint.skipPending(nodeID, pending, incomplete)
+	}
+
+	return incomplete, nil
+}
 
+// skipPending returns the items which aren't pending, up to the endpoint
+// batch size.
+func (endpoint *Endpoint) skipPending(nodeID storj.NodeID, pending *PendingMap, items []*TransferQueueItem) []*TransferQueueItem {
+	result := items[:0]
+	for _, item := range items {
+		if len(result) >= endpoint.config.EndpointBatchSize {
+			break
+		}
+		if _, ok := pending.Get(item.RootPieceID.Derive(nodeID, item.PieceNum)); ok {
+			continue
+		}
+		result = append(result, item)
+	}
+	return result
+}
+
+// processIncompleteBatch sends the transfers of the transfer queue items to
+// the exiting node. The segments of the items are fetched and their
+// replacement nodes are selected together.
+func (endpoint *Endpoint) processIncompleteBatch(ctx context.Context, stream pb.DRPCSatelliteGracefulExit_ProcessStream, pending *PendingMap, nodeID storj.NodeID, incomplete []*TransferQueueItem) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	items := make([]*TransferQueueItem, 0, len(incomplete))
+	for _, item := range incomplete {
+		if item.OrderLimitSendCount >= endpoint.config.MaxOrderLimitSendCount {
+			err := endpoint.db.IncrementProgress(ctx, nodeID, 0, 0, 1)
+			if err != nil {
+				return Error.Wrap(err)
+			}
+			err = endpoint.db.DeleteTransferQueueItem(ctx, nodeID, item.StreamID, item.Position, item.PieceNum)
+			if err != nil {
+				return Error.Wrap(err)
+			}
+			continue
+		}
+		items = append(items, item)
+	}
+	if len(items) == 0 {
 		return nil
 	}
 
-	nodePiece, err := endpoint.getNodePiece(ctx, segment, incomplete)
+	keys := make([]metabase.GetSegmentByPosition, len(items))
+	for i, item := range items {
+		keys[i] = metabase.GetSegmentByPosition{StreamID: item.StreamID, Position: item.Position}
+	}
+	segments, err := endpoint.getSegments(ctx, keys)
 	if err != nil {
-		deleteErr := endpoint.db.DeleteTransferQueueItem(ctx, nodeID, incomplete.StreamID, incomplete.Position, incomplete.PieceNum)
-		if deleteErr != nil {
-			return Error.Wrap(deleteErr)
-		}
 		return Error.Wrap(err)
 	}
 
-	pieceSize, err := endpoint.calculatePieceSize(ctx, segment, incomplete)
-	if ErrAboveOptimalThreshold.Has(err) {
-		err = endpoint.UpdatePiecesCheckDuplicates(ctx, segment, metabase.Pieces{}, metabase.Pieces{nodePiece}, false)
+	type batchTransfer struct {
+		item      *TransferQueueItem
+		segment   metabase.Segment
+		pieceSize int64
+	}
+
+	transfers := make([]batchTransfer, 0, len(items))
+	for _, item := range items {
+		segment, ok := segments[segmentKey{item.StreamID, item.Position}]
+		if !ok || (!item.RootPieceID.IsZero() && item.RootPieceID != segment.RootPieceID) {
+			endpoint.log.Warn("invalid segment", zap.Stringer("Node ID", nodeID),
+				zap.Stringer("stream_id", item.StreamID), zap.Uint64("position", item.Position.Encode()))
+			err = endpoint.db.DeleteTransferQueueItem(ctx, nodeID, item.StreamID, item.Position, item.PieceNum)
+			if err != nil {
+				return Error.Wrap(err)
+			}
+			continue
+		}
+
+		nodePiece, err := endpoint.getNodePiece(ctx, segment, item)
 		if err != nil {
+			deleteErr := endpoint.db.DeleteTransferQueueItem(ctx, nodeID, item.StreamID, item.Position, item.PieceNum)
+			if deleteErr != nil {
+				return Error.Wrap(deleteErr)
+			}
 			return Error.Wrap(err)
 		}
 
-		err = endpoint.db.DeleteTransferQueueItem(ctx, nodeID, incomplete.StreamID, incomplete.Position, incomplete.PieceNum)
+		pieceSize, err := endpoint.calculatePieceSize(ctx, segment, item)
+		if ErrAboveOptimalThreshold.Has(err) {
+			err = endpoint.UpdatePiecesCheckDuplicates(ctx, segment, metabase.Pieces{}, metabase.Pieces{nodePiece}, false)
+			if err != nil {
+				return Error.Wrap(err)
+			}
+
+			err = endpoint.db.DeleteTransferQueueItem(ctx, nodeID, item.StreamID, item.Position, item.PieceNum)
+			if err != nil {
+				return Error.Wrap(err)
+			}
+			continue
+		}
 		if err != nil {
 			return Error.Wrap(err)
 		}
+
+		transfers = append(transfers, batchTransfer{item: item, segment: segment, pieceSize: pieceSize})
+	}
+	if len(transfers) == 0 {
 		return nil
 	}
+
+	transferSegments := make([]metabase.Segment, len(transfers))
+	for i, transfer := range transfers {
+		transferSegments[i] = transfer.segment
+	}
+	selector, err := endpoint.newReplacementSelector(ctx, nodeID, transferSegments)
 	if err != nil {
 		return Error.Wrap(err)
 	}
 
-	// populate excluded node IDs
-	pieces := segment.Pieces
-	excludedIDs := make([]storj.NodeID, len(pieces))
-	for i, piece := range pieces {
-		excludedIDs[i] = piece.StorageNode
-	}
+	for _, transfer := range transfers {
+		newNode, err := selector.Select(ctx, transfer.segment)
+		if err != nil {
+			return Error.Wrap(err)
+		}
+		if newNode == nil {
+			return Error.New("could not find a node to receive piece transfer: node ID %v, stream_id %v, piece num %v", nodeID, transfer.item.StreamID, transfer.item.PieceNum)
+		}
 
-	// get replacement node
-	request := &overlay.FindStorageNodesRequest{
-		RequestedCount: 1,
-		ExcludedIDs:    excludedIDs,
+		err = endpoint.sendTransfer(ctx, stream, pending, transfer.item, transfer.segment, transfer.pieceSize, newNode)
+		if err != nil {
+			return err
+		}
 	}
 
-	newNodes, err := endpoint.overlay.FindStorageNodesForGracefulExit(ctx, *request)
-	if err != nil {
-		return Error.Wrap(err)
-	}
+	return nil
+}
 
-	if len(newNodes) == 0 {
-		return Error.New("could not find a node to receive piece transfer: node ID %v, stream_id %v, piece num %v", nodeID, incomplete.StreamID, incomplete.PieceNum)
-	}
+// sendTransfer sends the order limit for transferring the piece to the
+// replacement node and adds the transfer to the pending map.
+func (endpoint *Endpoint) sendTransfer(ctx context.Context, stream pb.DRPCSatelliteGracefulExit_ProcessStream, pending *PendingMap, incomplete *TransferQueueItem, segment metabase.Segment, pieceSize int64, newNode *overlay.SelectedNode) error {
+	nodeID := incomplete.NodeID
 
-	newNode := newNodes[0]
 	endpoint.log.Debug("found new node for piece transfer", zap.Stringer("original node ID", nodeID), zap.Stringer("replacement node ID", newNode.ID),
 		zap.ByteString("streamID", incomplete.StreamID[:]), zap.Uint32("Part", incomplete.Position.Part), zap.Uint32("Index", incomplete.Position.Index),
 		zap.Int32("piece num", incomplete.PieceNum))
@@ -434,12 +567,22 @@ func (endpoint *Endpoint) processIncomplete(ctx context.Context, stream pb.DRPCS
 		SatelliteMessage:    transferMsg,
 		OriginalRootPieceID: segment.RootPieceID,
 		PieceNum:            uint16(incomplete.PieceNum), // TODO
+		FailedCount:         incomplete.FailedCount,
 	})
 
 	return err
 }
 
-func (endpoint *Endpoint) handleSucceeded(ctx context.Context, stream pb.DRPCSatelliteGracefulExit_ProcessStream, pending *PendingMap, exitingNodeID storj.NodeID, message *pb.StorageNodeMessage_Succeeded) (err error) {
+// succeededTransfer is a verified transfer, which hasn't been applied to its
+// segment yet.
+type succeededTransfer struct {
+	OriginalPieceID storj.PieceID
+	ReceivingNodeID storj.NodeID
+	Transfer        *PendingTransfer
+}
+
+// verifySucceeded verifies the success message of a pending transfer.
+func (endpoint *Endpoint) verifySucceeded(ctx context.Context, pending *PendingMap, message *pb.StorageNodeMessage_Succeeded) (_ succeededTransfer, err error) {
 	defer mon.Task()(&ctx)(&err)
 
 	originalPieceID := message.Succeeded.OriginalPieceId
@@ -447,73 +590,155 @@ func (endpoint *Endpoint) handleSucceeded(ctx context.Context, stream pb.DRPCSat
 	transfer, ok := pending.Get(originalPieceID)
 	if !ok {
 		endpoint.log.Error("Could not find transfer item in pending queue", zap.Stringer("Piece ID", originalPieceID))
-		return Error.New("Could not find transfer item in pending queue")
+		return succeededTransfer{}, Error.New("Could not find transfer item in pending queue")
 	}
 
 	err = endpoint.validatePendingTransfer(ctx, transfer)
 	if err != nil {
-		return Error.Wrap(err)
+		return succeededTransfer{}, Error.Wrap(err)
 	}
 
 	receivingNodeID := transfer.SatelliteMessage.GetTransferPiece().GetAddressedOrderLimit().GetLimit().StorageNodeId
 	// get peerID and signee for new storage node
 	peerID, err := endpoint.peerIdentities.Get(ctx, receivingNodeID)
 	if err != nil {
-		return Error.Wrap(err)
+		return succeededTransfer{}, Error.Wrap(err)
 	}
 	// verify transferred piece
 	err = endpoint.verifyPieceTransferred(ctx, message, transfer, peerID)
 	if err != nil {
-		return Error.Wrap(err)
+		return succeededTransfer{}, Error.Wrap(err)
+	}
+
+	return succeededTransfer{
+		OriginalPieceID: originalPieceID,
+		ReceivingNodeID: receivingNodeID,
+		Transfer:        transfer,
+	}, nil
+}
+
+// handleSucceededBatch moves the pieces of the succeeded transfers to their
+// receiving nodes, with a single query to fetch the segments and a single
+// query to update them, and tells the exiting node to delete them. Transfers
+// which can't be applied are removed from the pending map, so they are
+// retried. It returns the number of bytes transferred.
+func (endpoint *Endpoint) handleSucceededBatch(ctx context.Context, stream pb.DRPCSatelliteGracefulExit_ProcessStream, pending *PendingMap, exitingNodeID storj.NodeID, batch []succeededTransfer) (transferred int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	keys := make([]metabase.GetSegmentByPosition, len(batch))
+	for i, succeeded := range batch {
+		keys[i] = metabase.GetSegmentByPosition{StreamID: succeeded.Transfer.StreamID, Position: succeeded.Transfer.Position}
 	}
-	transferQueueItem, err := endpoint.db.GetTransferQueueItem(ctx, exitingNodeID, transfer.StreamID, transfer.Position, int32(transfer.PieceNum))
+	segments, err := endpoint.getSegments(ctx, keys)
 	if err != nil {
-		return Error.Wrap(err)
+		return 0, Error.Wrap(err)
 	}
 
-	err = endpoint.updateSegment(ctx, exitingNodeID, receivingNodeID, transfer.StreamID, transfer.Position, transfer.PieceNum, transferQueueItem.RootPieceID)
-	if err != nil {
-		// remove the piece from the pending queue so it gets retried
-		deleteErr := pending.Delete(originalPieceID)
+	var dropped []TransferQueueItem
+	var release []storj.PieceID
+	var updates []metabase.UpdateSegmentPieces
+	var updating []succeededTransfer
+	updatingSegments := make(map[segmentKey]struct{}, len(batch))
 
-		return Error.Wrap(errs.Combine(err, deleteErr))
-	}
+	for _, succeeded := range batch {
+		transfer := succeeded.Transfer
+		key := segmentKey{transfer.StreamID, transfer.Position}
+
+		segment, ok := segments[key]
+		if !ok || segment.RootPieceID != transfer.OriginalRootPieceID {
+			// the segment was deleted or replaced during the transfer.
+			endpoint.log.Debug("segment has changed during the transfer", zap.Stringer("Piece ID", succeeded.OriginalPieceID))
+			dropped = append(dropped, TransferQueueItem{StreamID: transfer.StreamID, Position: transfer.Position, PieceNum: int32(transfer.PieceNum)})
+			release = append(release, succeeded.OriginalPieceID)
+			continue
+		}
+
+		if _, ok := updatingSegments[key]; ok {
+			release = append(release, succeeded.OriginalPieceID)
+			continue
+		}
 
-	var failed int64
-	if transferQueueItem.FailedCount != nil && *transferQueueItem.FailedCount >= endpoint.config.MaxFailuresPerPiece {
-		failed = -1
+		update, err := endpoint.segmentUpdate(segment, exitingNodeID, succeeded.ReceivingNodeID, transfer.PieceNum)
+		if err != nil {
+			// this will get retried
+			endpoint.log.Warn("unable to update segment", zap.Stringer("Piece ID", succeeded.OriginalPieceID), zap.Error(err))
+			release = append(release, succeeded.OriginalPieceID)
+			continue
+		}
+
+		updatingSegments[key] = struct{}{}
+		updates = append(updates, update)
+		updating = append(updating, succeeded)
 	}
 
-	err = endpoint.db.IncrementProgress(ctx, exitingNodeID, transfer.PieceSize, 1, failed)
+	updated, err := endpoint.metabase.UpdateSegmentsPieces(ctx, metabase.UpdateSegmentsPieces{Segments: updates})
 	if err != nil {
-		return Error.Wrap(err)
+		return 0, Error.Wrap(err)
 	}
 
-	err = endpoint.db.DeleteTransferQueueItem(ctx, exitingNodeID, transfer.StreamID, transfer.Position, int32(transfer.PieceNum))
-	if err != nil {
-		return Error.Wrap(err)
+	var completed []TransferQueueItem
+	var completedPieces []storj.PieceID
+	var transfers, failed int64
+	for i, succeeded := range updating {
+		if !updated[i] {
+			endpoint.log.Warn("segment was modified during the transfer, retrying", zap.Stringer("Piece ID", succeeded.OriginalPieceID))
+			release = append(release, succeeded.OriginalPieceID)
+			continue
+		}
+
+		transfer := succeeded.Transfer
+		transferred += transfer.PieceSize
+		transfers++
+		if transfer.FailedCount != nil && *transfer.FailedCount >= endpoint.config.MaxFailuresPerPiece {
+			failed--
+		}
+
+		completed = append(completed, TransferQueueItem{StreamID: transfer.StreamID, Position: transfer.Position, PieceNum: int32(transfer.PieceNum)})
+		completedPieces = append(completedPieces, succeeded.OriginalPieceID)
 	}
 
-	err = pending.Delete(originalPieceID)
+	if transfers > 0 {
+		err = endpoint.db.IncrementProgress(ctx, exitingNodeID, transferred, transfers, failed)
+		if err != nil {
+			return 0, Error.Wrap(err)
+		}
+	}
+
+	err = endpoint.db.DeleteTransferQueueItemBatch(ctx, exitingNodeID, append(completed, dropped...))
 	if err != nil {
-		return err
+		return 0, Error.Wrap(err)
 	}
 
-	deleteMsg := &pb.SatelliteMessage{
-		Message: &pb.SatelliteMessage_DeletePiece{
-			DeletePiece: &pb.DeletePiece{
-				OriginalPieceId: originalPieceID,
-			},
-		},
+	// transfers which weren't applied, and still have a queue item, are
+	// sent again.
+	for _, pieceID := range release {
+		if err := pending.Delete(pieceID); err != nil {
+			return 0, err
+		}
 	}
 
-	err = stream.Send(deleteMsg)
-	if err != nil {
-		return Error.Wrap(err)
+	for _, pieceID := range completedPieces {
+		if err := pending.Delete(pieceID); err != nil {
+			return 0, err
+		}
+
+		deleteMsg := &pb.SatelliteMessage{
+			Message: &pb.SatelliteMessage_DeletePiece{
+				DeletePiece: &pb.DeletePiece{
+					OriginalPieceId: pieceID,
+				},
+			},
+		}
+
+		err = stream.Send(deleteMsg)
+		if err != nil {
+			return 0, Error.Wrap(err)
+		}
+
+		mon.Meter("graceful_exit_transfer_piece_success").Mark(1) //mon:locked
 	}
 
-	mon.Meter("graceful_exit_transfer_piece_success").Mark(1) //mon:locked
-	return nil
+	return transferred, nil
 }
 
 func (endpoint *Endpoint) handleFailed(ctx context.Context, pending *PendingMap, nodeID storj.NodeID, message *pb.StorageNodeMessage_Failed) (err error) {
@@ -707,45 +932,48 @@ func (endpoint *Endpoint) getFinishedMessage(ctx context.Context, nodeID storj.N
 	return message, nil
 }
 
-func (endpoint *Endpoint) updateSegment(ctx context.Context, exitingNodeID storj.NodeID, receivingNodeID storj.NodeID, streamID uuid.UUID, position metabase.SegmentPosition, pieceNumber uint16, originalRootPieceID storj.PieceID) (err error) {
-	defer mon.Task()(&ctx)(&err)
-
-	// remove the node from the segment
-	segment, err := endpoint.getValidSegment(ctx, streamID, position, originalRootPieceID)
-	if err != nil {
-		return Error.Wrap(err)
-	}
-
+// segmentUpdate returns the update which moves the piece of the exiting node
+// to the receiving node.
+func (endpoint *Endpoint) segmentUpdate(segment metabase.Segment, exitingNodeID storj.NodeID, receivingNodeID storj.NodeID, pieceNumber uint16) (_ metabase.UpdateSegmentPieces, err error) {
 	pieceMap := make(map[storj.NodeID]metabase.Piece)
 	for _, piece := range segment.Pieces {
 		pieceMap[piece.StorageNode] = piece
 	}
 
-	var toRemove metabase.Pieces
 	existingPiece, ok := pieceMap[exitingNodeID]
 	if !ok {
-		return Error.New("node no longer has the piece. Node ID: %s", exitingNodeID.String())
+		return metabase.UpdateSegmentPieces{}, Error.New("node no longer has the piece. Node ID: %s", exitingNodeID.String())
 	}
 	if existingPiece != (metabase.Piece{}) && existingPiece.Number != pieceNumber {
-		return Error.New("invalid existing piece info. Exiting Node ID: %s, PieceNum: %d", exitingNodeID.String(), pieceNumber)
+		return metabase.UpdateSegmentPieces{}, Error.New("invalid existing piece info. Exiting Node ID: %s, PieceNum: %d", exitingNodeID.String(), pieceNumber)
 	}
-	toRemove = metabase.Pieces{existingPiece}
+	toRemove := metabase.Pieces{existingPiece}
 	delete(pieceMap, exitingNodeID)
 
 	var toAdd metabase.Pieces
 	if !receivingNodeID.IsZero() {
+		if _, ok := pieceMap[receivingNodeID]; ok {
+			return metabase.UpdateSegmentPieces{}, metainfo.ErrNodeAlreadyExists.New("node id already exists in segment. StreamID: %s, Position: %d, NodeID: %s", segment.StreamID, segment.Position, receivingNodeID.String())
+		}
 		toAdd = metabase.Pieces{{
 			Number:      pieceNumber,
 			StorageNode: receivingNodeID,
 		}}
 	}
 
-	err = endpoint.UpdatePiecesCheckDuplicates(ctx, segment, toAdd, toRemove, true)
+	pieces, err := segment.Pieces.Update(toAdd, toRemove)
 	if err != nil {
-		return Error.Wrap(err)
+		return metabase.UpdateSegmentPieces{}, Error.Wrap(err)
 	}
 
-	return nil
+	return metabase.UpdateSegmentPieces{
+		StreamID: segment.StreamID,
+		Position: segment.Position,
+
+		OldPieces:     segment.Pieces,
+		NewRedundancy: segment.Redundancy,
+		NewPieces:     pieces,
+	}, nil
 }
 
 // checkExitStatus returns a satellite message based on a node current graceful exit status
@@ -877,6 +1105,31 @@ func (endpoint *Endpoint) getValidSegment(ctx context.Context, streamID uuid.UUI
 	return segment, nil
 }
 
+// segmentKey identifies a segment by its stream and position.
+type segmentKey struct {
+	StreamID uuid.UUID
+	Position metabase.SegmentPosition
+}
+
+// getSegments fetches the segments with a single query. Missing segments
+// aren't in the result.
+func (endpoint *Endpoint) getSegments(ctx context.Context, keys []metabase.GetSegmentByPosition) (_ map[segmentKey]metabase.Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	segments, err := endpoint.metabase.GetSegmentsByPositions(ctx, metabase.GetSegmentsByPositions{
+		Segments: keys,
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	result := make(map[segmentKey]metabase.Segment, len(segments))
+	for _, segment := range segments {
+		result[segmentKey{segment.StreamID, segment.Position}] = segment
+	}
+	return result, nil
+}
+
 func (endpoint *Endpoint) getNodePiece(ctx context.Context, segment metabase.Segment, incomplete *TransferQueueItem) (metabase.Piece, error) {
 	nodeID := incomplete.NodeID
 
@@ -19,6 +19,11 @@ var _ segmentloop.Observer = (*PathCollector)(nil)
 
 // PathCollector uses the metainfo loop to add paths to node reservoirs.
 //
+// The transfer queue items of all the exiting nodes are collected into shared
+// batches, which are inserted by a background writer, so the segment loop
+// doesn't wait on the database. At most bufferedBatches batches are waiting
+// for the writer, before the loop is slowed down.
+//
 // architecture: Observer
 type PathCollector struct {
 	db            DB
@@ -27,16 +32,23 @@ type PathCollector struct {
 	buffer        []TransferQueueItem
 	log           *zap.Logger
 	batchSize     int
+
+	batches   chan []TransferQueueItem
+	writeDone chan struct{}
+	writeMu   sync.Mutex
+	writeErr  error
 }
 
 // NewPathCollector instantiates a path collector.
-func NewPathCollector(db DB, nodeIDs storj.NodeIDList, log *zap.Logger, batchSize int) *PathCollector {
+func NewPathCollector(db DB, nodeIDs storj.NodeIDList, log *zap.Logger, batchSize, bufferedBatches int) *PathCollector {
 	buffer := make([]TransferQueueItem, 0, batchSize)
 	collector := &PathCollector{
 		db:        db,
 		log:       log,
 		buffer:    buffer,
 		batchSize: batchSize,
+
+		batches: make(chan []TransferQueueItem, bufferedBatches),
 	}
 
 	if len(nodeIDs) > 0 {
@@ -50,14 +62,31 @@ func NewPathCollector(db DB, nodeIDs storj.NodeIDList, log *zap.Logger, batchSiz
 }
 
 // LoopStarted is called at each start of a loop.
-func (collector *PathCollector) LoopStarted(context.Context, segmentloop.LoopInfo) (err error) {
+func (collector *PathCollector) LoopStarted(ctx context.Context, info segmentloop.LoopInfo) (err error) {
+	if len(collector.nodeIDStorage) == 0 || collector.writeDone != nil {
+		return nil
+	}
+
+	collector.writeDone = make(chan struct{})
+	go collector.write(ctx)
 	return nil
 }
 
-// Flush persists the current buffer items to the database.
+// Flush persists the current buffer items to the database and waits for
+// the background writer to finish. The collector must not be used afterwards.
 func (collector *PathCollector) Flush(ctx context.Context) (err error) {
 	defer mon.Task()(&ctx)(&err)
-	return collector.flush(ctx, 1)
+
+	if collector.writeDone == nil {
+		return nil
+	}
+
+	err = collector.flush(ctx, 1)
+
+	close(collector.batches)
+	<-collector.writeDone
+
+	return errs.Combine(err, collector.writeError())
 }
 
 // RemoteSegment takes a remote segment found in metainfo and creates a graceful exit transfer queue item if it doesn't exist already.
@@ -115,11 +144,45 @@ func (collector *PathCollector) InlineSegment(ctx context.Context, segment *segm
 func (collector *PathCollector) flush(ctx context.Context, limit int) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	if len(collector.buffer) >= limit {
-		err = collector.db.Enqueue(ctx, collector.buffer, collector.batchSize)
-		collector.buffer = collector.buffer[:0]
+	if len(collector.buffer) < limit {
+		return nil
+	}
 
-		return errs.Wrap(err)
+	if err := collector.writeError(); err != nil {
+		return err
 	}
+
+	// the writer owns the batch from now on.
+	select {
+	case collector.batches <- collector.buffer:
+	case <-ctx.Done():
+		return ctx.Err()
+	}
+	collector.buffer = make([]TransferQueueItem, 0, collector.batchSize)
 	return nil
 }
+
+// write inserts the batches into the transfer queue until the batches
+// channel is closed. Batches following a failed insert are discarded.
+func (collector *PathCollector) write(ctx context.Context) {
+	defer close(collector.writeDone)
+
+	for batch := range collector.batches {
+		if collector.writeError() != nil {
+			continue
+		}
+
+		err := collector.db.Enqueue(ctx, batch, collector.batchSize)
+		if err != nil {
+			collector.writeMu.Lock()
+			collector.writeErr = errs.Wrap(err)
+			collector.writeMu.Unlock()
+		}
+	}
+}
+
+func (collector *PathCollector) writeError() error {
+	collector.writeMu.Lock()
+	defer collector.writeMu.Unlock()
+	return collector.writeErr
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package gracefulexit_test
+
+import (
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/storj"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/satellite"
+	"storj.io/storj/satellite/gracefulexit"
+	"storj.io/storj/satellite/metabase"
+	"storj.io/storj/satellite/metabase/segmentloop"
+	"storj.io/storj/satellite/satellitedb/satellitedbtest"
+)
+
+func TestPathCollector(t *testing.T) {
+	satellitedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db satellite.DB) {
+		exiting := storj.NodeIDList{testrand.NodeID(), testrand.NodeID()}
+		other := testrand.NodeID()
+
+		// a batch size smaller than the number of items and a single buffered
+		// batch make the loop hand batches over to the writer repeatedly.
+		collector := gracefulexit.NewPathCollector(db.GracefulExit(), exiting, zaptest.NewLogger(t), 3, 1)
+		require.NoError(t, collector.LoopStarted(ctx, segmentloop.LoopInfo{Started: time.Now()}))
+
+		const segmentCount = 10
+		for i := 0; i < segmentCount; i++ {
+			err := collector.RemoteSegment(ctx, &segmentloop.Segment{
+				StreamID:      testrand.UUID(),
+				RootPieceID:   testrand.PieceID(),
+				EncryptedSize: 1024,
+				Redundancy: storj.RedundancyScheme{
+					Algorithm:      storj.ReedSolomon,
+					ShareSize:      256,
+					RequiredShares: 1,
+					RepairShares:   2,
+					OptimalShares:  3,
+					TotalShares:    3,
+				},
+				Pieces: metabase.Pieces{
+					{Number: 0, StorageNode: exiting[0]},
+					{Number: 1, StorageNode: exiting[1]},
+					{Number: 2, StorageNode: other},
+				},
+			})
+			require.NoError(t, err)
+		}
+		require.NoError(t, collector.Flush(ctx))
+
+		for _, nodeID := range exiting {
+			items, err := db.GracefulExit().GetIncomplete(ctx, nodeID, 2*segmentCount, 0)
+			require.NoError(t, err)
+			require.Len(t, items, segmentCount)
+		}
+
+		items, err := db.GracefulExit().GetIncomplete(ctx, other, 2*segmentCount, 0)
+		require.NoError(t, err)
+		require.Empty(t, items)
+	})
+}
@@ -5,7 +5,9 @@ package gracefulexit
 
 import (
 	"context"
+	"math"
 	"sync"
+	"time"
 
 	"storj.io/common/pb"
 	"storj.io/common/storj"
@@ -57,12 +59,14 @@ type PendingTransfer struct {
 	SatelliteMessage    *pb.SatelliteMessage
 	OriginalRootPieceID storj.PieceID
 	PieceNum            uint16
+	FailedCount         *int
 }
 
 // PendingMap for managing concurrent access to the pending transfer map.
 type PendingMap struct {
 	mu              sync.RWMutex
 	data            map[storj.PieceID]*PendingTransfer
+	bytes           int64
 	doneSending     bool
 	doneSendingErr  error
 	finishedPromise *PendingFinishedPromise
@@ -91,6 +95,7 @@ func (pm *PendingMap) Put(pieceID storj.PieceID, pendingTransfer *PendingTransfe
 	}
 
 	pm.data[pieceID] = pendingTransfer
+	pm.bytes += pendingTransfer.PieceSize
 
 	if pm.finishedPromise != nil {
 		pm.finishedPromise.addedWork()
@@ -116,14 +121,24 @@ func (pm *PendingMap) Length() int {
 	return len(pm.data)
 }
 
+// Bytes returns the total piece size of the elements in the map.
+func (pm *PendingMap) Bytes() int64 {
+	pm.mu.RLock()
+	defer pm.mu.RUnlock()
+
+	return pm.bytes
+}
+
 // Delete removes the pending transfer item from the map and returns an error if the data does not exist.
 func (pm *PendingMap) Delete(pieceID storj.PieceID) error {
 	pm.mu.Lock()
 	defer pm.mu.Unlock()
 
-	if _, ok := pm.data[pieceID]; !ok {
+	pendingTransfer, ok := pm.data[pieceID]
+	if !ok {
 		return Error.New("piece ID does not exist in pending map")
 	}
+	pm.bytes -= pendingTransfer.PieceSize
 	delete(pm.data, pieceID)
 	return nil
 }
@@ -173,3 +188,81 @@ func (pm *PendingMap) DoneSending(err error) error {
 	pm.doneSendingErr = err
 	return nil
 }
+
+// transferWindow limits the pending transfers of an exiting node to the
+// amount of data, which the node has transferred within the last window
+// duration. The transferred bytes decay exponentially over the window
+// duration, so the limit follows the node when its bandwidth changes. New
+// transfers are sent before the previous ones have finished while the
+// pending data is below that limit.
+type transferWindow struct {
+	mu       sync.Mutex
+	duration time.Duration
+	now      func() time.Time
+	started  time.Time
+	updated  time.Time
+	// recent is the transferred bytes, decayed to updated.
+	recent float64
+}
+
+func newTransferWindow(duration time.Duration) *transferWindow {
+	return newTransferWindowWithClock(duration, time.Now)
+}
+
+func newTransferWindowWithClock(duration time.Duration, now func() time.Time) *transferWindow {
+	started := now()
+	return &transferWindow{
+		duration: duration,
+		now:      now,
+		started:  started,
+		updated:  started,
+	}
+}
+
+// decay decays the transferred bytes to now. It must be called with mu held.
+func (window *transferWindow) decay(now time.Time) {
+	if elapsed := now.Sub(window.updated); elapsed > 0 {
+		window.recent *= math.Exp(-float64(elapsed) / float64(window.duration))
+		window.updated = now
+	}
+}
+
+// Transferred records the bytes which the node has transferred.
+func (window *transferWindow) Transferred(bytes int64) {
+	window.mu.Lock()
+	defer window.mu.Unlock()
+
+	if window.duration <= 0 {
+		return
+	}
+	window.decay(window.now())
+	window.recent += float64(bytes)
+}
+
+// Limit returns how many bytes may be pending.
+func (window *transferWindow) Limit() int64 {
+	window.mu.Lock()
+	defer window.mu.Unlock()
+
+	if window.duration <= 0 {
+		return 0
+	}
+
+	now := window.now()
+	window.decay(now)
+
+	elapsed := now.Sub(window.started)
+	if elapsed <= 0 {
+		return 0
+	}
+	// within the first windows the bytes cover a shorter time than the
+	// window, so they are scaled up to it.
+	covered := 1 - math.Exp(-float64(elapsed)/float64(window.duration))
+	return int64(window.recent / covered)
+}
+
+// CanSend returns whether more transfers may be sent, while the pending ones
+// haven't finished yet.
+func (window *transferWindow) CanSend(pending *PendingMap) bool {
+	return pending.Length() == 0 || pending.Bytes() < window.Limit()
+}
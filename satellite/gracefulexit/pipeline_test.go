@@ -0,0 +1,117 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package gracefulexit
+
+import (
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+
+	"storj.io/common/storj"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/satellite/metabase"
+	"storj.io/storj/satellite/overlay"
+)
+
+func TestTransferWindow(t *testing.T) {
+	now := time.Now()
+	window := newTransferWindowWithClock(time.Minute, func() time.Time { return now })
+	require.Zero(t, window.Limit())
+
+	transfer := func(seconds int, bytesPerSecond int64) {
+		for i := 0; i < seconds; i++ {
+			now = now.Add(time.Second)
+			window.Transferred(bytesPerSecond)
+		}
+	}
+
+	// the first seconds are scaled up to the window.
+	transfer(10, 1e6)
+	require.InDelta(t, 60e6, window.Limit(), 3e6)
+
+	transfer(590, 1e6)
+	require.InDelta(t, 60e6, window.Limit(), 3e6)
+
+	// the limit follows the node when it slows down.
+	transfer(300, 1e5)
+	require.InDelta(t, 6e6, window.Limit(), 1e6)
+
+	// and when it speeds up again.
+	transfer(300, 2e6)
+	require.InDelta(t, 120e6, window.Limit(), 6e6)
+}
+
+func TestTransferWindowPipelining(t *testing.T) {
+	now := time.Now()
+	window := newTransferWindowWithClock(time.Minute, func() time.Time { return now })
+	pending := NewPendingMap()
+
+	put := func(size int64) {
+		require.NoError(t, pending.Put(testrand.PieceID(), &PendingTransfer{PieceSize: size}))
+	}
+
+	// until the node has transferred anything, one transfer is sent at a
+	// time.
+	require.True(t, window.CanSend(pending))
+	put(1e6)
+	require.False(t, window.CanSend(pending))
+
+	for i := 0; i < 600; i++ {
+		now = now.Add(time.Second)
+		window.Transferred(1e6)
+	}
+
+	// the transfers are sent ahead of the replies, while the pending bytes
+	// are below what the node transfers within the window.
+	put(39e6)
+	require.True(t, window.CanSend(pending))
+	put(40e6)
+	require.False(t, window.CanSend(pending))
+}
+
+func TestReplacementSelector(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	holder := testrand.NodeID()
+	offlineHolder := testrand.NodeID()
+	segment := metabase.Segment{
+		Pieces: metabase.Pieces{
+			{Number: 0, StorageNode: holder},
+			{Number: 1, StorageNode: offlineHolder},
+		},
+	}
+
+	inSegment := &overlay.SelectedNode{ID: holder, LastNet: "10.0.0"}
+	sameNetwork := &overlay.SelectedNode{ID: testrand.NodeID(), LastNet: "10.0.0"}
+	sameNetworkAsOffline := &overlay.SelectedNode{ID: testrand.NodeID(), LastNet: "10.0.1"}
+	first := &overlay.SelectedNode{ID: testrand.NodeID(), LastNet: "10.0.2"}
+	second := &overlay.SelectedNode{ID: testrand.NodeID(), LastNet: "10.0.3"}
+
+	selector := &replacementSelector{
+		candidates: []*overlay.SelectedNode{inSegment, sameNetwork, first, sameNetworkAsOffline, second},
+		networks: map[storj.NodeID]string{
+			holder:        "10.0.0",
+			offlineHolder: "10.0.1",
+		},
+	}
+
+	// the candidates of the batch are handed out in turn, skipping the ones
+	// which don't fit the segment.
+	for _, expected := range []*overlay.SelectedNode{first, second, first} {
+		node, err := selector.Select(ctx, segment)
+		require.NoError(t, err)
+		require.Equal(t, expected, node)
+	}
+
+	// without distinct networks only the nodes of the segment are skipped.
+	selector = &replacementSelector{
+		candidates: []*overlay.SelectedNode{inSegment, sameNetwork},
+	}
+	node, err := selector.Select(ctx, segment)
+	require.NoError(t, err)
+	require.Equal(t, sameNetwork, node)
+}
@@ -0,0 +1,119 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package gracefulexit
+
+import (
+	"context"
+
+	"storj.io/common/storj"
+	"storj.io/storj/satellite/metabase"
+	"storj.io/storj/satellite/overlay"
+)
+
+// replacementSelector selects the nodes which receive the pieces of a batch
+// of transfers. The candidates are selected for the whole batch with a
+// single query and are handed out in turn. A transfer for which none of the
+// candidates fits falls back to a selection for its segment alone.
+type replacementSelector struct {
+	overlay    *overlay.Service
+	candidates []*overlay.SelectedNode
+	next       int
+
+	// networks contains the networks of the nodes, which hold the pieces of
+	// the segments, online or not. It's nil when the node selection doesn't
+	// require distinct networks.
+	networks map[storj.NodeID]string
+}
+
+// newReplacementSelector selects the candidates for the transfers of the
+// segments.
+func (endpoint *Endpoint) newReplacementSelector(ctx context.Context, exitingNodeID storj.NodeID, segments []metabase.Segment) (_ *replacementSelector, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	candidates, err := endpoint.overlay.FindStorageNodesForGracefulExit(ctx, overlay.FindStorageNodesRequest{
+		RequestedCount: len(segments),
+		ExcludedIDs:    []storj.NodeID{exitingNodeID},
+	})
+	if err != nil && !overlay.ErrNotEnoughNodes.Has(err) {
+		return nil, err
+	}
+
+	selector := &replacementSelector{
+		overlay:    endpoint.overlay,
+		candidates: candidates,
+	}
+	if !endpoint.overlay.DistinctIP() {
+		return selector, nil
+	}
+
+	// the selection for a single segment excludes the networks of all of
+	// its pieces, so the networks of the offline nodes are excluded as well.
+	var nodeIDs []storj.NodeID
+	seen := make(map[storj.NodeID]struct{})
+	for _, segment := range segments {
+		for _, piece := range segment.Pieces {
+			if _, ok := seen[piece.StorageNode]; !ok {
+				seen[piece.StorageNode] = struct{}{}
+				nodeIDs = append(nodeIDs, piece.StorageNode)
+			}
+		}
+	}
+
+	networks, err := endpoint.overlay.GetNodesNetworkInOrder(ctx, nodeIDs)
+	if err != nil {
+		return nil, err
+	}
+
+	selector.networks = make(map[storj.NodeID]string, len(nodeIDs))
+	for i, nodeID := range nodeIDs {
+		selector.networks[nodeID] = networks[i]
+	}
+	return selector, nil
+}
+
+// Select returns the node which receives the transferred piece of the
+// segment. It returns nil when there is no suitable node.
+func (selector *replacementSelector) Select(ctx context.Context, segment metabase.Segment) (_ *overlay.SelectedNode, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	excludedIDs := make([]storj.NodeID, len(segment.Pieces))
+	excludedNodes := make(map[storj.NodeID]struct{}, len(segment.Pieces))
+	excludedNetworks := make(map[string]struct{}, len(segment.Pieces))
+	for i, piece := range segment.Pieces {
+		excludedIDs[i] = piece.StorageNode
+		excludedNodes[piece.StorageNode] = struct{}{}
+		if network := selector.networks[piece.StorageNode]; network != "" {
+			excludedNetworks[network] = struct{}{}
+		}
+	}
+
+	for i := range selector.candidates {
+		k := (selector.next + i) % len(selector.candidates)
+		candidate := selector.candidates[k]
+
+		if _, ok := excludedNodes[candidate.ID]; ok {
+			continue
+		}
+		if _, ok := excludedNetworks[candidate.LastNet]; ok {
+			continue
+		}
+
+		selector.next = k + 1
+		return candidate, nil
+	}
+
+	mon.Event("graceful_exit_replacement_fallback")
+
+	newNodes, err := selector.overlay.FindStorageNodesForGracefulExit(ctx, overlay.FindStorageNodesRequest{
+		RequestedCount: 1,
+		ExcludedIDs:    excludedIDs,
+	})
+	if err != nil {
+		return nil, err
+	}
+	if len(newNodes) == 0 {
+		return nil, nil
+	}
+	return newNodes[0], nil
+}
@@ -31,56 +31,46 @@ func BenchmarkExpiredDeletion(b *testing.B) {
 	if testing.Short() {
 		expiredScenario{
 			objects:           10,
+			expired:           10,
 			segmentsPerObject: 2,
-			expiredRatio:      1,
 		}.Run(b)
 		return
 	}
 	expiredScenario{
 		objects:           1000,
+		expired:           1,
 		segmentsPerObject: 10,
-		expiredRatio:      0.001,
 	}.Run(b)
+
+	// the deletion cost should depend on the number of expired objects and
+	// not on the size of the objects table, so the same number of expired
+	// objects is deleted from a growing table
+	for _, objects := range []int{1000, 10000, 50000} {
+		expiredScenario{
+			objects:           objects,
+			expired:           100,
+			segmentsPerObject: 1,
+		}.Run(b)
+	}
+	// and a growing number of expired objects from the same table.
+	for _, expired := range []int{10, 100, 1000} {
+		expiredScenario{
+			objects:           10000,
+			expired:           expired,
+			segmentsPerObject: 1,
+		}.Run(b)
+	}
 }
 
 type expiredScenario struct {
+	// objects is the number of objects in the table, including the expired
+	// ones.
 	objects           int
+	expired           int
 	segmentsPerObject int
-	expiredRatio      float32
 	// info filled in during execution.
-	redundancy   storj.RedundancyScheme
-	objectStream []metabase.ObjectStream
-}
-
-type expirationDateGenerator struct {
-	expired    int
-	nonExpired int
-	now        time.Time
-}
-
-func (g *expirationDateGenerator) init(total int, ratio float32, now time.Time) {
-	g.expired = int(ratio * float32(total))
-	g.nonExpired = total - g.expired
-	g.now = now
-}
-
-func (g *expirationDateGenerator) getDeadline() time.Time {
-	timeInterval := time.Duration(testrand.Intn(36))*time.Hour + time.Hour
-	if g.expired == 0 && g.nonExpired != 0 {
-		g.nonExpired--
-		return g.now.Add(timeInterval)
-	}
-	if g.nonExpired == 0 && g.expired != 0 {
-		g.expired--
-		return g.now.Add(-timeInterval)
-	}
-	expired := (testrand.Intn(2) == 0)
-	if expired {
-		g.expired--
-		return g.now.Add(-timeInterval)
-	}
-	g.nonExpired--
-	return g.now.Add(timeInterval)
+	redundancy storj.RedundancyScheme
+	nodes      []storj.NodeID
 }
 
 // Run runs the scenario as a subtest.
@@ -90,7 +80,7 @@ func (s expiredScenario) Run(b *testing.B) {
 
 // name returns the scenario arguments as a string.
 func (s *expiredScenario) name() string {
-	return fmt.Sprintf("objects=%d,expiredRatio:%f", s.objects, s.expiredRatio)
+	return fmt.Sprintf("objects=%d,expired=%d", s.objects, s.expired)
 }
 
 // run runs the specified scenario.
@@ -108,84 +98,29 @@ func (s *expiredScenario) run(ctx *testcontext.Context, b *testing.B, db *metaba
 		}
 	}
 
-	nodes := make([]storj.NodeID, 10000)
-	for i := range nodes {
-		nodes[i] = testrand.NodeID()
+	s.nodes = make([]storj.NodeID, 10000)
+	for i := range s.nodes {
+		s.nodes[i] = testrand.NodeID()
 	}
 
 	now := time.Now()
+	expiresIn := func() time.Duration {
+		return time.Duration(testrand.Intn(36))*time.Hour + time.Hour
+	}
+
+	// the objects which haven't expired stay in the table between the
+	// iterations.
+	metabasetest.DeleteAll{}.Check(ctx, b, db)
+	for objectIndex := s.expired; objectIndex < s.objects; objectIndex++ {
+		s.createObject(ctx, b, db, now.Add(expiresIn()))
+	}
 
 	m := make(Metrics, 0, b.N)
 	defer m.Report(b, "ns/loop")
 	b.Run("Delete expired objects", func(b *testing.B) {
 		for i := 0; i < b.N; i++ {
-			// wipe data so we can do the exact same test
-			metabasetest.DeleteAll{}.Check(ctx, b, db)
-			s.objectStream = nil
-			var expiredGenerator expirationDateGenerator
-
-			expiredGenerator.init(s.objects, s.expiredRatio, now)
-			for objectIndex := 0; objectIndex < s.objects; objectIndex++ {
-
-				expiresAt := expiredGenerator.getDeadline()
-				objectStream := metabase.ObjectStream{
-					ProjectID:  testrand.UUID(),
-					BucketName: randBucketname(10),
-					ObjectKey:  metabase.ObjectKey(testrand.UUID().String()),
-					Version:    1,
-					StreamID:   testrand.UUID(),
-				}
-				s.objectStream = append(s.objectStream, objectStream)
-				_, err := db.BeginObjectExactVersion(ctx, metabase.BeginObjectExactVersion{
-					ObjectStream: objectStream,
-					Encryption: storj.EncryptionParameters{
-						CipherSuite: storj.EncAESGCM,
-						BlockSize:   256,
-					},
-					ExpiresAt: &expiresAt,
-				})
-				require.NoError(b, err)
-
-				for segment := 0; segment < s.segmentsPerObject-1; segment++ {
-					rootPieceID := testrand.PieceID()
-					pieces := randPieces(int(s.redundancy.OptimalShares), nodes)
-
-					err := db.BeginSegment(ctx, metabase.BeginSegment{
-						ObjectStream: objectStream,
-						Position: metabase.SegmentPosition{
-							Part:  uint32(0),
-							Index: uint32(segment),
-						},
-						RootPieceID: rootPieceID,
-						Pieces:      pieces,
-					})
-					require.NoError(b, err)
-
-					segmentSize := testrand.Intn(64*memory.MiB.Int()) + 1
-					encryptedKey := testrand.BytesInt(storj.KeySize)
-					encryptedKeyNonce := testrand.BytesInt(storj.NonceSize)
-
-					err = db.CommitSegment(ctx, metabase.CommitSegment{
-						ObjectStream: objectStream,
-						Position: metabase.SegmentPosition{
-							Part:  uint32(0),
-							Index: uint32(segment),
-						},
-						EncryptedKey:      encryptedKey,
-						EncryptedKeyNonce: encryptedKeyNonce,
-						PlainSize:         int32(segmentSize),
-						EncryptedSize:     int32(segmentSize),
-						RootPieceID:       rootPieceID,
-						Pieces:            pieces,
-						Redundancy:        s.redundancy,
-					})
-					require.NoError(b, err)
-				}
-
-				_, err = db.CommitObject(ctx, metabase.CommitObject{
-					ObjectStream: objectStream,
-				})
-				require.NoError(b, err)
+			for objectIndex := 0; objectIndex < s.expired; objectIndex++ {
+				s.createObject(ctx, b, db, now.Add(-expiresIn()))
 			}
 
 			m.Record(func() {
@@ -196,7 +131,65 @@ func (s *expiredScenario) run(ctx *testcontext.Context, b *testing.B, db *metaba
 			})
 		}
 	})
-	if len(s.objectStream) == 0 {
-		b.Fatal("no objects uploaded")
+}
+
+// createObject creates a committed object, which expires at expiresAt.
+func (s *expiredScenario) createObject(ctx *testcontext.Context, b *testing.B, db *metabase.DB, expiresAt time.Time) {
+	objectStream := metabase.ObjectStream{
+		ProjectID:  testrand.UUID(),
+		BucketName: randBucketname(10),
+		ObjectKey:  metabase.ObjectKey(testrand.UUID().String()),
+		Version:    1,
+		StreamID:   testrand.UUID(),
 	}
+	_, err := db.BeginObjectExactVersion(ctx, metabase.BeginObjectExactVersion{
+		ObjectStream: objectStream,
+		Encryption: storj.EncryptionParameters{
+			CipherSuite: storj.EncAESGCM,
+			BlockSize:   256,
+		},
+		ExpiresAt: &expiresAt,
+	})
+	require.NoError(b, err)
+
+	for segment := 0; segment < s.segmentsPerObject-1; segment++ {
+		rootPieceID := testrand.PieceID()
+		pieces := randPieces(int(s.redundancy.OptimalShares), s.nodes)
+
+		err := db.BeginSegment(ctx, metabase.BeginSegment{
+			ObjectStream: objectStream,
+			Position: metabase.SegmentPosition{
+				Part:  uint32(0),
+				Index: uint32(segment),
+			},
+			RootPieceID: rootPieceID,
+			Pieces:      pieces,
+		})
+		require.NoError(b, err)
+
+		segmentSize := testrand.Intn(64*memory.MiB.Int()) + 1
+		encryptedKey := testrand.BytesInt(storj.KeySize)
+		encryptedKeyNonce := testrand.BytesInt(storj.NonceSize)
+
+		err = db.CommitSegment(ctx, metabase.CommitSegment{
+			ObjectStream: objectStream,
+			Position: metabase.SegmentPosition{
+				Part:  uint32(0),
+				Index: uint32(segment),
+			},
+			EncryptedKey:      encryptedKey,
+			EncryptedKeyNonce: encryptedKeyNonce,
+			PlainSize:         int32(segmentSize),
+			EncryptedSize:     int32(segmentSize),
+			RootPieceID:       rootPieceID,
+			Pieces:            pieces,
+			Redundancy:        s.redundancy,
+		})
+		require.NoError(b, err)
+	}
+
+	_, err = db.CommitObject(ctx, metabase.CommitObject{
+		ObjectStream: objectStream,
+	})
+	require.NoError(b, err)
 }
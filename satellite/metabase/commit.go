@@ -230,6 +230,68 @@ func (db *DB) BeginSegment(ctx context.Context, opts BeginSegment) (err error) {
 	return nil
 }
 
+// BeginSegments contains options to verify, whether multiple new segment
+// uploads of the same object can be started.
+type BeginSegments struct {
+	ObjectStream
+
+	Segments []BeginSegmentsItem
+}
+
+// BeginSegmentsItem describes a single segment of BeginSegments.
+type BeginSegmentsItem struct {
+	Position    SegmentPosition
+	RootPieceID storj.PieceID
+	Pieces      Pieces
+}
+
+// BeginSegments verifies, whether new segment uploads can be started, using
+// a single query for all of them.
+func (db *DB) BeginSegments(ctx context.Context, opts BeginSegments) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := opts.ObjectStream.Verify(); err != nil {
+		return err
+	}
+
+	if len(opts.Segments) == 0 {
+		return ErrInvalidRequest.New("Segments missing")
+	}
+
+	for _, segment := range opts.Segments {
+		if err := segment.Pieces.Verify(); err != nil {
+			return err
+		}
+
+		if segment.RootPieceID.IsZero() {
+			return ErrInvalidRequest.New("RootPieceID missing")
+		}
+	}
+
+	// Verify that object exists and is partial.
+	var value int
+	err = db.db.QueryRowContext(ctx, `
+		SELECT 1
+		FROM objects WHERE
+			project_id   = $1 AND
+			bucket_name  = $2 AND
+			object_key   = $3 AND
+			version      = $4 AND
+			stream_id    = $5 AND
+			status       = `+pendingStatus,
+		opts.ProjectID, []byte(opts.BucketName), []byte(opts.ObjectKey), opts.Version, opts.StreamID).Scan(&value)
+	if err != nil {
+		if errors.Is(err, sql.ErrNoRows) {
+			return Error.New("pending object missing")
+		}
+		return Error.New("unable to query object status: %w", err)
+	}
+
+	mon.Meter("segment_begin").Mark(len(opts.Segments))
+
+	return nil
+}
+
 // CommitSegment contains all necessary information about the segment.
 type CommitSegment struct {
 	ObjectStream
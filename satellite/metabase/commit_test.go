@@ -858,6 +858,104 @@ func TestBeginSegment(t *testing.T) {
 	})
 }
 
+func TestBeginSegments(t *testing.T) {
+	metabasetest.Run(t, func(ctx *testcontext.Context, t *testing.T, db *metabase.DB) {
+		obj := metabasetest.RandObjectStream()
+
+		segments := make([]metabase.BeginSegmentsItem, 5)
+		for i := range segments {
+			segments[i] = metabase.BeginSegmentsItem{
+				Position:    metabase.SegmentPosition{Index: uint32(i)},
+				RootPieceID: testrand.PieceID(),
+				Pieces: []metabase.Piece{{
+					Number:      1,
+					StorageNode: testrand.NodeID(),
+				}},
+			}
+		}
+
+		t.Run("Segments missing", func(t *testing.T) {
+			defer metabasetest.DeleteAll{}.Check(ctx, t, db)
+
+			metabasetest.BeginSegments{
+				Opts: metabase.BeginSegments{
+					ObjectStream: obj,
+				},
+				ErrClass: &metabase.ErrInvalidRequest,
+				ErrText:  "Segments missing",
+			}.Check(ctx, t, db)
+			metabasetest.Verify{}.Check(ctx, t, db)
+		})
+
+		t.Run("RootPieceID missing", func(t *testing.T) {
+			defer metabasetest.DeleteAll{}.Check(ctx, t, db)
+
+			metabasetest.BeginSegments{
+				Opts: metabase.BeginSegments{
+					ObjectStream: obj,
+					Segments: []metabase.BeginSegmentsItem{
+						segments[0],
+						{
+							Pieces: segments[1].Pieces,
+						},
+					},
+				},
+				ErrClass: &metabase.ErrInvalidRequest,
+				ErrText:  "RootPieceID missing",
+			}.Check(ctx, t, db)
+			metabasetest.Verify{}.Check(ctx, t, db)
+		})
+
+		t.Run("pending object missing", func(t *testing.T) {
+			defer metabasetest.DeleteAll{}.Check(ctx, t, db)
+
+			metabasetest.BeginSegments{
+				Opts: metabase.BeginSegments{
+					ObjectStream: obj,
+					Segments:     segments,
+				},
+				ErrClass: &metabase.Error,
+				ErrText:  "pending object missing",
+			}.Check(ctx, t, db)
+			metabasetest.Verify{}.Check(ctx, t, db)
+		})
+
+		t.Run("begin segments successfully", func(t *testing.T) {
+			defer metabasetest.DeleteAll{}.Check(ctx, t, db)
+			now := time.Now()
+			zombieDeadline := now.Add(24 * time.Hour)
+
+			metabasetest.BeginObjectExactVersion{
+				Opts: metabase.BeginObjectExactVersion{
+					ObjectStream: obj,
+					Encryption:   metabasetest.DefaultEncryption,
+				},
+				Version: 1,
+			}.Check(ctx, t, db)
+
+			metabasetest.BeginSegments{
+				Opts: metabase.BeginSegments{
+					ObjectStream: obj,
+					Segments:     segments,
+				},
+			}.Check(ctx, t, db)
+
+			metabasetest.Verify{
+				Objects: []metabase.RawObject{
+					{
+						ObjectStream: obj,
+						CreatedAt:    now,
+						Status:       metabase.Pending,
+
+						Encryption:             metabasetest.DefaultEncryption,
+						ZombieDeletionDeadline: &zombieDeadline,
+					},
+				},
+			}.Check(ctx, t, db)
+		})
+	})
+}
+
 func TestCommitSegment(t *testing.T) {
 	metabasetest.Run(t, func(ctx *testcontext.Context, t *testing.T, db *metabase.DB) {
 		obj := metabasetest.RandObjectStream()
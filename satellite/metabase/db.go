@@ -310,6 +310,14 @@ func (db *DB) PostgresMigration() *migrate.Migration {
 					`ALTER TABLE segments ALTER COLUMN created_at SET NOT NULL`,
 				},
 			},
+			{
+				DB:          &db.db,
+				Description: "add index on expires_at to objects",
+				Version:     14,
+				Action: migrate.SQL{
+					`CREATE INDEX IF NOT EXISTS objects_expires_at_index ON objects (expires_at) WHERE expires_at IS NOT NULL`,
+				},
+			},
 		},
 	}
 }
@@ -7,6 +7,9 @@ import (
 	"context"
 	"database/sql"
 	"errors"
+	"sync/atomic"
+
+	"golang.org/x/sync/errgroup"
 
 	"storj.io/common/uuid"
 	"storj.io/private/dbutil"
@@ -15,6 +18,10 @@ import (
 
 const (
 	deleteBatchSizeLimit = intLimitRange(50)
+
+	// deleteBucketMaxConcurrency is the maximum number of key ranges, which
+	// are split on the first byte of the object key.
+	deleteBucketMaxConcurrency = 256
 )
 
 // DeleteBucketObjects contains arguments for deleting a whole bucket.
@@ -22,8 +29,13 @@ type DeleteBucketObjects struct {
 	Bucket    BucketLocation
 	BatchSize int
 
+	// Concurrency is the number of non-overlapping object key ranges which
+	// are deleted in parallel. Zero or one means a single range.
+	Concurrency int
+
 	// DeletePieces is called for every batch of objects.
 	// Slice `segments` will be reused between calls.
+	// When Concurrency is larger than one it's called concurrently.
 	DeletePieces func(ctx context.Context, segments []DeletedSegmentInfo) error
 }
 
@@ -31,6 +43,9 @@ type DeleteBucketObjects struct {
 // Deletion performs in batches, so in case of error while processing,
 // this method will return the number of objects deleted to the moment
 // when an error occurs.
+//
+// Deleted objects are removed from the database by each batch, hence calling
+// it again after a failure resumes the deletion of the remaining objects.
 func (db *DB) DeleteBucketObjects(ctx context.Context, opts DeleteBucketObjects) (deletedObjectCount int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
@@ -40,13 +55,66 @@ func (db *DB) DeleteBucketObjects(ctx context.Context, opts DeleteBucketObjects)
 
 	deleteBatchSizeLimit.Ensure(&opts.BatchSize)
 
+	if opts.Concurrency > deleteBucketMaxConcurrency {
+		opts.Concurrency = deleteBucketMaxConcurrency
+	}
+	if opts.Concurrency <= 1 {
+		return db.deleteBucketObjectsRange(ctx, opts, objectKeyRange{})
+	}
+
+	group, ctx := errgroup.WithContext(ctx)
+	var totalDeleted int64
+	for _, keyRange := range splitObjectKeyRanges(opts.Concurrency) {
+		keyRange := keyRange
+		group.Go(func() error {
+			deleted, err := db.deleteBucketObjectsRange(ctx, opts, keyRange)
+			atomic.AddInt64(&totalDeleted, deleted)
+			return err
+		})
+	}
+	err = group.Wait()
+
+	return atomic.LoadInt64(&totalDeleted), err
+}
+
+// objectKeyRange is a range of object keys, Start is inclusive and Limit is
+// exclusive. A nil Limit means that the range is unbounded.
+type objectKeyRange struct {
+	Start ObjectKey
+	Limit *ObjectKey
+}
+
+// splitObjectKeyRanges splits the object key space into n ranges on the
+// first byte of the key. Object keys are encrypted, so the objects are
+// distributed evenly between the ranges.
+func splitObjectKeyRanges(n int) []objectKeyRange {
+	ranges := make([]objectKeyRange, n)
+	for i := range ranges {
+		if i > 0 {
+			ranges[i].Start = ObjectKey([]byte{byte(i * 256 / n)})
+		}
+		if i < n-1 {
+			limit := ObjectKey([]byte{byte((i + 1) * 256 / n)})
+			ranges[i].Limit = &limit
+		}
+	}
+	return ranges
+}
+
+// deleteBucketObjectsRange deletes all objects in the specified bucket and
+// key range.
+func (db *DB) deleteBucketObjectsRange(ctx context.Context, opts DeleteBucketObjects, keyRange objectKeyRange) (deletedObjectCount int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	var query string
 	switch db.impl {
 	case dbutil.Cockroach:
 		query = `
 		WITH deleted_objects AS (
 			DELETE FROM objects
-			WHERE project_id = $1 AND bucket_name = $2 LIMIT $3
+			WHERE project_id = $1 AND bucket_name = $2 AND
+				object_key >= $4 AND ($5::BYTEA IS NULL OR object_key < $5)
+			LIMIT $3
 			RETURNING objects.stream_id
 		)
 		DELETE FROM segments
@@ -59,7 +127,8 @@ func (db *DB) DeleteBucketObjects(ctx context.Context, opts DeleteBucketObjects)
 			DELETE FROM objects
 			WHERE stream_id IN (
 				SELECT stream_id FROM objects
-				WHERE project_id = $1 AND bucket_name = $2
+				WHERE project_id = $1 AND bucket_name = $2 AND
+					object_key >= $4 AND ($5::BYTEA IS NULL OR object_key < $5)
 				LIMIT $3
 			)
 			RETURNING objects.stream_id
@@ -72,17 +141,27 @@ func (db *DB) DeleteBucketObjects(ctx context.Context, opts DeleteBucketObjects)
 		return 0, Error.New("unhandled database: %v", db.impl)
 	}
 
+	start := []byte(keyRange.Start)
+	if start == nil {
+		start = []byte{}
+	}
+	var limit []byte
+	if keyRange.Limit != nil {
+		limit = []byte(*keyRange.Limit)
+	}
+
 	// TODO: fix the count for objects without segments
 	deletedSegments := make([]DeletedSegmentInfo, 0, 100)
 	for {
 		if err := ctx.Err(); err != nil {
-			return 0, err
+			return deletedObjectCount, err
 		}
 
 		deletedSegments = deletedSegments[:0]
 		deletedObjects := 0
 		err = withRows(db.db.QueryContext(ctx, query,
-			opts.Bucket.ProjectID, []byte(opts.Bucket.BucketName), opts.BatchSize))(func(rows tagsql.Rows) error {
+			opts.Bucket.ProjectID, []byte(opts.Bucket.BucketName), opts.BatchSize,
+			start, limit))(func(rows tagsql.Rows) error {
 			ids := map[uuid.UUID]struct{}{} // TODO: avoid map here
 			for rows.Next() {
 				var streamID uuid.UUID
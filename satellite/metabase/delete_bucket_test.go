@@ -6,6 +6,7 @@ package metabase_test
 import (
 	"context"
 	"errors"
+	"sync"
 	"testing"
 	"time"
 
@@ -278,6 +279,39 @@ func TestDeleteBucketObjects(t *testing.T) {
 			require.Equal(t, 25, segmentsDeleted)
 			metabasetest.Verify{}.Check(ctx, t, db)
 		})
+
+		t.Run("multiple objects with concurrency", func(t *testing.T) {
+			defer metabasetest.DeleteAll{}.Check(ctx, t, db)
+
+			root := metabasetest.RandObjectStream()
+			for i := 0; i < 20; i++ {
+				obj := metabasetest.RandObjectStream()
+				obj.ProjectID = root.ProjectID
+				obj.BucketName = root.BucketName
+				obj.ObjectKey = metabase.ObjectKey([]byte{byte(i * 13)}) + obj.ObjectKey
+				metabasetest.CreateObject(ctx, t, db, obj, 2)
+			}
+
+			var mu sync.Mutex
+			segmentsDeleted := 0
+			metabasetest.DeleteBucketObjects{
+				Opts: metabase.DeleteBucketObjects{
+					Bucket:      root.Location().Bucket(),
+					BatchSize:   3,
+					Concurrency: 4,
+					DeletePieces: func(ctx context.Context, segments []metabase.DeletedSegmentInfo) error {
+						mu.Lock()
+						defer mu.Unlock()
+						segmentsDeleted += len(segments)
+						return nil
+					},
+				},
+				Deleted: 20,
+			}.Check(ctx, t, db)
+
+			require.Equal(t, 40, segmentsDeleted)
+			metabasetest.Verify{}.Check(ctx, t, db)
+		})
 	})
 }
 
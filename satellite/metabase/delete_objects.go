@@ -6,266 +6,409 @@ package metabase
 import (
 	"context"
 	"encoding/hex"
+	"sync/atomic"
 	"time"
 
-	"github.com/jackc/pgx/v4"
-	"github.com/zeebo/errs"
 	"go.uber.org/zap"
+	"golang.org/x/sync/errgroup"
 
-	"storj.io/private/dbutil/pgxutil"
+	"storj.io/common/uuid"
 	"storj.io/private/tagsql"
 )
 
 const (
 	deleteBatchsizeLimit = intLimitRange(1000)
+
+	// deleteObjectsMaxConcurrency is the maximum number of ranges which are
+	// deleted in parallel. The project id ranges are split on the first byte
+	// of the project id.
+	deleteObjectsMaxConcurrency = 256
 )
 
 // DeleteExpiredObjects contains all the information necessary to delete expired objects and segments.
 type DeleteExpiredObjects struct {
-	ExpiredBefore  time.Time
-	AsOfSystemTime time.Time
-	BatchSize      int
+	ExpiredBefore time.Time
+	BatchSize     int
+
+	// Concurrency is the number of non-overlapping expiration time windows
+	// which are processed in parallel. Zero or one means a single window.
+	Concurrency int
 }
 
 // DeleteExpiredObjects deletes all objects that expired before expiredBefore.
+//
+// Objects are visited in expires_at order using objects_expires_at_index, so
+// the cost is proportional to the number of expired objects rather than to the
+// size of the objects table.
 func (db *DB) DeleteExpiredObjects(ctx context.Context, opts DeleteExpiredObjects) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	return db.deleteObjectsAndSegmentsBatch(ctx, opts.BatchSize, func(startAfter ObjectStream, batchsize int) (last ObjectStream, err error) {
-		query := `
+	deleteBatchsizeLimit.Ensure(&opts.BatchSize)
+
+	windows, err := db.splitExpiredWindows(ctx, opts)
+	if err != nil {
+		return Error.New("unable to delete expired objects: %w", err)
+	}
+
+	deleted, err := deleteInParallel(ctx, len(windows), func(ctx context.Context, i int) (int64, error) {
+		return db.deleteExpiredObjectsWindow(ctx, opts, windows[i])
+	})
+	if deleted > 0 {
+		db.log.Info("Deleted expired objects", zap.Int64("count", deleted))
+	}
+	if err != nil {
+		return Error.New("unable to delete expired objects: %w", err)
+	}
+	return nil
+}
+
+// expiredObject is an object together with its expiration time, which is
+// used as a cursor when iterating over expired objects.
+type expiredObject struct {
+	ObjectStream
+	ExpiresAt time.Time
+}
+
+// expiresAtWindow is a window of expiration times, Start is inclusive and
+// Limit is exclusive.
+type expiresAtWindow struct {
+	Start time.Time
+	Limit time.Time
+}
+
+// splitExpiredWindows splits the expiration times of the expired objects into
+// opts.Concurrency windows of equal length. Each window is a separate part of
+// objects_expires_at_index, so the windows don't read the same index entries.
+func (db *DB) splitExpiredWindows(ctx context.Context, opts DeleteExpiredObjects) (_ []expiresAtWindow, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	var first *time.Time
+	err = db.db.QueryRowContext(ctx, `
+		SELECT min(expires_at) FROM objects
+		WHERE expires_at < $1
+	`, opts.ExpiredBefore).Scan(&first)
+	if err != nil {
+		return nil, err
+	}
+	if first == nil {
+		return nil, nil
+	}
+
+	n := opts.Concurrency
+	if n > deleteObjectsMaxConcurrency {
+		n = deleteObjectsMaxConcurrency
+	}
+	if n < 1 {
+		n = 1
+	}
+
+	step := opts.ExpiredBefore.Sub(*first) / time.Duration(n)
+	if step <= 0 {
+		n = 1
+	}
+
+	windows := make([]expiresAtWindow, n)
+	for i := range windows {
+		windows[i].Start = first.Add(step * time.Duration(i))
+		windows[i].Limit = first.Add(step * time.Duration(i+1))
+	}
+	windows[n-1].Limit = opts.ExpiredBefore
+
+	return windows, nil
+}
+
+// deleteExpiredObjectsWindow deletes the expired objects in the expiration
+// time window, it keeps its own cursor so that the windows progress
+// independently.
+func (db *DB) deleteExpiredObjectsWindow(ctx context.Context, opts DeleteExpiredObjects, window expiresAtWindow) (deleted int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	startAfter := expiredObject{ExpiresAt: window.Start}
+	for {
+		if err := ctx.Err(); err != nil {
+			return deleted, err
+		}
+
+		batch, err := db.deleteExpiredObjectsBatch(ctx, opts, window, startAfter)
+		if err != nil {
+			return deleted, err
+		}
+		if len(batch) == 0 {
+			return deleted, nil
+		}
+		deleted += int64(len(batch))
+
+		startAfter = batch[len(batch)-1]
+	}
+}
+
+// deleteExpiredObjectsBatch selects and deletes the next batch of expired
+// objects, together with their segments, in a single round trip.
+func (db *DB) deleteExpiredObjectsBatch(ctx context.Context, opts DeleteExpiredObjects, window expiresAtWindow, startAfter expiredObject) (_ []expiredObject, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	query := `
+		WITH expired AS (
 			SELECT
 				project_id, bucket_name, object_key, version, stream_id,
 				expires_at
 			FROM objects
-			` + db.impl.AsOfSystemTime(opts.AsOfSystemTime) + `
 			WHERE
-				(project_id, bucket_name, object_key, version) > ($1, $2, $3, $4)
-				AND expires_at < $5
-				ORDER BY project_id, bucket_name, object_key, version
-			LIMIT $6;`
-
-		expiredObjects := make([]ObjectStream, 0, batchsize)
-
-		err = withRows(db.db.QueryContext(ctx, query,
-			startAfter.ProjectID, []byte(startAfter.BucketName), []byte(startAfter.ObjectKey), startAfter.Version,
-			opts.ExpiredBefore,
-			batchsize),
-		)(func(rows tagsql.Rows) error {
-			for rows.Next() {
-				var expiresAt time.Time
-				err = rows.Scan(
-					&last.ProjectID, &last.BucketName, &last.ObjectKey, &last.Version, &last.StreamID,
-					&expiresAt)
-				if err != nil {
-					return Error.New("unable to delete expired objects: %w", err)
-				}
-
-				db.log.Info("Deleting expired object",
-					zap.Stringer("Project", last.ProjectID),
-					zap.String("Bucket", last.BucketName),
-					zap.String("Object Key", string(last.ObjectKey)),
-					zap.Int64("Version", int64(last.Version)),
-					zap.String("StreamID", hex.EncodeToString(last.StreamID[:])),
-					zap.Time("Expired At", expiresAt),
-				)
-				expiredObjects = append(expiredObjects, last)
+				expires_at < $1
+				AND expires_at >= $2
+				AND (expires_at, project_id, bucket_name, object_key, version) > ($2, $3, $4, $5, $6)
+			ORDER BY expires_at, project_id, bucket_name, object_key, version
+			LIMIT $7
+		), deleted_objects AS (
+			DELETE FROM objects
+			WHERE (project_id, bucket_name, object_key, version, stream_id) IN (
+				SELECT project_id, bucket_name, object_key, version, stream_id FROM expired
+			)
+			RETURNING stream_id
+		), deleted_segments AS (
+			DELETE FROM segments
+			WHERE segments.stream_id IN (SELECT stream_id FROM deleted_objects)
+			RETURNING 1
+		)
+		SELECT
+			project_id, bucket_name, object_key, version, stream_id,
+			expires_at,
+			(SELECT count(*) FROM deleted_segments)
+		FROM expired
+		ORDER BY expires_at, project_id, bucket_name, object_key, version`
+
+	expiredObjects := make([]expiredObject, 0, opts.BatchSize)
+	var segmentsDeleted int64
+
+	err = withRows(db.db.QueryContext(ctx, query,
+		window.Limit,
+		startAfter.ExpiresAt, startAfter.ProjectID, []byte(startAfter.BucketName), []byte(startAfter.ObjectKey), startAfter.Version,
+		opts.BatchSize),
+	)(func(rows tagsql.Rows) error {
+		for rows.Next() {
+			var last expiredObject
+			err = rows.Scan(
+				&last.ProjectID, &last.BucketName, &last.ObjectKey, &last.Version, &last.StreamID,
+				&last.ExpiresAt,
+				&segmentsDeleted)
+			if err != nil {
+				return err
 			}
 
-			return nil
-		})
-		if err != nil {
-			return ObjectStream{}, Error.New("unable to delete expired objects: %w", err)
-		}
-
-		err = db.deleteObjectsAndSegments(ctx, expiredObjects)
-		if err != nil {
-			return ObjectStream{}, err
+			db.log.Debug("Deleting expired object",
+				zap.Stringer("Project", last.ProjectID),
+				zap.String("Bucket", last.BucketName),
+				zap.String("Object Key", string(last.ObjectKey)),
+				zap.Int64("Version", int64(last.Version)),
+				zap.String("StreamID", hex.EncodeToString(last.StreamID[:])),
+				zap.Time("Expired At", last.ExpiresAt),
+			)
+			expiredObjects = append(expiredObjects, last)
 		}
 
-		return last, nil
+		return nil
 	})
+	if err != nil {
+		return nil, err
+	}
+
+	mon.Meter("object_delete").Mark(len(expiredObjects))
+	mon.Meter("segment_delete").Mark64(segmentsDeleted)
+
+	return expiredObjects, nil
 }
 
 // DeleteZombieObjects contains all the information necessary to delete zombie objects and segments.
 type DeleteZombieObjects struct {
 	DeadlineBefore   time.Time
 	InactiveDeadline time.Time
-	AsOfSystemTime   time.Time
 	BatchSize        int
+
+	// Concurrency is the number of non-overlapping project id ranges which
+	// are processed in parallel. Zero or one means a single range.
+	Concurrency int
 }
 
 // DeleteZombieObjects deletes all objects that zombie deletion deadline passed.
 func (db *DB) DeleteZombieObjects(ctx context.Context, opts DeleteZombieObjects) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	return db.deleteObjectsAndSegmentsBatch(ctx, opts.BatchSize, func(startAfter ObjectStream, batchsize int) (last ObjectStream, err error) {
-		query := `
-			SELECT
-				project_id, bucket_name, object_key, version, stream_id
-			FROM objects
-			` + db.impl.AsOfSystemTime(opts.AsOfSystemTime) + `
-			WHERE
-				(project_id, bucket_name, object_key, version) > ($1, $2, $3, $4)
-				AND status = ` + pendingStatus + `
-				AND zombie_deletion_deadline < $5
-				ORDER BY project_id, bucket_name, object_key, version
-			LIMIT $6;`
-
-		objects := make([]ObjectStream, 0, batchsize)
-
-		err = withRows(db.db.QueryContext(ctx, query,
-			startAfter.ProjectID, []byte(startAfter.BucketName), []byte(startAfter.ObjectKey), startAfter.Version,
-			opts.DeadlineBefore,
-			batchsize),
-		)(func(rows tagsql.Rows) error {
-			for rows.Next() {
-				err = rows.Scan(&last.ProjectID, &last.BucketName, &last.ObjectKey, &last.Version, &last.StreamID)
-				if err != nil {
-					return Error.New("unable to delete zombie objects: %w", err)
-				}
-
-				db.log.Debug("Deleting zombie object",
-					zap.Stringer("Project", last.ProjectID),
-					zap.String("Bucket", last.BucketName),
-					zap.String("Object Key", string(last.ObjectKey)),
-					zap.Int64("Version", int64(last.Version)),
-					zap.String("StreamID", hex.EncodeToString(last.StreamID[:])),
-				)
-				objects = append(objects, last)
-			}
-
-			return nil
-		})
-		if err != nil {
-			return ObjectStream{}, Error.New("unable to delete zombie objects: %w", err)
-		}
+	deleteBatchsizeLimit.Ensure(&opts.BatchSize)
 
-		err = db.deleteInactiveObjectsAndSegments(ctx, objects, opts.InactiveDeadline)
-		if err != nil {
-			return ObjectStream{}, err
-		}
+	// the zombie objects are visited in primary key order, so each project
+	// id range reads a separate part of the primary index.
+	concurrency := opts.Concurrency
+	if concurrency > deleteObjectsMaxConcurrency {
+		concurrency = deleteObjectsMaxConcurrency
+	}
+	if concurrency < 1 {
+		concurrency = 1
+	}
+	ranges := splitProjectIDRanges(concurrency)
 
-		return last, nil
+	_, err = deleteInParallel(ctx, len(ranges), func(ctx context.Context, i int) (int64, error) {
+		return db.deleteZombieObjectsRange(ctx, opts, ranges[i])
 	})
+	if err != nil {
+		return Error.New("unable to delete zombie objects: %w", err)
+	}
+	return nil
 }
 
-func (db *DB) deleteObjectsAndSegmentsBatch(ctx context.Context, batchsize int, deleteBatch func(startAfter ObjectStream, batchsize int) (last ObjectStream, err error)) (err error) {
+// deleteZombieObjectsRange deletes the zombie objects in the project id
+// range, it keeps its own cursor so that the ranges progress independently.
+func (db *DB) deleteZombieObjectsRange(ctx context.Context, opts DeleteZombieObjects, projectRange projectIDRange) (deleted int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	deleteBatchsizeLimit.Ensure(&batchsize)
-
 	var startAfter ObjectStream
 	for {
-		lastDeleted, err := deleteBatch(startAfter, batchsize)
+		if err := ctx.Err(); err != nil {
+			return deleted, err
+		}
+
+		last, batchDeleted, err := db.deleteZombieObjectsBatch(ctx, opts, projectRange, startAfter)
 		if err != nil {
-			return err
+			return deleted, err
 		}
-		if lastDeleted.StreamID.IsZero() {
-			return nil
+		deleted += batchDeleted
+		if last.StreamID.IsZero() {
+			return deleted, nil
 		}
-		startAfter = lastDeleted
+		startAfter = last
 	}
 }
 
-func (db *DB) deleteObjectsAndSegments(ctx context.Context, objects []ObjectStream) (err error) {
+// deleteZombieObjectsBatch selects the next batch of zombie objects and
+// deletes the ones without recent upload activity, together with their
+// segments, in a single round trip. It returns the last selected object,
+// which may not have been deleted.
+func (db *DB) deleteZombieObjectsBatch(ctx context.Context, opts DeleteZombieObjects, projectRange projectIDRange, startAfter ObjectStream) (last ObjectStream, deleted int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	if len(objects) == 0 {
-		return nil
-	}
-
-	err = pgxutil.Conn(ctx, db.db, func(conn *pgx.Conn) error {
-		var batch pgx.Batch
-		for _, obj := range objects {
-			obj := obj
-
-			batch.Queue(`
-				WITH deleted_objects AS (
-					DELETE FROM objects
-					WHERE (project_id, bucket_name, object_key, version, stream_id) = ($1::BYTEA, $2, $3, $4, $5::BYTEA)
-					RETURNING stream_id
+	query := `
+		WITH zombies AS (
+			SELECT
+				project_id, bucket_name, object_key, version, stream_id
+			FROM objects
+			WHERE
+				(project_id, bucket_name, object_key, version) > ($1, $2, $3, $4)
+				AND project_id >= $5 AND ($6::BYTEA IS NULL OR project_id < $6)
+				AND status = ` + pendingStatus + `
+				AND zombie_deletion_deadline < $7
+			ORDER BY project_id, bucket_name, object_key, version
+			LIMIT $8
+		), deleted_objects AS (
+			DELETE FROM objects
+			WHERE
+				(project_id, bucket_name, object_key, version, stream_id) IN (
+					SELECT project_id, bucket_name, object_key, version, stream_id FROM zombies
 				)
-				DELETE FROM segments
-				WHERE segments.stream_id = $5::BYTEA
-			`, obj.ProjectID, []byte(obj.BucketName), []byte(obj.ObjectKey), obj.Version, obj.StreamID)
-		}
-
-		results := conn.SendBatch(ctx, &batch)
-		defer func() { err = errs.Combine(err, results.Close()) }()
-
-		var objectsDeletedGuess, segmentsDeleted int64
-
-		var errlist errs.Group
-		for i := 0; i < batch.Len(); i++ {
-			result, err := results.Exec()
-			errlist.Add(err)
-
-			if affectedSegmentCount := result.RowsAffected(); affectedSegmentCount > 0 {
-				// Note, this slightly miscounts objects without any segments
-				// there doesn't seem to be a simple work around for this.
-				// Luckily, this is used only for metrics, where it's not a
-				// significant problem to slightly miscount.
-				objectsDeletedGuess++
-				segmentsDeleted += affectedSegmentCount
+				-- check that all segments where created before inactive time
+				AND NOT EXISTS (
+					SELECT 1 FROM segments
+					WHERE segments.stream_id = objects.stream_id AND segments.created_at > $9
+				)
+			RETURNING stream_id
+		), deleted_segments AS (
+			DELETE FROM segments
+			WHERE segments.stream_id IN (SELECT stream_id FROM deleted_objects)
+			RETURNING 1
+		)
+		SELECT
+			project_id, bucket_name, object_key, version, stream_id,
+			stream_id IN (SELECT stream_id FROM deleted_objects)
+		FROM zombies
+		ORDER BY project_id, bucket_name, object_key, version`
+
+	start, limit := projectRange.bounds()
+
+	err = withRows(db.db.QueryContext(ctx, query,
+		startAfter.ProjectID, []byte(startAfter.BucketName), []byte(startAfter.ObjectKey), startAfter.Version,
+		start, limit,
+		opts.DeadlineBefore,
+		opts.BatchSize,
+		opts.InactiveDeadline),
+	)(func(rows tagsql.Rows) error {
+		for rows.Next() {
+			var wasDeleted bool
+			err = rows.Scan(&last.ProjectID, &last.BucketName, &last.ObjectKey, &last.Version, &last.StreamID, &wasDeleted)
+			if err != nil {
+				return err
+			}
+			if !wasDeleted {
+				continue
 			}
-		}
 
-		mon.Meter("object_delete").Mark64(objectsDeletedGuess)
-		mon.Meter("segment_delete").Mark64(segmentsDeleted)
+			db.log.Debug("Deleting zombie object",
+				zap.Stringer("Project", last.ProjectID),
+				zap.String("Bucket", last.BucketName),
+				zap.String("Object Key", string(last.ObjectKey)),
+				zap.Int64("Version", int64(last.Version)),
+				zap.String("StreamID", hex.EncodeToString(last.StreamID[:])),
+			)
+			deleted++
+		}
 
-		return errlist.Err()
+		return nil
 	})
 	if err != nil {
-		return Error.New("unable to delete expired objects: %w", err)
+		return ObjectStream{}, deleted, err
 	}
-	return nil
+
+	return last, deleted, nil
 }
 
-func (db *DB) deleteInactiveObjectsAndSegments(ctx context.Context, objects []ObjectStream, inactiveDeadline time.Time) (err error) {
-	defer mon.Task()(&ctx)(&err)
+// projectIDRange is a range of project ids, Start is inclusive and Limit is
+// exclusive. A nil Limit means that the range is unbounded.
+type projectIDRange struct {
+	Start uuid.UUID
+	Limit *uuid.UUID
+}
 
-	if len(objects) == 0 {
-		return nil
+// bounds returns the range as query arguments.
+func (projectRange projectIDRange) bounds() (start, limit []byte) {
+	start = projectRange.Start[:]
+	if projectRange.Limit != nil {
+		limit = projectRange.Limit[:]
 	}
+	return start, limit
+}
 
-	err = pgxutil.Conn(ctx, db.db, func(conn *pgx.Conn) error {
-		var batch pgx.Batch
-		for _, obj := range objects {
-			batch.Queue(`
-				WITH deleted_objects AS (
-					DELETE FROM objects
-					WHERE
-						(project_id, bucket_name, object_key, version) = ($1::BYTEA, $2::BYTEA, $3::BYTEA, $4) AND
-						stream_id = $5::BYTEA AND (
-							-- TODO figure out something more optimal
-							NOT EXISTS (SELECT stream_id FROM segments WHERE stream_id = $5::BYTEA)
-							OR
-							-- check that all segments where created before inactive time
-							NOT EXISTS (SELECT stream_id FROM segments WHERE stream_id = $5::BYTEA AND created_at > $6)
-						)
-						RETURNING version -- return anything
-				)
-				DELETE FROM segments
-				WHERE
-					segments.stream_id = $5::BYTEA AND
-					NOT EXISTS (SELECT stream_id FROM segments WHERE stream_id = $5::BYTEA AND created_at > $6)
-			`, obj.ProjectID, []byte(obj.BucketName), []byte(obj.ObjectKey), obj.Version, obj.StreamID, inactiveDeadline)
+// splitProjectIDRanges splits the project id space into n ranges on the
+// first byte of the id. Project ids are random, so the objects are
+// distributed evenly between the ranges.
+func splitProjectIDRanges(n int) []projectIDRange {
+	ranges := make([]projectIDRange, n)
+	for i := range ranges {
+		ranges[i].Start[0] = byte(i * 256 / n)
+		if i < n-1 {
+			var limit uuid.UUID
+			limit[0] = byte((i + 1) * 256 / n)
+			ranges[i].Limit = &limit
 		}
+	}
+	return ranges
+}
 
-		results := conn.SendBatch(ctx, &batch)
-		defer func() { err = errs.Combine(err, results.Close()) }()
+// deleteInParallel calls deleteRange for the n ranges in parallel and returns
+// the total number of deleted objects.
+func deleteInParallel(ctx context.Context, n int, deleteRange func(ctx context.Context, i int) (int64, error)) (deleted int64, err error) {
+	defer mon.Task()(&ctx)(&err)
 
-		var errlist errs.Group
-		for i := 0; i < batch.Len(); i++ {
-			_, err := results.Exec()
-			errlist.Add(err)
-		}
+	if n == 1 {
+		return deleteRange(ctx, 0)
+	}
 
-		return errlist.Err()
-	})
-	if err != nil {
-		return Error.New("unable to delete zombie objects: %w", err)
+	group, ctx := errgroup.WithContext(ctx)
+	for i := 0; i < n; i++ {
+		i := i
+		group.Go(func() error {
+			rangeDeleted, err := deleteRange(ctx, i)
+			atomic.AddInt64(&deleted, rangeDeleted)
+			return err
+		})
 	}
+	err = group.Wait()
 
-	return nil
+	return atomic.LoadInt64(&deleted), err
 }
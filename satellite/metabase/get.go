@@ -13,6 +13,8 @@ import (
 
 	"storj.io/common/storj"
 	"storj.io/common/uuid"
+	"storj.io/private/dbutil/pgutil"
+	"storj.io/private/tagsql"
 )
 
 // ErrSegmentNotFound is an error class for non-existing segment.
@@ -290,6 +292,78 @@ func (db *DB) GetSegmentByPosition(ctx context.Context, opts GetSegmentByPositio
 	return segment, nil
 }
 
+// GetSegmentsByPositions contains arguments necessary for fetching several
+// segments at once.
+type GetSegmentsByPositions struct {
+	Segments []GetSegmentByPosition
+}
+
+// GetSegmentsByPositions returns the segments on the specified positions
+// with a single query. Segments which don't exist are left out of the
+// result, which isn't ordered.
+func (db *DB) GetSegmentsByPositions(ctx context.Context, opts GetSegmentsByPositions) (segments []Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(opts.Segments) == 0 {
+		return nil, nil
+	}
+
+	streamIDs := make([][]byte, 0, len(opts.Segments))
+	positions := make([]int64, 0, len(opts.Segments))
+	for i := range opts.Segments {
+		if err := opts.Segments[i].Verify(); err != nil {
+			return nil, err
+		}
+		streamIDs = append(streamIDs, opts.Segments[i].StreamID[:])
+		positions = append(positions, int64(opts.Segments[i].Position.Encode()))
+	}
+
+	err = withRows(db.db.QueryContext(ctx, `
+		SELECT
+			stream_id, position,
+			created_at, expires_at, repaired_at,
+			root_piece_id, encrypted_key_nonce, encrypted_key,
+			encrypted_size, plain_offset, plain_size,
+			encrypted_etag,
+			redundancy,
+			inline_data, remote_alias_pieces
+		FROM segments
+		WHERE (stream_id, position) IN (
+			SELECT unnest($1::BYTEA[]), unnest($2::INT8[])
+		)
+	`, pgutil.ByteaArray(streamIDs), pgutil.Int8Array(positions)))(func(rows tagsql.Rows) error {
+		for rows.Next() {
+			var segment Segment
+			var aliasPieces AliasPieces
+			err := rows.Scan(
+				&segment.StreamID, &segment.Position,
+				&segment.CreatedAt, &segment.ExpiresAt, &segment.RepairedAt,
+				&segment.RootPieceID, &segment.EncryptedKeyNonce, &segment.EncryptedKey,
+				&segment.EncryptedSize, &segment.PlainOffset, &segment.PlainSize,
+				&segment.EncryptedETag,
+				redundancyScheme{&segment.Redundancy},
+				&segment.InlineData, &aliasPieces,
+			)
+			if err != nil {
+				return Error.New("unable to scan segment: %w", err)
+			}
+
+			segment.Pieces, err = db.aliasCache.ConvertAliasesToPieces(ctx, aliasPieces)
+			if err != nil {
+				return Error.New("unable to convert aliases to pieces: %w", err)
+			}
+
+			segments = append(segments, segment)
+		}
+		return nil
+	})
+	if err != nil {
+		return nil, Error.New("unable to query segments: %w", err)
+	}
+
+	return segments, nil
+}
+
 // GetLatestObjectLastSegment contains arguments necessary for fetching a last segment information.
 type GetLatestObjectLastSegment struct {
 	ObjectLocation
@@ -113,6 +113,19 @@ func (step BeginSegment) Check(ctx *testcontext.Context, t testing.TB, db *metab
 	checkError(t, err, step.ErrClass, step.ErrText)
 }
 
+// BeginSegments is for testing metabase.BeginSegments.
+type BeginSegments struct {
+	Opts     metabase.BeginSegments
+	ErrClass *errs.Class
+	ErrText  string
+}
+
+// Check runs the test.
+func (step BeginSegments) Check(ctx *testcontext.Context, t testing.TB, db *metabase.DB) {
+	err := db.BeginSegments(ctx, step.Opts)
+	checkError(t, err, step.ErrClass, step.ErrText)
+}
+
 // CommitSegment is for testing metabase.CommitSegment.
 type CommitSegment struct {
 	Opts     metabase.CommitSegment
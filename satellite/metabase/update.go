@@ -13,6 +13,8 @@ import (
 
 	"storj.io/common/storj"
 	"storj.io/common/uuid"
+	"storj.io/private/dbutil/pgutil"
+	"storj.io/private/tagsql"
 	"storj.io/storj/storage"
 )
 
@@ -29,11 +31,8 @@ type UpdateSegmentPieces struct {
 	NewRepairedAt time.Time // sets new time of last segment repair (optional).
 }
 
-// UpdateSegmentPieces updates pieces for specified segment. If provided old pieces
-// won't match current database state update will fail.
-func (db *DB) UpdateSegmentPieces(ctx context.Context, opts UpdateSegmentPieces) (err error) {
-	defer mon.Task()(&ctx)(&err)
-
+// Verify verifies update segment pieces request fields.
+func (opts *UpdateSegmentPieces) Verify() error {
 	if opts.StreamID.IsZero() {
 		return ErrInvalidRequest.New("StreamID missing")
 	}
@@ -61,6 +60,17 @@ func (db *DB) UpdateSegmentPieces(ctx context.Context, opts UpdateSegmentPieces)
 		}
 		return err
 	}
+	return nil
+}
+
+// UpdateSegmentPieces updates pieces for specified segment. If provided old pieces
+// won't match current database state update will fail.
+func (db *DB) UpdateSegmentPieces(ctx context.Context, opts UpdateSegmentPieces) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := opts.Verify(); err != nil {
+		return err
+	}
 
 	updateRepairAt := !opts.NewRepairedAt.IsZero()
 
@@ -110,3 +120,124 @@ func (db *DB) UpdateSegmentPieces(ctx context.Context, opts UpdateSegmentPieces)
 
 	return nil
 }
+
+// UpdateSegmentsPieces contains arguments necessary for updating the pieces
+// of several segments at once.
+type UpdateSegmentsPieces struct {
+	Segments []UpdateSegmentPieces
+}
+
+// UpdateSegmentsPieces updates the pieces and the redundancy of several
+// segments with a single query. Like with UpdateSegmentPieces, a segment is
+// only updated when its pieces still match the provided old pieces.
+// NewRepairedAt isn't supported.
+//
+// updated[i] reports whether opts.Segments[i] was updated; segments which
+// have changed or are missing aren't reported as an error.
+func (db *DB) UpdateSegmentsPieces(ctx context.Context, opts UpdateSegmentsPieces) (updated []bool, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(opts.Segments) == 0 {
+		return nil, nil
+	}
+
+	type segmentKey struct {
+		StreamID uuid.UUID
+		Position SegmentPosition
+	}
+
+	indexes := make(map[segmentKey]int, len(opts.Segments))
+	streamIDs := make([][]byte, 0, len(opts.Segments))
+	positions := make([]int64, 0, len(opts.Segments))
+	oldPieces := make([][]byte, 0, len(opts.Segments))
+	newPieces := make([][]byte, 0, len(opts.Segments))
+	redundancies := make([]int64, 0, len(opts.Segments))
+	for i := range opts.Segments {
+		segment := &opts.Segments[i]
+		if err := segment.Verify(); err != nil {
+			return nil, err
+		}
+		if !segment.NewRepairedAt.IsZero() {
+			return nil, ErrInvalidRequest.New("NewRepairedAt isn't supported")
+		}
+
+		key := segmentKey{segment.StreamID, segment.Position}
+		if _, ok := indexes[key]; ok {
+			return nil, ErrInvalidRequest.New("segment %s/%d is updated more than once", segment.StreamID, segment.Position.Encode())
+		}
+		indexes[key] = i
+
+		oldAliases, err := db.aliasCache.ConvertPiecesToAliases(ctx, segment.OldPieces)
+		if err != nil {
+			return nil, Error.New("unable to convert pieces to aliases: %w", err)
+		}
+		oldBytes, err := oldAliases.Bytes()
+		if err != nil {
+			return nil, Error.New("unable to encode pieces: %w", err)
+		}
+
+		newAliases, err := db.aliasCache.ConvertPiecesToAliases(ctx, segment.NewPieces)
+		if err != nil {
+			return nil, Error.New("unable to convert pieces to aliases: %w", err)
+		}
+		newBytes, err := newAliases.Bytes()
+		if err != nil {
+			return nil, Error.New("unable to encode pieces: %w", err)
+		}
+
+		redundancy, err := redundancyScheme{&segment.NewRedundancy}.Value()
+		if err != nil {
+			return nil, err
+		}
+
+		streamIDs = append(streamIDs, segment.StreamID[:])
+		positions = append(positions, int64(segment.Position.Encode()))
+		oldPieces = append(oldPieces, oldBytes)
+		newPieces = append(newPieces, newBytes)
+		redundancies = append(redundancies, redundancy.(int64))
+	}
+
+	updated = make([]bool, len(opts.Segments))
+	err = withRows(db.db.QueryContext(ctx, `
+		UPDATE segments SET
+			remote_alias_pieces = u.new_pieces,
+			redundancy          = u.redundancy
+		FROM (
+			SELECT
+				unnest($1::BYTEA[]) AS stream_id,
+				unnest($2::INT8[])  AS position,
+				unnest($3::BYTEA[]) AS old_pieces,
+				unnest($4::BYTEA[]) AS new_pieces,
+				unnest($5::INT8[])  AS redundancy
+		) AS u
+		WHERE
+			segments.stream_id = u.stream_id AND
+			segments.position  = u.position AND
+			segments.remote_alias_pieces = u.old_pieces
+		RETURNING segments.stream_id, segments.position
+	`, pgutil.ByteaArray(streamIDs), pgutil.Int8Array(positions),
+		pgutil.ByteaArray(oldPieces), pgutil.ByteaArray(newPieces), pgutil.Int8Array(redundancies),
+	))(func(rows tagsql.Rows) error {
+		for rows.Next() {
+			var key segmentKey
+			if err := rows.Scan(&key.StreamID, &key.Position); err != nil {
+				return Error.New("unable to scan updated segment: %w", err)
+			}
+			if i, ok := indexes[key]; ok {
+				updated[i] = true
+			}
+		}
+		return nil
+	})
+	if err != nil {
+		return nil, Error.New("unable to update segments pieces: %w", err)
+	}
+
+	for _, ok := range updated {
+		if ok {
+			mon.Meter("segment_update").Mark(1)
+		}
+	}
+
+	return updated, nil
+}
@@ -429,3 +429,69 @@ func TestUpdateSegmentPieces(t *testing.T) {
 		})
 	})
 }
+
+func TestUpdateSegmentsPieces(t *testing.T) {
+	metabasetest.Run(t, func(ctx *testcontext.Context, t *testing.T, db *metabase.DB) {
+		obj := metabasetest.RandObjectStream()
+
+		t.Run("update several segments", func(t *testing.T) {
+			defer metabasetest.DeleteAll{}.Check(ctx, t, db)
+
+			object := metabasetest.CreateObject(ctx, t, db, obj, 3)
+
+			segments, err := db.GetSegmentsByPositions(ctx, metabase.GetSegmentsByPositions{
+				Segments: []metabase.GetSegmentByPosition{
+					{StreamID: object.StreamID, Position: metabase.SegmentPosition{Index: 0}},
+					{StreamID: object.StreamID, Position: metabase.SegmentPosition{Index: 2}},
+					{StreamID: testrand.UUID(), Position: metabase.SegmentPosition{Index: 0}},
+				},
+			})
+			require.NoError(t, err)
+			require.Len(t, segments, 2)
+
+			newPieces := metabase.Pieces{{
+				Number:      1,
+				StorageNode: testrand.NodeID(),
+			}}
+
+			updates := make([]metabase.UpdateSegmentPieces, 0, len(segments))
+			for _, segment := range segments {
+				updates = append(updates, metabase.UpdateSegmentPieces{
+					StreamID:      segment.StreamID,
+					Position:      segment.Position,
+					OldPieces:     segment.Pieces,
+					NewRedundancy: segment.Redundancy,
+					NewPieces:     newPieces,
+				})
+			}
+			// the old pieces of the second segment don't match anymore.
+			updates[1].OldPieces = metabase.Pieces{{
+				Number:      3,
+				StorageNode: testrand.NodeID(),
+			}}
+
+			updated, err := db.UpdateSegmentsPieces(ctx, metabase.UpdateSegmentsPieces{Segments: updates})
+			require.NoError(t, err)
+			require.Equal(t, []bool{true, false}, updated)
+
+			segment, err := db.GetSegmentByPosition(ctx, metabase.GetSegmentByPosition{
+				StreamID: segments[0].StreamID,
+				Position: segments[0].Position,
+			})
+			require.NoError(t, err)
+			require.Equal(t, newPieces, segment.Pieces)
+
+			segment, err = db.GetSegmentByPosition(ctx, metabase.GetSegmentByPosition{
+				StreamID: segments[1].StreamID,
+				Position: segments[1].Position,
+			})
+			require.NoError(t, err)
+			require.Equal(t, segments[1].Pieces, segment.Pieces)
+
+			_, err = db.UpdateSegmentsPieces(ctx, metabase.UpdateSegmentsPieces{
+				Segments: []metabase.UpdateSegmentPieces{updates[0], updates[0]},
+			})
+			require.True(t, metabase.ErrInvalidRequest.Has(err))
+		})
+	})
+}
@@ -26,6 +26,7 @@ type Config struct {
 	Interval    time.Duration `help:"the time between each attempt to go through the db and clean up zombie objects" releaseDefault:"12h" devDefault:"10s"`
 	Enabled     bool          `help:"set if zombie object cleanup is enabled or not" releaseDefault:"false" devDefault:"true"`
 	ListLimit   int           `help:"how many objects to query in a batch" default:"100"`
+	Concurrency int           `help:"how many project id ranges to clean up in parallel" default:"4"`
 	InactiveFor time.Duration `help:"after what time object will be deleted if there where no new upload activity" default:"24h"`
 }
 
@@ -83,5 +84,6 @@ func (chore *Chore) deleteZombieObjects(ctx context.Context) (err error) {
 		DeadlineBefore:   chore.nowFn(),
 		InactiveDeadline: chore.nowFn().Add(-chore.config.InactiveFor),
 		BatchSize:        chore.config.ListLimit,
+		Concurrency:      chore.config.Concurrency,
 	})
 }
@@ -4,6 +4,7 @@
 package metainfo
 
 import (
+	"bytes"
 	"context"
 
 	"github.com/zeebo/errs"
@@ -24,7 +25,14 @@ func (endpoint *Endpoint) Batch(ctx context.Context, req *pb.BatchRequest) (resp
 	var lastStreamID storj.StreamID
 	var lastSegmentID storj.SegmentID
 	var prevSegmentReq *pb.BatchRequestItem
+	// skipUntil is the index of the last request already handled together
+	// with a previous one.
+	skipUntil := -1
 	for i, request := range req.Requests {
+		if i <= skipUntil {
+			continue
+		}
+
 		switch singleRequest := request.Request.(type) {
 		// BUCKET
 		case *pb.BatchRequestItem_BucketCreate:
@@ -197,6 +205,30 @@ func (endpoint *Endpoint) Batch(ctx context.Context, req *pb.BatchRequest) (resp
 				singleRequest.SegmentBegin.StreamId = lastStreamID
 			}
 
+			// consecutive segment begins of the same stream are handled
+			// together to do authorization and metabase checks only once.
+			segmentBegins := endpoint.collectSegmentBegins(singleRequest.SegmentBegin, req.Requests[i+1:])
+			if len(segmentBegins) > 1 {
+				for _, segmentBegin := range segmentBegins[1:] {
+					segmentBegin.Header = req.Header
+				}
+				skipUntil = i + len(segmentBegins) - 1
+
+				responses, err := endpoint.BeginSegments(ctx, segmentBegins)
+				if err != nil {
+					return resp, err
+				}
+				for _, response := range responses {
+					resp.Responses = append(resp.Responses, &pb.BatchResponseItem{
+						Response: &pb.BatchResponseItem_SegmentBegin{
+							SegmentBegin: response,
+						},
+					})
+					lastSegmentID = response.SegmentId
+				}
+				continue
+			}
+
 			response, err := endpoint.BeginSegment(ctx, singleRequest.SegmentBegin)
 			if err != nil {
 				return resp, err
@@ -366,3 +398,21 @@ func (endpoint *Endpoint) shouldCombine(segmentIndex int32, reqIndex int, reques
 	}
 	return false
 }
+
+// collectSegmentBegins returns first together with the segment begin
+// requests which directly follow it in requests and belong to the same
+// stream.
+func (endpoint *Endpoint) collectSegmentBegins(first *pb.SegmentBeginRequest, requests []*pb.BatchRequestItem) []*pb.SegmentBeginRequest {
+	segmentBegins := []*pb.SegmentBeginRequest{first}
+	for _, request := range requests {
+		segmentBegin := request.GetSegmentBegin()
+		if segmentBegin == nil {
+			break
+		}
+		if !segmentBegin.StreamId.IsZero() && !bytes.Equal(segmentBegin.StreamId, first.StreamId) {
+			break
+		}
+		segmentBegins = append(segmentBegins, segmentBegin)
+	}
+	return segmentBegins
+}
@@ -120,4 +120,7 @@ type Config struct {
 	RateLimiter                 RateLimiterConfig    `help:"rate limiter configuration"`
 	ProjectLimits               ProjectLimitConfig   `help:"project limit configuration"`
 	PieceDeletion               piecedeletion.Config `help:"piece deletion configuration"`
+	DownloadPrefetchSegments    int                  `default:"1" help:"number of segments, from the start of the requested range, for which an object download returns order limits up front"`
+	DeleteBucketConcurrency     int                  `default:"4" help:"number of object key ranges deleted in parallel when a bucket is deleted with its objects"`
+	DeleteBucketPiecesQueue     int                  `default:"16" help:"number of deleted batches which can wait for piece deletion when a bucket is deleted with its objects"`
 }
@@ -10,6 +10,7 @@ import (
 
 	"github.com/stretchr/testify/assert"
 	"github.com/stretchr/testify/require"
+	"go.uber.org/zap"
 
 	"storj.io/common/errs2"
 	"storj.io/common/memory"
@@ -20,6 +21,7 @@ import (
 	"storj.io/common/testcontext"
 	"storj.io/common/testrand"
 	"storj.io/storj/private/testplanet"
+	"storj.io/storj/satellite"
 	"storj.io/storj/satellite/metabase"
 	"storj.io/uplink"
 	"storj.io/uplink/private/metaclient"
@@ -623,3 +625,140 @@ func TestEndpoint_UpdateObjectMetadata(t *testing.T) {
 		assert.Equal(t, testEncryptedMetadataNonce[:], objects[0].EncryptedMetadataNonce)
 	})
 }
+
+func TestEndpoint_BeginSegments(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		apiKey := planet.Uplinks[0].APIKey[planet.Satellites[0].ID()]
+		endpoint := planet.Satellites[0].Metainfo.Endpoint
+
+		err := planet.Uplinks[0].CreateBucket(ctx, planet.Satellites[0], "testbucket")
+		require.NoError(t, err)
+
+		metainfoClient, err := planet.Uplinks[0].DialMetainfo(ctx, planet.Satellites[0], apiKey)
+		require.NoError(t, err)
+		defer ctx.Check(metainfoClient.Close)
+
+		beginObject := func(key string) storj.StreamID {
+			response, err := metainfoClient.BeginObject(ctx, metaclient.BeginObjectParams{
+				Bucket:        []byte("testbucket"),
+				EncryptedPath: []byte(key),
+				EncryptionParameters: storj.EncryptionParameters{
+					CipherSuite: storj.EncAESGCM,
+					BlockSize:   256,
+				},
+			})
+			require.NoError(t, err)
+			return response.StreamID
+		}
+
+		header := &pb.RequestHeader{ApiKey: apiKey.SerializeRaw()}
+
+		t.Run("same stream", func(t *testing.T) {
+			streamID := beginObject("first-object")
+
+			const numOfSegments = 5
+			requests := make([]*pb.SegmentBeginRequest, numOfSegments)
+			for i := range requests {
+				requests[i] = &pb.SegmentBeginRequest{
+					Header:        header,
+					Position:      &pb.SegmentPosition{Index: int32(i)},
+					MaxOrderLimit: memory.MiB.Int64(),
+				}
+			}
+			// only the first request needs the stream ID.
+			requests[0].StreamId = streamID
+
+			responses, err := endpoint.BeginSegments(ctx, requests)
+			require.NoError(t, err)
+			require.Len(t, responses, numOfSegments)
+
+			pieceIDs := map[storj.PieceID]struct{}{}
+			for _, response := range responses {
+				require.NotEmpty(t, response.SegmentId)
+				require.Len(t, response.AddressedLimits, planet.Satellites[0].Config.Metainfo.RS.Total)
+
+				pieceIDs[response.AddressedLimits[0].Limit.PieceId] = struct{}{}
+			}
+			require.Len(t, pieceIDs, numOfSegments)
+		})
+
+		t.Run("different streams", func(t *testing.T) {
+			_, err := endpoint.BeginSegments(ctx, []*pb.SegmentBeginRequest{
+				{
+					Header:        header,
+					StreamId:      beginObject("second-object"),
+					Position:      &pb.SegmentPosition{Index: 0},
+					MaxOrderLimit: memory.MiB.Int64(),
+				},
+				{
+					Header:        header,
+					StreamId:      beginObject("third-object"),
+					Position:      &pb.SegmentPosition{Index: 1},
+					MaxOrderLimit: memory.MiB.Int64(),
+				},
+			})
+			require.Error(t, err)
+			require.True(t, errs2.IsRPC(err, rpcstatus.InvalidArgument))
+		})
+	})
+}
+
+func TestEndpoint_DownloadObject_PrefetchSegments(t *testing.T) {
+	const prefetch = 3
+
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
+		Reconfigure: testplanet.Reconfigure{
+			Satellite: testplanet.Combine(
+				testplanet.MaxSegmentSize(13*memory.KiB),
+				func(log *zap.Logger, index int, config *satellite.Config) {
+					config.Metainfo.DownloadPrefetchSegments = prefetch
+				},
+			),
+		},
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		apiKey := planet.Uplinks[0].APIKey[planet.Satellites[0].ID()]
+
+		// 5 segments
+		expectedData := testrand.Bytes(60 * memory.KiB)
+		err := planet.Uplinks[0].Upload(ctx, planet.Satellites[0], "testbucket", "object", expectedData)
+		require.NoError(t, err)
+
+		metainfoClient, err := planet.Uplinks[0].DialMetainfo(ctx, planet.Satellites[0], apiKey)
+		require.NoError(t, err)
+		defer ctx.Check(metainfoClient.Close)
+
+		objects, err := planet.Satellites[0].Metabase.DB.TestingAllCommittedObjects(ctx, planet.Uplinks[0].Projects[0].ID, "testbucket")
+		require.NoError(t, err)
+		require.Len(t, objects, 1)
+
+		download, err := metainfoClient.DownloadObject(ctx, metaclient.DownloadObjectParams{
+			Bucket:             []byte("testbucket"),
+			EncryptedObjectKey: []byte(objects[0].ObjectKey),
+		})
+		require.NoError(t, err)
+		require.Len(t, download.DownloadedSegments, prefetch)
+		for _, segment := range download.DownloadedSegments {
+			require.NotEmpty(t, segment.Limits)
+		}
+
+		// the window is limited by the requested range.
+		download, err = metainfoClient.DownloadObject(ctx, metaclient.DownloadObjectParams{
+			Bucket:             []byte("testbucket"),
+			EncryptedObjectKey: []byte(objects[0].ObjectKey),
+			Range: metaclient.StreamRange{
+				Mode:  metaclient.StreamRangeStartLimit,
+				Start: 0,
+				Limit: 20 * memory.KiB.Int64(),
+			},
+		})
+		require.NoError(t, err)
+		require.Len(t, download.DownloadedSegments, 2)
+
+		data, err := planet.Uplinks[0].Download(ctx, planet.Satellites[0], "testbucket", "object")
+		require.NoError(t, err)
+		require.Equal(t, expectedData, data)
+	})
+}
@@ -23,9 +23,10 @@ var (
 
 // Config contains configurable values for expired segment cleanup.
 type Config struct {
-	Interval  time.Duration `help:"the time between each attempt to go through the db and clean up expired segments" releaseDefault:"24h" devDefault:"10s" testDefault:"$TESTINTERVAL"`
-	Enabled   bool          `help:"set if expired segment cleanup is enabled or not" releaseDefault:"true" devDefault:"true"`
-	ListLimit int           `help:"how many expired objects to query in a batch" default:"100"`
+	Interval    time.Duration `help:"the time between each attempt to go through the db and clean up expired segments" releaseDefault:"24h" devDefault:"10s" testDefault:"$TESTINTERVAL"`
+	Enabled     bool          `help:"set if expired segment cleanup is enabled or not" releaseDefault:"true" devDefault:"true"`
+	ListLimit   int           `help:"how many expired objects to query in a batch" default:"100"`
+	Concurrency int           `help:"how many expiration time windows to clean up in parallel" default:"4"`
 }
 
 // Chore implements the expired segment cleanup chore.
@@ -83,6 +84,7 @@ func (chore *Chore) deleteExpiredObjects(ctx context.Context) (err error) {
 	err = chore.metabase.DeleteExpiredObjects(ctx, metabase.DeleteExpiredObjects{
 		ExpiredBefore: chore.nowFn(),
 		BatchSize:     chore.config.ListLimit,
+		Concurrency:   chore.config.Concurrency,
 	})
 	if err != nil {
 		chore.log.Error("deleting expired objects failed", zap.Error(err))
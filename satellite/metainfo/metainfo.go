@@ -4,6 +4,7 @@
 package metainfo
 
 import (
+	"bytes"
 	"context"
 	"crypto/sha256"
 	"fmt"
@@ -12,6 +13,7 @@ import (
 	"github.com/spacemonkeygo/monkit/v3"
 	"github.com/zeebo/errs"
 	"go.uber.org/zap"
+	"golang.org/x/sync/errgroup"
 
 	"storj.io/common/context2"
 	"storj.io/common/encryption"
@@ -439,15 +441,46 @@ func (endpoint *Endpoint) deleteBucketNotEmpty(ctx context.Context, projectID uu
 func (endpoint *Endpoint) deleteBucketObjects(ctx context.Context, projectID uuid.UUID, bucketName []byte) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	concurrency := endpoint.config.DeleteBucketConcurrency
+	if concurrency < 1 {
+		concurrency = 1
+	}
+
+	// the pieces are handed to the piece deletion service, which deletes them
+	// in the background, so neither the database deletes nor the request
+	// wait for the storage nodes. The workers only look up the nodes, and
+	// the queue bounds how far the database deletes can get ahead of them.
+	queue := make(chan []metabase.DeletedSegmentInfo, endpoint.config.DeleteBucketPiecesQueue)
+
+	var group errgroup.Group
+	for i := 0; i < concurrency; i++ {
+		group.Go(func() error {
+			for deleted := range queue {
+				endpoint.deleteSegmentPiecesAsync(ctx, deleted)
+			}
+			return nil
+		})
+	}
+
 	bucketLocation := metabase.BucketLocation{ProjectID: projectID, BucketName: string(bucketName)}
 	deletedObjects, err := endpoint.metabase.DeleteBucketObjects(ctx, metabase.DeleteBucketObjects{
-		Bucket: bucketLocation,
+		Bucket:      bucketLocation,
+		Concurrency: concurrency,
 		DeletePieces: func(ctx context.Context, deleted []metabase.DeletedSegmentInfo) error {
-			endpoint.deleteSegmentPieces(ctx, deleted)
-			return nil
+			// deleted is reused by the caller.
+			batch := append([]metabase.DeletedSegmentInfo(nil), deleted...)
+			select {
+			case queue <- batch:
+				return nil
+			case <-ctx.Done():
+				return ctx.Err()
+			}
 		},
 	})
 
+	close(queue)
+	_ = group.Wait()
+
 	return deletedObjects, Error.Wrap(err)
 }
 
@@ -968,7 +1001,7 @@ func (endpoint *Endpoint) DownloadObject(ctx context.Context, req *pb.ObjectDown
 		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
 	}
 
-	// get the download response for the first segment
+	// get the download responses for the first segments
 	downloadSegments, err := func() ([]*pb.SegmentDownloadResponse, error) {
 		if len(segments.Segments) == 0 {
 			return nil, nil
@@ -977,10 +1010,7 @@ func (endpoint *Endpoint) DownloadObject(ctx context.Context, req *pb.ObjectDown
 			return nil, nil
 		}
 
-		segment, err := endpoint.metabase.GetSegmentByPosition(ctx, metabase.GetSegmentByPosition{
-			StreamID: object.StreamID,
-			Position: segments.Segments[0].Position,
-		})
+		prefetched, err := endpoint.getDownloadSegments(ctx, object.StreamID, segments.Segments)
 		if err != nil {
 			// object was deleted between the steps
 			if storj.ErrObjectNotFound.Has(err) {
@@ -993,97 +1023,15 @@ func (endpoint *Endpoint) DownloadObject(ctx context.Context, req *pb.ObjectDown
 			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
 		}
 
-		downloadSizes := endpoint.calculateDownloadSizes(streamRange, segment, object.Encryption)
-
-		// Update the current bandwidth cache value incrementing the SegmentSize.
-		err = endpoint.projectUsage.UpdateProjectBandwidthUsage(ctx, keyInfo.ProjectID, downloadSizes.encryptedSize)
-		if err != nil {
-			// log it and continue. it's most likely our own fault that we couldn't
-			// track it, and the only thing that will be affected is our per-project
-			// bandwidth limits.
-			endpoint.log.Error("Could not track the new project's bandwidth usage", zap.Stringer("Project ID", keyInfo.ProjectID), zap.Error(err))
-		}
-
-		encryptedKeyNonce, err := storj.NonceFromBytes(segment.EncryptedKeyNonce)
-		if err != nil {
-			endpoint.log.Error("unable to get encryption key nonce from metadata", zap.Error(err))
-			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
-		}
-
-		if segment.Inline() {
-			err := endpoint.orders.UpdateGetInlineOrder(ctx, object.Location().Bucket(), downloadSizes.plainSize)
+		downloadSegments := make([]*pb.SegmentDownloadResponse, 0, len(prefetched))
+		for _, segment := range prefetched {
+			downloadSegment, err := endpoint.createDownloadSegmentResponse(ctx, keyInfo, object, streamRange, segment)
 			if err != nil {
-				endpoint.log.Error("internal", zap.Error(err))
-				return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
-			}
-			endpoint.log.Info("Inline Segment Download", zap.Stringer("Project ID", keyInfo.ProjectID), zap.String("operation", "get"), zap.String("type", "inline"))
-			mon.Meter("req_get_inline").Mark(1)
-
-			return []*pb.SegmentDownloadResponse{{
-				PlainOffset:         segment.PlainOffset,
-				PlainSize:           int64(segment.PlainSize),
-				SegmentSize:         int64(segment.EncryptedSize),
-				EncryptedInlineData: segment.InlineData,
-
-				EncryptedKeyNonce: encryptedKeyNonce,
-				EncryptedKey:      segment.EncryptedKey,
-
-				Position: &pb.SegmentPosition{
-					PartNumber: int32(segment.Position.Part),
-					Index:      int32(segment.Position.Index),
-				},
-			}}, nil
-		}
-
-		limits, privateKey, err := endpoint.orders.CreateGetOrderLimits(ctx, object.Location().Bucket(), segment, downloadSizes.orderLimit)
-		if err != nil {
-			if orders.ErrDownloadFailedNotEnoughPieces.Has(err) {
-				endpoint.log.Error("Unable to create order limits.",
-					zap.Stringer("Project ID", keyInfo.ProjectID),
-					zap.Stringer("API Key ID", keyInfo.ID),
-					zap.Error(err),
-				)
-			}
-			endpoint.log.Error("internal", zap.Error(err))
-			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
-		}
-
-		limits = sortLimits(limits, segment)
-
-		// workaround to avoid sending nil values on top level
-		for i := range limits {
-			if limits[i] == nil {
-				limits[i] = &pb.AddressedOrderLimit{}
+				return nil, err
 			}
+			downloadSegments = append(downloadSegments, downloadSegment)
 		}
-
-		endpoint.log.Info("Segment Download", zap.Stringer("Project ID", keyInfo.ProjectID), zap.String("operation", "get"), zap.String("type", "remote"))
-		mon.Meter("req_get_remote").Mark(1)
-
-		return []*pb.SegmentDownloadResponse{{
-			AddressedLimits: limits,
-			PrivateKey:      privateKey,
-			PlainOffset:     segment.PlainOffset,
-			PlainSize:       int64(segment.PlainSize),
-			SegmentSize:     int64(segment.EncryptedSize),
-
-			EncryptedKeyNonce: encryptedKeyNonce,
-			EncryptedKey:      segment.EncryptedKey,
-			RedundancyScheme: &pb.RedundancyScheme{
-				Type:             pb.RedundancyScheme_SchemeType(segment.Redundancy.Algorithm),
-				ErasureShareSize: segment.Redundancy.ShareSize,
-
-				MinReq:           int32(segment.Redundancy.RequiredShares),
-				RepairThreshold:  int32(segment.Redundancy.RepairShares),
-				SuccessThreshold: int32(segment.Redundancy.OptimalShares),
-				Total:            int32(segment.Redundancy.TotalShares),
-			},
-
-			Position: &pb.SegmentPosition{
-				PartNumber: int32(segment.Position.Part),
-				Index:      int32(segment.Position.Index),
-			},
-		}}, nil
+		return downloadSegments, nil
 	}()
 	if err != nil {
 		return nil, err
@@ -1109,9 +1057,9 @@ func (endpoint *Endpoint) DownloadObject(ctx context.Context, req *pb.ObjectDown
 	return &pb.ObjectDownloadResponse{
 		Object: protoObject,
 
-		// The RPC API allows for multiple segment download responses, but for now
-		// we return only one. This can be changed in the future if it seems useful
-		// to return more than one on the initial response.
+		// Contains the download responses for up to DownloadPrefetchSegments
+		// segments from the beginning of the requested range, so sequential
+		// reads don't need a DownloadSegment request for each of them.
 		SegmentDownload: downloadSegments,
 
 		// In the case where the client needs the segment list, it will contain
@@ -1121,6 +1069,160 @@ func (endpoint *Endpoint) DownloadObject(ctx context.Context, req *pb.ObjectDown
 	}, nil
 }
 
+// getDownloadSegments returns the first segments of positions, up to
+// DownloadPrefetchSegments of them.
+//
+// When more than one segment is requested they are read with a single
+// metabase query.
+func (endpoint *Endpoint) getDownloadSegments(ctx context.Context, streamID uuid.UUID, positions []metabase.SegmentPositionInfo) (_ []metabase.Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	window := endpoint.config.DownloadPrefetchSegments
+	if window > len(positions) {
+		window = len(positions)
+	}
+
+	if window <= 1 {
+		segment, err := endpoint.metabase.GetSegmentByPosition(ctx, metabase.GetSegmentByPosition{
+			StreamID: streamID,
+			Position: positions[0].Position,
+		})
+		if err != nil {
+			return nil, err
+		}
+		return []metabase.Segment{segment}, nil
+	}
+
+	// the listing cursor is exclusive, hence we start from the position
+	// right before the first one.
+	var cursor metabase.SegmentPosition
+	if first := positions[0].Position.Encode(); first > 0 {
+		cursor = metabase.SegmentPositionFromEncoded(first - 1)
+	}
+
+	result, err := endpoint.metabase.ListSegments(ctx, metabase.ListSegments{
+		StreamID: streamID,
+		Cursor:   cursor,
+		Limit:    window,
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	segments := make([]metabase.Segment, 0, window)
+	for i, segment := range result.Segments {
+		if i >= window || segment.Position != positions[i].Position {
+			break
+		}
+		segments = append(segments, segment)
+	}
+
+	if len(segments) == 0 {
+		// object was deleted between the steps
+		return nil, storj.ErrObjectNotFound.New("segment missing")
+	}
+
+	return segments, nil
+}
+
+// createDownloadSegmentResponse creates the download response, including the
+// order limits, for a segment of object.
+func (endpoint *Endpoint) createDownloadSegmentResponse(ctx context.Context, keyInfo *console.APIKeyInfo, object metabase.Object, streamRange *metabase.StreamRange, segment metabase.Segment) (_ *pb.SegmentDownloadResponse, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	downloadSizes := endpoint.calculateDownloadSizes(streamRange, segment, object.Encryption)
+
+	// Update the current bandwidth cache value incrementing the SegmentSize.
+	err = endpoint.projectUsage.UpdateProjectBandwidthUsage(ctx, keyInfo.ProjectID, downloadSizes.encryptedSize)
+	if err != nil {
+		// log it and continue. it's most likely our own fault that we couldn't
+		// track it, and the only thing that will be affected is our per-project
+		// bandwidth limits.
+		endpoint.log.Error("Could not track the new project's bandwidth usage", zap.Stringer("Project ID", keyInfo.ProjectID), zap.Error(err))
+	}
+
+	encryptedKeyNonce, err := storj.NonceFromBytes(segment.EncryptedKeyNonce)
+	if err != nil {
+		endpoint.log.Error("unable to get encryption key nonce from metadata", zap.Error(err))
+		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+	}
+
+	if segment.Inline() {
+		err := endpoint.orders.UpdateGetInlineOrder(ctx, object.Location().Bucket(), downloadSizes.plainSize)
+		if err != nil {
+			endpoint.log.Error("internal", zap.Error(err))
+			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+		}
+		endpoint.log.Info("Inline Segment Download", zap.Stringer("Project ID", keyInfo.ProjectID), zap.String("operation", "get"), zap.String("type", "inline"))
+		mon.Meter("req_get_inline").Mark(1)
+
+		return &pb.SegmentDownloadResponse{
+			PlainOffset:         segment.PlainOffset,
+			PlainSize:           int64(segment.PlainSize),
+			SegmentSize:         int64(segment.EncryptedSize),
+			EncryptedInlineData: segment.InlineData,
+
+			EncryptedKeyNonce: encryptedKeyNonce,
+			EncryptedKey:      segment.EncryptedKey,
+
+			Position: &pb.SegmentPosition{
+				PartNumber: int32(segment.Position.Part),
+				Index:      int32(segment.Position.Index),
+			},
+		}, nil
+	}
+
+	limits, privateKey, err := endpoint.orders.CreateGetOrderLimits(ctx, object.Location().Bucket(), segment, downloadSizes.orderLimit)
+	if err != nil {
+		if orders.ErrDownloadFailedNotEnoughPieces.Has(err) {
+			endpoint.log.Error("Unable to create order limits.",
+				zap.Stringer("Project ID", keyInfo.ProjectID),
+				zap.Stringer("API Key ID", keyInfo.ID),
+				zap.Error(err),
+			)
+		}
+		endpoint.log.Error("internal", zap.Error(err))
+		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+	}
+
+	limits = sortLimits(limits, segment)
+
+	// workaround to avoid sending nil values on top level
+	for i := range limits {
+		if limits[i] == nil {
+			limits[i] = &pb.AddressedOrderLimit{}
+		}
+	}
+
+	endpoint.log.Info("Segment Download", zap.Stringer("Project ID", keyInfo.ProjectID), zap.String("operation", "get"), zap.String("type", "remote"))
+	mon.Meter("req_get_remote").Mark(1)
+
+	return &pb.SegmentDownloadResponse{
+		AddressedLimits: limits,
+		PrivateKey:      privateKey,
+		PlainOffset:     segment.PlainOffset,
+		PlainSize:       int64(segment.PlainSize),
+		SegmentSize:     int64(segment.EncryptedSize),
+
+		EncryptedKeyNonce: encryptedKeyNonce,
+		EncryptedKey:      segment.EncryptedKey,
+		RedundancyScheme: &pb.RedundancyScheme{
+			Type:             pb.RedundancyScheme_SchemeType(segment.Redundancy.Algorithm),
+			ErasureShareSize: segment.Redundancy.ShareSize,
+
+			MinReq:           int32(segment.Redundancy.RequiredShares),
+			RepairThreshold:  int32(segment.Redundancy.RepairShares),
+			SuccessThreshold: int32(segment.Redundancy.OptimalShares),
+			Total:            int32(segment.Redundancy.TotalShares),
+		},
+
+		Position: &pb.SegmentPosition{
+			PartNumber: int32(segment.Position.Part),
+			Index:      int32(segment.Position.Index),
+		},
+	}, nil
+}
+
 type downloadSizes struct {
 	// amount of data that uplink eventually gets
 	plainSize int64
@@ -1696,12 +1798,54 @@ func (endpoint *Endpoint) BeginSegment(ctx context.Context, req *pb.SegmentBegin
 		endpoint.log.Warn("unable to collect uplink version", zap.Error(err))
 	}
 
-	streamID, err := endpoint.unmarshalSatStreamID(ctx, req.StreamId)
+	responses, err := endpoint.beginSegments(ctx, []*pb.SegmentBeginRequest{req})
+	if err != nil {
+		return nil, err
+	}
+	return responses[0], nil
+}
+
+// BeginSegments begins the upload of multiple segments of the same stream.
+//
+// The requests are authorized, checked against the project storage limit and
+// verified by the metabase only once for all the segments, so uploads of
+// large objects don't pay these costs for every segment. Requests without a
+// stream ID use the stream ID of the first request.
+func (endpoint *Endpoint) BeginSegments(ctx context.Context, reqs []*pb.SegmentBeginRequest) (resps []*pb.SegmentBeginResponse, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(reqs) == 0 {
+		return nil, rpcstatus.Error(rpcstatus.InvalidArgument, "no segments requested")
+	}
+
+	err = endpoint.versionCollector.collect(reqs[0].Header.UserAgent, mon.Func().ShortName())
+	if err != nil {
+		endpoint.log.Warn("unable to collect uplink version", zap.Error(err))
+	}
+
+	return endpoint.beginSegments(ctx, reqs)
+}
+
+// beginSegments begins the upload of all the segments requested by reqs,
+// which must belong to the same stream.
+func (endpoint *Endpoint) beginSegments(ctx context.Context, reqs []*pb.SegmentBeginRequest) (resps []*pb.SegmentBeginResponse, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	first := reqs[0]
+	for _, req := range reqs[1:] {
+		if req.StreamId.IsZero() {
+			req.StreamId = first.StreamId
+		} else if !bytes.Equal(req.StreamId, first.StreamId) {
+			return nil, rpcstatus.Error(rpcstatus.InvalidArgument, "all segments must belong to the same stream")
+		}
+	}
+
+	streamID, err := endpoint.unmarshalSatStreamID(ctx, first.StreamId)
 	if err != nil {
 		return nil, rpcstatus.Error(rpcstatus.InvalidArgument, err.Error())
 	}
 
-	keyInfo, err := endpoint.validateAuth(ctx, req.Header, macaroon.Action{
+	keyInfo, err := endpoint.validateAuth(ctx, first.Header, macaroon.Action{
 		Op:            macaroon.ActionWrite,
 		Bucket:        streamID.Bucket,
 		EncryptedPath: streamID.EncryptedPath,
@@ -1713,8 +1857,10 @@ func (endpoint *Endpoint) BeginSegment(ctx context.Context, req *pb.SegmentBegin
 
 	// no need to validate streamID fields because it was validated during BeginObject
 
-	if req.Position.Index < 0 {
-		return nil, rpcstatus.Error(rpcstatus.InvalidArgument, "segment index must be greater then 0")
+	for _, req := range reqs {
+		if req.Position.Index < 0 {
+			return nil, rpcstatus.Error(rpcstatus.InvalidArgument, "segment index must be greater then 0")
+		}
 	}
 
 	if err := endpoint.checkExceedsStorageUsage(ctx, keyInfo.ProjectID); err != nil {
@@ -1726,38 +1872,63 @@ func (endpoint *Endpoint) BeginSegment(ctx context.Context, req *pb.SegmentBegin
 		return nil, rpcstatus.Error(rpcstatus.InvalidArgument, err.Error())
 	}
 
-	maxPieceSize := eestream.CalcPieceSize(req.MaxOrderLimit, redundancy)
-
-	request := overlay.FindStorageNodesRequest{
-		RequestedCount: redundancy.TotalCount(),
-	}
-	nodes, err := endpoint.overlay.FindStorageNodesForUpload(ctx, request)
+	id, err := uuid.FromBytes(streamID.StreamId)
 	if err != nil {
 		endpoint.log.Error("internal", zap.Error(err))
 		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
 	}
 
 	bucket := metabase.BucketLocation{ProjectID: keyInfo.ProjectID, BucketName: string(streamID.Bucket)}
-	rootPieceID, addressedLimits, piecePrivateKey, err := endpoint.orders.CreatePutOrderLimits(ctx, bucket, nodes, streamID.ExpirationDate, maxPieceSize)
-	if err != nil {
-		endpoint.log.Error("internal", zap.Error(err))
-		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
-	}
 
-	id, err := uuid.FromBytes(streamID.StreamId)
-	if err != nil {
-		endpoint.log.Error("internal", zap.Error(err))
-		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+	type segmentLimits struct {
+		rootPieceID     storj.PieceID
+		addressedLimits []*pb.AddressedOrderLimit
+		piecePrivateKey storj.PiecePrivateKey
 	}
+	limits := make([]segmentLimits, len(reqs))
+	segments := make([]metabase.BeginSegmentsItem, len(reqs))
 
-	pieces := metabase.Pieces{}
-	for i, limit := range addressedLimits {
-		pieces = append(pieces, metabase.Piece{
-			Number:      uint16(i),
-			StorageNode: limit.Limit.StorageNodeId,
-		})
+	for i, req := range reqs {
+		maxPieceSize := eestream.CalcPieceSize(req.MaxOrderLimit, redundancy)
+
+		request := overlay.FindStorageNodesRequest{
+			RequestedCount: redundancy.TotalCount(),
+		}
+		nodes, err := endpoint.overlay.FindStorageNodesForUpload(ctx, request)
+		if err != nil {
+			endpoint.log.Error("internal", zap.Error(err))
+			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+		}
+
+		rootPieceID, addressedLimits, piecePrivateKey, err := endpoint.orders.CreatePutOrderLimits(ctx, bucket, nodes, streamID.ExpirationDate, maxPieceSize)
+		if err != nil {
+			endpoint.log.Error("internal", zap.Error(err))
+			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+		}
+		limits[i] = segmentLimits{
+			rootPieceID:     rootPieceID,
+			addressedLimits: addressedLimits,
+			piecePrivateKey: piecePrivateKey,
+		}
+
+		pieces := metabase.Pieces{}
+		for i, limit := range addressedLimits {
+			pieces = append(pieces, metabase.Piece{
+				Number:      uint16(i),
+				StorageNode: limit.Limit.StorageNodeId,
+			})
+		}
+		segments[i] = metabase.BeginSegmentsItem{
+			Position: metabase.SegmentPosition{
+				Part:  uint32(req.Position.PartNumber),
+				Index: uint32(req.Position.Index),
+			},
+			RootPieceID: rootPieceID,
+			Pieces:      pieces,
+		}
 	}
-	err = endpoint.metabase.BeginSegment(ctx, metabase.BeginSegment{
+
+	err = endpoint.metabase.BeginSegments(ctx, metabase.BeginSegments{
 		ObjectStream: metabase.ObjectStream{
 			ProjectID:  keyInfo.ProjectID,
 			BucketName: string(streamID.Bucket),
@@ -1765,36 +1936,40 @@ func (endpoint *Endpoint) BeginSegment(ctx context.Context, req *pb.SegmentBegin
 			StreamID:   id,
 			Version:    1,
 		},
-		Position: metabase.SegmentPosition{
-			Part:  uint32(req.Position.PartNumber),
-			Index: uint32(req.Position.Index),
-		},
-		RootPieceID: rootPieceID,
-		Pieces:      pieces,
+		Segments: segments,
 	})
 	if err != nil {
 		endpoint.log.Error("internal", zap.Error(err))
 		return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
 	}
 
-	segmentID, err := endpoint.packSegmentID(ctx, &internalpb.SegmentID{
-		StreamId:            streamID,
-		PartNumber:          req.Position.PartNumber,
-		Index:               req.Position.Index,
-		OriginalOrderLimits: addressedLimits,
-		RootPieceId:         rootPieceID,
-		CreationDate:        time.Now(),
-	})
+	resps = make([]*pb.SegmentBeginResponse, 0, len(reqs))
+	for i, req := range reqs {
+		segmentID, err := endpoint.packSegmentID(ctx, &internalpb.SegmentID{
+			StreamId:            streamID,
+			PartNumber:          req.Position.PartNumber,
+			Index:               req.Position.Index,
+			OriginalOrderLimits: limits[i].addressedLimits,
+			RootPieceId:         limits[i].rootPieceID,
+			CreationDate:        time.Now(),
+		})
+		if err != nil {
+			endpoint.log.Error("internal", zap.Error(err))
+			return nil, rpcstatus.Error(rpcstatus.Internal, err.Error())
+		}
 
-	endpoint.log.Info("Segment Upload", zap.Stringer("Project ID", keyInfo.ProjectID), zap.String("operation", "put"), zap.String("type", "remote"))
-	mon.Meter("req_put_remote").Mark(1)
+		resps = append(resps, &pb.SegmentBeginResponse{
+			SegmentId:        segmentID,
+			AddressedLimits:  limits[i].addressedLimits,
+			PrivateKey:       limits[i].piecePrivateKey,
+			RedundancyScheme: endpoint.defaultRS,
+		})
+	}
 
-	return &pb.SegmentBeginResponse{
-		SegmentId:        segmentID,
-		AddressedLimits:  addressedLimits,
-		PrivateKey:       piecePrivateKey,
-		RedundancyScheme: endpoint.defaultRS,
-	}, nil
+	endpoint.log.Info("Segment Upload", zap.Stringer("Project ID", keyInfo.ProjectID), zap.String("operation", "put"), zap.String("type", "remote"), zap.Int("segments", len(reqs)))
+	mon.Meter("req_put_remote").Mark(len(reqs))
+
+	return resps, nil
 }
 
 // CommitSegment commits segment after uploading.
@@ -2581,6 +2756,25 @@ func (endpoint *Endpoint) deleteObjectsPieces(ctx context.Context, result metaba
 }
 
 func (endpoint *Endpoint) deleteSegmentPieces(ctx context.Context, segments []metabase.DeletedSegmentInfo) {
+	// Only return an error if we failed to delete the objects. If we failed
+	// to delete pieces, let garbage collector take care of it.
+	if err := endpoint.deletePieces.Delete(ctx, segmentPiecesRequests(segments), deleteObjectPiecesSuccessThreshold); err != nil {
+		endpoint.log.Error("failed to delete pieces", zap.Error(err))
+	}
+}
+
+// deleteSegmentPiecesAsync hands the pieces of the segments to the piece
+// deletion service, without waiting for the storage nodes.
+func (endpoint *Endpoint) deleteSegmentPiecesAsync(ctx context.Context, segments []metabase.DeletedSegmentInfo) {
+	// pieces which couldn't be queued are left to the garbage collector.
+	if err := endpoint.deletePieces.DeleteAsync(ctx, segmentPiecesRequests(segments)); err != nil {
+		endpoint.log.Error("failed to delete pieces", zap.Error(err))
+	}
+}
+
+// segmentPiecesRequests groups the pieces of the segments into a piece
+// deletion request per node.
+func segmentPiecesRequests(segments []metabase.DeletedSegmentInfo) []piecedeletion.Request {
 	nodesPieces := groupPiecesByNodeID(segments)
 
 	var requests []piecedeletion.Request
@@ -2592,12 +2786,7 @@ func (endpoint *Endpoint) deleteSegmentPieces(ctx context.Context, segments []me
 			Pieces: pieces,
 		})
 	}
-
-	// Only return an error if we failed to delete the objects. If we failed
-	// to delete pieces, let garbage collector take care of it.
-	if err := endpoint.deletePieces.Delete(ctx, requests, deleteObjectPiecesSuccessThreshold); err != nil {
-		endpoint.log.Error("failed to delete pieces", zap.Error(err))
-	}
+	return requests
 }
 
 func (endpoint *Endpoint) objectToProto(ctx context.Context, object metabase.Object, rs *pb.RedundancyScheme) (*pb.Object, error) {
@@ -1227,6 +1227,107 @@ func TestBatch(t *testing.T) {
 	})
 }
 
+func TestBatchBeginSegments(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		apiKey := planet.Uplinks[0].APIKey[planet.Satellites[0].ID()]
+
+		err := planet.Uplinks[0].CreateBucket(ctx, planet.Satellites[0], "testbucket")
+		require.NoError(t, err)
+
+		metainfoClient, err := planet.Uplinks[0].DialMetainfo(ctx, planet.Satellites[0], apiKey)
+		require.NoError(t, err)
+		defer ctx.Check(metainfoClient.Close)
+
+		beginObjectResponse, err := metainfoClient.BeginObject(ctx, metaclient.BeginObjectParams{
+			Bucket:        []byte("testbucket"),
+			EncryptedPath: []byte("encrypted-path"),
+			Redundancy: storj.RedundancyScheme{
+				Algorithm:      storj.ReedSolomon,
+				ShareSize:      256,
+				RequiredShares: 1,
+				RepairShares:   1,
+				OptimalShares:  3,
+				TotalShares:    4,
+			},
+			EncryptionParameters: storj.EncryptionParameters{
+				CipherSuite: storj.EncAESGCM,
+				BlockSize:   256,
+			},
+		})
+		require.NoError(t, err)
+
+		// the segment committed in the batch is begun beforehand, so that the
+		// piece hashes can be signed.
+		beginSegmentResponse, err := metainfoClient.BeginSegment(ctx, metaclient.BeginSegmentParams{
+			StreamID:      beginObjectResponse.StreamID,
+			Position:      storj.SegmentPosition{Index: 2},
+			MaxOrderLimit: memory.MiB.Int64(),
+		})
+		require.NoError(t, err)
+
+		fullIDMap := make(map[storj.NodeID]*identity.FullIdentity)
+		for _, node := range planet.StorageNodes {
+			fullIDMap[node.ID()] = node.Identity
+		}
+
+		var uploadResults []*pb.SegmentPieceUploadResult
+		for num := int32(0); num < 3; num++ {
+			limit := beginSegmentResponse.Limits[num].Limit
+			signer := signing.SignerFromFullIdentity(fullIDMap[limit.StorageNodeId])
+			signedHash, err := signing.SignPieceHash(ctx, signer, &pb.PieceHash{
+				PieceId:   limit.PieceId,
+				PieceSize: 1048832,
+				Timestamp: time.Now(),
+			})
+			require.NoError(t, err)
+
+			uploadResults = append(uploadResults, &pb.SegmentPieceUploadResult{
+				PieceNum: num,
+				NodeId:   limit.StorageNodeId,
+				Hash:     signedHash,
+			})
+		}
+
+		// the two segment begins are handled together, which must not skip
+		// the request after them.
+		responses, err := metainfoClient.Batch(ctx,
+			&metaclient.BeginSegmentParams{
+				StreamID:      beginObjectResponse.StreamID,
+				Position:      storj.SegmentPosition{Index: 0},
+				MaxOrderLimit: memory.MiB.Int64(),
+			},
+			&metaclient.BeginSegmentParams{
+				StreamID:      beginObjectResponse.StreamID,
+				Position:      storj.SegmentPosition{Index: 1},
+				MaxOrderLimit: memory.MiB.Int64(),
+			},
+			&metaclient.CommitSegmentParams{
+				SegmentID: beginSegmentResponse.SegmentID,
+				Encryption: storj.SegmentEncryption{
+					EncryptedKey: testrand.Bytes(256),
+				},
+				PlainSize:         5000,
+				SizeEncryptedData: memory.MiB.Int64(),
+				UploadResult:      uploadResults,
+			},
+		)
+		require.NoError(t, err)
+		require.Len(t, responses, 3)
+
+		for _, response := range responses[:2] {
+			_, err := response.BeginSegment()
+			require.NoError(t, err)
+		}
+
+		segments, err := planet.Satellites[0].Metabase.DB.TestingAllSegments(ctx)
+		require.NoError(t, err)
+		require.Len(t, segments, 1)
+		require.Equal(t, uint32(2), segments[0].Position.Index)
+	})
+}
+
 func TestRateLimit(t *testing.T) {
 	rateLimit := 2
 	testplanet.Run(t, testplanet.Config{
@@ -0,0 +1,274 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package piecedeletion
+
+import (
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+
+	"github.com/zeebo/errs"
+	"go.uber.org/zap"
+
+	"storj.io/common/storj"
+)
+
+// backlogFileExt is the extension of the files containing the pieces of a
+// node which are persisted to disk.
+const backlogFileExt = ".pieces"
+
+// Backlog keeps the pieces which couldn't be deleted from a node, so they can
+// be deleted later, in large batches, when the node is reachable again.
+//
+// Pieces are kept in memory up to maxMemoryPieces, the pieces of the node with
+// the largest backlog are moved to dir when the limit is exceeded and when
+// the backlog is closed. Pieces are dropped, and left to the garbage
+// collection, when dir isn't set or the disk limit is exceeded.
+type Backlog struct {
+	log             *zap.Logger
+	dir             string
+	maxMemoryPieces int
+	maxDiskSize     int64
+
+	mu          sync.Mutex
+	memory      map[storj.NodeID][]storj.PieceID
+	memoryCount int
+	disk        map[storj.NodeID]int64
+	diskSize    int64
+}
+
+// NewBacklog creates a new backlog, loading the list of nodes which have
+// pieces persisted in dir.
+func NewBacklog(log *zap.Logger, dir string, maxMemoryPieces int, maxDiskSize int64) (*Backlog, error) {
+	backlog := &Backlog{
+		log:             log,
+		dir:             dir,
+		maxMemoryPieces: maxMemoryPieces,
+		maxDiskSize:     maxDiskSize,
+		memory:          map[storj.NodeID][]storj.PieceID{},
+		disk:            map[storj.NodeID]int64{},
+	}
+
+	if dir == "" {
+		return backlog, nil
+	}
+
+	if err := os.MkdirAll(dir, 0700); err != nil {
+		return nil, Error.Wrap(err)
+	}
+
+	entries, err := ioutil.ReadDir(dir)
+	if err != nil {
+		return nil, Error.Wrap(err)
+	}
+	for _, info := range entries {
+		name := info.Name()
+		if info.IsDir() || !strings.HasSuffix(name, backlogFileExt) {
+			continue
+		}
+
+		nodeID, err := storj.NodeIDFromString(strings.TrimSuffix(name, backlogFileExt))
+		if err != nil {
+			log.Warn("unexpected file in piece deletion backlog", zap.String("name", name))
+			continue
+		}
+
+		size := info.Size() - info.Size()%int64(len(storj.PieceID{}))
+		backlog.disk[nodeID] = size
+		backlog.diskSize += size
+	}
+
+	return backlog, nil
+}
+
+// Add adds pieces to the backlog of the node.
+func (backlog *Backlog) Add(nodeID storj.NodeID, pieces []storj.PieceID) {
+	if len(pieces) == 0 {
+		return
+	}
+
+	backlog.mu.Lock()
+	defer backlog.mu.Unlock()
+
+	backlog.memory[nodeID] = append(backlog.memory[nodeID], pieces...)
+	backlog.memoryCount += len(pieces)
+
+	mon.Counter("piece_deletion_backlog_added").Inc(int64(len(pieces)))
+
+	for backlog.memoryCount > backlog.maxMemoryPieces && len(backlog.memory) > 0 {
+		backlog.spillLargest()
+	}
+}
+
+// Take removes and returns all the pieces of the node.
+func (backlog *Backlog) Take(nodeID storj.NodeID) (_ []storj.PieceID, err error) {
+	backlog.mu.Lock()
+	defer backlog.mu.Unlock()
+
+	pieces := backlog.memory[nodeID]
+	delete(backlog.memory, nodeID)
+	backlog.memoryCount -= len(pieces)
+
+	if size, ok := backlog.disk[nodeID]; ok {
+		path := backlog.path(nodeID)
+
+		data, err := ioutil.ReadFile(path)
+		if err != nil {
+			return pieces, Error.Wrap(err)
+		}
+		if err := os.Remove(path); err != nil {
+			return pieces, Error.Wrap(err)
+		}
+
+		delete(backlog.disk, nodeID)
+		backlog.diskSize -= size
+
+		for len(data) >= len(storj.PieceID{}) {
+			var pieceID storj.PieceID
+			copy(pieceID[:], data)
+			pieces = append(pieces, pieceID)
+			data = data[len(pieceID):]
+		}
+	}
+
+	return pieces, nil
+}
+
+// Nodes returns the nodes which have pieces in the backlog.
+func (backlog *Backlog) Nodes() storj.NodeIDList {
+	backlog.mu.Lock()
+	defer backlog.mu.Unlock()
+
+	nodes := make(storj.NodeIDList, 0, len(backlog.memory)+len(backlog.disk))
+	for nodeID := range backlog.memory {
+		nodes = append(nodes, nodeID)
+	}
+	for nodeID := range backlog.disk {
+		if _, ok := backlog.memory[nodeID]; !ok {
+			nodes = append(nodes, nodeID)
+		}
+	}
+	return nodes
+}
+
+// Count returns the number of pieces in the backlog.
+func (backlog *Backlog) Count() int {
+	backlog.mu.Lock()
+	defer backlog.mu.Unlock()
+
+	return backlog.memoryCount + int(backlog.diskSize/int64(len(storj.PieceID{})))
+}
+
+// Close persists the pieces which are in memory.
+func (backlog *Backlog) Close() error {
+	backlog.mu.Lock()
+	defer backlog.mu.Unlock()
+
+	var group errs.Group
+	nodes := make([]storj.NodeID, 0, len(backlog.memory))
+	for nodeID := range backlog.memory {
+		nodes = append(nodes, nodeID)
+	}
+	// persist the largest backlogs first, in case the disk limit is reached.
+	sort.Slice(nodes, func(i, k int) bool {
+		return len(backlog.memory[nodes[i]]) > len(backlog.memory[nodes[k]])
+	})
+	for _, nodeID := range nodes {
+		group.Add(backlog.spill(nodeID))
+	}
+	return group.Err()
+}
+
+// spillLargest moves the pieces of the node with the largest backlog in
+// memory to the disk.
+func (backlog *Backlog) spillLargest() {
+	var largest storj.NodeID
+	var largestCount int
+	for nodeID, pieces := range backlog.memory {
+		if len(pieces) > largestCount {
+			largest, largestCount = nodeID, len(pieces)
+		}
+	}
+
+	if err := backlog.spill(largest); err != nil {
+		backlog.log.Warn("unable to persist piece deletion backlog", zap.Stringer("Node ID", largest), zap.Error(err))
+	}
+}
+
+// spill moves the pieces of the node from memory to the disk, it drops the
+// pieces which don't fit.
+func (backlog *Backlog) spill(nodeID storj.NodeID) (err error) {
+	pieces := backlog.memory[nodeID]
+	delete(backlog.memory, nodeID)
+	backlog.memoryCount -= len(pieces)
+
+	if backlog.dir == "" {
+		mon.Counter("piece_deletion_backlog_dropped").Inc(int64(len(pieces)))
+		return nil
+	}
+
+	available := (backlog.maxDiskSize - backlog.diskSize) / int64(len(storj.PieceID{}))
+	if available < int64(len(pieces)) {
+		if available < 0 {
+			available = 0
+		}
+		mon.Counter("piece_deletion_backlog_dropped").Inc(int64(len(pieces)) - available)
+		pieces = pieces[:available]
+	}
+	if len(pieces) == 0 {
+		return nil
+	}
+
+	data := make([]byte, 0, len(pieces)*len(storj.PieceID{}))
+	for _, pieceID := range pieces {
+		data = append(data, pieceID[:]...)
+	}
+
+	file, err := os.OpenFile(backlog.path(nodeID), os.O_CREATE|os.O_WRONLY|os.O_APPEND, 0600)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+	defer func() { err = errs.Combine(err, Error.Wrap(file.Close())) }()
+
+	n, err := file.Write(data)
+	written := int64(n) - int64(n)%int64(len(storj.PieceID{}))
+	if err != nil && written != int64(n) {
+		// drop the incomplete piece id, so the following appends stay aligned.
+		err = errs.Combine(err, file.Truncate(backlog.disk[nodeID]+written))
+	}
+	backlog.disk[nodeID] += written
+	backlog.diskSize += written
+
+	return Error.Wrap(err)
+}
+
+func (backlog *Backlog) path(nodeID storj.NodeID) string {
+	return filepath.Join(backlog.dir, nodeID.String()+backlogFileExt)
+}
+
+// backlogPromise adds the pieces of a job to the backlog when it fails.
+type backlogPromise struct {
+	backlog *Backlog
+	nodeID  storj.NodeID
+	pieces  []storj.PieceID
+	next    Promise
+}
+
+// Success is called when the job has been successfully handled.
+func (promise *backlogPromise) Success() {
+	if promise.next != nil {
+		promise.next.Success()
+	}
+}
+
+// Failure is called when the job didn't complete successfully.
+func (promise *backlogPromise) Failure() {
+	promise.backlog.Add(promise.nodeID, promise.pieces)
+	if promise.next != nil {
+		promise.next.Failure()
+	}
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package piecedeletion_test
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/storj"
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/satellite/metainfo/piecedeletion"
+)
+
+func TestBacklog(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	log := zaptest.NewLogger(t)
+	dir := ctx.Dir("backlog")
+
+	node1, node2 := testrand.NodeID(), testrand.NodeID()
+	pieces1 := randomPieces(10)
+	pieces2 := randomPieces(5)
+
+	backlog, err := piecedeletion.NewBacklog(log, dir, 12, 1<<20)
+	require.NoError(t, err)
+
+	backlog.Add(node1, pieces1[:4])
+	backlog.Add(node2, pieces2)
+	require.Equal(t, 9, backlog.Count())
+
+	// exceeding the memory limit moves the largest backlog to the disk.
+	backlog.Add(node1, pieces1[4:])
+	require.Equal(t, 15, backlog.Count())
+	require.ElementsMatch(t, []storj.NodeID{node1, node2}, backlog.Nodes())
+
+	taken, err := backlog.Take(node1)
+	require.NoError(t, err)
+	require.Equal(t, pieces1, taken)
+	require.Equal(t, 5, backlog.Count())
+
+	// closing persists the backlog, which is loaded again on open.
+	backlog.Add(node1, pieces1[:3])
+	require.NoError(t, backlog.Close())
+
+	backlog, err = piecedeletion.NewBacklog(log, dir, 12, 1<<20)
+	require.NoError(t, err)
+	require.Equal(t, 8, backlog.Count())
+	require.ElementsMatch(t, []storj.NodeID{node1, node2}, backlog.Nodes())
+
+	taken, err = backlog.Take(node1)
+	require.NoError(t, err)
+	require.Equal(t, pieces1[:3], taken)
+
+	taken, err = backlog.Take(node2)
+	require.NoError(t, err)
+	require.Equal(t, pieces2, taken)
+
+	require.Equal(t, 0, backlog.Count())
+	require.Empty(t, backlog.Nodes())
+}
+
+func TestBacklog_Limits(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	log := zaptest.NewLogger(t)
+	node := testrand.NodeID()
+	pieces := randomPieces(10)
+
+	{ // without a directory the pieces over the memory limit are dropped.
+		backlog, err := piecedeletion.NewBacklog(log, "", 5, 0)
+		require.NoError(t, err)
+
+		backlog.Add(node, pieces[:5])
+		require.Equal(t, 5, backlog.Count())
+
+		backlog.Add(node, pieces[5:])
+		require.Equal(t, 0, backlog.Count())
+		require.NoError(t, backlog.Close())
+	}
+
+	{ // the pieces over the disk limit are dropped.
+		backlog, err := piecedeletion.NewBacklog(log, ctx.Dir("limits"), 0, int64(3*len(storj.PieceID{})))
+		require.NoError(t, err)
+
+		backlog.Add(node, pieces)
+		require.Equal(t, 3, backlog.Count())
+
+		taken, err := backlog.Take(node)
+		require.NoError(t, err)
+		require.Equal(t, pieces[:3], taken)
+	}
+}
+
+func randomPieces(n int) []storj.PieceID {
+	pieces := make([]storj.PieceID, n)
+	for i := range pieces {
+		pieces[i] = testrand.PieceID()
+	}
+	return pieces
+}
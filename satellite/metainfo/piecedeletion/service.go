@@ -5,12 +5,14 @@ package piecedeletion
 
 import (
 	"context"
+	"sync/atomic"
 	"time"
 
 	"github.com/zeebo/errs"
 	"go.uber.org/zap"
 	"golang.org/x/sync/semaphore"
 
+	"storj.io/common/memory"
 	"storj.io/common/pb"
 	"storj.io/common/rpc"
 	"storj.io/common/storj"
@@ -28,6 +30,12 @@ type Config struct {
 	DialTimeout    time.Duration `help:"timeout for dialing nodes (0 means satellite default)" default:"0" testDefault:"2s"`
 	FailThreshold  time.Duration `help:"threshold for retrying a failed node" releaseDefault:"5m" devDefault:"2s"`
 	RequestTimeout time.Duration `help:"timeout for a single delete request" releaseDefault:"1m" devDefault:"2s"`
+
+	BacklogEnabled         bool          `help:"keep the pieces which couldn't be deleted and retry them when the node is reachable" releaseDefault:"true" devDefault:"false"`
+	BacklogInterval        time.Duration `help:"how often to retry deleting the pieces in the backlog" releaseDefault:"10m" devDefault:"10s"`
+	BacklogDir             string        `help:"directory for persisting the backlog; when empty the backlog is only kept in memory" default:""`
+	BacklogMaxMemoryPieces int           `help:"maximum number of backlog pieces kept in memory" default:"1000000"`
+	BacklogMaxDiskSize     memory.Size   `help:"maximum disk space used by the persisted backlog" default:"1GiB"`
 }
 
 const (
@@ -59,6 +67,9 @@ func (config *Config) Verify() errs.Group {
 	if config.RequestTimeout < minTimeout || maxTimeout < config.RequestTimeout {
 		errlist.Add(Error.New("request timeout %v should be between %v and %v", config.RequestTimeout, minTimeout, maxTimeout))
 	}
+	if config.BacklogEnabled && config.BacklogInterval <= 0 {
+		errlist.Add(Error.New("backlog interval %v must be greater than 0", config.BacklogInterval))
+	}
 	return errlist
 }
 
@@ -83,6 +94,10 @@ type Service struct {
 	combiner *Combiner
 	dialer   *Dialer
 	limited  *LimitedHandler
+
+	// backlog is nil when it's disabled.
+	backlog     *Backlog
+	backlogLoop *sync2.Cycle
 }
 
 // NewService creates a new service.
@@ -109,13 +124,24 @@ func NewService(log *zap.Logger, dialer rpc.Dialer, nodesDB Nodes, config Config
 		dialerClone.DialTimeout = config.DialTimeout
 	}
 
-	return &Service{
+	service := &Service{
 		log:                log,
 		config:             config,
 		concurrentRequests: semaphore.NewWeighted(int64(config.MaxConcurrentPieces)),
 		rpcDialer:          dialerClone,
 		nodesDB:            nodesDB,
-	}, nil
+	}
+
+	if config.BacklogEnabled {
+		backlog, err := NewBacklog(log.Named("backlog"), config.BacklogDir, config.BacklogMaxMemoryPieces, config.BacklogMaxDiskSize.Int64())
+		if err != nil {
+			return nil, err
+		}
+		service.backlog = backlog
+		service.backlogLoop = sync2.NewCycle(config.BacklogInterval)
+	}
+
+	return service, nil
 }
 
 // newQueue creates the configured queue.
@@ -123,25 +149,95 @@ func (service *Service) newQueue() Queue {
 	return NewLimitedJobs(service.config.MaxPiecesPerBatch)
 }
 
-// Run initializes the service.
+// Run initializes the service and retries the deletion of the pieces in the
+// backlog.
 func (service *Service) Run(ctx context.Context) error {
-	defer service.running.Release()
-
 	config := service.config
 	service.dialer = NewDialer(service.log.Named("dialer"), service.rpcDialer, config.RequestTimeout, config.FailThreshold, config.MaxPiecesPerRequest)
 	service.limited = NewLimitedHandler(service.dialer, config.MaxConcurrency)
 	service.combiner = NewCombiner(ctx, service.limited, service.newQueue)
+	service.running.Release()
 
-	return nil
+	if service.backlog == nil {
+		return nil
+	}
+
+	return service.backlogLoop.Run(ctx, func(ctx context.Context) error {
+		service.flushBacklog(ctx)
+		return nil
+	})
 }
 
 // Close shuts down the service.
 func (service *Service) Close() error {
+	if service.backlogLoop != nil {
+		service.backlogLoop.Close()
+	}
+
 	<-service.running.Done()
 	service.combiner.Close()
+
+	if service.backlog != nil {
+		return service.backlog.Close()
+	}
 	return nil
 }
 
+// flushBacklog sends the pieces in the backlog to the nodes which are
+// reachable. The pieces which fail again are put back to the backlog.
+func (service *Service) flushBacklog(ctx context.Context) {
+	defer mon.Task()(&ctx)(nil)
+
+	mon.IntVal("piece_deletion_backlog_count").Observe(int64(service.backlog.Count()))
+
+	nodeIDs := service.backlog.Nodes()
+	if len(nodeIDs) == 0 {
+		return
+	}
+
+	// offline and disqualified nodes are not returned, their pieces stay in
+	// the backlog until the node comes back or they are dropped by the limits.
+	nodes, err := service.nodesDB.KnownReliable(ctx, nodeIDs)
+	if err != nil {
+		service.log.Warn("unable to get nodes for the piece deletion backlog", zap.Error(err))
+		return
+	}
+
+	for _, node := range nodes {
+		nodeURL := storj.NodeURL{
+			ID:      node.Id,
+			Address: node.Address.Address,
+		}
+		if service.dialer.recentlyFailed(ctx, nodeURL) {
+			continue
+		}
+
+		pieces, err := service.backlog.Take(node.Id)
+		if err != nil {
+			service.log.Warn("unable to read the piece deletion backlog", zap.Stringer("Node ID", node.Id), zap.Error(err))
+		}
+
+		// split into batches, so a failure puts back only the pieces which
+		// weren't deleted.
+		for len(pieces) > 0 {
+			batch := pieces
+			if len(batch) > service.config.MaxPiecesPerBatch {
+				batch = batch[:service.config.MaxPiecesPerBatch]
+			}
+			pieces = pieces[len(batch):]
+
+			service.combiner.Enqueue(nodeURL, Job{
+				Pieces: batch,
+				Resolve: &backlogPromise{
+					backlog: service.backlog,
+					nodeID:  node.Id,
+					pieces:  batch,
+				},
+			})
+		}
+	}
+}
+
 // Delete deletes the pieces specified in the requests waiting until success threshold is reached.
 func (service *Service) Delete(ctx context.Context, requests []Request, successThreshold float64) (err error) {
 	defer mon.Task()(&ctx, len(requests), requestsPieceCount(requests), successThreshold)(&err)
@@ -150,14 +246,62 @@ func (service *Service) Delete(ctx context.Context, requests []Request, successT
 		return nil
 	}
 
+	nodesReqs, pieceCount, err := service.prepare(ctx, requests)
+	if err != nil {
+		return err
+	}
+	defer service.concurrentRequests.Release(int64(pieceCount))
+
+	threshold, err := sync2.NewSuccessThreshold(len(nodesReqs), successThreshold)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	service.enqueue(nodesReqs, threshold)
+
+	threshold.Wait(ctx)
+
+	return nil
+}
+
+// DeleteAsync deletes the pieces specified in the requests without waiting
+// for the storage nodes. It only waits for the nodes to be looked up, and
+// for the pieces which are being deleted to fall below the concurrency
+// limit.
+func (service *Service) DeleteAsync(ctx context.Context, requests []Request) (err error) {
+	defer mon.Task()(&ctx, len(requests), requestsPieceCount(requests))(&err)
+
+	if len(requests) == 0 {
+		return nil
+	}
+
+	nodesReqs, pieceCount, err := service.prepare(ctx, requests)
+	if err != nil {
+		return err
+	}
+
+	service.enqueue(nodesReqs, &releasePromise{
+		pending: int32(len(nodesReqs)),
+		release: func() {
+			service.concurrentRequests.Release(int64(pieceCount))
+		},
+	})
+
+	return nil
+}
+
+// prepare validates the requests, acquires the pieces from the concurrency
+// limit and looks up the addresses of the nodes. The caller must release
+// pieceCount from concurrentRequests, when err is nil.
+func (service *Service) prepare(ctx context.Context, requests []Request) (nodesReqs map[storj.NodeID]Request, pieceCount int, err error) {
 	// wait for combiner and dialer to set themselves up.
 	if !service.running.Wait(ctx) {
-		return Error.Wrap(ctx.Err())
+		return nil, 0, Error.Wrap(ctx.Err())
 	}
 
 	for i, req := range requests {
 		if !req.IsValid() {
-			return Error.New("request #%d is invalid", i)
+			return nil, 0, Error.New("request #%d is invalid", i)
 		}
 	}
 
@@ -169,13 +313,12 @@ func (service *Service) Delete(ctx context.Context, requests []Request, successT
 	}
 
 	if err := service.concurrentRequests.Acquire(ctx, int64(totalPieceCount)); err != nil {
-		return Error.Wrap(err)
+		return nil, 0, Error.Wrap(err)
 	}
-	defer service.concurrentRequests.Release(int64(totalPieceCount))
 
 	// Create a map for matching node information with the corresponding
 	// request.
-	nodesReqs := make(map[storj.NodeID]Request, len(requests))
+	nodesReqs = make(map[storj.NodeID]Request, len(requests))
 	nodeIDs := []storj.NodeID{}
 	for _, req := range requests {
 		if req.Node.Address == "" {
@@ -187,8 +330,9 @@ func (service *Service) Delete(ctx context.Context, requests []Request, successT
 	if len(nodeIDs) > 0 {
 		nodes, err := service.nodesDB.KnownReliable(ctx, nodeIDs)
 		if err != nil {
+			service.concurrentRequests.Release(int64(totalPieceCount))
 			// Pieces will be collected by garbage collector
-			return Error.Wrap(err)
+			return nil, 0, Error.Wrap(err)
 		}
 
 		for _, node := range nodes {
@@ -204,21 +348,46 @@ func (service *Service) Delete(ctx context.Context, requests []Request, successT
 		}
 	}
 
-	threshold, err := sync2.NewSuccessThreshold(len(nodesReqs), successThreshold)
-	if err != nil {
-		return Error.Wrap(err)
-	}
+	return nodesReqs, totalPieceCount, nil
+}
 
+// enqueue adds a job per node to the combiner. next is resolved once for
+// every job.
+func (service *Service) enqueue(nodesReqs map[storj.NodeID]Request, next Promise) {
 	for _, req := range nodesReqs {
+		resolve := next
+		if service.backlog != nil {
+			resolve = &backlogPromise{
+				backlog: service.backlog,
+				nodeID:  req.Node.ID,
+				pieces:  req.Pieces,
+				next:    next,
+			}
+		}
+
 		service.combiner.Enqueue(req.Node, Job{
 			Pieces:  req.Pieces,
-			Resolve: threshold,
+			Resolve: resolve,
 		})
 	}
+}
 
-	threshold.Wait(ctx)
+// releasePromise calls release once all of its jobs have been handled.
+type releasePromise struct {
+	pending int32
+	release func()
+}
 
-	return nil
+// Success is called when the job has been successfully handled.
+func (promise *releasePromise) Success() { promise.done() }
+
+// Failure is called when the job didn't complete successfully.
+func (promise *releasePromise) Failure() { promise.done() }
+
+func (promise *releasePromise) done() {
+	if atomic.AddInt32(&promise.pending, -1) == 0 {
+		promise.release()
+	}
 }
 
 // Request defines a deletion requests for a node.
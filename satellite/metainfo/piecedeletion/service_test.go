@@ -174,6 +174,63 @@ func TestService_DeletePieces_AllNodesUp(t *testing.T) {
 	})
 }
 
+func TestService_DeleteAsync(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
+		Reconfigure: testplanet.Reconfigure{
+			Satellite: testplanet.Combine(
+				testplanet.ReconfigureRS(2, 2, 4, 4),
+				testplanet.MaxSegmentSize(15*memory.KiB),
+			),
+		},
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		uplnk := planet.Uplinks[0]
+		satelliteSys := planet.Satellites[0]
+
+		{
+			data := testrand.Bytes(10 * memory.KiB)
+			err := uplnk.Upload(ctx, satelliteSys, "a-bucket", "object-filename", data)
+			require.NoError(t, err)
+		}
+
+		var requests []piecedeletion.Request
+		for _, sn := range planet.StorageNodes {
+			nodePieces := piecedeletion.Request{Node: sn.NodeURL()}
+			err := sn.Storage2.Store.WalkSatellitePieces(ctx, satelliteSys.ID(),
+				func(store pieces.StoredPieceAccess) error {
+					nodePieces.Pieces = append(nodePieces.Pieces, store.PieceID())
+					return nil
+				},
+			)
+			require.NoError(t, err)
+
+			requests = append(requests, nodePieces)
+		}
+
+		err := satelliteSys.API.Metainfo.PieceDeletion.DeleteAsync(ctx, requests)
+		require.NoError(t, err)
+
+		// the pieces are deleted in the background.
+		deadline := time.Now().Add(time.Minute)
+		for {
+			planet.WaitForStorageNodeDeleters(ctx)
+
+			var totalUsedSpace int64
+			for _, sn := range planet.StorageNodes {
+				piecesTotal, _, err := sn.Storage2.Store.SpaceUsedForPieces(ctx)
+				require.NoError(t, err)
+				totalUsedSpace += piecesTotal
+			}
+			if totalUsedSpace == 0 {
+				break
+			}
+
+			require.True(t, time.Now().Before(deadline), "pieces weren't deleted")
+			time.Sleep(50 * time.Millisecond)
+		}
+	})
+}
+
 func TestService_DeletePieces_SomeNodesDown(t *testing.T) {
 	testplanet.Run(t, testplanet.Config{
 		SatelliteCount: 1, StorageNodeCount: 4, UplinkCount: 1,
@@ -83,6 +83,9 @@ type DB interface {
 
 	// GetNodesNetwork returns the /24 subnet for each storage node, order is not guaranteed.
 	GetNodesNetwork(ctx context.Context, nodeIDs []storj.NodeID) (nodeNets []string, err error)
+	// GetNodesNetworkInOrder returns the /24 subnet for each storage node, in
+	// the order of nodeIDs. A node which isn't found gets an empty subnet.
+	GetNodesNetworkInOrder(ctx context.Context, nodeIDs []storj.NodeID) (nodeNets []string, err error)
 
 	// DisqualifyNode disqualifies a storage node.
 	DisqualifyNode(ctx context.Context, nodeID storj.NodeID) (err error)
@@ -337,6 +340,19 @@ func (service *Service) GetNodeIPs(ctx context.Context, nodeIDs []storj.NodeID)
 	return service.DownloadSelectionCache.GetNodeIPs(ctx, nodeIDs)
 }
 
+// GetNodesNetworkInOrder returns the /24 subnet for each storage node, in the
+// order of nodeIDs. A node which isn't found gets an empty subnet.
+func (service *Service) GetNodesNetworkInOrder(ctx context.Context, nodeIDs []storj.NodeID) (_ []string, err error) {
+	defer mon.Task()(&ctx)(&err)
+	return service.db.GetNodesNetworkInOrder(ctx, nodeIDs)
+}
+
+// DistinctIP returns whether the node selection requires the nodes to be on
+// distinct networks.
+func (service *Service) DistinctIP() bool {
+	return service.config.Node.DistinctIP
+}
+
 // IsOnline checks if a node is 'online' based on the collected statistics.
 func (service *Service) IsOnline(node *NodeDossier) bool {
 	return time.Since(node.Reputation.LastContactSuccess) < service.config.Node.OnlineWindow
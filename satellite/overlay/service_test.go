@@ -380,6 +380,38 @@ func TestGetOnlineNodesForGetDelete(t *testing.T) {
 	})
 }
 
+func TestGetNodesNetworkInOrder(t *testing.T) {
+	satellitedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db satellite.DB) {
+		cache := db.OverlayCache()
+
+		var nodeIDs []storj.NodeID
+		var expected []string
+		for i := 0; i < 5; i++ {
+			nodeID := testrand.NodeID()
+			addr := fmt.Sprintf("127.0.%d.0:8080", i)
+			lastNet := fmt.Sprintf("127.0.%d", i)
+			err := cache.UpdateCheckIn(ctx, overlay.NodeCheckInInfo{
+				NodeID:     nodeID,
+				Address:    &pb.NodeAddress{Address: addr, Transport: pb.NodeTransport_TCP_TLS_GRPC},
+				LastIPPort: addr,
+				LastNet:    lastNet,
+				Version:    &pb.NodeVersion{Version: "v1.0.0"},
+				Capacity:   &pb.NodeCapacity{},
+				IsUp:       true,
+			}, time.Now().UTC(), overlay.NodeSelectionConfig{})
+			require.NoError(t, err)
+
+			// the unknown nodes get an empty network.
+			nodeIDs = append(nodeIDs, nodeID, testrand.NodeID())
+			expected = append(expected, lastNet, "")
+		}
+
+		networks, err := cache.GetNodesNetworkInOrder(ctx, nodeIDs)
+		require.NoError(t, err)
+		require.Equal(t, expected, networks)
+	})
+}
+
 func TestKnownReliable(t *testing.T) {
 	testplanet.Run(t, testplanet.Config{
 		SatelliteCount: 1, StorageNodeCount: 6, UplinkCount: 1,
@@ -28,6 +28,8 @@ import (
 	"storj.io/storj/satellite/console/consoleweb"
 	"storj.io/storj/satellite/contact"
 	"storj.io/storj/satellite/gc"
+	"storj.io/storj/satellite/gc/bloomfilter"
+	"storj.io/storj/satellite/gc/sender"
 	"storj.io/storj/satellite/gracefulexit"
 	"storj.io/storj/satellite/mailservice"
 	"storj.io/storj/satellite/metabase/zombiedeletion"
@@ -88,6 +90,8 @@ type DB interface {
 	Orders() orders.DB
 	// Containment returns database for containment
 	Containment() audit.Containment
+	// VerifyQueue returns database for the audit verification queue
+	VerifyQueue() audit.VerifyQueue
 	// Buckets returns the database to interact with buckets
 	Buckets() metainfo.BucketsDB
 	// GracefulExit returns database for graceful exit
@@ -125,7 +129,9 @@ type Config struct {
 	Repairer repairer.Config
 	Audit    audit.Config
 
-	GarbageCollection gc.Config
+	GarbageCollection       gc.Config
+	GarbageCollectionBF     bloomfilter.Config
+	GarbageCollectionSender sender.Config
 
 	ExpiredDeletion expireddeletion.Config
 	ZombieDeletion  zombiedeletion.Config
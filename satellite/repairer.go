@@ -159,6 +159,7 @@ func NewRepairer(log *zap.Logger, full *identity.FullIdentity,
 
 		peer.Services.Add(lifecycle.Item{
 			Name:  "reputation",
+			Run:   peer.Reputation.Run,
 			Close: peer.Reputation.Close,
 		})
 	}
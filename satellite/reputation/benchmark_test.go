@@ -69,6 +69,29 @@ func BenchmarkReputation(b *testing.B) {
 			}
 		})
 
+		b.Run("UpdateBatchSuccess", func(b *testing.B) {
+			// apply the outcomes of a single audit to every node.
+			updates := make([]reputation.BatchUpdate, len(all))
+			for i, id := range all {
+				updates[i] = reputation.BatchUpdate{
+					UpdateRequest: reputation.UpdateRequest{
+						NodeID:       id,
+						AuditOutcome: reputation.AuditSuccess,
+						AuditHistory: testAuditHistoryConfig(),
+					},
+				}
+			}
+
+			for i := 0; i < b.N; i += len(updates) {
+				now := time.Now()
+				for k := range updates {
+					updates[k].AuditTime = now
+				}
+				_, _, err := reputationdb.UpdateBatch(ctx, updates)
+				require.NoError(b, err)
+			}
+		})
+
 		b.Run("UpdateStatsOffline", func(b *testing.B) {
 			for i := 0; i < b.N; i++ {
 				id := all[i%len(all)]
@@ -30,6 +30,8 @@ type Config struct {
 	SuspensionGracePeriod time.Duration `help:"the time period that must pass before suspended nodes will be disqualified" releaseDefault:"168h" devDefault:"1h"`
 	SuspensionDQEnabled   bool          `help:"whether nodes will be disqualified if they have been suspended for longer than the suspended grace period" releaseDefault:"false" devDefault:"true"`
 	AuditCount            int64         `help:"the number of times a node has been audited to not be considered a New Node" releaseDefault:"100" devDefault:"0"`
+	FlushInterval         time.Duration `help:"the time audit outcomes are kept in memory before being written to the database in a single batch, zero writes them immediately" default:"0s"`
+	FlushMaxPending       int           `help:"the number of pending audit outcomes which triggers an early flush" default:"10000"`
 	AuditHistory          AuditHistoryConfig
 }
 
@@ -12,6 +12,7 @@ import (
 	"go.uber.org/zap"
 
 	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
 	"storj.io/storj/private/testplanet"
 	"storj.io/storj/satellite"
 	"storj.io/storj/satellite/reputation"
@@ -63,6 +64,65 @@ func TestUpdate(t *testing.T) {
 	})
 }
 
+func TestUpdateBatch(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 0,
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		db := planet.Satellites[0].DB.Reputation()
+
+		sequential := testrand.NodeID()
+		batched := testrand.NodeID()
+
+		outcomes := []reputation.AuditType{
+			reputation.AuditSuccess, reputation.AuditSuccess, reputation.AuditOffline,
+			reputation.AuditUnknown, reputation.AuditFailure, reputation.AuditSuccess,
+		}
+
+		now := time.Now()
+		var updates []reputation.BatchUpdate
+		for i, outcome := range outcomes {
+			auditTime := now.Add(time.Duration(i) * time.Minute)
+
+			_, _, err := db.Update(ctx, reputation.UpdateRequest{
+				NodeID:                   sequential,
+				AuditOutcome:             outcome,
+				AuditLambda:              0.95,
+				AuditWeight:              1,
+				AuditsRequiredForVetting: 3,
+				AuditHistory:             testAuditHistoryConfig(),
+			}, auditTime)
+			require.NoError(t, err)
+
+			updates = append(updates, reputation.BatchUpdate{
+				UpdateRequest: reputation.UpdateRequest{
+					NodeID:                   batched,
+					AuditOutcome:             outcome,
+					AuditLambda:              0.95,
+					AuditWeight:              1,
+					AuditsRequiredForVetting: 3,
+					AuditHistory:             testAuditHistoryConfig(),
+				},
+				AuditTime: auditTime,
+			})
+		}
+
+		changes, failed, err := db.UpdateBatch(ctx, updates)
+		require.NoError(t, err)
+		require.Empty(t, failed)
+		// the node got vetted.
+		require.Len(t, changes, 1)
+		require.Equal(t, batched, changes[0].NodeID)
+		require.NotNil(t, changes[0].Status.VettedAt)
+
+		expected, err := db.Get(ctx, sequential)
+		require.NoError(t, err)
+		actual, err := db.Get(ctx, batched)
+		require.NoError(t, err)
+
+		require.Equal(t, expected, actual)
+	})
+}
+
 func testAuditHistoryConfig() reputation.AuditHistoryConfig {
 	return reputation.AuditHistoryConfig{
 		WindowSize:       time.Hour,
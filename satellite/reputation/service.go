@@ -5,17 +5,25 @@ package reputation
 
 import (
 	"context"
+	"sync"
 	"time"
 
+	"github.com/zeebo/errs"
 	"go.uber.org/zap"
 
 	"storj.io/common/storj"
+	"storj.io/common/sync2"
 	"storj.io/storj/satellite/overlay"
 )
 
 // DB is an interface for storing reputation data.
 type DB interface {
 	Update(ctx context.Context, request UpdateRequest, now time.Time) (_ *overlay.ReputationStatus, changed bool, err error)
+	// UpdateBatch applies the updates in order, with the same outcome as
+	// calling Update for each of them, reading and writing the nodes in bulk.
+	// It returns the nodes whose status changed and, on error, the nodes
+	// whose updates haven't been applied.
+	UpdateBatch(ctx context.Context, updates []BatchUpdate) (changes []StatusChange, failed storj.NodeIDList, err error)
 	SetNodeStatus(ctx context.Context, id storj.NodeID, status overlay.ReputationStatus) error
 	Get(ctx context.Context, nodeID storj.NodeID) (*Info, error)
 
@@ -48,6 +56,18 @@ type Info struct {
 	UnknownAuditReputationBeta  float64
 }
 
+// BatchUpdate is an update request together with the time of the audit.
+type BatchUpdate struct {
+	UpdateRequest
+	AuditTime time.Time
+}
+
+// StatusChange is the new reputation status of a node.
+type StatusChange struct {
+	NodeID storj.NodeID
+	Status overlay.ReputationStatus
+}
+
 // Service handles storing node reputation data and updating
 // the overlay cache when a node's status changes.
 type Service struct {
@@ -55,6 +75,16 @@ type Service struct {
 	overlay overlay.DB
 	db      DB
 	config  Config
+
+	// Loop flushes the pending updates when FlushInterval is set.
+	Loop *sync2.Cycle
+
+	mu      sync.Mutex
+	pending []BatchUpdate
+	// failedChanges are the status changes which have been written to the
+	// reputation database, but couldn't be applied to the overlay. Only the
+	// overlay update is retried for them.
+	failedChanges []StatusChange
 }
 
 // NewService creates a new reputation service.
@@ -64,25 +94,36 @@ func NewService(log *zap.Logger, overlay overlay.DB, db DB, config Config) *Serv
 		overlay: overlay,
 		db:      db,
 		config:  config,
+		Loop:    sync2.NewCycle(config.FlushInterval),
 	}
 }
 
+// Run flushes the pending audit outcomes every FlushInterval.
+func (service *Service) Run(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if service.config.FlushInterval <= 0 {
+		return nil
+	}
+
+	return service.Loop.Run(ctx, func(ctx context.Context) error {
+		service.Flush(ctx)
+		return nil
+	})
+}
+
 // ApplyAudit receives an audit result and applies it to the relevant node in DB.
+//
+// When FlushInterval is set, the result is applied with the next flush.
 func (service *Service) ApplyAudit(ctx context.Context, nodeID storj.NodeID, result AuditType) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	statusUpdate, changed, err := service.db.Update(ctx, UpdateRequest{
-		NodeID:       nodeID,
-		AuditOutcome: result,
+	if service.config.FlushInterval > 0 {
+		service.enqueue(service.newBatchUpdates(storj.NodeIDList{nodeID}, result))
+		return nil
+	}
 
-		AuditLambda:              service.config.AuditLambda,
-		AuditWeight:              service.config.AuditWeight,
-		AuditDQ:                  service.config.AuditDQ,
-		SuspensionGracePeriod:    service.config.SuspensionGracePeriod,
-		SuspensionDQEnabled:      service.config.SuspensionDQEnabled,
-		AuditsRequiredForVetting: service.config.AuditCount,
-		AuditHistory:             service.config.AuditHistory,
-	}, time.Now())
+	statusUpdate, changed, err := service.db.Update(ctx, service.newUpdateRequest(nodeID, result), time.Now())
 	if err != nil {
 		return err
 	}
@@ -97,6 +138,154 @@ func (service *Service) ApplyAudit(ctx context.Context, nodeID storj.NodeID, res
 	return err
 }
 
+// ApplyAudits applies the same audit result to several nodes using a single
+// batch of database updates. It returns the nodes which couldn't be updated.
+//
+// When FlushInterval is set, the results are applied with the next flush.
+func (service *Service) ApplyAudits(ctx context.Context, nodeIDs storj.NodeIDList, result AuditType) (failed storj.NodeIDList, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(nodeIDs) == 0 {
+		return nil, nil
+	}
+
+	updates := service.newBatchUpdates(nodeIDs, result)
+	if service.config.FlushInterval > 0 {
+		service.enqueue(updates)
+		return nil, nil
+	}
+
+	return service.applyBatch(ctx, updates)
+}
+
+// Flush applies all the pending audit outcomes. The updates of nodes which
+// couldn't be written to the reputation database are kept for the next flush.
+func (service *Service) Flush(ctx context.Context) {
+	service.mu.Lock()
+	updates := service.pending
+	service.pending = nil
+	retryOverlay := len(service.failedChanges) > 0
+	service.mu.Unlock()
+
+	if len(updates) == 0 && !retryOverlay {
+		return
+	}
+
+	failed, err := service.applyBatch(ctx, updates)
+	if err == nil {
+		return
+	}
+	service.log.Error("unable to apply audit outcomes", zap.Int("nodes", len(failed)), zap.Error(err))
+
+	notWritten := make(map[storj.NodeID]bool, len(failed))
+	for _, nodeID := range failed {
+		notWritten[nodeID] = true
+	}
+	var retry []BatchUpdate
+	for _, update := range updates {
+		if notWritten[update.NodeID] {
+			retry = append(retry, update)
+		}
+	}
+
+	service.mu.Lock()
+	service.pending = append(retry, service.pending...)
+	service.mu.Unlock()
+}
+
+// enqueue adds updates to be applied with the next flush, and triggers an
+// early flush when there are too many of them.
+func (service *Service) enqueue(updates []BatchUpdate) {
+	service.mu.Lock()
+	service.pending = append(service.pending, updates...)
+	full := len(service.pending) >= service.config.FlushMaxPending
+	service.mu.Unlock()
+
+	if full {
+		service.Loop.Trigger()
+	}
+}
+
+// applyBatch writes the updates to the database and updates the overlay for
+// the nodes whose status changed. It returns the nodes whose updates haven't
+// been written to the reputation database.
+func (service *Service) applyBatch(ctx context.Context, updates []BatchUpdate) (failed storj.NodeIDList, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	var changes []StatusChange
+	if len(updates) > 0 {
+		changes, failed, err = service.db.UpdateBatch(ctx, updates)
+	}
+
+	service.mu.Lock()
+	changes = append(service.failedChanges, changes...)
+	service.failedChanges = nil
+	service.mu.Unlock()
+
+	return failed, errs.Combine(err, service.updateOverlay(ctx, changes))
+}
+
+// updateOverlay applies the status changes to the overlay. The changes which
+// couldn't be applied are retried with the next batch.
+func (service *Service) updateOverlay(ctx context.Context, changes []StatusChange) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	// only the latest status of a node is applied.
+	latest := make(map[storj.NodeID]int, len(changes))
+	for i, change := range changes {
+		latest[change.NodeID] = i
+	}
+
+	var errlist errs.Group
+	var failedChanges []StatusChange
+	for i, change := range changes {
+		if latest[change.NodeID] != i {
+			continue
+		}
+		err := service.overlay.UpdateReputation(ctx, change.NodeID, &changes[i].Status)
+		if err != nil {
+			failedChanges = append(failedChanges, change)
+			errlist.Add(err)
+		}
+	}
+
+	if len(failedChanges) > 0 {
+		service.mu.Lock()
+		service.failedChanges = append(failedChanges, service.failedChanges...)
+		service.mu.Unlock()
+	}
+	return errlist.Err()
+}
+
+// newBatchUpdates creates update requests for the nodes with the current time.
+func (service *Service) newBatchUpdates(nodeIDs storj.NodeIDList, result AuditType) []BatchUpdate {
+	now := time.Now()
+	updates := make([]BatchUpdate, len(nodeIDs))
+	for i, nodeID := range nodeIDs {
+		updates[i] = BatchUpdate{
+			UpdateRequest: service.newUpdateRequest(nodeID, result),
+			AuditTime:     now,
+		}
+	}
+	return updates
+}
+
+// newUpdateRequest creates an update request using the service configuration.
+func (service *Service) newUpdateRequest(nodeID storj.NodeID, result AuditType) UpdateRequest {
+	return UpdateRequest{
+		NodeID:       nodeID,
+		AuditOutcome: result,
+
+		AuditLambda:              service.config.AuditLambda,
+		AuditWeight:              service.config.AuditWeight,
+		AuditDQ:                  service.config.AuditDQ,
+		SuspensionGracePeriod:    service.config.SuspensionGracePeriod,
+		SuspensionDQEnabled:      service.config.SuspensionDQEnabled,
+		AuditsRequiredForVetting: service.config.AuditCount,
+		AuditHistory:             service.config.AuditHistory,
+	}
+}
+
 // Get returns a node's reputation info from DB.
 // If a node is not found in the DB, default reputation information is returned.
 func (service *Service) Get(ctx context.Context, nodeID storj.NodeID) (info *Info, err error) {
@@ -152,5 +341,9 @@ func (service *Service) TestUnsuspendNodeUnknownAudit(ctx context.Context, nodeI
 	return service.overlay.TestUnsuspendNodeUnknownAudit(ctx, nodeID)
 }
 
-// Close closes resources.
-func (service *Service) Close() error { return nil }
+// Close stops the flush loop and applies the pending audit outcomes.
+func (service *Service) Close() error {
+	service.Loop.Close()
+	service.Flush(context.Background())
+	return nil
+}
@@ -4,17 +4,23 @@
 package reputation_test
 
 import (
+	"context"
 	"testing"
+	"time"
 
 	"github.com/stretchr/testify/require"
+	"github.com/zeebo/errs"
 	"go.uber.org/zap"
+	"go.uber.org/zap/zaptest"
 	"golang.org/x/sync/errgroup"
 
 	"storj.io/common/memory"
+	"storj.io/common/storj"
 	"storj.io/common/testcontext"
 	"storj.io/common/testrand"
 	"storj.io/storj/private/testplanet"
 	"storj.io/storj/satellite"
+	"storj.io/storj/satellite/overlay"
 	"storj.io/storj/satellite/reputation"
 )
 
@@ -99,6 +105,101 @@ func TestApplyAudit(t *testing.T) {
 	})
 }
 
+func TestApplyAudit_FlushInterval(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 2, UplinkCount: 0,
+		Reconfigure: testplanet.Reconfigure{
+			Satellite: func(log *zap.Logger, index int, config *satellite.Config) {
+				config.Reputation.FlushInterval = time.Hour
+			},
+		},
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		service := planet.Satellites[0].Reputation.Service
+		nodeIDs := storj.NodeIDList{planet.StorageNodes[0].ID(), planet.StorageNodes[1].ID()}
+
+		for i := 0; i < 3; i++ {
+			failed, err := service.ApplyAudits(ctx, nodeIDs, reputation.AuditSuccess)
+			require.NoError(t, err)
+			require.Empty(t, failed)
+		}
+		require.NoError(t, service.ApplyAudit(ctx, nodeIDs[0], reputation.AuditFailure))
+
+		// the outcomes are kept in memory until the next flush.
+		node, err := service.Get(ctx, nodeIDs[0])
+		require.NoError(t, err)
+		require.Zero(t, node.TotalAuditCount)
+
+		service.Flush(ctx)
+
+		node, err = service.Get(ctx, nodeIDs[0])
+		require.NoError(t, err)
+		require.EqualValues(t, 4, node.TotalAuditCount)
+		require.EqualValues(t, 3, node.AuditSuccessCount)
+
+		node, err = service.Get(ctx, nodeIDs[1])
+		require.NoError(t, err)
+		require.EqualValues(t, 3, node.TotalAuditCount)
+		require.EqualValues(t, 3, node.AuditSuccessCount)
+	})
+}
+
+// failingOverlay fails the reputation updates while fail is set.
+type failingOverlay struct {
+	overlay.DB
+	fail bool
+}
+
+func (db *failingOverlay) UpdateReputation(ctx context.Context, id storj.NodeID, request *overlay.ReputationStatus) error {
+	if db.fail {
+		return errs.New("overlay unavailable")
+	}
+	return db.DB.UpdateReputation(ctx, id, request)
+}
+
+func TestApplyAudits_OverlayFailure(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 1, UplinkCount: 0,
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		satellite := planet.Satellites[0]
+		nodeID := planet.StorageNodes[0].ID()
+
+		config := satellite.Config.Reputation
+		config.FlushInterval = time.Hour
+		// a single failed audit disqualifies the node, so its status changes.
+		config.AuditDQ = 1
+
+		overlayDB := &failingOverlay{DB: satellite.Overlay.DB, fail: true}
+		service := reputation.NewService(zaptest.NewLogger(t), overlayDB, satellite.DB.Reputation(), config)
+
+		require.NoError(t, service.ApplyAudit(ctx, nodeID, reputation.AuditFailure))
+		service.Flush(ctx)
+
+		node, err := service.Get(ctx, nodeID)
+		require.NoError(t, err)
+		require.EqualValues(t, 1, node.TotalAuditCount)
+		require.NotNil(t, node.Disqualified)
+		alpha, beta := node.AuditReputationAlpha, node.AuditReputationBeta
+
+		dossier, err := satellite.Overlay.DB.Get(ctx, nodeID)
+		require.NoError(t, err)
+		require.Nil(t, dossier.Disqualified)
+
+		// only the overlay update is retried, the audit isn't applied again.
+		overlayDB.fail = false
+		service.Flush(ctx)
+
+		node, err = service.Get(ctx, nodeID)
+		require.NoError(t, err)
+		require.EqualValues(t, 1, node.TotalAuditCount)
+		require.Equal(t, alpha, node.AuditReputationAlpha)
+		require.Equal(t, beta, node.AuditReputationBeta)
+
+		dossier, err = satellite.Overlay.DB.Get(ctx, nodeID)
+		require.NoError(t, err)
+		require.NotNil(t, dossier.Disqualified)
+	})
+}
+
 func TestGet(t *testing.T) {
 	testplanet.Run(t, testplanet.Config{
 		SatelliteCount: 1, StorageNodeCount: 1, UplinkCount: 0,
@@ -247,6 +247,11 @@ func (dbc *satelliteDBCollection) Containment() audit.Containment {
 	return &containment{db: dbc.getByName("containment")}
 }
 
+// VerifyQueue returns database for the audit verification queue.
+func (dbc *satelliteDBCollection) VerifyQueue() audit.VerifyQueue {
+	return &verifyQueue{db: dbc.getByName("verifyqueue")}
+}
+
 // GracefulExit returns database for graceful exit.
 func (dbc *satelliteDBCollection) GracefulExit() gracefulexit.DB {
 	return &gracefulexitDB{db: dbc.getByName("gracefulexit")}
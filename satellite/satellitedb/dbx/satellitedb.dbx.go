@@ -733,6 +733,16 @@ CREATE TABLE value_attributions (
 	last_updated timestamp with time zone NOT NULL,
 	PRIMARY KEY ( project_id, bucket_name )
 );
+CREATE TABLE verification_audits (
+	shard integer NOT NULL,
+	stream_id bytea NOT NULL,
+	position bigint NOT NULL,
+	expires_at timestamp with time zone,
+	inserted_at timestamp with time zone NOT NULL DEFAULT current_timestamp,
+	leased_until timestamp with time zone,
+	attempts integer NOT NULL DEFAULT 0,
+	PRIMARY KEY ( shard, stream_id, position )
+);
 CREATE TABLE api_keys (
 	id bytea NOT NULL,
 	project_id bytea NOT NULL REFERENCES projects( id ) ON DELETE CASCADE,
@@ -1321,6 +1331,16 @@ CREATE TABLE value_attributions (
 	last_updated timestamp with time zone NOT NULL,
 	PRIMARY KEY ( project_id, bucket_name )
 );
+CREATE TABLE verification_audits (
+	shard integer NOT NULL,
+	stream_id bytea NOT NULL,
+	position bigint NOT NULL,
+	expires_at timestamp with time zone,
+	inserted_at timestamp with time zone NOT NULL DEFAULT current_timestamp,
+	leased_until timestamp with time zone,
+	attempts integer NOT NULL DEFAULT 0,
+	PRIMARY KEY ( shard, stream_id, position )
+);
 CREATE TABLE api_keys (
 	id bytea NOT NULL,
 	project_id bytea NOT NULL REFERENCES projects( id ) ON DELETE CASCADE,
@@ -8807,6 +8827,193 @@ func (f ValueAttribution_LastUpdated_Field) value() interface{} {
 
 func (ValueAttribution_LastUpdated_Field) _Column() string { return "last_updated" }
 
+type VerificationAudits struct {
+	Shard       int
+	StreamId    []byte
+	Position    uint64
+	ExpiresAt   *time.Time
+	InsertedAt  time.Time
+	LeasedUntil *time.Time
+	Attempts    int
+}
+
+func (VerificationAudits) _Table() string { return "verification_audits" }
+
+type VerificationAudits_Create_Fields struct {
+	ExpiresAt   VerificationAudits_ExpiresAt_Field
+	InsertedAt  VerificationAudits_InsertedAt_Field
+	LeasedUntil VerificationAudits_LeasedUntil_Field
+	Attempts    VerificationAudits_Attempts_Field
+}
+
+type VerificationAudits_Update_Fields struct {
+	LeasedUntil VerificationAudits_LeasedUntil_Field
+	Attempts    VerificationAudits_Attempts_Field
+}
+
+type VerificationAudits_Shard_Field struct {
+	_set   bool
+	_null  bool
+	_value int
+}
+
+func VerificationAudits_Shard(v int) VerificationAudits_Shard_Field {
+	return VerificationAudits_Shard_Field{_set: true, _value: v}
+}
+
+func (f VerificationAudits_Shard_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_Shard_Field) _Column() string { return "shard" }
+
+type VerificationAudits_StreamId_Field struct {
+	_set   bool
+	_null  bool
+	_value []byte
+}
+
+func VerificationAudits_StreamId(v []byte) VerificationAudits_StreamId_Field {
+	return VerificationAudits_StreamId_Field{_set: true, _value: v}
+}
+
+func (f VerificationAudits_StreamId_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_StreamId_Field) _Column() string { return "stream_id" }
+
+type VerificationAudits_Position_Field struct {
+	_set   bool
+	_null  bool
+	_value uint64
+}
+
+func VerificationAudits_Position(v uint64) VerificationAudits_Position_Field {
+	return VerificationAudits_Position_Field{_set: true, _value: v}
+}
+
+func (f VerificationAudits_Position_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_Position_Field) _Column() string { return "position" }
+
+type VerificationAudits_ExpiresAt_Field struct {
+	_set   bool
+	_null  bool
+	_value *time.Time
+}
+
+func VerificationAudits_ExpiresAt(v time.Time) VerificationAudits_ExpiresAt_Field {
+	return VerificationAudits_ExpiresAt_Field{_set: true, _value: &v}
+}
+
+func VerificationAudits_ExpiresAt_Raw(v *time.Time) VerificationAudits_ExpiresAt_Field {
+	if v == nil {
+		return VerificationAudits_ExpiresAt_Null()
+	}
+	return VerificationAudits_ExpiresAt(*v)
+}
+
+func VerificationAudits_ExpiresAt_Null() VerificationAudits_ExpiresAt_Field {
+	return VerificationAudits_ExpiresAt_Field{_set: true, _null: true}
+}
+
+func (f VerificationAudits_ExpiresAt_Field) isnull() bool {
+	return !f._set || f._null || f._value == nil
+}
+
+func (f VerificationAudits_ExpiresAt_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_ExpiresAt_Field) _Column() string { return "expires_at" }
+
+type VerificationAudits_InsertedAt_Field struct {
+	_set   bool
+	_null  bool
+	_value time.Time
+}
+
+func VerificationAudits_InsertedAt(v time.Time) VerificationAudits_InsertedAt_Field {
+	return VerificationAudits_InsertedAt_Field{_set: true, _value: v}
+}
+
+func (f VerificationAudits_InsertedAt_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_InsertedAt_Field) _Column() string { return "inserted_at" }
+
+type VerificationAudits_LeasedUntil_Field struct {
+	_set   bool
+	_null  bool
+	_value *time.Time
+}
+
+func VerificationAudits_LeasedUntil(v time.Time) VerificationAudits_LeasedUntil_Field {
+	return VerificationAudits_LeasedUntil_Field{_set: true, _value: &v}
+}
+
+func VerificationAudits_LeasedUntil_Raw(v *time.Time) VerificationAudits_LeasedUntil_Field {
+	if v == nil {
+		return VerificationAudits_LeasedUntil_Null()
+	}
+	return VerificationAudits_LeasedUntil(*v)
+}
+
+func VerificationAudits_LeasedUntil_Null() VerificationAudits_LeasedUntil_Field {
+	return VerificationAudits_LeasedUntil_Field{_set: true, _null: true}
+}
+
+func (f VerificationAudits_LeasedUntil_Field) isnull() bool {
+	return !f._set || f._null || f._value == nil
+}
+
+func (f VerificationAudits_LeasedUntil_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_LeasedUntil_Field) _Column() string { return "leased_until" }
+
+type VerificationAudits_Attempts_Field struct {
+	_set   bool
+	_null  bool
+	_value int
+}
+
+func VerificationAudits_Attempts(v int) VerificationAudits_Attempts_Field {
+	return VerificationAudits_Attempts_Field{_set: true, _value: v}
+}
+
+func (f VerificationAudits_Attempts_Field) value() interface{} {
+	if !f._set || f._null {
+		return nil
+	}
+	return f._value
+}
+
+func (VerificationAudits_Attempts_Field) _Column() string { return "attempts" }
+
 type ApiKey struct {
 	Id        []byte
 	ProjectId []byte
@@ -15798,6 +16005,16 @@ func (obj *pgxImpl) deleteAll(ctx context.Context) (count int64, err error) {
 		return 0, obj.makeErr(err)
 	}
 
+	__count, err = __res.RowsAffected()
+	if err != nil {
+		return 0, obj.makeErr(err)
+	}
+	count += __count
+	__res, err = obj.driver.ExecContext(ctx, "DELETE FROM verification_audits;")
+	if err != nil {
+		return 0, obj.makeErr(err)
+	}
+
 	__count, err = __res.RowsAffected()
 	if err != nil {
 		return 0, obj.makeErr(err)
@@ -21785,6 +22002,16 @@ func (obj *pgxcockroachImpl) deleteAll(ctx context.Context) (count int64, err er
 		return 0, obj.makeErr(err)
 	}
 
+	__count, err = __res.RowsAffected()
+	if err != nil {
+		return 0, obj.makeErr(err)
+	}
+	count += __count
+	__res, err = obj.driver.ExecContext(ctx, "DELETE FROM verification_audits;")
+	if err != nil {
+		return 0, obj.makeErr(err)
+	}
+
 	__count, err = __res.RowsAffected()
 	if err != nil {
 		return 0, obj.makeErr(err)
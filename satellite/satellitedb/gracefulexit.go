@@ -179,6 +179,32 @@ func (db *gracefulexitDB) DeleteTransferQueueItem(ctx context.Context, nodeID st
 	return Error.Wrap(err)
 }
 
+// DeleteTransferQueueItemBatch deletes several graceful exit transfer queue entries of a node at once.
+func (db *gracefulexitDB) DeleteTransferQueueItemBatch(ctx context.Context, nodeID storj.NodeID, items []gracefulexit.TransferQueueItem) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(items) == 0 {
+		return nil
+	}
+
+	streamIDs := make([][]byte, 0, len(items))
+	positions := make([]int64, 0, len(items))
+	pieceNums := make([]int32, 0, len(items))
+	for i := range items {
+		streamIDs = append(streamIDs, items[i].StreamID[:])
+		positions = append(positions, int64(items[i].Position.Encode()))
+		pieceNums = append(pieceNums, items[i].PieceNum)
+	}
+
+	_, err = db.db.ExecContext(ctx, `
+		DELETE FROM graceful_exit_segment_transfer_queue
+		WHERE node_id = $1 AND (stream_id, position, piece_num) IN (
+			SELECT unnest($2::bytea[]), unnest($3::int8[]), unnest($4::int4[])
+		)
+	`, nodeID.Bytes(), pgutil.ByteaArray(streamIDs), pgutil.Int8Array(positions), pgutil.Int4Array(pieceNums))
+	return Error.Wrap(err)
+}
+
 // DeleteTransferQueueItem deletes a graceful exit transfer queue entries by nodeID.
 func (db *gracefulexitDB) DeleteTransferQueueItems(ctx context.Context, nodeID storj.NodeID) (err error) {
 	defer mon.Task()(&ctx)(&err)
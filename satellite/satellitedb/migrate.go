@@ -1627,6 +1627,23 @@ func (db *satelliteDB) PostgresMigration() *migrate.Migration {
 					`ALTER TABLE nodes DROP COLUMN total_audit_count`,
 				},
 			},
+			{
+				DB:          &db.migrationDB,
+				Description: "add verification_audits table",
+				Version:     172,
+				Action: migrate.SQL{
+					`CREATE TABLE verification_audits (
+						shard integer NOT NULL,
+						stream_id bytea NOT NULL,
+						position bigint NOT NULL,
+						expires_at timestamp with time zone,
+						inserted_at timestamp with time zone NOT NULL DEFAULT current_timestamp,
+						leased_until timestamp with time zone,
+						attempts integer NOT NULL DEFAULT 0,
+						PRIMARY KEY ( shard, stream_id, position )
+					)`,
+				},
+			},
 			// NB: after updating testdata in `testdata`, run
 			//     `go generate` to update `migratez.go`.
 		},
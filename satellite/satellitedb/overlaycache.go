@@ -214,6 +214,51 @@ func (cache *overlaycache) getNodesNetwork(ctx context.Context, nodeIDs []storj.
 	return nodeNets, Error.Wrap(rows.Err())
 }
 
+// GetNodesNetworkInOrder returns the /24 subnet for each storage node, in the
+// order of nodeIDs. A node which isn't found gets an empty subnet.
+func (cache *overlaycache) GetNodesNetworkInOrder(ctx context.Context, nodeIDs []storj.NodeID) (nodeNets []string, err error) {
+	for {
+		nodeNets, err = cache.getNodesNetworkInOrder(ctx, nodeIDs)
+		if err != nil {
+			if cockroachutil.NeedsRetry(err) {
+				continue
+			}
+			return nodeNets, err
+		}
+		break
+	}
+
+	return nodeNets, err
+}
+
+func (cache *overlaycache) getNodesNetworkInOrder(ctx context.Context, nodeIDs []storj.NodeID) (nodeNets []string, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	var rows tagsql.Rows
+	rows, err = cache.db.Query(ctx, cache.db.Rebind(`
+		SELECT coalesce(nodes.last_net, '')
+		FROM unnest($1::bytea[]) WITH ORDINALITY AS requested(node_id, ordinal)
+		LEFT JOIN nodes ON nodes.id = requested.node_id
+		ORDER BY requested.ordinal
+		`), pgutil.NodeIDArray(nodeIDs),
+	)
+	if err != nil {
+		return nil, err
+	}
+	defer func() { err = errs.Combine(err, rows.Close()) }()
+
+	nodeNets = make([]string, 0, len(nodeIDs))
+	for rows.Next() {
+		var ip string
+		err = rows.Scan(&ip)
+		if err != nil {
+			return nil, err
+		}
+		nodeNets = append(nodeNets, ip)
+	}
+	return nodeNets, Error.Wrap(rows.Err())
+}
+
 // Get looks up the node by nodeID.
 func (cache *overlaycache) Get(ctx context.Context, id storj.NodeID) (dossier *overlay.NodeDossier, err error) {
 	defer mon.Task()(&ctx)(&err)
@@ -14,6 +14,7 @@ import (
 
 	"storj.io/common/pb"
 	"storj.io/common/storj"
+	"storj.io/private/dbutil/pgutil"
 	"storj.io/storj/satellite/internalpb"
 	"storj.io/storj/satellite/overlay"
 	"storj.io/storj/satellite/reputation"
@@ -30,10 +31,10 @@ type reputations struct {
 // The update is done in a loop to handle concurrent update calls and to avoid
 // the need for a explicit transaction.
 // There are two main steps go into the update process:
-// 1. Get existing row for the node
-// 2. Depends on the result of the first step,
-//	a. if existing row is returned, do compare-and-swap.
-//	b. if no row found, insert a new row.
+//  1. Get existing row for the node
+//  2. Depends on the result of the first step,
+//     a. if existing row is returned, do compare-and-swap.
+//     b. if no row found, insert a new row.
 func (reputations *reputations) Update(ctx context.Context, updateReq reputation.UpdateRequest, now time.Time) (_ *overlay.ReputationStatus, changed bool, err error) {
 	defer mon.Task()(&ctx)(&err)
 
@@ -115,6 +116,365 @@ func (reputations *reputations) Update(ctx context.Context, updateReq reputation
 
 }
 
+// UpdateBatch applies the updates in order, with the same outcome as calling
+// Update for each of them.
+//
+// The nodes are read with a single query, the updates are applied in memory
+// and the nodes are written back with a single compare-and-swap statement.
+// Nodes which have been modified concurrently are read and updated again.
+func (reputations *reputations) UpdateBatch(ctx context.Context, updates []reputation.BatchUpdate) (changes []reputation.StatusChange, failed storj.NodeIDList, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(updates) == 0 {
+		return nil, nil, nil
+	}
+
+	// group the updates by node, keeping the order of the updates of each node.
+	byNode := make(map[storj.NodeID][]reputation.BatchUpdate)
+	var nodeIDs storj.NodeIDList
+	for _, update := range updates {
+		if _, ok := byNode[update.NodeID]; !ok {
+			nodeIDs = append(nodeIDs, update.NodeID)
+		}
+		byNode[update.NodeID] = append(byNode[update.NodeID], update)
+	}
+
+	for len(nodeIDs) > 0 {
+		dbNodes, err := reputations.getAll(ctx, nodeIDs)
+		if err != nil {
+			return changes, nodeIDs, Error.Wrap(err)
+		}
+
+		var missing, retry storj.NodeIDList
+		var writes []reputationWrite
+		for _, nodeID := range nodeIDs {
+			dbNode, ok := dbNodes[nodeID]
+			if !ok {
+				missing = append(missing, nodeID)
+				continue
+			}
+
+			write, err := reputations.applyUpdates(ctx, nodeID, dbNode, byNode[nodeID])
+			if err != nil {
+				return changes, nodeIDs, Error.Wrap(err)
+			}
+			if write != nil {
+				writes = append(writes, *write)
+			}
+		}
+
+		if len(missing) > 0 {
+			// new nodes get the default reputation and are updated with
+			// the next iteration.
+			if err := reputations.createAll(ctx, missing); err != nil {
+				return changes, nodeIDs, Error.Wrap(err)
+			}
+			retry = append(retry, missing...)
+		}
+
+		written, err := reputations.writeAll(ctx, writes)
+		if err != nil {
+			return changes, nodeIDs, Error.Wrap(err)
+		}
+
+		for _, write := range writes {
+			if !written[write.nodeID] {
+				// the node has been updated concurrently, try again so the
+				// audits are recorded correctly.
+				mon.Event("reputations_update_batch_retry")
+				retry = append(retry, write.nodeID)
+				continue
+			}
+
+			if !write.newStatus.Equal(write.oldStatus) {
+				changes = append(changes, reputation.StatusChange{
+					NodeID: write.nodeID,
+					Status: write.newStatus,
+				})
+			}
+		}
+
+		nodeIDs = retry
+	}
+
+	return changes, nil, nil
+}
+
+// reputationWrite is a node whose reputation has been updated in memory.
+type reputationWrite struct {
+	nodeID     storj.NodeID
+	node       *dbx.Reputation
+	oldHistory []byte
+	oldStatus  overlay.ReputationStatus
+	newStatus  overlay.ReputationStatus
+}
+
+// applyUpdates applies the updates to dbNode in memory, the same way Update
+// would do it. It returns nil when there's nothing to write.
+func (reputations *reputations) applyUpdates(ctx context.Context, nodeID storj.NodeID, dbNode *dbx.Reputation, updates []reputation.BatchUpdate) (_ *reputationWrite, err error) {
+	write := &reputationWrite{
+		nodeID:     nodeID,
+		node:       dbNode,
+		oldHistory: dbNode.AuditHistory,
+		oldStatus:  getNodeStatus(dbNode),
+	}
+
+	changed := false
+	for _, update := range updates {
+		// do not update reputation if node is disqualified
+		if dbNode.Disqualified != nil {
+			break
+		}
+
+		auditHistoryResponse, err := reputations.UpdateAuditHistory(ctx, dbNode.AuditHistory, update.UpdateRequest, update.AuditTime)
+		if err != nil {
+			return nil, err
+		}
+
+		stats := reputations.populateUpdateNodeStats(dbNode, update.UpdateRequest, auditHistoryResponse, update.AuditTime)
+		applyUpdateNodeStats(dbNode, stats, auditHistoryResponse.History)
+		changed = true
+	}
+	if !changed {
+		return nil, nil
+	}
+
+	write.newStatus = getNodeStatus(dbNode)
+	return write, nil
+}
+
+// applyUpdateNodeStats sets the fields of dbNode the same way as the fields
+// returned by populateUpdateFields.
+func applyUpdateNodeStats(dbNode *dbx.Reputation, update updateNodeStats, history []byte) {
+	dbNode.AuditHistory = history
+
+	setTime := func(field timeField, value **time.Time) {
+		if !field.set {
+			return
+		}
+		if field.isNil {
+			*value = nil
+			return
+		}
+		t := field.value
+		*value = &t
+	}
+
+	setTime(update.VettedAt, &dbNode.VettedAt)
+	setTime(update.Disqualified, &dbNode.Disqualified)
+	setTime(update.UnknownAuditSuspended, &dbNode.UnknownAuditSuspended)
+	setTime(update.OfflineSuspended, &dbNode.OfflineSuspended)
+	setTime(update.OfflineUnderReview, &dbNode.UnderReview)
+
+	if update.TotalAuditCount.set {
+		dbNode.TotalAuditCount = update.TotalAuditCount.value
+	}
+	if update.AuditSuccessCount.set {
+		dbNode.AuditSuccessCount = update.AuditSuccessCount.value
+	}
+	if update.AuditReputationAlpha.set {
+		dbNode.AuditReputationAlpha = update.AuditReputationAlpha.value
+	}
+	if update.AuditReputationBeta.set {
+		dbNode.AuditReputationBeta = update.AuditReputationBeta.value
+	}
+	if update.UnknownAuditReputationAlpha.set {
+		dbNode.UnknownAuditReputationAlpha = update.UnknownAuditReputationAlpha.value
+	}
+	if update.UnknownAuditReputationBeta.set {
+		dbNode.UnknownAuditReputationBeta = update.UnknownAuditReputationBeta.value
+	}
+	if update.Contained.set {
+		dbNode.Contained = update.Contained.value
+	}
+	if update.OnlineScore.set {
+		dbNode.OnlineScore = update.OnlineScore.value
+	}
+}
+
+// getAll returns the reputations of the nodes, nodes without an entry are
+// missing from the result.
+func (reputations *reputations) getAll(ctx context.Context, nodeIDs storj.NodeIDList) (_ map[storj.NodeID]*dbx.Reputation, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	rows, err := reputations.db.QueryContext(ctx, `
+		SELECT
+			id, audit_success_count, total_audit_count, vetted_at,
+			contained, disqualified, unknown_audit_suspended,
+			offline_suspended, under_review, online_score, audit_history,
+			audit_reputation_alpha, audit_reputation_beta,
+			unknown_audit_reputation_alpha, unknown_audit_reputation_beta
+		FROM reputations
+		WHERE id = ANY($1::BYTEA[])
+	`, pgutil.NodeIDArray(nodeIDs))
+	if err != nil {
+		return nil, err
+	}
+	defer func() { err = errs.Combine(err, rows.Close()) }()
+
+	dbNodes := make(map[storj.NodeID]*dbx.Reputation, len(nodeIDs))
+	for rows.Next() {
+		dbNode := &dbx.Reputation{}
+		err := rows.Scan(
+			&dbNode.Id, &dbNode.AuditSuccessCount, &dbNode.TotalAuditCount, &dbNode.VettedAt,
+			&dbNode.Contained, &dbNode.Disqualified, &dbNode.UnknownAuditSuspended,
+			&dbNode.OfflineSuspended, &dbNode.UnderReview, &dbNode.OnlineScore, &dbNode.AuditHistory,
+			&dbNode.AuditReputationAlpha, &dbNode.AuditReputationBeta,
+			&dbNode.UnknownAuditReputationAlpha, &dbNode.UnknownAuditReputationBeta,
+		)
+		if err != nil {
+			return nil, err
+		}
+
+		nodeID, err := storj.NodeIDFromBytes(dbNode.Id)
+		if err != nil {
+			return nil, err
+		}
+		dbNodes[nodeID] = dbNode
+	}
+
+	return dbNodes, rows.Err()
+}
+
+// createAll inserts the default reputation for the nodes which don't have an
+// entry yet.
+func (reputations *reputations) createAll(ctx context.Context, nodeIDs storj.NodeIDList) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	historyBytes, err := pb.Marshal(&internalpb.AuditHistory{})
+	if err != nil {
+		return err
+	}
+
+	_, err = reputations.db.ExecContext(ctx, `
+		INSERT INTO reputations (id, audit_history)
+		SELECT unnest($1::BYTEA[]), $2
+		ON CONFLICT (id) DO NOTHING
+	`, pgutil.NodeIDArray(nodeIDs), historyBytes)
+	return err
+}
+
+// writeAll writes the reputations with a single statement. A node is only
+// written when its audit history hasn't changed since it was read. It returns
+// the nodes which have been written.
+func (reputations *reputations) writeAll(ctx context.Context, writes []reputationWrite) (_ map[storj.NodeID]bool, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(writes) == 0 {
+		return nil, nil
+	}
+
+	var (
+		ids                    = make([][]byte, len(writes))
+		oldHistories           = make([][]byte, len(writes))
+		histories              = make([][]byte, len(writes))
+		auditSuccessCounts     = make([]int64, len(writes))
+		totalAuditCounts       = make([]int64, len(writes))
+		vettedAts              = make([]time.Time, len(writes))
+		disqualifieds          = make([]time.Time, len(writes))
+		unknownAuditSuspendeds = make([]time.Time, len(writes))
+		offlineSuspendeds      = make([]time.Time, len(writes))
+		underReviews           = make([]time.Time, len(writes))
+		onlineScores           = make([]float64, len(writes))
+		auditAlphas            = make([]float64, len(writes))
+		auditBetas             = make([]float64, len(writes))
+		unknownAuditAlphas     = make([]float64, len(writes))
+		unknownAuditBetas      = make([]float64, len(writes))
+	)
+
+	// there's no array type for nullable timestamps, hence the zero time
+	// is used for NULL.
+	nullable := func(t *time.Time) time.Time {
+		if t == nil {
+			return time.Time{}
+		}
+		return *t
+	}
+
+	for i, write := range writes {
+		node := write.node
+		ids[i] = node.Id
+		oldHistories[i] = write.oldHistory
+		histories[i] = node.AuditHistory
+		auditSuccessCounts[i] = node.AuditSuccessCount
+		totalAuditCounts[i] = node.TotalAuditCount
+		vettedAts[i] = nullable(node.VettedAt)
+		disqualifieds[i] = nullable(node.Disqualified)
+		unknownAuditSuspendeds[i] = nullable(node.UnknownAuditSuspended)
+		offlineSuspendeds[i] = nullable(node.OfflineSuspended)
+		underReviews[i] = nullable(node.UnderReview)
+		onlineScores[i] = node.OnlineScore
+		auditAlphas[i] = node.AuditReputationAlpha
+		auditBetas[i] = node.AuditReputationBeta
+		unknownAuditAlphas[i] = node.UnknownAuditReputationAlpha
+		unknownAuditBetas[i] = node.UnknownAuditReputationBeta
+	}
+
+	rows, err := reputations.db.QueryContext(ctx, `
+		UPDATE reputations SET
+			audit_history = u.audit_history,
+			audit_success_count = u.audit_success_count,
+			total_audit_count = u.total_audit_count,
+			vetted_at = NULLIF(u.vetted_at, $16::TIMESTAMPTZ),
+			-- updating node stats always exits it from containment mode
+			contained = false,
+			disqualified = NULLIF(u.disqualified, $16::TIMESTAMPTZ),
+			unknown_audit_suspended = NULLIF(u.unknown_audit_suspended, $16::TIMESTAMPTZ),
+			offline_suspended = NULLIF(u.offline_suspended, $16::TIMESTAMPTZ),
+			under_review = NULLIF(u.under_review, $16::TIMESTAMPTZ),
+			online_score = u.online_score,
+			audit_reputation_alpha = u.audit_reputation_alpha,
+			audit_reputation_beta = u.audit_reputation_beta,
+			unknown_audit_reputation_alpha = u.unknown_audit_reputation_alpha,
+			unknown_audit_reputation_beta = u.unknown_audit_reputation_beta,
+			updated_at = now()
+		FROM (
+			SELECT
+				unnest($1::BYTEA[]) AS id,
+				unnest($2::BYTEA[]) AS old_audit_history,
+				unnest($3::BYTEA[]) AS audit_history,
+				unnest($4::INT8[]) AS audit_success_count,
+				unnest($5::INT8[]) AS total_audit_count,
+				unnest($6::TIMESTAMPTZ[]) AS vetted_at,
+				unnest($7::TIMESTAMPTZ[]) AS disqualified,
+				unnest($8::TIMESTAMPTZ[]) AS unknown_audit_suspended,
+				unnest($9::TIMESTAMPTZ[]) AS offline_suspended,
+				unnest($10::TIMESTAMPTZ[]) AS under_review,
+				unnest($11::FLOAT8[]) AS online_score,
+				unnest($12::FLOAT8[]) AS audit_reputation_alpha,
+				unnest($13::FLOAT8[]) AS audit_reputation_beta,
+				unnest($14::FLOAT8[]) AS unknown_audit_reputation_alpha,
+				unnest($15::FLOAT8[]) AS unknown_audit_reputation_beta
+		) AS u
+		WHERE reputations.id = u.id AND reputations.audit_history = u.old_audit_history
+		RETURNING reputations.id
+	`, pgutil.ByteaArray(ids), pgutil.ByteaArray(oldHistories), pgutil.ByteaArray(histories),
+		pgutil.Int8Array(auditSuccessCounts), pgutil.Int8Array(totalAuditCounts),
+		pgutil.TimestampTZArray(vettedAts), pgutil.TimestampTZArray(disqualifieds),
+		pgutil.TimestampTZArray(unknownAuditSuspendeds), pgutil.TimestampTZArray(offlineSuspendeds),
+		pgutil.TimestampTZArray(underReviews),
+		pgutil.Float8Array(onlineScores),
+		pgutil.Float8Array(auditAlphas), pgutil.Float8Array(auditBetas),
+		pgutil.Float8Array(unknownAuditAlphas), pgutil.Float8Array(unknownAuditBetas),
+		time.Time{},
+	)
+	if err != nil {
+		return nil, err
+	}
+	defer func() { err = errs.Combine(err, rows.Close()) }()
+
+	written := make(map[storj.NodeID]bool, len(writes))
+	for rows.Next() {
+		var nodeID storj.NodeID
+		if err := rows.Scan(&nodeID); err != nil {
+			return nil, err
+		}
+		written[nodeID] = true
+	}
+
+	return written, rows.Err()
+}
+
 // SetNodeStatus updates node reputation status.
 func (reputations *reputations) SetNodeStatus(ctx context.Context, id storj.NodeID, status overlay.ReputationStatus) (err error) {
 	defer mon.Task()(&ctx)(&err)
@@ -0,0 +1,236 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package satellitedb
+
+import (
+	"context"
+	"math/rand"
+	"time"
+
+	"github.com/zeebo/errs"
+
+	"storj.io/common/uuid"
+	"storj.io/private/dbutil"
+	"storj.io/private/dbutil/pgutil"
+	"storj.io/storj/satellite/audit"
+)
+
+// verifyQueueShards is the number of shards the verification audits are
+// split into. Every lease starts from a random shard, so that concurrent
+// workers mostly take rows from different parts of the table.
+const verifyQueueShards = 16
+
+type verifyQueue struct {
+	db *satelliteDB
+}
+
+var _ audit.VerifyQueue = (*verifyQueue)(nil)
+
+// verifyQueueShard returns the shard of the segment. Stream ids are random,
+// so the segments are spread evenly between the shards.
+func verifyQueueShard(streamID uuid.UUID) int32 {
+	return int32(streamID[0]) % verifyQueueShards
+}
+
+// Push adds segments to the queue, in batches of at most maxBatchSize.
+func (queue *verifyQueue) Push(ctx context.Context, segments []audit.Segment, maxBatchSize int) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if maxBatchSize <= 0 {
+		maxBatchSize = len(segments)
+	}
+
+	for len(segments) > 0 {
+		batch := segments
+		if len(batch) > maxBatchSize {
+			batch = batch[:maxBatchSize]
+		}
+		segments = segments[len(batch):]
+
+		shards := make([]int32, 0, len(batch))
+		streamIDs := make([][]byte, 0, len(batch))
+		positions := make([]int64, 0, len(batch))
+		expiresAts := make([]time.Time, 0, len(batch))
+		for i := range batch {
+			segment := &batch[i]
+			shards = append(shards, verifyQueueShard(segment.StreamID))
+			streamIDs = append(streamIDs, segment.StreamID[:])
+			positions = append(positions, int64(segment.Position.Encode()))
+			// zero time is stored as NULL.
+			var expiresAt time.Time
+			if segment.ExpiresAt != nil {
+				expiresAt = *segment.ExpiresAt
+			}
+			expiresAts = append(expiresAts, expiresAt)
+		}
+
+		_, err = queue.db.ExecContext(ctx, `
+			INSERT INTO verification_audits (shard, stream_id, position, expires_at)
+			SELECT shard, stream_id, position, NULLIF(expires_at, $5::TIMESTAMPTZ)
+			FROM (
+				SELECT
+					unnest($1::INT4[]) AS shard,
+					unnest($2::BYTEA[]) AS stream_id,
+					unnest($3::INT8[]) AS position,
+					unnest($4::TIMESTAMPTZ[]) AS expires_at
+			) AS u
+			ON CONFLICT DO NOTHING
+		`, pgutil.Int4Array(shards), pgutil.ByteaArray(streamIDs), pgutil.Int8Array(positions),
+			pgutil.TimestampTZArray(expiresAts), time.Time{})
+		if err != nil {
+			return Error.Wrap(err)
+		}
+	}
+
+	return nil
+}
+
+// Lease returns up to limit segments, which are not leased by another worker,
+// and leases them for the given duration. Segments which have already been
+// leased maxAttempts times are removed.
+func (queue *verifyQueue) Lease(ctx context.Context, limit int, duration time.Duration, maxAttempts int) (segments []audit.Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if limit <= 0 {
+		return nil, nil
+	}
+
+	// take from the shards following a random one first and wrap around, to
+	// fill the batch, when they don't have enough segments.
+	start := rand.Int31n(verifyQueueShards)
+
+	segments, err = queue.leaseShards(ctx, start, verifyQueueShards, limit, duration, maxAttempts)
+	if err != nil {
+		return nil, err
+	}
+	if len(segments) < limit && start > 0 {
+		more, err := queue.leaseShards(ctx, 0, start, limit-len(segments), duration, maxAttempts)
+		if err != nil {
+			return segments, err
+		}
+		segments = append(segments, more...)
+	}
+
+	return segments, nil
+}
+
+// leaseShards leases up to limit segments from the shards in [start, end).
+// The segments which were leased too many times are removed, and others are
+// leased in their place.
+func (queue *verifyQueue) leaseShards(ctx context.Context, start, end int32, limit int, duration time.Duration, maxAttempts int) (segments []audit.Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	for len(segments) < limit {
+		leased, exhausted, err := queue.leaseShardsOnce(ctx, start, end, limit-len(segments), duration, maxAttempts)
+		if err != nil {
+			return segments, err
+		}
+		segments = append(segments, leased...)
+		if len(exhausted) == 0 {
+			break
+		}
+
+		// the segments whose audits keep failing are dropped, so that they
+		// don't take the workers from the other segments.
+		mon.IntVal("verify_queue_dropped_segments").Observe(int64(len(exhausted)))
+		if err := queue.Remove(ctx, exhausted); err != nil {
+			return segments, err
+		}
+	}
+
+	return segments, nil
+}
+
+// leaseShardsOnce leases up to limit segments from the shards in [start, end).
+// It returns the segments which were already leased maxAttempts times
+// separately.
+func (queue *verifyQueue) leaseShardsOnce(ctx context.Context, start, end int32, limit int, duration time.Duration, maxAttempts int) (segments, exhausted []audit.Segment, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	var query string
+	switch queue.db.impl {
+	case dbutil.Postgres:
+		query = `
+			UPDATE verification_audits
+			SET
+				leased_until = now() + $3 * INTERVAL '1 microsecond',
+				attempts = attempts + 1
+			WHERE (shard, stream_id, position) IN (
+				SELECT shard, stream_id, position FROM verification_audits
+				WHERE
+					shard >= $1 AND shard < $2
+					AND (leased_until IS NULL OR leased_until < now())
+				ORDER BY shard, stream_id, position
+				LIMIT $4
+				FOR UPDATE SKIP LOCKED
+			)
+			RETURNING stream_id, position, expires_at, attempts
+		`
+	case dbutil.Cockroach:
+		query = `
+			UPDATE verification_audits
+			SET
+				leased_until = now() + $3 * INTERVAL '1 microsecond',
+				attempts = attempts + 1
+			WHERE
+				shard >= $1 AND shard < $2
+				AND (leased_until IS NULL OR leased_until < now())
+			ORDER BY shard, stream_id, position
+			LIMIT $4
+			RETURNING stream_id, position, expires_at, attempts
+		`
+	default:
+		return nil, nil, errs.New("unhandled database: %v", queue.db.impl)
+	}
+
+	rows, err := queue.db.QueryContext(ctx, query, start, end, duration.Microseconds(), limit)
+	if err != nil {
+		return nil, nil, Error.Wrap(err)
+	}
+	defer func() { err = errs.Combine(err, Error.Wrap(rows.Close())) }()
+
+	for rows.Next() {
+		var segment audit.Segment
+		var attempts int
+		if err := rows.Scan(&segment.StreamID, &segment.Position, &segment.ExpiresAt, &attempts); err != nil {
+			return nil, nil, Error.Wrap(err)
+		}
+		if maxAttempts > 0 && attempts > maxAttempts {
+			exhausted = append(exhausted, segment)
+			continue
+		}
+		segments = append(segments, segment)
+	}
+	if err := rows.Err(); err != nil {
+		return nil, nil, Error.Wrap(err)
+	}
+
+	return segments, exhausted, nil
+}
+
+// Remove removes audited segments from the queue.
+func (queue *verifyQueue) Remove(ctx context.Context, segments []audit.Segment) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(segments) == 0 {
+		return nil
+	}
+
+	shards := make([]int32, 0, len(segments))
+	streamIDs := make([][]byte, 0, len(segments))
+	positions := make([]int64, 0, len(segments))
+	for i := range segments {
+		shards = append(shards, verifyQueueShard(segments[i].StreamID))
+		streamIDs = append(streamIDs, segments[i].StreamID[:])
+		positions = append(positions, int64(segments[i].Position.Encode()))
+	}
+
+	_, err = queue.db.ExecContext(ctx, `
+		DELETE FROM verification_audits
+		WHERE (shard, stream_id, position) IN (
+			SELECT unnest($1::INT4[]), unnest($2::BYTEA[]), unnest($3::INT8[])
+		)
+	`, pgutil.Int4Array(shards), pgutil.ByteaArray(streamIDs), pgutil.Int8Array(positions))
+	return Error.Wrap(err)
+}
@@ -539,6 +539,20 @@ func (dir *Dir) DeleteNamespace(ctx context.Context, ref []byte) (err error) {
 func (dir *Dir) deleteWithStorageFormatInPath(ctx context.Context, path string, ref storage.BlobRef, formatVer storage.FormatVersion) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	if canRemoveOpenFiles {
+		// the blob can be removed while it's being read, so a single unlink
+		// is enough in the common case.
+		pathBase, err := dir.refToDirPath(ref, path)
+		if err != nil {
+			return err
+		}
+		err = os.Remove(blobPathForFormatVersion(pathBase, formatVer))
+		if err == nil || os.IsNotExist(err) {
+			return nil
+		}
+		// fall back to the garbage dir and the delete queue.
+	}
+
 	// Ensure garbage dir exists so that we know any os.IsNotExist errors below
 	// are not from a missing garbage dir
 	_, err = os.Stat(dir.garbagedir())
@@ -13,6 +13,9 @@ import (
 	"golang.org/x/sys/unix"
 )
 
+// canRemoveOpenFiles is set when a blob can be removed while it is open.
+const canRemoveOpenFiles = true
+
 func isBusy(err error) bool {
 	err = underlyingError(err)
 	return errors.Is(err, unix.EBUSY)
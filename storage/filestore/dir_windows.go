@@ -17,6 +17,9 @@ import (
 
 var errSharingViolation = windows.Errno(32)
 
+// canRemoveOpenFiles is set when a blob can be removed while it is open.
+const canRemoveOpenFiles = false
+
 func isBusy(err error) bool {
 	err = underlyingError(err)
 	return errors.Is(err, errSharingViolation)
@@ -0,0 +1,598 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package filestore
+
+import (
+	"context"
+	"math/rand"
+	"os"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/zeebo/errs"
+	"go.uber.org/zap"
+	"golang.org/x/sync/errgroup"
+
+	"storj.io/common/storj"
+	"storj.io/storj/storage"
+)
+
+const (
+	// maxMultiStoreDirs is the maximum number of directories of a multiStore,
+	// so that a directory index fits in the location index.
+	maxMultiStoreDirs = 256
+	// locationEntrySize is the memory used by an entry of the location index.
+	locationEntrySize = 8
+	// freeSpaceRefreshInterval is how often the free space of a directory is
+	// read from the file system for the placement of the new blobs.
+	freeSpaceRefreshInterval = 10 * time.Second
+	// minCommitLatency is the commit latency assumed for a directory without
+	// measurements, and the lower bound of the measurements.
+	minCommitLatency = time.Millisecond
+)
+
+var _ storage.Blobs = (*multiStore)(nil)
+
+// multiStore is a blob store which spreads the blobs across several
+// directories, usually on different disks.
+//
+// A new blob is placed in a random directory, weighted by the free space of
+// the directory divided by its recent commit latency, so the faster and
+// emptier disks receive more of the writes. The directory of a blob is
+// remembered in a location index, which is filled as the blobs are created,
+// found and walked. A blob missing from the index is looked up in every
+// directory. The operations which concern all of the blobs, such as walking,
+// trash and garbage collection, run in parallel for every directory.
+//
+// The location index is a fixed size table, which uses config.LocationIndexSize
+// bytes of memory, 8 bytes per entry, regardless of the number of blobs. Every
+// entry holds the directory and the upper 56 bits of the hash of a blob, and
+// a blob is stored in the entry selected by its hash, replacing the blob
+// which was stored there before. So the blobs used recently are likely to be
+// found in the index, and the others are looked up in every directory.
+type multiStore struct {
+	log    *zap.Logger
+	stores []*blobStore
+	disks  []*diskStats
+
+	// locations is the location index, its entries are accessed atomically.
+	locations []uint64
+}
+
+// diskStats are the statistics of a directory used for placing the blobs.
+type diskStats struct {
+	// the fields are int64 for the atomic operations, which need them at the
+	// top of the struct on 32-bit platforms.
+
+	// free is the free space at the last refresh, minus the blobs committed
+	// since.
+	free int64
+	// refreshed is when free was last read from the file system, in unix
+	// nanoseconds.
+	refreshed int64
+	// latency is the moving average of the commit latency in nanoseconds.
+	latency int64
+}
+
+// NewMulti creates a blob store which spreads the blobs across the specified
+// directories.
+func NewMulti(ctx context.Context, log *zap.Logger, dirs []*Dir, config Config) (storage.Blobs, error) {
+	if len(dirs) == 0 || len(dirs) > maxMultiStoreDirs {
+		return nil, Error.New("invalid number of directories: %d", len(dirs))
+	}
+
+	store := &multiStore{
+		log:       log,
+		locations: make([]uint64, config.LocationIndexSize.Int64()/locationEntrySize),
+	}
+	for _, dir := range dirs {
+		store.stores = append(store.stores, &blobStore{dir: dir, log: log, config: config})
+
+		disk := &diskStats{}
+		if info, err := dir.Info(ctx); err == nil {
+			disk.free = info.AvailableSpace
+			disk.refreshed = time.Now().UnixNano()
+		}
+		store.disks = append(store.disks, disk)
+	}
+	return store, nil
+}
+
+// locationKey returns the key of the blob in the location index, which is
+// the 64-bit FNV-1a hash of the namespace and key.
+func locationKey(ref storage.BlobRef) uint64 {
+	const offset, prime = 14695981039346656037, 1099511628211
+
+	hash := uint64(offset)
+	for _, b := range ref.Namespace {
+		hash = (hash ^ uint64(b)) * prime
+	}
+	for _, b := range ref.Key {
+		hash = (hash ^ uint64(b)) * prime
+	}
+	return hash
+}
+
+// locationEntry returns the entry of the location index for the blob and
+// the upper 56 bits of its hash, which identify the blob in the entry.
+func (store *multiStore) locationEntry(ref storage.BlobRef) (entry *uint64, tag uint64) {
+	if len(store.locations) == 0 {
+		return nil, 0
+	}
+	key := locationKey(ref)
+	return &store.locations[key%uint64(len(store.locations))], key &^ 0xFF
+}
+
+// location returns the directory of the blob in the location index.
+func (store *multiStore) location(ref storage.BlobRef) (int, bool) {
+	entry, tag := store.locationEntry(ref)
+	if entry == nil {
+		return 0, false
+	}
+
+	value := atomic.LoadUint64(entry)
+	if value == 0 || value&^0xFF != tag {
+		return 0, false
+	}
+	return int(value & 0xFF), true
+}
+
+// setLocation records the directory of the blob in the location index.
+func (store *multiStore) setLocation(ref storage.BlobRef, i int) {
+	entry, tag := store.locationEntry(ref)
+	if entry == nil {
+		return
+	}
+	atomic.StoreUint64(entry, tag|uint64(i))
+}
+
+// removeLocation removes the blob from the location index.
+func (store *multiStore) removeLocation(ref storage.BlobRef) {
+	entry, tag := store.locationEntry(ref)
+	if entry == nil {
+		return
+	}
+
+	// the entry may have been reused by another blob.
+	value := atomic.LoadUint64(entry)
+	if value&^0xFF == tag {
+		atomic.CompareAndSwapUint64(entry, value, 0)
+	}
+}
+
+// locate calls fn for the directory of the blob, first trying the directory
+// in the location index and then the others, until fn doesn't return a not
+// found error.
+func (store *multiStore) locate(ref storage.BlobRef, fn func(i int, s *blobStore) error) error {
+	hint, hinted := store.location(ref)
+	if hinted {
+		err := fn(hint, store.stores[hint])
+		if !errs.IsFunc(err, os.IsNotExist) {
+			return err
+		}
+		store.removeLocation(ref)
+	}
+
+	err := error(os.ErrNotExist)
+	for i, s := range store.stores {
+		if hinted && i == hint {
+			continue
+		}
+		err = fn(i, s)
+		if !errs.IsFunc(err, os.IsNotExist) {
+			if err == nil {
+				store.setLocation(ref, i)
+			}
+			return err
+		}
+	}
+	return err
+}
+
+// forEach calls fn for the directories of the blob, which is every directory
+// unless the blob is in the location index.
+func (store *multiStore) forEach(ctx context.Context, ref storage.BlobRef, fn func(ctx context.Context, s *blobStore) error) error {
+	if i, ok := store.location(ref); ok {
+		return fn(ctx, store.stores[i])
+	}
+	return store.parallel(ctx, func(ctx context.Context, _ int, s *blobStore) error {
+		return fn(ctx, s)
+	})
+}
+
+// parallel calls fn for every directory in parallel.
+func (store *multiStore) parallel(ctx context.Context, fn func(ctx context.Context, i int, s *blobStore) error) error {
+	group, ctx := errgroup.WithContext(ctx)
+	for i, s := range store.stores {
+		i, s := i, s
+		group.Go(func() error {
+			return fn(ctx, i, s)
+		})
+	}
+	return group.Wait()
+}
+
+// place chooses the directory of a new blob of the specified size. A blob
+// which is stored already, for example with another format version, is kept
+// in its directory, when it has room.
+func (store *multiStore) place(ctx context.Context, ref storage.BlobRef, size int64) int {
+	if i, ok := store.location(ref); ok && store.disks[i].freeSpace(ctx, store.stores[i].dir) > size {
+		return i
+	}
+
+	weights := make([]float64, len(store.stores))
+	var total float64
+	for i, disk := range store.disks {
+		free := disk.freeSpace(ctx, store.stores[i].dir)
+		if free <= size {
+			continue
+		}
+
+		latency := atomic.LoadInt64(&disk.latency)
+		if latency < int64(minCommitLatency) {
+			latency = int64(minCommitLatency)
+		}
+
+		weights[i] = float64(free) / float64(latency)
+		total += weights[i]
+	}
+	if total == 0 {
+		// every directory is full, so the creation fails in the first one.
+		return 0
+	}
+
+	choice := rand.Float64() * total
+	for i, weight := range weights {
+		if choice < weight {
+			return i
+		}
+		choice -= weight
+	}
+	return len(weights) - 1
+}
+
+// freeSpace returns the free space of dir, which is refreshed from the file
+// system every freeSpaceRefreshInterval.
+func (disk *diskStats) freeSpace(ctx context.Context, dir *Dir) int64 {
+	now := time.Now().UnixNano()
+	refreshed := atomic.LoadInt64(&disk.refreshed)
+	if now-refreshed > int64(freeSpaceRefreshInterval) && atomic.CompareAndSwapInt64(&disk.refreshed, refreshed, now) {
+		if info, err := dir.Info(ctx); err == nil {
+			atomic.StoreInt64(&disk.free, info.AvailableSpace)
+		}
+	}
+	return atomic.LoadInt64(&disk.free)
+}
+
+// observeCommit updates the statistics with a committed blob.
+func (disk *diskStats) observeCommit(size int64, latency time.Duration) {
+	atomic.AddInt64(&disk.free, -size)
+
+	for {
+		average := atomic.LoadInt64(&disk.latency)
+		next := int64(latency)
+		if average > 0 {
+			next = average + (int64(latency)-average)/8
+		}
+		if atomic.CompareAndSwapInt64(&disk.latency, average, next) {
+			return
+		}
+	}
+}
+
+// multiBlobWriter records the location and the commit latency of a blob.
+type multiBlobWriter struct {
+	storage.BlobWriter
+	store *multiStore
+	index int
+	ref   storage.BlobRef
+}
+
+// Commit commits the blob and records its location.
+func (blob *multiBlobWriter) Commit(ctx context.Context) error {
+	size, sizeErr := blob.BlobWriter.Size()
+	if sizeErr != nil {
+		size = 0
+	}
+
+	start := time.Now()
+	if err := blob.BlobWriter.Commit(ctx); err != nil {
+		return err
+	}
+	blob.store.disks[blob.index].observeCommit(size, time.Since(start))
+	blob.store.setLocation(blob.ref, blob.index)
+	return nil
+}
+
+// Close closes the stores.
+func (store *multiStore) Close() (err error) {
+	for _, s := range store.stores {
+		err = errs.Combine(err, s.Close())
+	}
+	return err
+}
+
+// Create creates a new blob in the directory chosen for it.
+func (store *multiStore) Create(ctx context.Context, ref storage.BlobRef, size int64) (_ storage.BlobWriter, err error) {
+	defer mon.Task()(&ctx)(&err)
+	i := store.place(ctx, ref, size)
+	writer, err := store.stores[i].Create(ctx, ref, size)
+	if err != nil {
+		return nil, err
+	}
+	return &multiBlobWriter{BlobWriter: writer, store: store, index: i, ref: ref}, nil
+}
+
+// TestCreateV0 creates a new V0 blob that can be written. This is ONLY appropriate in test situations.
+func (store *multiStore) TestCreateV0(ctx context.Context, ref storage.BlobRef) (_ storage.BlobWriter, err error) {
+	defer mon.Task()(&ctx)(&err)
+	i := store.place(ctx, ref, 0)
+	writer, err := store.stores[i].TestCreateV0(ctx, ref)
+	if err != nil {
+		return nil, err
+	}
+	return &multiBlobWriter{BlobWriter: writer, store: store, index: i, ref: ref}, nil
+}
+
+// Open opens the blob in the directory it is stored in.
+func (store *multiStore) Open(ctx context.Context, ref storage.BlobRef) (reader storage.BlobReader, err error) {
+	defer mon.Task()(&ctx)(&err)
+	err = store.locate(ref, func(_ int, s *blobStore) (err error) {
+		reader, err = s.Open(ctx, ref)
+		return err
+	})
+	return reader, err
+}
+
+// OpenWithStorageFormat opens the already-located blob with the given storage format version.
+func (store *multiStore) OpenWithStorageFormat(ctx context.Context, ref storage.BlobRef, formatVer storage.FormatVersion) (reader storage.BlobReader, err error) {
+	defer mon.Task()(&ctx)(&err)
+	err = store.locate(ref, func(_ int, s *blobStore) (err error) {
+		reader, err = s.OpenWithStorageFormat(ctx, ref, formatVer)
+		return err
+	})
+	return reader, err
+}
+
+// Stat looks up disk metadata on the blob file.
+func (store *multiStore) Stat(ctx context.Context, ref storage.BlobRef) (info storage.BlobInfo, err error) {
+	defer mon.Task()(&ctx)(&err)
+	err = store.locate(ref, func(_ int, s *blobStore) (err error) {
+		info, err = s.Stat(ctx, ref)
+		return err
+	})
+	return info, err
+}
+
+// StatWithStorageFormat looks up disk metadata on the blob file with the given storage format version.
+func (store *multiStore) StatWithStorageFormat(ctx context.Context, ref storage.BlobRef, formatVer storage.FormatVersion) (info storage.BlobInfo, err error) {
+	defer mon.Task()(&ctx)(&err)
+	err = store.locate(ref, func(_ int, s *blobStore) (err error) {
+		info, err = s.StatWithStorageFormat(ctx, ref, formatVer)
+		return err
+	})
+	return info, err
+}
+
+// Delete deletes blobs with the specified ref.
+func (store *multiStore) Delete(ctx context.Context, ref storage.BlobRef) (err error) {
+	defer mon.Task()(&ctx)(&err)
+	err = store.forEach(ctx, ref, func(ctx context.Context, s *blobStore) error {
+		return s.Delete(ctx, ref)
+	})
+	store.removeLocation(ref)
+	return err
+}
+
+// DeleteWithStorageFormat deletes blobs with the specified ref and storage format version.
+func (store *multiStore) DeleteWithStorageFormat(ctx context.Context, ref storage.BlobRef, formatVer storage.FormatVersion) (err error) {
+	defer mon.Task()(&ctx)(&err)
+	// the location index doesn't tell the format version, and the blob may
+	// be stored with another one in a different directory, so every
+	// directory is checked and the location is kept.
+	return store.parallel(ctx, func(ctx context.Context, _ int, s *blobStore) error {
+		return s.DeleteWithStorageFormat(ctx, ref, formatVer)
+	})
+}
+
+// DeleteNamespace deletes the blobs folder of the namespace in every directory.
+func (store *multiStore) DeleteNamespace(ctx context.Context, ref []byte) (err error) {
+	defer mon.Task()(&ctx)(&err)
+	return store.parallel(ctx, func(ctx context.Context, _ int, s *blobStore) error {
+		return s.DeleteNamespace(ctx, ref)
+	})
+}
+
+// Trash moves the blob to the trash of its directory.
+func (store *multiStore) Trash(ctx context.Context, ref storage.BlobRef) (err error) {
+	defer mon.Task()(&ctx)(&err)
+	err = store.forEach(ctx, ref, func(ctx context.Context, s *blobStore) error {
+		return s.Trash(ctx, ref)
+	})
+	store.removeLocation(ref)
+	return err
+}
+
+// RestoreTrash restores the trash of the namespace in every directory.
+func (store *multiStore) RestoreTrash(ctx context.Context, namespace []byte) (keysRestored [][]byte, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	var mu sync.Mutex
+	err = store.parallel(ctx, func(ctx context.Context, i int, s *blobStore) error {
+		keys, err := s.RestoreTrash(ctx, namespace)
+
+		mu.Lock()
+		defer mu.Unlock()
+		for _, key := range keys {
+			store.setLocation(storage.BlobRef{Namespace: namespace, Key: key}, i)
+		}
+		keysRestored = append(keysRestored, keys...)
+		return err
+	})
+	return keysRestored, err
+}
+
+// EmptyTrash empties the trash of the namespace in every directory.
+func (store *multiStore) EmptyTrash(ctx context.Context, namespace []byte, trashedBefore time.Time) (bytesEmptied int64, keys [][]byte, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	var mu sync.Mutex
+	err = store.parallel(ctx, func(ctx context.Context, _ int, s *blobStore) error {
+		emptied, deleted, err := s.EmptyTrash(ctx, namespace, trashedBefore)
+
+		mu.Lock()
+		defer mu.Unlock()
+		bytesEmptied += emptied
+		keys = append(keys, deleted...)
+		return err
+	})
+	return bytesEmptied, keys, err
+}
+
+// GarbageCollect tries to delete any files that haven't yet been deleted in every directory.
+func (store *multiStore) GarbageCollect(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+	return store.parallel(ctx, func(ctx context.Context, _ int, s *blobStore) error {
+		return s.GarbageCollect(ctx)
+	})
+}
+
+// sum adds up fn for every directory, calling it in parallel.
+func (store *multiStore) sum(ctx context.Context, fn func(ctx context.Context, s *blobStore) (int64, error)) (total int64, err error) {
+	var mu sync.Mutex
+	err = store.parallel(ctx, func(ctx context.Context, _ int, s *blobStore) error {
+		value, err := fn(ctx, s)
+
+		mu.Lock()
+		defer mu.Unlock()
+		total += value
+		return err
+	})
+	return total, err
+}
+
+// SpaceUsedForBlobs adds up the space used for the blobs in every directory.
+func (store *multiStore) SpaceUsedForBlobs(ctx context.Context) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+	return store.sum(ctx, func(ctx context.Context, s *blobStore) (int64, error) {
+		return s.SpaceUsedForBlobs(ctx)
+	})
+}
+
+// SpaceUsedForBlobsInNamespace adds up the space used for the blobs of the namespace in every directory.
+func (store *multiStore) SpaceUsedForBlobsInNamespace(ctx context.Context, namespace []byte) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+	return store.sum(ctx, func(ctx context.Context, s *blobStore) (int64, error) {
+		return s.SpaceUsedForBlobsInNamespace(ctx, namespace)
+	})
+}
+
+// SpaceUsedForTrash adds up the space used for the trash in every directory.
+func (store *multiStore) SpaceUsedForTrash(ctx context.Context) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+	return store.sum(ctx, func(ctx context.Context, s *blobStore) (int64, error) {
+		return s.SpaceUsedForTrash(ctx)
+	})
+}
+
+// FreeSpace adds up the free space of every directory.
+func (store *multiStore) FreeSpace(ctx context.Context) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	// directories on the same disk would count its free space twice.
+	seen := make(map[string]bool)
+	var total int64
+	for i, s := range store.stores {
+		info, err := s.dir.Info(ctx)
+		if err != nil {
+			return 0, err
+		}
+		atomic.StoreInt64(&store.disks[i].free, info.AvailableSpace)
+		atomic.StoreInt64(&store.disks[i].refreshed, time.Now().UnixNano())
+
+		if info.ID != "" && seen[info.ID] {
+			continue
+		}
+		seen[info.ID] = true
+		total += info.AvailableSpace
+	}
+	return total, nil
+}
+
+// CheckWritability tests the writability of every directory.
+func (store *multiStore) CheckWritability(ctx context.Context) error {
+	for _, s := range store.stores {
+		if err := s.CheckWritability(ctx); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// ListNamespaces finds the namespaces of every directory.
+func (store *multiStore) ListNamespaces(ctx context.Context) (ids [][]byte, err error) {
+	seen := make(map[string]bool)
+	for _, s := range store.stores {
+		namespaces, err := s.ListNamespaces(ctx)
+		if err != nil {
+			return nil, err
+		}
+		for _, namespace := range namespaces {
+			if !seen[string(namespace)] {
+				seen[string(namespace)] = true
+				ids = append(ids, namespace)
+			}
+		}
+	}
+	return ids, nil
+}
+
+// WalkNamespace walks the namespace of every directory in parallel, while
+// walkFunc is called for one blob at a time. The walked blobs are added to
+// the location index.
+func (store *multiStore) WalkNamespace(ctx context.Context, namespace []byte, walkFunc func(storage.BlobInfo) error) (err error) {
+	var mu sync.Mutex
+	return store.parallel(ctx, func(ctx context.Context, i int, s *blobStore) error {
+		return s.WalkNamespace(ctx, namespace, func(info storage.BlobInfo) error {
+			store.setLocation(info.BlobRef(), i)
+
+			mu.Lock()
+			defer mu.Unlock()
+			return walkFunc(info)
+		})
+	})
+}
+
+// CreateVerificationFile creates the verification file in every directory.
+func (store *multiStore) CreateVerificationFile(ctx context.Context, id storj.NodeID) error {
+	for _, s := range store.stores {
+		if err := s.CreateVerificationFile(ctx, id); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// VerifyStorageDir verifies the verification file of every directory. An
+// added directory without any blobs gets the verification file created.
+func (store *multiStore) VerifyStorageDir(ctx context.Context, id storj.NodeID) error {
+	for i, s := range store.stores {
+		err := s.VerifyStorageDir(ctx, id)
+		if i > 0 && os.IsNotExist(err) {
+			namespaces, listErr := s.ListNamespaces(ctx)
+			if listErr != nil {
+				return listErr
+			}
+			if len(namespaces) == 0 {
+				store.log.Info("creating the verification file of an added storage directory", zap.String("path", s.dir.Path()))
+				err = s.CreateVerificationFile(ctx, id)
+			}
+		}
+		if err != nil {
+			return err
+		}
+	}
+	return nil
+}
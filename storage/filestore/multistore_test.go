@@ -0,0 +1,200 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package filestore_test
+
+import (
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"github.com/zeebo/errs"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/storage"
+	"storj.io/storj/storage/filestore"
+)
+
+func TestMultiStore(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	log := zaptest.NewLogger(t)
+
+	paths := []string{ctx.Dir("disk0"), ctx.Dir("disk1"), ctx.Dir("disk2")}
+
+	// a small location index, so the blobs replace each other in it.
+	config := filestore.DefaultConfig
+	config.LocationIndexSize = 16 * 8
+	open := func() storage.Blobs {
+		var dirs []*filestore.Dir
+		for _, path := range paths {
+			dir, err := filestore.NewDir(log, path)
+			require.NoError(t, err)
+			dirs = append(dirs, dir)
+		}
+		store, err := filestore.NewMulti(ctx, log, dirs, config)
+		require.NoError(t, err)
+		return store
+	}
+
+	store := open()
+	defer ctx.Check(store.Close)
+
+	namespace := testrand.Bytes(32)
+	data := testrand.Bytes(1024)
+
+	var refs []storage.BlobRef
+	for i := 0; i < 60; i++ {
+		ref := storage.BlobRef{Namespace: namespace, Key: testrand.Bytes(32)}
+		refs = append(refs, ref)
+
+		writer, err := store.Create(ctx, ref, int64(len(data)))
+		require.NoError(t, err)
+		_, err = writer.Write(data)
+		require.NoError(t, err)
+		require.NoError(t, writer.Commit(ctx))
+	}
+
+	// the blobs are spread across the directories.
+	for _, path := range paths {
+		var count int
+		require.NoError(t, filepath.Walk(filepath.Join(path, "blobs"), func(_ string, info os.FileInfo, err error) error {
+			if err == nil && !info.IsDir() {
+				count++
+			}
+			return err
+		}))
+		require.NotZero(t, count, path)
+	}
+
+	used, err := store.SpaceUsedForBlobs(ctx)
+	require.NoError(t, err)
+	require.Equal(t, int64(len(refs)*len(data)), used)
+
+	// a reopened store finds the blobs without the location index.
+	reopened := open()
+	defer ctx.Check(reopened.Close)
+
+	for _, ref := range refs {
+		reader, err := reopened.Open(ctx, ref)
+		require.NoError(t, err)
+		read, err := ioutil.ReadAll(reader)
+		require.NoError(t, err)
+		require.NoError(t, reader.Close())
+		require.Equal(t, data, read)
+	}
+
+	var walked int
+	require.NoError(t, reopened.WalkNamespace(ctx, namespace, func(storage.BlobInfo) error {
+		walked++
+		return nil
+	}))
+	require.Equal(t, len(refs), walked)
+
+	// trash, restore and delete reach the blobs in every directory.
+	for _, ref := range refs[:10] {
+		require.NoError(t, reopened.Trash(ctx, ref))
+		_, err := reopened.Stat(ctx, ref)
+		require.True(t, errs.IsFunc(err, os.IsNotExist), err)
+	}
+
+	restored, err := reopened.RestoreTrash(ctx, namespace)
+	require.NoError(t, err)
+	require.Len(t, restored, 10)
+
+	for _, ref := range refs {
+		require.NoError(t, store.Delete(ctx, ref))
+		_, err := reopened.Open(ctx, ref)
+		require.True(t, os.IsNotExist(err), err)
+	}
+
+	_, deleted, err := reopened.EmptyTrash(ctx, namespace, time.Now())
+	require.NoError(t, err)
+	require.Empty(t, deleted)
+}
+
+func TestMultiStoreMigrateV0ToV1(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	log := zaptest.NewLogger(t)
+
+	paths := []string{ctx.Dir("disk0"), ctx.Dir("disk1"), ctx.Dir("disk2")}
+	open := func() storage.Blobs {
+		var dirs []*filestore.Dir
+		for _, path := range paths {
+			dir, err := filestore.NewDir(log, path)
+			require.NoError(t, err)
+			dirs = append(dirs, dir)
+		}
+		store, err := filestore.NewMulti(ctx, log, dirs, filestore.DefaultConfig)
+		require.NoError(t, err)
+		return store
+	}
+
+	store := open()
+	defer ctx.Check(store.Close)
+
+	namespace := testrand.Bytes(32)
+	data := testrand.Bytes(1024)
+
+	var refs []storage.BlobRef
+	for i := 0; i < 30; i++ {
+		ref := storage.BlobRef{Namespace: namespace, Key: testrand.Bytes(32)}
+		refs = append(refs, ref)
+
+		writer, err := store.TestCreateV0(ctx, ref)
+		require.NoError(t, err)
+		_, err = writer.Write(data)
+		require.NoError(t, err)
+		require.NoError(t, writer.Commit(ctx))
+	}
+
+	// the blobs in the location index are migrated in their directory, while
+	// the reopened store places the V1 blobs in any directory.
+	reopened := open()
+	defer ctx.Check(reopened.Close)
+
+	migrate := func(store storage.Blobs, ref storage.BlobRef) {
+		writer, err := store.Create(ctx, ref, int64(len(data)))
+		require.NoError(t, err)
+		_, err = writer.Write(data)
+		require.NoError(t, err)
+		require.NoError(t, writer.Commit(ctx))
+
+		require.NoError(t, store.DeleteWithStorageFormat(ctx, ref, filestore.FormatV0))
+	}
+	for _, ref := range refs[:10] {
+		migrate(store, ref)
+	}
+	for _, ref := range refs[10:] {
+		migrate(reopened, ref)
+	}
+
+	// no V0 blob is left behind in another directory.
+	for _, store := range []storage.Blobs{store, reopened} {
+		var walked int
+		require.NoError(t, store.WalkNamespace(ctx, namespace, func(info storage.BlobInfo) error {
+			require.Equal(t, filestore.FormatV1, info.StorageFormatVersion())
+			walked++
+			return nil
+		}))
+		require.Equal(t, len(refs), walked)
+
+		used, err := store.SpaceUsedForBlobs(ctx)
+		require.NoError(t, err)
+		require.Equal(t, int64(len(refs)*len(data)), used)
+	}
+
+	for _, ref := range refs {
+		info, err := reopened.Stat(ctx, ref)
+		require.NoError(t, err)
+		require.Equal(t, filestore.FormatV1, info.StorageFormatVersion())
+	}
+}
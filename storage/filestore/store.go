@@ -37,12 +37,15 @@ func monFileInTrash(namespace []byte) *monkit.Meter {
 
 // Config is configuration for the blob store.
 type Config struct {
-	WriteBufferSize memory.Size `help:"in-memory buffer for uploads" default:"128KiB"`
+	WriteBufferSize   memory.Size `help:"in-memory buffer for uploads" default:"128KiB"`
+	ExtraPaths        []string    `help:"additional directories, usually on other disks, to spread the pieces across"`
+	LocationIndexSize memory.Size `help:"memory used to remember the directories of the pieces, when extra paths are set" default:"32MiB"`
 }
 
 // DefaultConfig is the default value for Config.
 var DefaultConfig = Config{
-	WriteBufferSize: 128 * memory.KiB,
+	WriteBufferSize:   128 * memory.KiB,
+	LocationIndexSize: 32 * memory.MiB,
 }
 
 // blobStore implements a blob store.
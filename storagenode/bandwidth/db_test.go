@@ -15,6 +15,7 @@ import (
 	"storj.io/common/storj"
 	"storj.io/common/testcontext"
 	"storj.io/common/testrand"
+	"storj.io/storj/private/date"
 	"storj.io/storj/storagenode"
 	"storj.io/storj/storagenode/bandwidth"
 	"storj.io/storj/storagenode/storagenodedb/storagenodedbtest"
@@ -571,6 +572,70 @@ func TestBandwidthRollup(t *testing.T) {
 	})
 }
 
+func TestBandwidthPersist(t *testing.T) {
+	storagenodedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db storagenode.DB) {
+		bandwidthdb := db.Bandwidth()
+
+		satelliteID := testrand.NodeID()
+		now := time.Now()
+
+		check := func(expected int64) {
+			usage, err := bandwidthdb.Summary(ctx, now.Add(-time.Hour), now.Add(time.Hour))
+			require.NoError(t, err)
+			require.Equal(t, expected, usage.Total())
+
+			usage, err = bandwidthdb.SatelliteSummary(ctx, satelliteID, now.Add(-time.Hour), now.Add(time.Hour))
+			require.NoError(t, err)
+			require.Equal(t, expected, usage.Total())
+
+			usageBySatellite, err := bandwidthdb.SummaryBySatellite(ctx, now.Add(-time.Hour), now.Add(time.Hour))
+			require.NoError(t, err)
+			require.Equal(t, expected, usageBySatellite[satelliteID].Total())
+
+			monthly, err := bandwidthdb.MonthSummary(ctx, now)
+			require.NoError(t, err)
+			require.Equal(t, expected, monthly)
+
+			rollups, err := bandwidthdb.GetDailySatelliteRollups(ctx, satelliteID, now, now)
+			require.NoError(t, err)
+			require.Len(t, rollups, 1)
+			require.Equal(t, expected, rollups[0].Egress.Usage+rollups[0].Ingress.Usage)
+
+			// the whole current month is served from the usage kept in memory.
+			from, to := date.MonthBoundary(now.UTC())
+
+			usage, err = bandwidthdb.Summary(ctx, from, to)
+			require.NoError(t, err)
+			require.Equal(t, expected, usage.Total())
+
+			usage, err = bandwidthdb.SatelliteEgressSummary(ctx, satelliteID, from, to)
+			require.NoError(t, err)
+			require.Equal(t, expected-2, usage.Total())
+
+			rollups, err = bandwidthdb.GetDailyRollups(ctx, from, to)
+			require.NoError(t, err)
+			require.Len(t, rollups, 1)
+			require.Equal(t, expected, rollups[0].Egress.Usage+rollups[0].Ingress.Usage)
+		}
+
+		// the usage which isn't persisted yet is included.
+		require.NoError(t, bandwidthdb.Add(ctx, satelliteID, pb.PieceAction_PUT, 2, now))
+		require.NoError(t, bandwidthdb.Add(ctx, satelliteID, pb.PieceAction_GET, 3, now))
+		check(5)
+
+		require.NoError(t, bandwidthdb.Persist(ctx))
+		check(5)
+
+		// persisting adds to the hourly rollup which is already stored.
+		require.NoError(t, bandwidthdb.Add(ctx, satelliteID, pb.PieceAction_GET, 4, now))
+		check(9)
+
+		require.NoError(t, bandwidthdb.Persist(ctx))
+		require.NoError(t, bandwidthdb.Persist(ctx))
+		check(9)
+	})
+}
+
 func TestDB_Trivial(t *testing.T) {
 	storagenodedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db storagenode.DB) {
 		{ // Ensure Add works at all
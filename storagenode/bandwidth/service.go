@@ -10,6 +10,7 @@ import (
 
 	"github.com/spacemonkeygo/monkit/v3"
 	"go.uber.org/zap"
+	"golang.org/x/sync/errgroup"
 
 	"storj.io/common/sync2"
 )
@@ -18,31 +19,52 @@ var mon = monkit.Package()
 
 // Config defines parameters for storage node Collector.
 type Config struct {
-	Interval time.Duration `help:"how frequently bandwidth usage rollups are calculated" default:"1h0m0s"`
+	Interval        time.Duration `help:"how frequently bandwidth usage rollups are calculated" default:"1h0m0s"`
+	PersistInterval time.Duration `help:"how frequently the bandwidth usage kept in memory is written to the database, which bounds the usage lost on a crash" default:"1m0s"`
 }
 
 // Service implements the bandwidth usage rollup service.
 //
+// The bandwidth usage is kept in memory by the database and written with
+// PersistLoop, so at most PersistInterval of usage is lost on a crash.
+//
 // architecture: Chore
 type Service struct {
-	log  *zap.Logger
-	db   DB
-	Loop *sync2.Cycle
+	log         *zap.Logger
+	db          DB
+	Loop        *sync2.Cycle
+	PersistLoop *sync2.Cycle
 }
 
 // NewService creates a new bandwidth service.
 func NewService(log *zap.Logger, db DB, config Config) *Service {
 	return &Service{
-		log:  log,
-		db:   db,
-		Loop: sync2.NewCycle(config.Interval),
+		log:         log,
+		db:          db,
+		Loop:        sync2.NewCycle(config.Interval),
+		PersistLoop: sync2.NewCycle(config.PersistInterval),
 	}
 }
 
-// Run starts the background process for rollups of bandwidth usage.
+// Run starts the background processes for persisting and rollups of bandwidth usage.
 func (service *Service) Run(ctx context.Context) (err error) {
 	defer mon.Task()(&ctx)(&err)
-	return service.Loop.Run(ctx, service.Rollup)
+
+	var group errgroup.Group
+	service.Loop.Start(ctx, &group, service.Rollup)
+	service.PersistLoop.Start(ctx, &group, service.Persist)
+	return group.Wait()
+}
+
+// Persist calls bandwidth DB Persist method and logs any errors.
+func (service *Service) Persist(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	err = service.db.Persist(ctx)
+	if err != nil {
+		service.log.Error("Could not persist bandwidth usage", zap.Error(err))
+	}
+	return nil
 }
 
 // Rollup calls bandwidth DB Rollup method and logs any errors.
@@ -60,5 +82,6 @@ func (service *Service) Rollup(ctx context.Context) (err error) {
 // Close stops the background process for rollups of bandwidth usage.
 func (service *Service) Close() (err error) {
 	service.Loop.Close()
+	service.PersistLoop.Close()
 	return nil
 }
@@ -19,6 +19,8 @@ type DB interface {
 	// MonthSummary returns summary of the current months bandwidth usages.
 	MonthSummary(ctx context.Context, now time.Time) (int64, error)
 	Rollup(ctx context.Context) (err error)
+	// Persist writes the bandwidth usage, which is kept in memory, to the database.
+	Persist(ctx context.Context) (err error)
 	// Summary returns summary of bandwidth usages.
 	Summary(ctx context.Context, from, to time.Time) (*Usage, error)
 	// EgressSummary returns summary of egress bandwidth usages.
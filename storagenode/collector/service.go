@@ -93,8 +93,14 @@ func (service *Service) Collect(ctx context.Context, now time.Time) (err error)
 			return nil
 		}
 
-		for _, expired := range infos {
-			err := service.pieces.Delete(ctx, expired.SatelliteID, expired.PieceID)
+		// the expiration records of the batch are removed together.
+		deleteErrs, err := service.pieces.DeleteExpiredBatch(ctx, infos)
+		if err != nil {
+			return err
+		}
+
+		for i, expired := range infos {
+			err := deleteErrs[i]
 			if err != nil {
 				if os.IsNotExist(errors.Unwrap(err)) {
 					service.log.Info("file does not exist", zap.Stringer("Satellite ID", expired.SatelliteID), zap.Stringer("Piece ID", expired.PieceID))
@@ -45,12 +45,16 @@ type Config struct {
 	MinimumDiskSpace          memory.Size   `help:"how much disk space a node at minimum has to advertise" default:"500GB"`
 	MinimumBandwidth          memory.Size   `help:"how much bandwidth a node at minimum has to advertise (deprecated)" default:"0TB"`
 	NotifyLowDiskCooldown     time.Duration `help:"minimum length of time between capacity reports" default:"10m" hidden:"true"`
+	SpaceRefreshInterval      time.Duration `help:"how frequently the estimate of the space available for uploads is refreshed from the disk" default:"10s"`
 }
 
 // Service which monitors disk usage.
 //
 // architecture: Service
 type Service struct {
+	// Moved to top of struct to resolve alignment issue with atomic operations on ARM
+	space availableSpace
+
 	log                   *zap.Logger
 	store                 *pieces.Store
 	contact               *contact.Service
@@ -60,6 +64,7 @@ type Service struct {
 	Loop                  *sync2.Cycle
 	VerifyDirReadableLoop *sync2.Cycle
 	VerifyDirWritableLoop *sync2.Cycle
+	SpaceRefreshLoop      *sync2.Cycle
 	Config                Config
 }
 
@@ -75,6 +80,7 @@ func NewService(log *zap.Logger, store *pieces.Store, contact *contact.Service,
 		Loop:                  sync2.NewCycle(interval),
 		VerifyDirReadableLoop: sync2.NewCycle(config.VerifyDirReadableInterval),
 		VerifyDirWritableLoop: sync2.NewCycle(config.VerifyDirWritableInterval),
+		SpaceRefreshLoop:      sync2.NewCycle(config.SpaceRefreshInterval),
 		Config:                config,
 	}
 }
@@ -142,6 +148,15 @@ func (service *Service) Run(ctx context.Context) (err error) {
 			return nil
 		})
 	})
+	group.Go(func() error {
+		return service.SpaceRefreshLoop.Run(ctx, func(ctx context.Context) error {
+			err := service.refreshSpace(ctx)
+			if err != nil {
+				service.log.Error("error refreshing available space: ", zap.Error(err))
+			}
+			return nil
+		})
+	})
 	group.Go(func() error {
 		return service.Loop.Run(ctx, func(ctx context.Context) error {
 			err := service.updateNodeInformation(ctx)
@@ -176,6 +191,7 @@ func (service *Service) NotifyLowDisk() {
 // Close stops the monitor service.
 func (service *Service) Close() (err error) {
 	service.Loop.Close()
+	service.SpaceRefreshLoop.Close()
 	service.cooldown.Close()
 	return nil
 }
@@ -194,30 +210,15 @@ func (service *Service) updateNodeInformation(ctx context.Context) (err error) {
 	return nil
 }
 
-// AvailableSpace returns available disk space for upload.
+// AvailableSpace returns available disk space for upload. The estimate
+// used for reserving space is refreshed as well.
 func (service *Service) AvailableSpace(ctx context.Context) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	usedSpace, err := service.store.SpaceUsedForPiecesAndTrash(ctx)
-	if err != nil {
+	if err := service.refreshSpace(ctx); err != nil {
 		return 0, err
 	}
-
-	freeSpaceForStorj := service.allocatedDiskSpace - usedSpace
-
-	diskStatus, err := service.store.StorageStatus(ctx)
-	if err != nil {
-		return 0, Error.Wrap(err)
-	}
-	if diskStatus.DiskFree < freeSpaceForStorj {
-		freeSpaceForStorj = diskStatus.DiskFree
-	}
-
-	mon.IntVal("allocated_space").Observe(service.allocatedDiskSpace)
-	mon.IntVal("used_space").Observe(usedSpace)
-	mon.IntVal("available_space").Observe(freeSpaceForStorj)
-
-	return freeSpaceForStorj, nil
+	return service.space.Available(), nil
 }
 
 // DiskSpace returns consolidated disk space state info.
@@ -4,10 +4,12 @@
 package monitor_test
 
 import (
+	"sync/atomic"
 	"testing"
 
 	"github.com/stretchr/testify/assert"
 	"github.com/stretchr/testify/require"
+	"golang.org/x/sync/errgroup"
 
 	"storj.io/common/memory"
 	"storj.io/common/testcontext"
@@ -43,3 +45,53 @@ func TestMonitor(t *testing.T) {
 		assert.NotZero(t, nodeAssertions, "No storage node were verifed")
 	})
 }
+
+func TestReserveSpace(t *testing.T) {
+	testplanet.Run(t, testplanet.Config{
+		SatelliteCount: 1, StorageNodeCount: 1, UplinkCount: 0,
+	}, func(t *testing.T, ctx *testcontext.Context, planet *testplanet.Planet) {
+		monitor := planet.StorageNodes[0].Storage2.Monitor
+		monitor.Loop.Pause()
+		monitor.SpaceRefreshLoop.Pause()
+
+		available, err := monitor.AvailableSpace(ctx)
+		require.NoError(t, err)
+		require.Greater(t, available, int64(0))
+
+		amount := available / 4
+
+		// concurrent uploads can't reserve more than is available.
+		var accepted int64
+		var group errgroup.Group
+		for i := 0; i < 8; i++ {
+			group.Go(func() error {
+				reservation, _, err := monitor.ReserveSpace(ctx, amount)
+				if reservation != nil {
+					atomic.AddInt64(&accepted, 1)
+				}
+				return err
+			})
+		}
+		require.NoError(t, group.Wait())
+		require.LessOrEqual(t, accepted, int64(4))
+		require.Greater(t, accepted, int64(0))
+
+		// the accepted reservations are still held.
+		reservation, have, err := monitor.ReserveSpace(ctx, available)
+		require.NoError(t, err)
+		require.Nil(t, reservation)
+		require.Equal(t, available-accepted*amount, have)
+
+		reservation, have, err = monitor.ReserveSpace(ctx, 100)
+		require.NoError(t, err)
+		require.NotNil(t, reservation)
+
+		// only the committed size stays in use.
+		reservation.Commit(40)
+		reservation.Release()
+
+		_, afterCommit, err := monitor.ReserveSpace(ctx, available)
+		require.NoError(t, err)
+		require.Equal(t, have-40, afterCommit)
+	})
+}
@@ -0,0 +1,137 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package monitor
+
+import (
+	"context"
+	"sync"
+	"sync/atomic"
+)
+
+// availableSpace is an estimate of the space available for uploads, which is
+// checked and reserved without locks or syscalls.
+//
+// The estimate is refreshed from the used space cache and the free disk
+// space in the background. Between refreshes, the committed pieces and the
+// reservations of the uploads in progress are subtracted from it.
+type availableSpace struct {
+	// the 64-bit fields are at the top of the struct for the atomic
+	// operations on 32-bit platforms.
+
+	// free is the available space at the last refresh.
+	free int64
+	// written is the size of the pieces committed since the last refresh.
+	written int64
+	// reserved is the space reserved by the uploads in progress.
+	reserved int64
+
+	// refreshed is set once the estimate has been refreshed.
+	refreshed int32
+
+	// refreshMu serializes the refreshes, so the committed pieces are
+	// subtracted from written only once.
+	refreshMu sync.Mutex
+}
+
+// Available returns the estimated available space, without the reserved
+// space.
+func (space *availableSpace) Available() int64 {
+	return atomic.LoadInt64(&space.free) - atomic.LoadInt64(&space.written) - atomic.LoadInt64(&space.reserved)
+}
+
+// SpaceReservation is space reserved for an upload. It must be committed or
+// released once the upload has finished.
+type SpaceReservation struct {
+	space  *availableSpace
+	amount int64
+	done   bool
+}
+
+// ReserveSpace reserves amount bytes for an upload. It returns the available
+// space before the reservation and a nil reservation when there isn't enough
+// space.
+func (service *Service) ReserveSpace(ctx context.Context, amount int64) (_ *SpaceReservation, available int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if atomic.LoadInt32(&service.space.refreshed) == 0 {
+		if err := service.refreshSpace(ctx); err != nil {
+			return nil, 0, err
+		}
+	}
+
+	// the reservation is added before the check, so concurrent uploads can't
+	// all pass the check and overcommit the disk.
+	atomic.AddInt64(&service.space.reserved, amount)
+	available = service.space.Available() + amount
+	if available < amount {
+		atomic.AddInt64(&service.space.reserved, -amount)
+		mon.Event("upload_space_reservation_rejected")
+		return nil, available, nil
+	}
+
+	return &SpaceReservation{
+		space:  &service.space,
+		amount: amount,
+	}, available, nil
+}
+
+// Commit counts size bytes of the reservation as used space and releases
+// the rest.
+func (reservation *SpaceReservation) Commit(size int64) {
+	if reservation.done {
+		return
+	}
+	reservation.done = true
+
+	atomic.AddInt64(&reservation.space.written, size)
+	atomic.AddInt64(&reservation.space.reserved, -reservation.amount)
+}
+
+// Release releases the reservation, unless it has been committed.
+func (reservation *SpaceReservation) Release() {
+	if reservation.done {
+		return
+	}
+	reservation.done = true
+
+	atomic.AddInt64(&reservation.space.reserved, -reservation.amount)
+}
+
+// refreshSpace updates the estimate of the available space from the used
+// space cache and the free disk space.
+func (service *Service) refreshSpace(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	service.space.refreshMu.Lock()
+	defer service.space.refreshMu.Unlock()
+
+	// the pieces committed while refreshing may be counted twice until the
+	// next refresh, which errs on the safe side.
+	written := atomic.LoadInt64(&service.space.written)
+
+	usedSpace, err := service.store.SpaceUsedForPiecesAndTrash(ctx)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+
+	freeSpaceForStorj := service.allocatedDiskSpace - usedSpace
+
+	diskStatus, err := service.store.StorageStatus(ctx)
+	if err != nil {
+		return Error.Wrap(err)
+	}
+	if diskStatus.DiskFree < freeSpaceForStorj {
+		freeSpaceForStorj = diskStatus.DiskFree
+	}
+
+	atomic.StoreInt64(&service.space.free, freeSpaceForStorj)
+	atomic.AddInt64(&service.space.written, -written)
+	atomic.StoreInt32(&service.space.refreshed, 1)
+
+	mon.IntVal("allocated_space").Observe(service.allocatedDiskSpace)
+	mon.IntVal("used_space").Observe(usedSpace)
+	mon.IntVal("available_space").Observe(freeSpaceForStorj)
+
+	return nil
+}
@@ -141,6 +141,8 @@ func (config *Config) DatabaseConfig() storagenodedb.Config {
 		Info2:     filepath.Join(dbdir, "info.db"),
 		Pieces:    config.Storage.Path,
 		Filestore: config.Filestore,
+
+		CommitInterval: config.Storage2.DatabaseCommitInterval,
 	}
 }
 
@@ -232,17 +234,18 @@ type Peer struct {
 
 	Storage2 struct {
 		// TODO: lift things outside of it to organize better
-		Trust         *trust.Pool
-		Store         *pieces.Store
-		TrashChore    *pieces.TrashChore
-		BlobsCache    *pieces.BlobsUsageCache
-		CacheService  *pieces.CacheService
-		RetainService *retain.Service
-		PieceDeleter  *pieces.Deleter
-		Endpoint      *piecestore.Endpoint
-		Inspector     *inspector.Endpoint
-		Monitor       *monitor.Service
-		Orders        *orders.Service
+		Trust           *trust.Pool
+		Store           *pieces.Store
+		TrashChore      *pieces.TrashChore
+		BlobsCache      *pieces.BlobsUsageCache
+		CacheService    *pieces.CacheService
+		ExpirationCache *pieces.ExpirationCache
+		RetainService   *retain.Service
+		PieceDeleter    *pieces.Deleter
+		Endpoint        *piecestore.Endpoint
+		Inspector       *inspector.Endpoint
+		Monitor         *monitor.Service
+		Orders          *orders.Service
 	}
 
 	Collector *collector.Service
@@ -428,10 +431,19 @@ func New(log *zap.Logger, full *identity.FullIdentity, db DB, revocationDB exten
 	{ // setup storage
 		peer.Storage2.BlobsCache = pieces.NewBlobsUsageCache(peer.Log.Named("blobscache"), peer.DB.Pieces())
 
+		peer.Storage2.ExpirationCache = pieces.NewExpirationCache(peer.Log.Named("expirationcache"), peer.DB.PieceExpirationDB(), config.Pieces)
+		peer.Services.Add(lifecycle.Item{
+			Name:  "pieces:expirationcache",
+			Run:   peer.Storage2.ExpirationCache.Run,
+			Close: peer.Storage2.ExpirationCache.Close,
+		})
+		peer.Debug.Server.Panel.Add(
+			debug.Cycle("Piece Expiration Cache", peer.Storage2.ExpirationCache.Loop))
+
 		peer.Storage2.Store = pieces.NewStore(peer.Log.Named("pieces"),
 			peer.Storage2.BlobsCache,
 			peer.DB.V0PieceInfo(),
-			peer.DB.PieceExpirationDB(),
+			peer.Storage2.ExpirationCache,
 			peer.DB.PieceSpaceUsedDB(),
 			config.Pieces,
 		)
@@ -777,6 +789,8 @@ func New(log *zap.Logger, full *identity.FullIdentity, db DB, revocationDB exten
 	})
 	peer.Debug.Server.Panel.Add(
 		debug.Cycle("Bandwidth", peer.Bandwidth.Loop))
+	peer.Debug.Server.Panel.Add(
+		debug.Cycle("Bandwidth Persist", peer.Bandwidth.PersistLoop))
 
 	{ // setup multinode endpoints
 		// TODO: add to peer?
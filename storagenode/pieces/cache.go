@@ -7,6 +7,7 @@ import (
 	"context"
 	"fmt"
 	"sync"
+	"sync/atomic"
 	"time"
 
 	"github.com/zeebo/errs"
@@ -94,9 +95,7 @@ func (service *CacheService) Run(ctx context.Context) (err error) {
 // so that if the storagenode restarts it can retrieve the latest space used
 // values without needing to recalculate since that could take a long time.
 func (service *CacheService) PersistCacheTotals(ctx context.Context) error {
-	cache := service.usageCache
-	cache.mu.Lock()
-	defer cache.mu.Unlock()
+	cache := service.usageCache.copyCacheTotals()
 	if err := service.store.spaceUsedDB.UpdatePieceTotals(ctx, cache.piecesTotal, cache.piecesContentSize); err != nil {
 		return err
 	}
@@ -149,12 +148,41 @@ func (service *CacheService) Close() (err error) {
 //
 // pieceTotal and pieceContentSize are the corollary for a single file.
 //
+// The totals are atomic counters, and the per-satellite counters are kept in
+// a copy-on-write table, which is only copied when a satellite is added or
+// the totals are reset. So updating and reading the totals doesn't take a
+// lock.
+//
 // architecture: Database
 type BlobsUsageCache struct {
+	// the 64-bit fields are at the top of the struct for the atomic
+	// operations on 32-bit platforms.
+	piecesTotal       int64
+	piecesContentSize int64
+	trashTotal        int64
+
 	storage.Blobs
 	log *zap.Logger
 
-	mu                   sync.Mutex
+	// satellites holds a satelliteTable. It's only replaced while holding
+	// satellitesMu.
+	satellitesMu sync.Mutex
+	satellites   atomic.Value
+}
+
+// satelliteTable contains the space used counters of each satellite. It
+// isn't modified after it has been stored.
+type satelliteTable map[storj.NodeID]*satelliteUsage
+
+// satelliteUsage contains the space used counters of a satellite, which are
+// updated with atomic operations.
+type satelliteUsage struct {
+	total       int64
+	contentSize int64
+}
+
+// cacheTotals is a snapshot of the totals of the cache.
+type cacheTotals struct {
 	piecesTotal          int64
 	piecesContentSize    int64
 	trashTotal           int64
@@ -163,55 +191,92 @@ type BlobsUsageCache struct {
 
 // NewBlobsUsageCache creates a new disk blob store with a space used cache.
 func NewBlobsUsageCache(log *zap.Logger, blob storage.Blobs) *BlobsUsageCache {
-	return &BlobsUsageCache{
-		log:                  log,
-		Blobs:                blob,
-		spaceUsedBySatellite: map[storj.NodeID]SatelliteUsage{},
+	blobs := &BlobsUsageCache{
+		log:   log,
+		Blobs: blob,
 	}
+	blobs.satellites.Store(satelliteTable{})
+	return blobs
 }
 
 // NewBlobsUsageCacheTest creates a new disk blob store with a space used cache.
 func NewBlobsUsageCacheTest(log *zap.Logger, blob storage.Blobs, piecesTotal, piecesContentSize, trashTotal int64, spaceUsedBySatellite map[storj.NodeID]SatelliteUsage) *BlobsUsageCache {
-	return &BlobsUsageCache{
-		log:                  log,
-		Blobs:                blob,
-		piecesTotal:          piecesTotal,
-		piecesContentSize:    piecesContentSize,
-		trashTotal:           trashTotal,
-		spaceUsedBySatellite: spaceUsedBySatellite,
+	blobs := &BlobsUsageCache{
+		log:   log,
+		Blobs: blob,
 	}
+	blobs.init(piecesTotal, piecesContentSize, trashTotal, spaceUsedBySatellite)
+	return blobs
 }
 
 func (blobs *BlobsUsageCache) init(pieceTotal, contentSize, trashTotal int64, totalsBySatellite map[storj.NodeID]SatelliteUsage) {
-	blobs.mu.Lock()
-	defer blobs.mu.Unlock()
-	blobs.piecesTotal = pieceTotal
-	blobs.piecesContentSize = contentSize
-	blobs.trashTotal = trashTotal
-	blobs.spaceUsedBySatellite = totalsBySatellite
+	table := make(satelliteTable, len(totalsBySatellite))
+	for satelliteID, usage := range totalsBySatellite {
+		table[satelliteID] = &satelliteUsage{
+			total:       usage.Total,
+			contentSize: usage.ContentSize,
+		}
+	}
+
+	// the updates, which happen concurrently with resetting the totals, may
+	// be lost; the same as when the totals were guarded by a lock.
+	blobs.satellitesMu.Lock()
+	defer blobs.satellitesMu.Unlock()
+	atomic.StoreInt64(&blobs.piecesTotal, pieceTotal)
+	atomic.StoreInt64(&blobs.piecesContentSize, contentSize)
+	atomic.StoreInt64(&blobs.trashTotal, trashTotal)
+	blobs.satellites.Store(table)
+}
+
+// loadSatellites returns the current satellite table.
+func (blobs *BlobsUsageCache) loadSatellites() satelliteTable {
+	table, _ := blobs.satellites.Load().(satelliteTable)
+	return table
+}
+
+// satellite returns the counters of the satellite, adding them to the table
+// when they don't exist yet.
+func (blobs *BlobsUsageCache) satellite(satelliteID storj.NodeID) *satelliteUsage {
+	if usage, ok := blobs.loadSatellites()[satelliteID]; ok {
+		return usage
+	}
+
+	blobs.satellitesMu.Lock()
+	defer blobs.satellitesMu.Unlock()
+
+	table := blobs.loadSatellites()
+	if usage, ok := table[satelliteID]; ok {
+		return usage
+	}
+
+	updated := make(satelliteTable, len(table)+1)
+	for id, usage := range table {
+		updated[id] = usage
+	}
+	usage := &satelliteUsage{}
+	updated[satelliteID] = usage
+	blobs.satellites.Store(updated)
+	return usage
 }
 
 // SpaceUsedBySatellite returns the current total space used for a specific
 // satellite for all pieces.
 func (blobs *BlobsUsageCache) SpaceUsedBySatellite(ctx context.Context, satelliteID storj.NodeID) (piecesTotal int64, piecesContentSize int64, err error) {
-	blobs.mu.Lock()
-	defer blobs.mu.Unlock()
-	values := blobs.spaceUsedBySatellite[satelliteID]
-	return values.Total, values.ContentSize, nil
+	usage, ok := blobs.loadSatellites()[satelliteID]
+	if !ok {
+		return 0, 0, nil
+	}
+	return atomic.LoadInt64(&usage.total), atomic.LoadInt64(&usage.contentSize), nil
 }
 
 // SpaceUsedForPieces returns the current total used space for all pieces.
 func (blobs *BlobsUsageCache) SpaceUsedForPieces(ctx context.Context) (int64, int64, error) {
-	blobs.mu.Lock()
-	defer blobs.mu.Unlock()
-	return blobs.piecesTotal, blobs.piecesContentSize, nil
+	return atomic.LoadInt64(&blobs.piecesTotal), atomic.LoadInt64(&blobs.piecesContentSize), nil
 }
 
 // SpaceUsedForTrash returns the current total used space for the trash dir.
 func (blobs *BlobsUsageCache) SpaceUsedForTrash(ctx context.Context) (int64, error) {
-	blobs.mu.Lock()
-	defer blobs.mu.Unlock()
-	return blobs.trashTotal, nil
+	return atomic.LoadInt64(&blobs.trashTotal), nil
 }
 
 // Delete gets the size of the piece that is going to be deleted then deletes it and
@@ -249,34 +314,26 @@ func (blobs *BlobsUsageCache) pieceSizes(ctx context.Context, blobRef storage.Bl
 
 // Update updates the cache totals.
 func (blobs *BlobsUsageCache) Update(ctx context.Context, satelliteID storj.NodeID, piecesTotalDelta, piecesContentSizeDelta, trashDelta int64) {
-	blobs.mu.Lock()
-	defer blobs.mu.Unlock()
-
-	blobs.piecesTotal += piecesTotalDelta
-	blobs.piecesContentSize += piecesContentSizeDelta
-	blobs.trashTotal += trashDelta
-
-	blobs.ensurePositiveCacheValue(&blobs.piecesTotal, "piecesTotal")
-	blobs.ensurePositiveCacheValue(&blobs.piecesContentSize, "piecesContentSize")
-	blobs.ensurePositiveCacheValue(&blobs.trashTotal, "trashTotal")
-
-	oldVals := blobs.spaceUsedBySatellite[satelliteID]
-	newVals := SatelliteUsage{
-		Total:       oldVals.Total + piecesTotalDelta,
-		ContentSize: oldVals.ContentSize + piecesContentSizeDelta,
-	}
-	blobs.ensurePositiveCacheValue(&newVals.Total, "satPiecesTotal")
-	blobs.ensurePositiveCacheValue(&newVals.ContentSize, "satPiecesContentSize")
-	blobs.spaceUsedBySatellite[satelliteID] = newVals
+	blobs.add(&blobs.piecesTotal, piecesTotalDelta, "piecesTotal")
+	blobs.add(&blobs.piecesContentSize, piecesContentSizeDelta, "piecesContentSize")
+	blobs.add(&blobs.trashTotal, trashDelta, "trashTotal")
 
+	usage := blobs.satellite(satelliteID)
+	blobs.add(&usage.total, piecesTotalDelta, "satPiecesTotal")
+	blobs.add(&usage.contentSize, piecesContentSizeDelta, "satPiecesContentSize")
 }
 
-func (blobs *BlobsUsageCache) ensurePositiveCacheValue(value *int64, name string) {
-	if *value >= 0 {
+// add adds delta to the counter and resets it to zero when it would become
+// negative.
+func (blobs *BlobsUsageCache) add(value *int64, delta int64, name string) {
+	current := atomic.AddInt64(value, delta)
+	if current >= 0 {
 		return
 	}
-	blobs.log.Error(fmt.Sprintf("%s < 0", name), zap.Int64(name, *value))
-	*value = 0
+	blobs.log.Error(fmt.Sprintf("%s < 0", name), zap.Int64(name, current))
+	for current < 0 && !atomic.CompareAndSwapInt64(value, current, 0) {
+		current = atomic.LoadInt64(value)
+	}
 }
 
 // Trash moves the ref to the trash and updates the cache.
@@ -344,17 +401,19 @@ func (blobs *BlobsUsageCache) RestoreTrash(ctx context.Context, namespace []byte
 	return keysRestored, err
 }
 
-func (blobs *BlobsUsageCache) copyCacheTotals() BlobsUsageCache {
-	blobs.mu.Lock()
-	defer blobs.mu.Unlock()
-	var copyMap = map[storj.NodeID]SatelliteUsage{}
-	for k, v := range blobs.spaceUsedBySatellite {
-		copyMap[k] = v
-	}
-	return BlobsUsageCache{
-		piecesTotal:          blobs.piecesTotal,
-		piecesContentSize:    blobs.piecesContentSize,
-		trashTotal:           blobs.trashTotal,
+func (blobs *BlobsUsageCache) copyCacheTotals() cacheTotals {
+	table := blobs.loadSatellites()
+	copyMap := make(map[storj.NodeID]SatelliteUsage, len(table))
+	for satelliteID, usage := range table {
+		copyMap[satelliteID] = SatelliteUsage{
+			Total:       atomic.LoadInt64(&usage.total),
+			ContentSize: atomic.LoadInt64(&usage.contentSize),
+		}
+	}
+	return cacheTotals{
+		piecesTotal:          atomic.LoadInt64(&blobs.piecesTotal),
+		piecesContentSize:    atomic.LoadInt64(&blobs.piecesContentSize),
+		trashTotal:           atomic.LoadInt64(&blobs.trashTotal),
 		spaceUsedBySatellite: copyMap,
 	}
 }
@@ -443,12 +502,7 @@ func (blobs *BlobsUsageCache) Recalculate(
 		}
 	}
 
-	blobs.mu.Lock()
-	blobs.piecesTotal = estimatedPiecesTotal
-	blobs.piecesContentSize = estimatedPiecesContentSize
-	blobs.trashTotal = estimatedTotalTrash
-	blobs.spaceUsedBySatellite = estimatedTotalsBySatellite
-	blobs.mu.Unlock()
+	blobs.init(estimatedPiecesTotal, estimatedPiecesContentSize, estimatedTotalTrash, estimatedTotalsBySatellite)
 }
 
 func estimate(newSpaceUsedTotal, totalAtIterationStart, totalAtIterationEnd int64) int64 {
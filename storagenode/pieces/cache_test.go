@@ -9,6 +9,7 @@ import (
 
 	"github.com/stretchr/testify/assert"
 	"github.com/stretchr/testify/require"
+	"go.uber.org/zap"
 	"go.uber.org/zap/zaptest"
 	"golang.org/x/sync/errgroup"
 
@@ -710,3 +711,39 @@ func TestConcurrency(t *testing.T) {
 		require.NoError(t, group.Wait())
 	})
 }
+
+func BenchmarkUpdateWithReaders(b *testing.B) {
+	ctx := testcontext.New(b)
+	defer ctx.Cleanup()
+
+	satellites := []storj.NodeID{testrand.NodeID(), testrand.NodeID(), testrand.NodeID()}
+	cache := pieces.NewBlobsUsageCacheTest(zap.NewNop(), nil, 0, 0, 0, nil)
+
+	// the readers poll the totals, like the monitor and the uploads do.
+	done := make(chan struct{})
+	var readers errgroup.Group
+	for i := 0; i < 4; i++ {
+		readers.Go(func() error {
+			for {
+				select {
+				case <-done:
+					return nil
+				default:
+				}
+				_, _, _ = cache.SpaceUsedForPieces(ctx)
+				_, _, _ = cache.SpaceUsedBySatellite(ctx, satellites[0])
+			}
+		})
+	}
+
+	b.ResetTimer()
+	b.RunParallel(func(p *testing.PB) {
+		for i := 0; p.Next(); i++ {
+			cache.Update(ctx, satellites[i%len(satellites)], 1024, 1000, 0)
+		}
+	})
+	b.StopTimer()
+
+	close(done)
+	require.NoError(b, readers.Wait())
+}
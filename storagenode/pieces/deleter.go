@@ -5,7 +5,9 @@ package pieces
 
 import (
 	"context"
+	"sort"
 	"sync"
+	"sync/atomic"
 	"time"
 
 	"github.com/zeebo/errs"
@@ -25,6 +27,11 @@ type DeleteRequest struct {
 // Deleter is a worker that processes requests to delete groups of pieceIDs.
 // Deletes are processed "best-effort" asynchronously, and any errors are
 // logged.
+//
+// The queued deletes are taken in batches and sorted by the blob directory of
+// the piece, so each worker deletes the pieces of a few directories at a time.
+// The number of workers adapts to the observed delete latency, up to
+// numWorkers.
 type Deleter struct {
 	mu         sync.Mutex
 	ch         chan DeleteRequest
@@ -41,8 +48,20 @@ type Deleter struct {
 	testDone     chan struct{}
 }
 
+const (
+	// deleteBatchSize is the maximum number of queued deletes, which are
+	// sorted by directory together.
+	deleteBatchSize = 1000
+	// deleteChunkSize is the minimum number of deletes, which are handed to a
+	// worker at once, unless the batch is smaller.
+	deleteChunkSize = 50
+)
+
 // NewDeleter creates a new Deleter.
 func NewDeleter(log *zap.Logger, store *Store, numWorkers int, queueSize int) *Deleter {
+	if numWorkers < 1 {
+		numWorkers = 1
+	}
 	return &Deleter{
 		ch:         make(chan DeleteRequest, queueSize),
 		numWorkers: numWorkers,
@@ -67,11 +86,9 @@ func (d *Deleter) Run(ctx context.Context) error {
 	ctx, d.stop = context.WithCancel(ctx)
 	d.eg = &errgroup.Group{}
 
-	for i := 0; i < d.numWorkers; i++ {
-		d.eg.Go(func() error {
-			return d.work(ctx)
-		})
-	}
+	d.eg.Go(func() error {
+		return d.dispatch(ctx)
+	})
 
 	return nil
 }
@@ -124,19 +141,67 @@ func (d *Deleter) checkDone(delta int) {
 	d.mu.Unlock()
 }
 
-func (d *Deleter) work(ctx context.Context) error {
+// dispatch takes the queued deletes in batches and hands them to the
+// workers, sorted by directory.
+func (d *Deleter) dispatch(ctx context.Context) error {
+	workers := newDeleteWorkers(d.numWorkers)
+	defer workers.Wait()
+
+	// undispatched is the number of deletes of the current batch, which
+	// haven't been handed to a worker yet.
+	var undispatched int64
+
+	batch := make([]DeleteRequest, 0, deleteBatchSize)
 	for {
+		batch = batch[:0]
 		select {
 		case <-ctx.Done():
 			return nil
 		case r := <-d.ch:
-			mon.IntVal("piecedeleter-queue-time").Observe(int64(time.Since(r.QueueTime)))
-			mon.IntVal("piecedeleter-queue-size").Observe(int64(len(d.ch)))
-			d.deleteOrTrash(ctx, r.SatelliteID, r.PieceID)
-			// If we are in test mode, check if we are done processing deletes
-			if d.testMode {
-				d.checkDone(-1)
+			batch = append(batch, r)
+		}
+	collect:
+		for len(batch) < deleteBatchSize {
+			select {
+			case r := <-d.ch:
+				batch = append(batch, r)
+			default:
+				break collect
+			}
+		}
+		mon.IntVal("piecedeleter-batch-size").Observe(int64(len(batch)))
+
+		sortByDirectory(batch)
+		atomic.StoreInt64(&undispatched, int64(len(batch)))
+		for _, chunk := range chunkByDirectory(batch, deleteChunkSize) {
+			if !workers.Acquire(ctx) {
+				return nil
 			}
+			atomic.AddInt64(&undispatched, -int64(len(chunk)))
+
+			// the batch is reused, so the chunk has to be copied.
+			chunk := append([]DeleteRequest(nil), chunk...)
+			go func() {
+				start := time.Now()
+				d.deleteChunk(ctx, chunk)
+				backlog := len(d.ch) > 0 || atomic.LoadInt64(&undispatched) > 0
+				workers.Release(time.Since(start), len(chunk), backlog)
+			}()
+		}
+	}
+}
+
+func (d *Deleter) deleteChunk(ctx context.Context, chunk []DeleteRequest) {
+	for _, r := range chunk {
+		if ctx.Err() != nil {
+			return
+		}
+		mon.IntVal("piecedeleter-queue-time").Observe(int64(time.Since(r.QueueTime)))
+		mon.IntVal("piecedeleter-queue-size").Observe(int64(len(d.ch)))
+		d.deleteOrTrash(ctx, r.SatelliteID, r.PieceID)
+		// If we are in test mode, check if we are done processing deletes
+		if d.testMode {
+			d.checkDone(-1)
 		}
 	}
 }
@@ -203,3 +268,128 @@ func (d *Deleter) deleteOrTrash(ctx context.Context, satelliteID storj.NodeID, p
 		)
 	}
 }
+
+// blobDirectory returns the prefix of the blob directory of the piece. It
+// matches the first two characters of the base32 encoded piece ID, which
+// filestore uses as the directory name.
+func blobDirectory(pieceID storj.PieceID) uint16 {
+	return uint16(pieceID[0])<<2 | uint16(pieceID[1]>>6)
+}
+
+// sortByDirectory sorts the deletes by satellite and blob directory.
+func sortByDirectory(batch []DeleteRequest) {
+	sort.Slice(batch, func(i, k int) bool {
+		if c := batch[i].SatelliteID.Compare(batch[k].SatelliteID); c != 0 {
+			return c < 0
+		}
+		return blobDirectory(batch[i].PieceID) < blobDirectory(batch[k].PieceID)
+	})
+}
+
+// chunkByDirectory splits the sorted deletes into chunks of at least minSize
+// deletes, without splitting a directory between chunks.
+func chunkByDirectory(batch []DeleteRequest, minSize int) (chunks [][]DeleteRequest) {
+	start := 0
+	for i := 1; i <= len(batch); i++ {
+		if i < len(batch) {
+			if i-start < minSize {
+				continue
+			}
+			if batch[i].SatelliteID == batch[i-1].SatelliteID &&
+				blobDirectory(batch[i].PieceID) == blobDirectory(batch[i-1].PieceID) {
+				continue
+			}
+		}
+		chunks = append(chunks, batch[start:i])
+		start = i
+	}
+	return chunks
+}
+
+// deleteWorkers limits the number of concurrent delete workers. The limit
+// is raised while there is a backlog and the delete latency stays close to
+// the lowest observed latency, and lowered once the disk slows down.
+type deleteWorkers struct {
+	mu      sync.Mutex
+	cond    sync.Cond
+	max     int
+	limit   int
+	running int
+
+	// latency is the moving average of the latency of a single delete and
+	// best is the lowest average, which slowly follows the current one.
+	latency float64
+	best    float64
+}
+
+func newDeleteWorkers(max int) *deleteWorkers {
+	workers := &deleteWorkers{
+		max:   max,
+		limit: 1,
+	}
+	workers.cond.L = &workers.mu
+	return workers
+}
+
+// Acquire waits until another worker may run. It returns false when ctx is
+// canceled.
+func (workers *deleteWorkers) Acquire(ctx context.Context) bool {
+	workers.mu.Lock()
+	defer workers.mu.Unlock()
+
+	// the running workers stop once ctx is canceled, so this doesn't block
+	// for long after the cancellation.
+	for workers.running >= workers.limit {
+		workers.cond.Wait()
+	}
+	if ctx.Err() != nil {
+		return false
+	}
+	workers.running++
+	return true
+}
+
+// Release marks a worker finished, which deleted count pieces in elapsed
+// time, and adjusts the limit.
+func (workers *deleteWorkers) Release(elapsed time.Duration, count int, backlog bool) {
+	workers.mu.Lock()
+	defer workers.mu.Unlock()
+
+	workers.running--
+	defer workers.cond.Broadcast()
+
+	if count <= 0 {
+		return
+	}
+
+	latency := float64(elapsed) / float64(count)
+	if workers.latency == 0 {
+		workers.latency = latency
+	} else {
+		workers.latency += (latency - workers.latency) / 5
+	}
+	if workers.best == 0 || workers.latency < workers.best {
+		workers.best = workers.latency
+	} else {
+		workers.best += (workers.latency - workers.best) / 100
+	}
+
+	switch {
+	case workers.latency > 2*workers.best && workers.limit > 1:
+		workers.limit--
+	case workers.latency < 1.25*workers.best && backlog && workers.limit < workers.max:
+		workers.limit++
+	}
+	mon.IntVal("piecedeleter-workers").Observe(int64(workers.limit))
+	mon.FloatVal("piecedeleter-delete-latency").Observe(workers.latency / float64(time.Second))
+}
+
+// Wait waits for the running workers to finish.
+func (workers *deleteWorkers) Wait() {
+	workers.mu.Lock()
+	defer workers.mu.Unlock()
+
+	for workers.running > 0 {
+		workers.cond.Wait()
+	}
+}
@@ -147,3 +147,46 @@ func TestEnqueueUnhandled(t *testing.T) {
 		require.NoError(t, deleter.Close())
 	}
 }
+
+func TestDeleterManyPieces(t *testing.T) {
+	storagenodedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db storagenode.DB) {
+		dir, err := filestore.NewDir(zaptest.NewLogger(t), ctx.Dir("piecedeleter"))
+		require.NoError(t, err)
+
+		blobs := filestore.New(zaptest.NewLogger(t), dir, filestore.DefaultConfig)
+		defer ctx.Check(blobs.Close)
+
+		store := pieces.NewStore(zaptest.NewLogger(t), blobs, db.V0PieceInfo(), db.PieceExpirationDB(), nil, pieces.Config{
+			WritePreallocSize: 4 * memory.MiB,
+		})
+		deleter := pieces.NewDeleter(zaptest.NewLogger(t), store, 4, 10000)
+		defer ctx.Check(deleter.Close)
+		deleter.SetupTest()
+
+		satelliteID := testrand.NodeID()
+		pieceIDs := make([]storj.PieceID, 300)
+		for i := range pieceIDs {
+			pieceIDs[i] = testrand.PieceID()
+
+			w, err := store.Writer(ctx, satelliteID, pieceIDs[i])
+			require.NoError(t, err)
+			_, err = w.Write(testrand.Bytes(memory.KB))
+			require.NoError(t, err)
+			require.NoError(t, w.Commit(ctx, &pb.PieceHeader{}))
+		}
+
+		// the deletes are queued before the workers start, so they are
+		// sorted and split between the workers.
+		unhandled := deleter.Enqueue(ctx, satelliteID, pieceIDs)
+		require.Equal(t, 0, unhandled)
+
+		require.NoError(t, deleter.Run(ctx))
+		deleter.Wait(ctx)
+
+		for _, pieceID := range pieceIDs {
+			r, err := store.Reader(ctx, satelliteID, pieceID)
+			require.Error(t, err)
+			require.Nil(t, r)
+		}
+	})
+}
@@ -0,0 +1,380 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package pieces
+
+import (
+	"context"
+	"sync"
+	"time"
+
+	"github.com/zeebo/errs"
+	"go.uber.org/zap"
+
+	"storj.io/common/bloomfilter"
+	"storj.io/common/context2"
+	"storj.io/common/storj"
+	"storj.io/common/sync2"
+)
+
+const (
+	// minExpirationFilterCapacity is the smallest number of pieces the
+	// expiration filter is sized for.
+	minExpirationFilterCapacity = 100000
+	// expirationFilterFalsePositiveRate is the rate of the pieces without an
+	// expiration record, which are still looked up in the database.
+	expirationFilterFalsePositiveRate = 0.01
+)
+
+// expirationKey identifies the expiration record of a piece.
+type expirationKey struct {
+	SatelliteID storj.NodeID
+	PieceID     storj.PieceID
+}
+
+// ExpirationCache is a piece expiration database, which buffers the set and
+// deleted expirations in memory and writes them in batches.
+//
+// The buffered changes are written every ExpirationFlushInterval, or earlier
+// when ExpirationBatchSize changes are buffered, and before the buffered
+// records are read. A filter of the pieces which may have an expiration
+// record lets deleting a piece without one skip the database altogether.
+//
+// architecture: Database
+type ExpirationCache struct {
+	PieceExpirationDB
+	log       *zap.Logger
+	batchSize int
+	Loop      *sync2.Cycle
+
+	// flushMu serializes writing the buffered changes, so they are applied
+	// in the order they were made.
+	flushMu sync.Mutex
+
+	mu      sync.Mutex
+	sets    map[expirationKey]time.Time
+	deletes map[expirationKey]struct{}
+
+	// filter contains every piece which may have an expiration record. It's
+	// nil until it has been loaded from the database.
+	filter         *bloomfilter.Filter
+	filterCount    int
+	filterCapacity int
+	// rebuilding is the filter which is being loaded from the database.
+	rebuilding *bloomfilter.Filter
+}
+
+// NewExpirationCache creates a new piece expiration database, which buffers
+// the changes of db.
+func NewExpirationCache(log *zap.Logger, db PieceExpirationDB, config Config) *ExpirationCache {
+	return &ExpirationCache{
+		PieceExpirationDB: db,
+		log:               log,
+		batchSize:         config.ExpirationBatchSize,
+		Loop:              sync2.NewCycle(config.ExpirationFlushInterval),
+
+		sets:    map[expirationKey]time.Time{},
+		deletes: map[expirationKey]struct{}{},
+	}
+}
+
+// Run loads the expiration filter and writes the buffered changes on an
+// interval.
+func (cache *ExpirationCache) Run(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	defer func() {
+		// the buffered changes would be lost otherwise.
+		err = errs.Combine(err, cache.Flush(context2.WithoutCancellation(ctx)))
+	}()
+
+	return cache.Loop.Run(ctx, func(ctx context.Context) error {
+		if err := cache.Flush(ctx); err != nil {
+			cache.log.Error("error writing piece expirations", zap.Error(err))
+			return nil
+		}
+
+		cache.mu.Lock()
+		outdated := cache.filter == nil || cache.filterCount > cache.filterCapacity
+		cache.mu.Unlock()
+
+		if outdated {
+			if err := cache.loadFilter(ctx); err != nil {
+				cache.log.Error("error loading piece expiration filter", zap.Error(err))
+			}
+		}
+		return nil
+	})
+}
+
+// Close stops the loop.
+func (cache *ExpirationCache) Close() error {
+	cache.Loop.Close()
+	return nil
+}
+
+// SetExpiration buffers the expiration time of the piece.
+func (cache *ExpirationCache) SetExpiration(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID, expiresAt time.Time) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	key := expirationKey{SatelliteID: satellite, PieceID: pieceID}
+
+	cache.mu.Lock()
+	if _, ok := cache.sets[key]; ok {
+		cache.mu.Unlock()
+		return Error.New("expiration of piece %s is already set", pieceID)
+	}
+	cache.sets[key] = expiresAt
+	cache.addToFilter(pieceID)
+	buffered := len(cache.sets) + len(cache.deletes)
+	cache.mu.Unlock()
+
+	if buffered >= cache.batchSize {
+		cache.Loop.Trigger()
+	}
+	return nil
+}
+
+// DeleteExpiration buffers removing the expiration record of the piece. The
+// database isn't used when the piece doesn't have an expiration record, in
+// which case found is false.
+func (cache *ExpirationCache) DeleteExpiration(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID) (found bool, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	key := expirationKey{SatelliteID: satellite, PieceID: pieceID}
+
+	cache.mu.Lock()
+	if _, ok := cache.sets[key]; ok {
+		delete(cache.sets, key)
+		cache.mu.Unlock()
+		return true, nil
+	}
+	if !cache.mayHaveExpiration(pieceID) {
+		cache.mu.Unlock()
+		mon.Counter("expiration_delete_skipped").Inc(1)
+		return false, nil
+	}
+	cache.deletes[key] = struct{}{}
+	buffered := len(cache.sets) + len(cache.deletes)
+	cache.mu.Unlock()
+
+	if buffered >= cache.batchSize {
+		cache.Loop.Trigger()
+	}
+	return true, nil
+}
+
+// GetExpired gets piece IDs that expire or have expired before the given
+// time, after writing the buffered changes.
+func (cache *ExpirationCache) GetExpired(ctx context.Context, expiresBefore time.Time, limit int64) (_ []ExpiredInfo, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := cache.Flush(ctx); err != nil {
+		return nil, err
+	}
+	return cache.PieceExpirationDB.GetExpired(ctx, expiresBefore, limit)
+}
+
+// SetExpirations sets the expiration times of several pieces.
+func (cache *ExpirationCache) SetExpirations(ctx context.Context, expirations []ExpirationInfo) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	cache.mu.Lock()
+	for _, expiration := range expirations {
+		cache.addToFilter(expiration.PieceID)
+	}
+	cache.mu.Unlock()
+
+	if err := cache.Flush(ctx); err != nil {
+		return err
+	}
+	return cache.PieceExpirationDB.SetExpirations(ctx, expirations)
+}
+
+// DeleteExpirations removes the expiration records of several pieces.
+func (cache *ExpirationCache) DeleteExpirations(ctx context.Context, expired []ExpiredInfo) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := cache.Flush(ctx); err != nil {
+		return err
+	}
+	return cache.PieceExpirationDB.DeleteExpirations(ctx, expired)
+}
+
+// DeleteFailed marks the expiration record of the piece as having
+// experienced a failure in deleting the piece from the disk.
+func (cache *ExpirationCache) DeleteFailed(ctx context.Context, satelliteID storj.NodeID, pieceID storj.PieceID, failedAt time.Time) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if !cache.hasExpiration(pieceID) {
+		return nil
+	}
+	if err := cache.Flush(ctx); err != nil {
+		return err
+	}
+	return cache.PieceExpirationDB.DeleteFailed(ctx, satelliteID, pieceID, failedAt)
+}
+
+// Trash marks the expiration record of the piece as trashed.
+func (cache *ExpirationCache) Trash(ctx context.Context, satelliteID storj.NodeID, pieceID storj.PieceID) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if !cache.hasExpiration(pieceID) {
+		return nil
+	}
+	if err := cache.Flush(ctx); err != nil {
+		return err
+	}
+	return cache.PieceExpirationDB.Trash(ctx, satelliteID, pieceID)
+}
+
+// RestoreTrash marks all the expiration records of the satellite as not
+// trashed.
+func (cache *ExpirationCache) RestoreTrash(ctx context.Context, satelliteID storj.NodeID) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if err := cache.Flush(ctx); err != nil {
+		return err
+	}
+	return cache.PieceExpirationDB.RestoreTrash(ctx, satelliteID)
+}
+
+// Flush writes the buffered changes to the database.
+func (cache *ExpirationCache) Flush(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	cache.flushMu.Lock()
+	defer cache.flushMu.Unlock()
+
+	return cache.flush(ctx)
+}
+
+// flush writes the buffered changes. The caller must hold flushMu.
+func (cache *ExpirationCache) flush(ctx context.Context) (err error) {
+	cache.mu.Lock()
+	sets, deletes := cache.sets, cache.deletes
+	if len(sets) == 0 && len(deletes) == 0 {
+		cache.mu.Unlock()
+		return nil
+	}
+	cache.sets = map[expirationKey]time.Time{}
+	cache.deletes = map[expirationKey]struct{}{}
+	cache.mu.Unlock()
+
+	expired := make([]ExpiredInfo, 0, len(deletes))
+	for key := range deletes {
+		expired = append(expired, ExpiredInfo{SatelliteID: key.SatelliteID, PieceID: key.PieceID})
+	}
+	expirations := make([]ExpirationInfo, 0, len(sets))
+	for key, expiresAt := range sets {
+		expirations = append(expirations, ExpirationInfo{SatelliteID: key.SatelliteID, PieceID: key.PieceID, PieceExpiration: expiresAt})
+	}
+
+	// a buffered delete removes a record which was written before any of the
+	// buffered sets of the same piece.
+	if err := cache.PieceExpirationDB.DeleteExpirations(ctx, expired); err != nil {
+		cache.restore(sets, deletes)
+		return Error.Wrap(err)
+	}
+	if err := cache.PieceExpirationDB.SetExpirations(ctx, expirations); err != nil {
+		cache.restore(sets, nil)
+		return Error.Wrap(err)
+	}
+
+	mon.IntVal("expiration_sets_written").Observe(int64(len(expirations)))
+	mon.IntVal("expiration_deletes_written").Observe(int64(len(expired)))
+	return nil
+}
+
+// restore buffers the changes, which couldn't be written, again.
+func (cache *ExpirationCache) restore(sets map[expirationKey]time.Time, deletes map[expirationKey]struct{}) {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	for key, expiresAt := range sets {
+		// the piece was deleted while writing.
+		if _, ok := cache.deletes[key]; ok {
+			delete(cache.deletes, key)
+			continue
+		}
+		if _, ok := cache.sets[key]; !ok {
+			cache.sets[key] = expiresAt
+		}
+	}
+	for key := range deletes {
+		cache.deletes[key] = struct{}{}
+	}
+}
+
+// loadFilter loads the filter of the pieces which have an expiration record
+// from the database.
+func (cache *ExpirationCache) loadFilter(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	// the pieces which are being written must be either in the database or
+	// in the buffer while loading.
+	cache.flushMu.Lock()
+	defer cache.flushMu.Unlock()
+
+	cache.mu.Lock()
+	capacity := 2 * cache.filterCount
+	if capacity < minExpirationFilterCapacity {
+		capacity = minExpirationFilterCapacity
+	}
+	filter := bloomfilter.NewOptimal(capacity, expirationFilterFalsePositiveRate)
+	for key := range cache.sets {
+		filter.Add(key.PieceID)
+	}
+	count := len(cache.sets)
+	cache.rebuilding = filter
+	cache.mu.Unlock()
+
+	err = cache.PieceExpirationDB.WalkPieceIDs(ctx, func(pieceID storj.PieceID) {
+		cache.mu.Lock()
+		filter.Add(pieceID)
+		cache.mu.Unlock()
+		count++
+	})
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	cache.rebuilding = nil
+	if err != nil {
+		return err
+	}
+
+	cache.filter = filter
+	cache.filterCount = count
+	cache.filterCapacity = capacity
+
+	mon.IntVal("expiration_filter_count").Observe(int64(count))
+	return nil
+}
+
+// addToFilter adds the piece to the expiration filter. The caller must hold
+// mu.
+func (cache *ExpirationCache) addToFilter(pieceID storj.PieceID) {
+	if cache.filter != nil {
+		cache.filter.Add(pieceID)
+		cache.filterCount++
+	}
+	if cache.rebuilding != nil {
+		cache.rebuilding.Add(pieceID)
+	}
+}
+
+// mayHaveExpiration returns whether the piece may have an expiration record
+// in the database. The caller must hold mu.
+func (cache *ExpirationCache) mayHaveExpiration(pieceID storj.PieceID) bool {
+	return cache.filter == nil || cache.filter.Contains(pieceID)
+}
+
+// hasExpiration returns whether the piece may have a buffered or stored
+// expiration record.
+func (cache *ExpirationCache) hasExpiration(pieceID storj.PieceID) bool {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	return cache.mayHaveExpiration(pieceID)
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package pieces_test
+
+import (
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+	"go.uber.org/zap/zaptest"
+
+	"storj.io/common/testcontext"
+	"storj.io/common/testrand"
+	"storj.io/storj/storagenode"
+	"storj.io/storj/storagenode/pieces"
+	"storj.io/storj/storagenode/storagenodedb/storagenodedbtest"
+)
+
+func TestExpirationCache(t *testing.T) {
+	storagenodedbtest.Run(t, func(ctx *testcontext.Context, t *testing.T, db storagenode.DB) {
+		expireDB := db.PieceExpirationDB()
+		cache := pieces.NewExpirationCache(zaptest.NewLogger(t), expireDB, pieces.Config{
+			ExpirationFlushInterval: time.Hour,
+			ExpirationBatchSize:     1000,
+		})
+
+		satelliteID := testrand.NodeID()
+		expiredID := testrand.PieceID()
+		deletedID := testrand.PieceID()
+		expireAt := time.Now()
+
+		require.NoError(t, cache.SetExpiration(ctx, satelliteID, expiredID, expireAt))
+		require.NoError(t, cache.SetExpiration(ctx, satelliteID, deletedID, expireAt))
+		require.Error(t, cache.SetExpiration(ctx, satelliteID, deletedID, expireAt))
+
+		// the changes are buffered.
+		infos, err := expireDB.GetExpired(ctx, expireAt.Add(time.Hour), 1000)
+		require.NoError(t, err)
+		require.Empty(t, infos)
+
+		found, err := cache.DeleteExpiration(ctx, satelliteID, deletedID)
+		require.NoError(t, err)
+		require.True(t, found)
+
+		// the buffered changes are written before reading.
+		infos, err = cache.GetExpired(ctx, expireAt.Add(time.Hour), 1000)
+		require.NoError(t, err)
+		require.Equal(t, []pieces.ExpiredInfo{{SatelliteID: satelliteID, PieceID: expiredID}}, infos)
+
+		ctx.Go(func() error {
+			return cache.Run(ctx)
+		})
+		defer ctx.Check(cache.Close)
+
+		// the filter is loaded on the first cycle, after which the pieces
+		// without an expiration record don't reach the database.
+		cache.Loop.TriggerWait()
+
+		var skipped int
+		for i := 0; i < 10; i++ {
+			found, err := cache.DeleteExpiration(ctx, satelliteID, testrand.PieceID())
+			require.NoError(t, err)
+			if !found {
+				skipped++
+			}
+		}
+		require.NotZero(t, skipped)
+
+		found, err = cache.DeleteExpiration(ctx, satelliteID, expiredID)
+		require.NoError(t, err)
+		require.True(t, found)
+
+		require.NoError(t, cache.Flush(ctx))
+
+		infos, err = expireDB.GetExpired(ctx, expireAt.Add(time.Hour), 1000)
+		require.NoError(t, err)
+		require.Empty(t, infos)
+	})
+}
@@ -0,0 +1,235 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package pieces
+
+import (
+	"bytes"
+	"container/list"
+	"sync"
+
+	"storj.io/common/storj"
+	"storj.io/storj/storage"
+)
+
+const (
+	// readCacheAdmission is how many times a piece has to be requested
+	// before it is loaded into the read cache.
+	readCacheAdmission = 2
+	// readCacheEntryShare limits the size of a cached piece to the cache size
+	// divided by readCacheEntryShare.
+	readCacheEntryShare = 8
+	// readCacheFrequencyLimit is how many piece request counts are kept before
+	// they are halved.
+	readCacheFrequencyLimit = 1 << 16
+)
+
+// readCache is an in-memory cache of frequently downloaded pieces.
+//
+// The requests of every piece are counted, and the counts are halved
+// periodically, so they reflect the recent requests. A piece is only loaded
+// after it has been requested readCacheAdmission times, and it only evicts
+// pieces which have been requested less often. So one-off reads don't evict
+// the hot pieces.
+type readCache struct {
+	maxSize int64
+
+	mu          sync.Mutex
+	size        int64
+	recent      *list.List // of *readCacheEntry, the most recently used first
+	entries     map[readCacheKey]*list.Element
+	frequency   map[readCacheKey]uint8
+	generations [256]uint64
+}
+
+// readCacheKey identifies a cached piece.
+type readCacheKey struct {
+	satellite storj.NodeID
+	pieceID   storj.PieceID
+}
+
+// readCacheEntry is the content of a cached piece blob.
+type readCacheEntry struct {
+	key           readCacheKey
+	data          []byte
+	formatVersion storage.FormatVersion
+}
+
+// newReadCache returns a read cache which holds up to maxSize bytes.
+func newReadCache(maxSize int64) *readCache {
+	return &readCache{
+		maxSize:   maxSize,
+		recent:    list.New(),
+		entries:   make(map[readCacheKey]*list.Element),
+		frequency: make(map[readCacheKey]uint8),
+	}
+}
+
+// lookup counts a request of the piece and returns the cached piece. When the
+// piece isn't cached, it returns whether the piece should be loaded and the
+// generation to pass to add.
+func (cache *readCache) lookup(key readCacheKey) (_ *readCacheEntry, generation uint64, admit bool) {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	count := cache.touch(key)
+
+	if element, ok := cache.entries[key]; ok {
+		cache.recent.MoveToFront(element)
+		return element.Value.(*readCacheEntry), 0, false
+	}
+
+	return nil, cache.generations[key.pieceID[0]], count >= readCacheAdmission
+}
+
+// touch increments the request count of the piece and returns it.
+func (cache *readCache) touch(key readCacheKey) uint8 {
+	if len(cache.frequency) >= readCacheFrequencyLimit {
+		for k, count := range cache.frequency {
+			if count <= 1 {
+				delete(cache.frequency, k)
+			} else {
+				cache.frequency[k] = count / 2
+			}
+		}
+	}
+
+	count := cache.frequency[key]
+	if count < 255 {
+		count++
+		cache.frequency[key] = count
+	}
+	return count
+}
+
+// canAdd returns whether a piece blob of the specified size can be cached.
+func (cache *readCache) canAdd(size int64) bool {
+	return size <= cache.maxSize/readCacheEntryShare
+}
+
+// admits returns whether a piece blob of the specified size would be added to
+// the cache, that is whether the pieces which would have to be evicted for it
+// are requested less often. It's checked before the piece is loaded, so a
+// piece which doesn't make it into the cache isn't read from the disk as a
+// whole on every request; it's loaded once it's requested more often than
+// the cached pieces.
+func (cache *readCache) admits(key readCacheKey, size int64) bool {
+	if !cache.canAdd(size) {
+		return false
+	}
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	count := cache.frequency[key]
+	free := cache.maxSize - cache.size
+	for element := cache.recent.Back(); free < size && element != nil; element = element.Prev() {
+		victim := element.Value.(*readCacheEntry)
+		if cache.frequency[victim.key] >= count {
+			mon.Event("piece_read_cache_rejected")
+			return false
+		}
+		free += int64(len(victim.data))
+	}
+	return free >= size
+}
+
+// add adds the piece blob to the cache, unless the piece was invalidated
+// after generation was returned by lookup or the pieces that would have to be
+// evicted are requested at least as often.
+func (cache *readCache) add(key readCacheKey, generation uint64, data []byte, formatVersion storage.FormatVersion) {
+	if !cache.canAdd(int64(len(data))) {
+		return
+	}
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	if generation != cache.generations[key.pieceID[0]] {
+		return
+	}
+	if _, ok := cache.entries[key]; ok {
+		return
+	}
+
+	count := cache.frequency[key]
+	for cache.size+int64(len(data)) > cache.maxSize {
+		victim := cache.recent.Back().Value.(*readCacheEntry)
+		if cache.frequency[victim.key] >= count {
+			mon.Event("piece_read_cache_rejected")
+			return
+		}
+		cache.remove(victim.key)
+	}
+
+	cache.entries[key] = cache.recent.PushFront(&readCacheEntry{
+		key:           key,
+		data:          data,
+		formatVersion: formatVersion,
+	})
+	cache.size += int64(len(data))
+}
+
+// invalidate removes the piece from the cache and prevents the loads which
+// started before from adding it. It must be called after the piece blob has
+// been deleted or moved.
+func (cache *readCache) invalidate(key readCacheKey) {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	cache.generations[key.pieceID[0]]++
+	cache.remove(key)
+}
+
+// invalidateSatellite removes the pieces of the satellite from the cache.
+func (cache *readCache) invalidateSatellite(satellite storj.NodeID) {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	for i := range cache.generations {
+		cache.generations[i]++
+	}
+	for key := range cache.entries {
+		if key.satellite == satellite {
+			cache.remove(key)
+		}
+	}
+}
+
+// remove removes the piece from the cache. It must be called with mu held.
+func (cache *readCache) remove(key readCacheKey) {
+	element, ok := cache.entries[key]
+	if !ok {
+		return
+	}
+	entry := cache.recent.Remove(element).(*readCacheEntry)
+	delete(cache.entries, key)
+	cache.size -= int64(len(entry.data))
+}
+
+// open returns a blob reader for the cached piece.
+func (entry *readCacheEntry) open() storage.BlobReader {
+	return &cachedBlobReader{
+		Reader:        bytes.NewReader(entry.data),
+		formatVersion: entry.formatVersion,
+	}
+}
+
+// cachedBlobReader reads a piece blob from memory.
+type cachedBlobReader struct {
+	*bytes.Reader
+	formatVersion storage.FormatVersion
+}
+
+// Size returns the size of the blob.
+func (reader *cachedBlobReader) Size() (int64, error) {
+	return reader.Reader.Size(), nil
+}
+
+// StorageFormatVersion returns the storage format version of the blob.
+func (reader *cachedBlobReader) StorageFormatVersion() storage.FormatVersion {
+	return reader.formatVersion
+}
+
+// Close implements io.Closer.
+func (reader *cachedBlobReader) Close() error { return nil }
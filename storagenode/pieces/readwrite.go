@@ -70,6 +70,11 @@ type Writer struct {
 	blobs     storage.Blobs
 	satellite storj.NodeID
 	closed    bool
+
+	// pipeline hashes and writes the data in the background, when it is
+	// enabled. It is stopped before the hash is read or the blob is closed.
+	pipeline    *writePipeline
+	pipelineErr error
 }
 
 // NewWriter creates a new writer for storage.BlobWriter.
@@ -96,8 +101,35 @@ func NewWriter(log *zap.Logger, blobWriter storage.BlobWriter, blobs storage.Blo
 	return w, nil
 }
 
+// startPipeline makes the writer hash and write the data in the background,
+// using the specified number of buffers.
+func (w *Writer) startPipeline(buffers int) {
+	if buffers > 0 {
+		w.pipeline = newWritePipeline(w.hash, w.blob, buffers)
+	}
+}
+
+// flushPipeline waits for the data written in the background and stops the
+// pipeline.
+func (w *Writer) flushPipeline() error {
+	if w.pipeline != nil {
+		w.pipelineErr = w.pipeline.Flush()
+		w.pipeline = nil
+	}
+	return w.pipelineErr
+}
+
 // Write writes data to the blob and calculates the hash.
+//
+// When the pipeline is enabled, the data is hashed and written in the
+// background and the errors are returned by a later call.
 func (w *Writer) Write(data []byte) (int, error) {
+	if w.pipeline != nil {
+		n, err := w.pipeline.Write(data)
+		w.pieceSize += int64(n)
+		return n, err
+	}
+
 	n, err := w.blob.Write(data)
 	w.pieceSize += int64(n)
 	_, _ = w.hash.Write(data[:n]) // guaranteed not to return an error
@@ -111,8 +143,13 @@ func (w *Writer) Write(data []byte) (int, error) {
 // the piece header.
 func (w *Writer) Size() int64 { return w.pieceSize }
 
-// Hash returns the hash of data written so far.
-func (w *Writer) Hash() []byte { return w.hash.Sum(nil) }
+// Hash returns the hash of data written so far. It stops the pipeline, so
+// the data written afterwards is hashed and written directly.
+func (w *Writer) Hash() []byte {
+	// the write error is returned by Commit.
+	_ = w.flushPipeline()
+	return w.hash.Sum(nil)
+}
 
 // Commit commits piece to permanent storage.
 func (w *Writer) Commit(ctx context.Context, pieceHeader *pb.PieceHeader) (err error) {
@@ -123,6 +160,13 @@ func (w *Writer) Commit(ctx context.Context, pieceHeader *pb.PieceHeader) (err e
 
 	// point of no return: after this we definitely either commit or cancel
 	w.closed = true
+
+	// the background writes must finish before the blob is committed or
+	// canceled.
+	if err := w.flushPipeline(); err != nil {
+		return Error.Wrap(errs.Combine(err, w.blob.Cancel(ctx)))
+	}
+
 	defer func() {
 		if err != nil {
 			err = Error.Wrap(errs.Combine(err, w.blob.Cancel(ctx)))
@@ -205,6 +249,8 @@ func (w *Writer) Cancel(ctx context.Context) (err error) {
 		return nil
 	}
 	w.closed = true
+	// the write error doesn't matter, since the piece is deleted anyway.
+	_ = w.flushPipeline()
 	return Error.Wrap(w.blob.Cancel(ctx))
 }
 
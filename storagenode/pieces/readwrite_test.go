@@ -4,8 +4,11 @@
 package pieces_test
 
 import (
+	"context"
 	"errors"
+	"fmt"
 	"io"
+	"sync/atomic"
 	"testing"
 	"time"
 
@@ -90,6 +93,159 @@ func BenchmarkReadWrite(b *testing.B) {
 	})
 }
 
+func BenchmarkWritePipeline(b *testing.B) {
+	ctx := testcontext.New(b)
+	defer ctx.Cleanup()
+
+	dir, err := filestore.NewDir(zap.NewNop(), ctx.Dir("pieces"))
+	require.NoError(b, err)
+	blobs := filestore.New(zap.NewNop(), dir, filestore.DefaultConfig)
+	defer ctx.Check(blobs.Close)
+
+	const chunkSize = int(32 * memory.KiB)
+	satelliteID := testrand.NodeID()
+	source := testrand.Bytes(2 * memory.MiB)
+
+	for _, buffers := range []int{0, 4} {
+		config := pieces.DefaultConfig
+		config.WritePipelineBuffers = buffers
+		store := pieces.NewStore(zap.NewNop(), blobs, nil, nil, nil, config)
+
+		b.Run(fmt.Sprintf("buffers=%d", buffers), func(b *testing.B) {
+			b.SetBytes(int64(len(source)))
+			for i := 0; i < b.N; i++ {
+				writer, err := store.Writer(ctx, satelliteID, testrand.PieceID())
+				require.NoError(b, err)
+
+				for data := source; len(data) > 0; {
+					n := chunkSize
+					if n > len(data) {
+						n = len(data)
+					}
+					// every received message has its own chunk.
+					chunk := append([]byte(nil), data[:n]...)
+					_, err = writer.Write(chunk)
+					require.NoError(b, err)
+					data = data[n:]
+				}
+
+				_ = writer.Hash()
+				require.NoError(b, writer.Commit(ctx, &pb.PieceHeader{}))
+			}
+		})
+	}
+}
+
+// errBlobWrite is returned by the writes of failingBlobs.
+var errBlobWrite = errors.New("blob write failed")
+
+// failingBlobs creates blobs, whose writes fail.
+type failingBlobs struct {
+	storage.Blobs
+	canceled int32
+}
+
+func (blobs *failingBlobs) Create(ctx context.Context, ref storage.BlobRef, size int64) (storage.BlobWriter, error) {
+	writer, err := blobs.Blobs.Create(ctx, ref, size)
+	if err != nil {
+		return nil, err
+	}
+	return &failingBlobWriter{BlobWriter: writer, blobs: blobs}, nil
+}
+
+type failingBlobWriter struct {
+	storage.BlobWriter
+	blobs *failingBlobs
+}
+
+func (writer *failingBlobWriter) Write(data []byte) (int, error) {
+	return 0, errBlobWrite
+}
+
+func (writer *failingBlobWriter) Cancel(ctx context.Context) error {
+	atomic.AddInt32(&writer.blobs.canceled, 1)
+	return writer.BlobWriter.Cancel(ctx)
+}
+
+func TestWritePipelineFailure(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	dir, err := filestore.NewDir(zaptest.NewLogger(t), ctx.Dir("pieces"))
+	require.NoError(t, err)
+	blobs := &failingBlobs{Blobs: filestore.New(zaptest.NewLogger(t), dir, filestore.DefaultConfig)}
+	defer ctx.Check(blobs.Close)
+
+	const buffers = 4
+	config := pieces.DefaultConfig
+	config.WritePipelineBuffers = buffers
+	store := pieces.NewStore(zaptest.NewLogger(t), blobs, nil, nil, nil, config)
+
+	satelliteID := testrand.NodeID()
+	chunk := testrand.Bytes(memory.KiB)
+
+	t.Run("Write", func(t *testing.T) {
+		writer, err := store.Writer(ctx, satelliteID, testrand.PieceID())
+		require.NoError(t, err)
+
+		// the first write is queued before anything has been written.
+		_, err = writer.Write(chunk)
+		require.NoError(t, err)
+
+		// the writes wait for a buffer once all of them are in use, and the
+		// buffer of the failed write is only released after the failure, so
+		// the failure is returned at the latest once every buffer has been
+		// reused.
+		for i := 0; i < buffers+1 && err == nil; i++ {
+			_, err = writer.Write(chunk)
+		}
+		require.ErrorIs(t, err, errBlobWrite)
+
+		canceled := atomic.LoadInt32(&blobs.canceled)
+		require.ErrorIs(t, writer.Commit(ctx, &pb.PieceHeader{}), errBlobWrite)
+		require.Equal(t, canceled+1, atomic.LoadInt32(&blobs.canceled))
+	})
+
+	t.Run("Commit", func(t *testing.T) {
+		writer, err := store.Writer(ctx, satelliteID, testrand.PieceID())
+		require.NoError(t, err)
+
+		_, err = writer.Write(chunk)
+		require.NoError(t, err)
+
+		// the failure of the last write is returned by Commit.
+		canceled := atomic.LoadInt32(&blobs.canceled)
+		require.ErrorIs(t, writer.Commit(ctx, &pb.PieceHeader{}), errBlobWrite)
+		require.Equal(t, canceled+1, atomic.LoadInt32(&blobs.canceled))
+	})
+
+	t.Run("Cancel", func(t *testing.T) {
+		writer, err := store.Writer(ctx, satelliteID, testrand.PieceID())
+		require.NoError(t, err)
+
+		// fill all the buffers, while the writes are failing.
+		for i := 0; i < buffers; i++ {
+			_, err = writer.Write(chunk)
+			if err != nil {
+				require.ErrorIs(t, err, errBlobWrite)
+				break
+			}
+		}
+
+		canceled := atomic.LoadInt32(&blobs.canceled)
+		done := make(chan error, 1)
+		go func() { done <- writer.Cancel(ctx) }()
+
+		select {
+		case err := <-done:
+			require.NoError(t, err)
+		case <-time.After(10 * time.Second):
+			t.Fatal("Cancel didn't drain the pipeline")
+		}
+		require.Equal(t, canceled+1, atomic.LoadInt32(&blobs.canceled))
+	})
+}
+
 func readAndWritePiece(t *testing.T, content []byte) {
 	ctx := testcontext.New(t)
 	defer ctx.Cleanup()
@@ -50,6 +50,13 @@ type ExpiredInfo struct {
 	InPieceInfo bool
 }
 
+// ExpirationInfo is the expiration time of a piece.
+type ExpirationInfo struct {
+	SatelliteID     storj.NodeID
+	PieceID         storj.PieceID
+	PieceExpiration time.Time
+}
+
 // PieceExpirationDB stores information about pieces with expiration dates.
 //
 // architecture: Database
@@ -60,6 +67,13 @@ type PieceExpirationDB interface {
 	SetExpiration(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID, expiresAt time.Time) error
 	// DeleteExpiration removes an expiration record for the given piece ID on the given satellite
 	DeleteExpiration(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID) (found bool, err error)
+	// SetExpirations sets the expiration times of several pieces, leaving the pieces which already
+	// have one as is
+	SetExpirations(ctx context.Context, expirations []ExpirationInfo) error
+	// DeleteExpirations removes the expiration records of several pieces
+	DeleteExpirations(ctx context.Context, expired []ExpiredInfo) error
+	// WalkPieceIDs calls fn for every piece which has an expiration record
+	WalkPieceIDs(ctx context.Context, fn func(pieceID storj.PieceID)) error
 	// DeleteFailed marks an expiration record as having experienced a failure in deleting the
 	// piece from the disk
 	DeleteFailed(ctx context.Context, satelliteID storj.NodeID, pieceID storj.PieceID, failedAt time.Time) error
@@ -154,13 +168,20 @@ type SatelliteUsage struct {
 
 // Config is configuration for Store.
 type Config struct {
-	WritePreallocSize memory.Size `help:"file preallocated for uploading" default:"4MiB"`
-	DeleteToTrash     bool        `help:"move pieces to trash upon deletion. Warning: if set to false, you risk disqualification for failed audits if a satellite database is restored from backup." default:"true"`
+	WritePreallocSize       memory.Size   `help:"file preallocated for uploading" default:"4MiB"`
+	WritePipelineBuffers    int           `help:"how many received chunks of an upload can wait to be hashed and written in the background. 0 hashes and writes the chunks as they are received" default:"4"`
+	DeleteToTrash           bool          `help:"move pieces to trash upon deletion. Warning: if set to false, you risk disqualification for failed audits if a satellite database is restored from backup." default:"true"`
+	ExpirationFlushInterval time.Duration `help:"how frequently the buffered piece expiration changes are written to the database, which bounds the changes lost on a crash" default:"1m0s"`
+	ExpirationBatchSize     int           `help:"how many buffered piece expiration changes are written before the next interval" default:"1000"`
+	ReadCacheSize           memory.Size   `help:"size of the in-memory cache of frequently downloaded pieces. 0 disables the cache" default:"0B"`
 }
 
 // DefaultConfig is the default value for the Config.
 var DefaultConfig = Config{
-	WritePreallocSize: 4 * memory.MiB,
+	WritePreallocSize:       4 * memory.MiB,
+	WritePipelineBuffers:    4,
+	ExpirationFlushInterval: time.Minute,
+	ExpirationBatchSize:     1000,
 }
 
 // Store implements storing pieces onto a blob storage implementation.
@@ -174,6 +195,9 @@ type Store struct {
 	v0PieceInfo    V0PieceInfoDB
 	expirationInfo PieceExpirationDB
 	spaceUsedDB    PieceSpaceUsedDB
+
+	// readCache is nil when the read cache is disabled.
+	readCache *readCache
 }
 
 // StoreForTest is a wrapper around Store to be used only in test scenarios. It enables writing
@@ -186,7 +210,7 @@ type StoreForTest struct {
 func NewStore(log *zap.Logger, blobs storage.Blobs, v0PieceInfo V0PieceInfoDB,
 	expirationInfo PieceExpirationDB, pieceSpaceUsedDB PieceSpaceUsedDB, config Config) *Store {
 
-	return &Store{
+	store := &Store{
 		log:            log,
 		config:         config,
 		blobs:          blobs,
@@ -194,6 +218,10 @@ func NewStore(log *zap.Logger, blobs storage.Blobs, v0PieceInfo V0PieceInfoDB,
 		expirationInfo: expirationInfo,
 		spaceUsedDB:    pieceSpaceUsedDB,
 	}
+	if config.ReadCacheSize > 0 {
+		store.readCache = newReadCache(config.ReadCacheSize.Int64())
+	}
+	return store
 }
 
 // CreateVerificationFile creates a file to be used for storage directory verification.
@@ -219,7 +247,11 @@ func (store *Store) Writer(ctx context.Context, satellite storj.NodeID, pieceID
 	}
 
 	writer, err := NewWriter(store.log.Named("blob-writer"), blobWriter, store.blobs, satellite)
-	return writer, Error.Wrap(err)
+	if err != nil {
+		return nil, Error.Wrap(err)
+	}
+	writer.startPipeline(store.config.WritePipelineBuffers)
+	return writer, nil
 }
 
 // WriterForFormatVersion allows opening a piece writer with a specified storage format version.
@@ -274,6 +306,55 @@ func (store *Store) Reader(ctx context.Context, satellite storj.NodeID, pieceID
 	return reader, Error.Wrap(err)
 }
 
+// CachedReader returns a new piece reader for a download, which reads the
+// piece from memory when it is downloaded frequently.
+//
+// It must not be used for the repair and audit reads, since they aren't
+// repeated and would only take the place of the frequently downloaded pieces.
+func (store *Store) CachedReader(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID) (_ *Reader, err error) {
+	defer mon.Task()(&ctx)(&err)
+	if store.readCache == nil {
+		return store.Reader(ctx, satellite, pieceID)
+	}
+
+	key := readCacheKey{satellite: satellite, pieceID: pieceID}
+	entry, generation, admit := store.readCache.lookup(key)
+	if entry != nil {
+		mon.Event("piece_read_cache_hit")
+		reader, err := NewReader(entry.open())
+		return reader, Error.Wrap(err)
+	}
+	mon.Event("piece_read_cache_miss")
+
+	reader, err := store.Reader(ctx, satellite, pieceID)
+	if err != nil || !admit {
+		return reader, err
+	}
+
+	// the piece is loaded with ReadAt, which doesn't move the reader, so the
+	// download continues from the disk.
+	size, err := reader.blob.Size()
+	if err != nil || !store.readCache.admits(key, size) {
+		return reader, nil
+	}
+	data := make([]byte, size)
+	if n, err := reader.blob.ReadAt(data, 0); n < len(data) {
+		store.log.Debug("failed to load piece into the read cache", zap.Stringer("Satellite ID", satellite), zap.Stringer("Piece ID", pieceID), zap.Error(err))
+		return reader, nil
+	}
+	store.readCache.add(key, generation, data, reader.blob.StorageFormatVersion())
+
+	return reader, nil
+}
+
+// invalidateReadCache removes the piece from the read cache. It must be
+// called after the piece blob has been deleted or moved.
+func (store *Store) invalidateReadCache(satellite storj.NodeID, pieceID storj.PieceID) {
+	if store.readCache != nil {
+		store.readCache.invalidate(readCacheKey{satellite: satellite, pieceID: pieceID})
+	}
+}
+
 // ReaderWithStorageFormat returns a new piece reader for a located piece, which avoids the
 // potential need to check multiple storage formats to find the right blob.
 func (store *Store) ReaderWithStorageFormat(ctx context.Context, satellite storj.NodeID,
@@ -296,12 +377,10 @@ func (store *Store) ReaderWithStorageFormat(ctx context.Context, satellite storj
 // Delete deletes the specified piece.
 func (store *Store) Delete(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID) (err error) {
 	defer mon.Task()(&ctx)(&err)
-	err = store.blobs.Delete(ctx, storage.BlobRef{
-		Namespace: satellite.Bytes(),
-		Key:       pieceID.Bytes(),
-	})
+
+	err = store.deleteBlob(ctx, satellite, pieceID)
 	if err != nil {
-		return Error.Wrap(err)
+		return err
 	}
 
 	// delete records in both the piece_expirations and pieceinfo DBs, wherever we find it.
@@ -322,6 +401,9 @@ func (store *Store) Delete(ctx context.Context, satellite storj.NodeID, pieceID
 // DeleteSatelliteBlobs deletes blobs folder of specific satellite after successful GE.
 func (store *Store) DeleteSatelliteBlobs(ctx context.Context, satellite storj.NodeID) (err error) {
 	defer mon.Task()(&ctx)(&err)
+	if store.readCache != nil {
+		defer store.readCache.invalidateSatellite(satellite)
+	}
 
 	err = store.blobs.DeleteNamespace(ctx, satellite.Bytes())
 	return Error.Wrap(err)
@@ -332,6 +414,7 @@ func (store *Store) DeleteSatelliteBlobs(ctx context.Context, satellite storj.No
 // pieceExpirationDB.
 func (store *Store) Trash(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID) (err error) {
 	defer mon.Task()(&ctx)(&err)
+	defer store.invalidateReadCache(satellite, pieceID)
 
 	// Check if the MaxFormatVersionSupported piece exists. If not, we assume
 	// this is an old piece version and attempt to migrate it.
@@ -547,6 +630,45 @@ func (store *Store) DeleteFailed(ctx context.Context, expired ExpiredInfo, when
 	return store.expirationInfo.DeleteFailed(ctx, expired.SatelliteID, expired.PieceID, when)
 }
 
+// DeleteExpiredBatch deletes the expired pieces, and removes the expiration
+// records of the deleted pieces together, instead of one at a time. It
+// returns the errors of deleting the pieces, in the order of expired.
+func (store *Store) DeleteExpiredBatch(ctx context.Context, expired []ExpiredInfo) (deleteErrs []error, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	deleteErrs = make([]error, len(expired))
+	records := make([]ExpiredInfo, 0, len(expired))
+	for i, info := range expired {
+		deleteErrs[i] = store.deleteBlob(ctx, info.SatelliteID, info.PieceID)
+		if deleteErrs[i] != nil {
+			continue
+		}
+
+		if info.InPieceInfo {
+			if store.v0PieceInfo != nil {
+				err = errs.Combine(err, store.v0PieceInfo.Delete(ctx, info.SatelliteID, info.PieceID))
+			}
+			continue
+		}
+		records = append(records, info)
+	}
+
+	if store.expirationInfo != nil && len(records) > 0 {
+		err = errs.Combine(err, store.expirationInfo.DeleteExpirations(ctx, records))
+	}
+	return deleteErrs, err
+}
+
+// deleteBlob deletes the blob of the piece, without its records.
+func (store *Store) deleteBlob(ctx context.Context, satellite storj.NodeID, pieceID storj.PieceID) error {
+	defer store.invalidateReadCache(satellite, pieceID)
+
+	return Error.Wrap(store.blobs.Delete(ctx, storage.BlobRef{
+		Namespace: satellite.Bytes(),
+		Key:       pieceID.Bytes(),
+	}))
+}
+
 // SpaceUsedForPieces returns *an approximation of* the disk space used by all local pieces (both
 // V0 and later). This is an approximation because changes may be being applied to the filestore as
 // this information is collected, and because it is possible that various errors in directory
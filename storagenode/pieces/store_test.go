@@ -11,6 +11,7 @@ import (
 	"io"
 	"io/ioutil"
 	"os"
+	"sync/atomic"
 	"testing"
 	"time"
 
@@ -877,3 +878,142 @@ func TestOverwriteV0WithV1(t *testing.T) {
 		require.NoError(t, err)
 	})
 }
+
+func TestReadCache(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	dir, err := filestore.NewDir(zaptest.NewLogger(t), ctx.Dir("pieces"))
+	require.NoError(t, err)
+
+	blobs := filestore.New(zaptest.NewLogger(t), dir, filestore.DefaultConfig)
+	defer ctx.Check(blobs.Close)
+
+	config := pieces.DefaultConfig
+	config.ReadCacheSize = memory.MiB
+	store := pieces.NewStore(zaptest.NewLogger(t), blobs, nil, nil, nil, config)
+
+	satelliteID := testrand.NodeID()
+	pieceID := testrand.PieceID()
+	source := testrand.Bytes(8000)
+
+	writer, err := store.Writer(ctx, satelliteID, pieceID)
+	require.NoError(t, err)
+	_, err = writer.Write(source)
+	require.NoError(t, err)
+	require.NoError(t, writer.Commit(ctx, &pb.PieceHeader{Hash: []byte{1}}))
+
+	read := func() ([]byte, error) {
+		reader, err := store.CachedReader(ctx, satelliteID, pieceID)
+		if err != nil {
+			return nil, err
+		}
+		defer ctx.Check(reader.Close)
+
+		header, err := reader.GetPieceHeader()
+		require.NoError(t, err)
+		require.Equal(t, []byte{1}, header.Hash)
+
+		return ioutil.ReadAll(reader)
+	}
+
+	// the piece is loaded on the second download.
+	for i := 0; i < 2; i++ {
+		data, err := read()
+		require.NoError(t, err)
+		require.Equal(t, source, data)
+	}
+
+	// remove the blob behind the store's back, so it can only be read
+	// from the cache.
+	require.NoError(t, blobs.Delete(ctx, storage.BlobRef{
+		Namespace: satelliteID.Bytes(),
+		Key:       pieceID.Bytes(),
+	}))
+
+	data, err := read()
+	require.NoError(t, err)
+	require.Equal(t, source, data)
+
+	// deleting the piece invalidates the cache.
+	require.NoError(t, store.Delete(ctx, satelliteID, pieceID))
+
+	_, err = read()
+	require.True(t, os.IsNotExist(err), err)
+}
+
+// readAtCountingBlobs counts the blobs loaded into the read cache.
+type readAtCountingBlobs struct {
+	storage.Blobs
+	loads int64
+}
+
+func (blobs *readAtCountingBlobs) Open(ctx context.Context, ref storage.BlobRef) (storage.BlobReader, error) {
+	reader, err := blobs.Blobs.Open(ctx, ref)
+	if err != nil {
+		return nil, err
+	}
+	return &readAtCountingReader{BlobReader: reader, blobs: blobs}, nil
+}
+
+type readAtCountingReader struct {
+	storage.BlobReader
+	blobs *readAtCountingBlobs
+}
+
+func (reader *readAtCountingReader) ReadAt(p []byte, off int64) (int, error) {
+	atomic.AddInt64(&reader.blobs.loads, 1)
+	return reader.BlobReader.ReadAt(p, off)
+}
+
+func TestReadCacheRejectsBeforeLoading(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	dir, err := filestore.NewDir(zaptest.NewLogger(t), ctx.Dir("pieces"))
+	require.NoError(t, err)
+
+	blobs := &readAtCountingBlobs{Blobs: filestore.New(zaptest.NewLogger(t), dir, filestore.DefaultConfig)}
+	defer ctx.Check(blobs.Close)
+
+	// the cache has room for 8 pieces with their header.
+	config := pieces.DefaultConfig
+	config.ReadCacheSize = 72 * memory.KiB
+	store := pieces.NewStore(zaptest.NewLogger(t), blobs, nil, nil, nil, config)
+
+	satelliteID := testrand.NodeID()
+	write := func() storj.PieceID {
+		pieceID := testrand.PieceID()
+		writer, err := store.Writer(ctx, satelliteID, pieceID)
+		require.NoError(t, err)
+		_, err = writer.Write(testrand.Bytes(8 * memory.KiB))
+		require.NoError(t, err)
+		require.NoError(t, writer.Commit(ctx, &pb.PieceHeader{}))
+		return pieceID
+	}
+	read := func(pieceID storj.PieceID) {
+		reader, err := store.CachedReader(ctx, satelliteID, pieceID)
+		require.NoError(t, err)
+		require.NoError(t, reader.Close())
+	}
+
+	// the hot pieces fill the cache.
+	for i := 0; i < 8; i++ {
+		pieceID := write()
+		for j := 0; j < 4; j++ {
+			read(pieceID)
+		}
+	}
+	require.EqualValues(t, 8, atomic.LoadInt64(&blobs.loads))
+
+	// a piece requested less often than the cached ones isn't loaded.
+	warm := write()
+	for i := 0; i < 4; i++ {
+		read(warm)
+	}
+	require.EqualValues(t, 8, atomic.LoadInt64(&blobs.loads))
+
+	// it's loaded once it's requested more often.
+	read(warm)
+	require.EqualValues(t, 9, atomic.LoadInt64(&blobs.loads))
+}
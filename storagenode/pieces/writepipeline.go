@@ -0,0 +1,111 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package pieces
+
+import (
+	"errors"
+	"hash"
+	"io"
+	"sync"
+
+	"storj.io/storj/storage"
+)
+
+// writePipeline hashes and writes the piece data in the background.
+//
+// The data is copied into one of a bounded ring of reusable buffers, which
+// goes through a hashing and a writing goroutine before it is reused. So
+// receiving a chunk, hashing the previous one and writing the one before run
+// at the same time, while the upload is slowed down when all of the buffers
+// are in use.
+type writePipeline struct {
+	hash hash.Hash
+	blob storage.BlobWriter
+
+	free    chan []byte
+	hashing chan []byte
+	writing chan []byte
+	done    chan struct{}
+
+	mu  sync.Mutex
+	err error
+}
+
+// newWritePipeline starts a pipeline which hashes data into h and writes it
+// to blob, using the specified number of buffers.
+func newWritePipeline(h hash.Hash, blob storage.BlobWriter, buffers int) *writePipeline {
+	pipeline := &writePipeline{
+		hash: h,
+		blob: blob,
+
+		free:    make(chan []byte, buffers),
+		hashing: make(chan []byte, buffers),
+		writing: make(chan []byte, buffers),
+		done:    make(chan struct{}),
+	}
+	for i := 0; i < buffers; i++ {
+		pipeline.free <- nil
+	}
+
+	go pipeline.hashLoop()
+	go pipeline.writeLoop()
+
+	return pipeline
+}
+
+// Write queues a copy of data to be hashed and written. It returns the error
+// of a previous write, if any.
+func (pipeline *writePipeline) Write(data []byte) (int, error) {
+	if err := pipeline.Err(); err != nil {
+		return 0, err
+	}
+
+	buf := <-pipeline.free
+	buf = append(buf[:0], data...)
+	pipeline.hashing <- buf
+
+	return len(data), nil
+}
+
+// Flush waits for the queued data to be hashed and written and stops the
+// pipeline. It must be called once, after the last Write.
+func (pipeline *writePipeline) Flush() error {
+	close(pipeline.hashing)
+	<-pipeline.done
+	return pipeline.Err()
+}
+
+// Err returns the first write error.
+func (pipeline *writePipeline) Err() error {
+	pipeline.mu.Lock()
+	defer pipeline.mu.Unlock()
+	return pipeline.err
+}
+
+func (pipeline *writePipeline) hashLoop() {
+	defer close(pipeline.writing)
+	for buf := range pipeline.hashing {
+		_, _ = pipeline.hash.Write(buf) // guaranteed not to return an error
+		pipeline.writing <- buf
+	}
+}
+
+func (pipeline *writePipeline) writeLoop() {
+	defer close(pipeline.done)
+	for buf := range pipeline.writing {
+		// after a failure, the buffers are only drained, so that Write
+		// doesn't block and can return the error.
+		if pipeline.Err() == nil {
+			if _, err := pipeline.blob.Write(buf); err != nil {
+				if !errors.Is(err, io.EOF) {
+					err = Error.Wrap(err)
+				}
+				pipeline.mu.Lock()
+				pipeline.err = err
+				pipeline.mu.Unlock()
+			}
+		}
+		pipeline.free <- buf
+	}
+}
@@ -53,9 +53,10 @@ type OldConfig struct {
 // Config defines parameters for piecestore endpoint.
 type Config struct {
 	DatabaseDir             string        `help:"directory to store databases. if empty, uses data path" default:""`
+	DatabaseCommitInterval  time.Duration `help:"how long database writes are collected to be committed in a single transaction. 0 commits each write separately" default:"0s"`
 	ExpirationGracePeriod   time.Duration `help:"how soon before expiration date should things be considered expired" default:"48h0m0s"`
 	MaxConcurrentRequests   int           `help:"how many concurrent requests are allowed, before uploads are rejected. 0 represents unlimited." default:"0"`
-	DeleteWorkers           int           `help:"how many piece delete workers" default:"1"`
+	DeleteWorkers           int           `help:"maximum number of piece delete workers, the number in use adapts to the disk latency" default:"4"`
 	DeleteQueueSize         int           `help:"size of the piece delete queue" default:"10000"`
 	OrderLimitGracePeriod   time.Duration `help:"how long after OrderLimit creation date are OrderLimits no longer accepted" default:"1h0m0s"`
 	CacheSyncInterval       time.Duration `help:"how often the space used cache is synced to persistent storage" releaseDefault:"1h0m0s" devDefault:"0h1m0s"`
@@ -234,7 +235,7 @@ func (endpoint *Endpoint) Upload(stream pb.DRPCPiecestore_UploadStream) (err err
 		return err
 	}
 
-	availableSpace, err := endpoint.monitor.AvailableSpace(ctx)
+	reservation, availableSpace, err := endpoint.monitor.ReserveSpace(ctx, limit.Limit)
 	if err != nil {
 		return rpcstatus.Wrap(rpcstatus.Internal, err)
 	}
@@ -245,9 +246,10 @@ func (endpoint *Endpoint) Upload(stream pb.DRPCPiecestore_UploadStream) (err err
 		}
 	}()
 
-	if availableSpace < limit.Limit {
+	if reservation == nil {
 		return rpcstatus.Errorf(rpcstatus.Aborted, "not enough available disk space, have: %v, need: %v", availableSpace, limit.Limit)
 	}
+	defer reservation.Release()
 
 	var pieceWriter *pieces.Writer
 	// committed is set to true when the piece is committed.
@@ -402,6 +404,7 @@ func (endpoint *Endpoint) Upload(stream pb.DRPCPiecestore_UploadStream) (err err
 					return rpcstatus.Wrap(rpcstatus.Internal, err)
 				}
 				committed = true
+				reservation.Commit(pieceWriter.Size())
 				if !limit.PieceExpiration.IsZero() {
 					err := endpoint.store.SetExpiration(ctx, limit.SatelliteId, limit.PieceId, limit.PieceExpiration)
 					if err != nil {
@@ -527,7 +530,13 @@ func (endpoint *Endpoint) Download(stream pb.DRPCPiecestore_DownloadStream) (err
 		}
 	}()
 
-	pieceReader, err = endpoint.store.Reader(ctx, limit.SatelliteId, limit.PieceId)
+	// only the downloads by the clients are repeated, so only they use the
+	// read cache.
+	if limit.Action == pb.PieceAction_GET {
+		pieceReader, err = endpoint.store.CachedReader(ctx, limit.SatelliteId, limit.PieceId)
+	} else {
+		pieceReader, err = endpoint.store.Reader(ctx, limit.SatelliteId, limit.PieceId)
+	}
 	if err != nil {
 		if os.IsNotExist(err) {
 			endpoint.monitor.VerifyDirReadableLoop.TriggerWait()
@@ -284,5 +284,8 @@ func setSpace(ctx context.Context, t *testing.T, planet *testplanet.Planet, spac
 		require.NoError(t, err)
 		err = storageNode.Storage2.CacheService.Init(ctx)
 		require.NoError(t, err)
+		// refresh the estimate used for reserving space.
+		_, err = storageNode.Storage2.Monitor.AvailableSpace(ctx)
+		require.NoError(t, err)
 	}
 }
@@ -7,6 +7,7 @@ import (
 	"context"
 	"database/sql"
 	"errors"
+	"sort"
 	"sync"
 	"time"
 
@@ -15,6 +16,7 @@ import (
 	"storj.io/common/pb"
 	"storj.io/common/storj"
 	"storj.io/private/dbutil"
+	"storj.io/private/tagsql"
 	"storj.io/storj/private/date"
 	"storj.io/storj/storagenode/bandwidth"
 )
@@ -28,56 +30,261 @@ const BandwidthDBName = "bandwidth"
 type bandwidthDB struct {
 	// Moved to top of struct to resolve alignment issue with atomic operations on ARM
 	usedSpace int64
-	usedMu    sync.RWMutex
+	usedMu    sync.Mutex
 	usedSince time.Time
 
+	// persistMu is held exclusively while the unpersisted usage is moved to
+	// the database, so that readers never count it twice or miss it.
+	persistMu sync.RWMutex
+
+	unpersistedMu sync.Mutex
+	unpersisted   map[bandwidthUsageKey]int64
+
+	// monthUsage contains the persisted usage of the current month by day.
+	// It's updated by Persist, so the queries, which only span whole days of
+	// the current month, don't read the database.
+	monthMu    sync.Mutex
+	monthStart time.Time
+	monthUsage map[dailyUsageKey]int64
+
 	dbContainerImpl
 }
 
-// Add adds bandwidth usage to the table.
+// dailyUsageKey identifies the bandwidth usage of a satellite and action
+// within a day.
+type dailyUsageKey struct {
+	SatelliteID storj.NodeID
+	Action      pb.PieceAction
+	Day         time.Time
+}
+
+// bandwidthUsageKey identifies the bandwidth usage of a satellite and action
+// within an hour.
+type bandwidthUsageKey struct {
+	SatelliteID   storj.NodeID
+	Action        pb.PieceAction
+	IntervalStart time.Time
+}
+
+// within returns whether the usage interval starts between from and to, with
+// the same precision as the database comparisons.
+func (key bandwidthUsageKey) within(from, to time.Time) bool {
+	return !key.IntervalStart.Before(from.UTC().Truncate(time.Second)) &&
+		!key.IntervalStart.After(to.UTC().Truncate(time.Second))
+}
+
+// Add adds bandwidth usage to the in-memory counters, which are written to
+// the database with Persist.
 func (db *bandwidthDB) Add(ctx context.Context, satelliteID storj.NodeID, action pb.PieceAction, amount int64, created time.Time) (err error) {
 	defer mon.Task()(&ctx)(&err)
-	_, err = db.ExecContext(ctx, `
-		INSERT INTO
-			bandwidth_usage(satellite_id, action, amount, created_at)
-		VALUES(?, ?, ?, datetime(?))`, satelliteID, action, amount, created.UTC())
-	if err == nil {
-		db.usedMu.Lock()
-		defer db.usedMu.Unlock()
-
-		beginningOfMonth := getBeginningOfMonth(created.UTC())
-		if beginningOfMonth.Equal(db.usedSince) {
-			db.usedSpace += amount
-		} else if beginningOfMonth.After(db.usedSince) {
-			usage, err := db.Summary(ctx, beginningOfMonth, time.Now())
+
+	key := bandwidthUsageKey{
+		SatelliteID:   satelliteID,
+		Action:        action,
+		IntervalStart: created.UTC().Truncate(time.Hour),
+	}
+
+	db.unpersistedMu.Lock()
+	defer db.unpersistedMu.Unlock()
+
+	if db.unpersisted == nil {
+		db.unpersisted = make(map[bandwidthUsageKey]int64)
+	}
+	db.unpersisted[key] += amount
+	return nil
+}
+
+// Persist writes the bandwidth usage, which is kept in memory, to the hourly
+// rollups. The usage is kept in memory when writing fails, so it's written
+// with the next attempt.
+func (db *bandwidthDB) Persist(ctx context.Context) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	db.persistMu.Lock()
+	defer db.persistMu.Unlock()
+
+	db.unpersistedMu.Lock()
+	usages := db.unpersisted
+	db.unpersisted = nil
+	db.unpersistedMu.Unlock()
+
+	if len(usages) == 0 {
+		return nil
+	}
+
+	err = withTx(ctx, db.GetDB(), func(tx tagsql.Tx) error {
+		for key, amount := range usages {
+			_, err := tx.ExecContext(ctx, `
+				INSERT INTO bandwidth_usage_rollups (interval_start, satellite_id, action, amount)
+				VALUES (datetime(?), ?, ?, ?)
+				ON CONFLICT(interval_start, satellite_id, action)
+				DO UPDATE SET amount = bandwidth_usage_rollups.amount + excluded.amount
+			`, key.IntervalStart, key.SatelliteID, key.Action, amount)
 			if err != nil {
 				return err
 			}
-			db.usedSince = beginningOfMonth
-			db.usedSpace = usage.Total()
+		}
+		return nil
+	})
+	if err != nil {
+		db.unpersistedMu.Lock()
+		if db.unpersisted == nil {
+			db.unpersisted = make(map[bandwidthUsageKey]int64, len(usages))
+		}
+		for key, amount := range usages {
+			db.unpersisted[key] += amount
+		}
+		db.unpersistedMu.Unlock()
+		return ErrBandwidth.Wrap(err)
+	}
+
+	db.usedMu.Lock()
+	for key, amount := range usages {
+		if getBeginningOfMonth(key.IntervalStart).Equal(db.usedSince) {
+			db.usedSpace += amount
+		}
+	}
+	db.usedMu.Unlock()
+
+	db.monthMu.Lock()
+	for key, amount := range usages {
+		if getBeginningOfMonth(key.IntervalStart).Equal(db.monthStart) {
+			db.monthUsage[dailyUsageKey{
+				SatelliteID: key.SatelliteID,
+				Action:      key.Action,
+				Day:         getBeginningOfDay(key.IntervalStart),
+			}] += amount
+		}
+	}
+	db.monthMu.Unlock()
+
+	mon.IntVal("bandwidth_persisted_usages").Observe(int64(len(usages)))
+
+	return nil
+}
+
+// eachPersistedDaily calls fn for the persisted usage between from and to by
+// day, from the usage of the current month kept in memory. It returns false
+// when the range isn't made of whole days of the current month, in which
+// case the database has to be queried. The caller must hold persistMu.
+func (db *bandwidthDB) eachPersistedDaily(ctx context.Context, from, to time.Time, fn func(key dailyUsageKey, amount int64)) (ok bool, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	from, to = from.UTC().Truncate(time.Second), to.UTC().Truncate(time.Second)
+
+	month := getBeginningOfMonth(from)
+	if !month.Equal(getBeginningOfMonth(to)) || !month.Equal(getBeginningOfMonth(time.Now())) {
+		return false, nil
+	}
+	firstDay, lastDay := getBeginningOfDay(from), getBeginningOfDay(to)
+	if !from.Equal(firstDay) || to.Before(lastDay.Add(24*time.Hour-time.Second)) {
+		return false, nil
+	}
+
+	db.monthMu.Lock()
+	defer db.monthMu.Unlock()
+
+	if !month.Equal(db.monthStart) {
+		usage, err := db.persistedMonthUsage(ctx, month)
+		if err != nil {
+			return false, err
+		}
+		db.monthStart = month
+		db.monthUsage = usage
+	}
+
+	for key, amount := range db.monthUsage {
+		if !key.Day.Before(firstDay) && !key.Day.After(lastDay) {
+			fn(key, amount)
 		}
 	}
-	return ErrBandwidth.Wrap(err)
+	return true, nil
+}
+
+// persistedMonthUsage returns the persisted usage of the month by day.
+func (db *bandwidthDB) persistedMonthUsage(ctx context.Context, month time.Time) (_ map[dailyUsageKey]int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	from, to := month, month.AddDate(0, 1, 0).Add(-time.Second)
+
+	rows, err := db.QueryContext(ctx, `
+		SELECT satellite_id, action, sum(a) amount, DATETIME(DATE(interval_start)) as date FROM (
+			SELECT satellite_id, action, sum(amount) a, created_at AS interval_start
+				FROM bandwidth_usage
+				WHERE datetime(?) <= created_at AND created_at <= datetime(?)
+				GROUP BY satellite_id, action, interval_start
+			UNION ALL
+			SELECT satellite_id, action, sum(amount) a, interval_start
+				FROM bandwidth_usage_rollups
+				WHERE datetime(?) <= interval_start AND interval_start <= datetime(?)
+				GROUP BY satellite_id, action, interval_start
+		) GROUP BY satellite_id, action, date
+	`, from, to, from, to)
+	if err != nil {
+		return nil, ErrBandwidth.Wrap(err)
+	}
+	defer func() { err = errs.Combine(err, rows.Close()) }()
+
+	usage := make(map[dailyUsageKey]int64)
+	for rows.Next() {
+		var key dailyUsageKey
+		var amount int64
+		var day dbutil.NullTime
+
+		err := rows.Scan(&key.SatelliteID, &key.Action, &amount, &day)
+		if err != nil {
+			return nil, ErrBandwidth.Wrap(err)
+		}
+		key.Day = getBeginningOfDay(day.Time)
+
+		usage[key] += amount
+	}
+
+	return usage, ErrBandwidth.Wrap(rows.Err())
+}
+
+// eachUnpersisted calls fn for the usage which isn't written to the database
+// yet. The caller must hold persistMu.
+func (db *bandwidthDB) eachUnpersisted(fn func(key bandwidthUsageKey, amount int64)) {
+	db.unpersistedMu.Lock()
+	defer db.unpersistedMu.Unlock()
+
+	for key, amount := range db.unpersisted {
+		fn(key, amount)
+	}
 }
 
 // MonthSummary returns summary of the current months bandwidth usages.
 func (db *bandwidthDB) MonthSummary(ctx context.Context, now time.Time) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
-	db.usedMu.RLock()
+	db.persistMu.RLock()
+	defer db.persistMu.RUnlock()
+
 	beginningOfMonth := getBeginningOfMonth(now)
-	if beginningOfMonth.Equal(db.usedSince) {
-		defer db.usedMu.RUnlock()
-		return db.usedSpace, nil
-	}
-	db.usedMu.RUnlock()
 
-	usage, err := db.Summary(ctx, beginningOfMonth, now)
-	if err != nil {
-		return 0, err
+	db.usedMu.Lock()
+	defer db.usedMu.Unlock()
+
+	// the persisted usage of the month only changes with Persist, which
+	// updates the cached total.
+	if !beginningOfMonth.Equal(db.usedSince) {
+		endOfMonth := beginningOfMonth.AddDate(0, 1, 0).Add(-time.Second)
+		usage, err := db.persistedSummary(ctx, beginningOfMonth, endOfMonth, bandwidthFilter)
+		if err != nil {
+			return 0, err
+		}
+		db.usedSince = beginningOfMonth
+		db.usedSpace = usage.Total()
 	}
-	// Just return the usage, don't update the cache. Let add handle updates
-	return usage.Total(), nil
+
+	total := db.usedSpace
+	db.eachUnpersisted(func(key bandwidthUsageKey, amount int64) {
+		if getBeginningOfMonth(key.IntervalStart).Equal(beginningOfMonth) {
+			total += amount
+		}
+	})
+	return total, nil
 }
 
 // actionFilter sums bandwidth depending on piece action type.
@@ -131,8 +338,36 @@ func (db *bandwidthDB) IngressSummary(ctx context.Context, from, to time.Time) (
 func (db *bandwidthDB) getSummary(ctx context.Context, from, to time.Time, filter actionFilter) (_ *bandwidth.Usage, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	db.persistMu.RLock()
+	defer db.persistMu.RUnlock()
+
+	usage, err := db.persistedSummary(ctx, from, to, filter)
+	if err != nil {
+		return nil, err
+	}
+
+	db.eachUnpersisted(func(key bandwidthUsageKey, amount int64) {
+		if key.within(from, to) {
+			filter(key.Action, amount, usage)
+		}
+	})
+	return usage, nil
+}
+
+// persistedSummary returns bandwidth data for all satellites, which is
+// written to the database.
+func (db *bandwidthDB) persistedSummary(ctx context.Context, from, to time.Time, filter actionFilter) (_ *bandwidth.Usage, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	usage := &bandwidth.Usage{}
 
+	ok, err := db.eachPersistedDaily(ctx, from, to, func(key dailyUsageKey, amount int64) {
+		filter(key.Action, amount, usage)
+	})
+	if err != nil || ok {
+		return usage, err
+	}
+
 	from, to = from.UTC(), to.UTC()
 
 	rows, err := db.QueryContext(ctx, `
@@ -196,8 +431,27 @@ func (db *bandwidthDB) SatelliteIngressSummary(ctx context.Context, satelliteID
 func (db *bandwidthDB) getSatelliteSummary(ctx context.Context, satelliteID storj.NodeID, from, to time.Time, filter actionFilter) (_ *bandwidth.Usage, err error) {
 	defer mon.Task()(&ctx, satelliteID, from, to)(&err)
 
+	db.persistMu.RLock()
+	defer db.persistMu.RUnlock()
+
 	from, to = from.UTC(), to.UTC()
 
+	usage := new(bandwidth.Usage)
+	db.eachUnpersisted(func(key bandwidthUsageKey, amount int64) {
+		if key.SatelliteID == satelliteID && key.within(from, to) {
+			filter(key.Action, amount, usage)
+		}
+	})
+
+	ok, err := db.eachPersistedDaily(ctx, from, to, func(key dailyUsageKey, amount int64) {
+		if key.SatelliteID == satelliteID {
+			filter(key.Action, amount, usage)
+		}
+	})
+	if err != nil || ok {
+		return usage, err
+	}
+
 	query := `SELECT action, sum(a) amount from(
 			SELECT action, sum(amount) a
 				FROM bandwidth_usage
@@ -220,7 +474,6 @@ func (db *bandwidthDB) getSatelliteSummary(ctx context.Context, satelliteID stor
 		err = ErrBandwidth.Wrap(errs.Combine(err, rows.Close()))
 	}()
 
-	usage := new(bandwidth.Usage)
 	for rows.Next() {
 		var action pb.PieceAction
 		var amount int64
@@ -240,10 +493,37 @@ func (db *bandwidthDB) getSatelliteSummary(ctx context.Context, satelliteID stor
 func (db *bandwidthDB) SummaryBySatellite(ctx context.Context, from, to time.Time) (_ map[storj.NodeID]*bandwidth.Usage, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	db.persistMu.RLock()
+	defer db.persistMu.RUnlock()
+
 	entries := map[storj.NodeID]*bandwidth.Usage{}
 
 	from, to = from.UTC(), to.UTC()
 
+	db.eachUnpersisted(func(key bandwidthUsageKey, amount int64) {
+		if !key.within(from, to) {
+			return
+		}
+		entry, ok := entries[key.SatelliteID]
+		if !ok {
+			entry = &bandwidth.Usage{}
+			entries[key.SatelliteID] = entry
+		}
+		entry.Include(key.Action, amount)
+	})
+
+	ok, err := db.eachPersistedDaily(ctx, from, to, func(key dailyUsageKey, amount int64) {
+		entry, ok := entries[key.SatelliteID]
+		if !ok {
+			entry = &bandwidth.Usage{}
+			entries[key.SatelliteID] = entry
+		}
+		entry.Include(key.Action, amount)
+	})
+	if err != nil || ok {
+		return entries, err
+	}
+
 	rows, err := db.QueryContext(ctx, `
 	SELECT satellite_id, action, sum(a) amount from(
 		SELECT satellite_id, action, sum(amount) a
@@ -340,7 +620,8 @@ func (db *bandwidthDB) GetDailyRollups(ctx context.Context, from, to time.Time)
 	since, _ := date.DayBoundary(from.UTC())
 	_, before := date.DayBoundary(to.UTC())
 
-	return db.getDailyUsageRollups(ctx,
+	return db.getDailyUsageRollups(ctx, since, before,
+		func(storj.NodeID) bool { return true },
 		"WHERE datetime(?) <= interval_start AND interval_start <= datetime(?)",
 		since, before)
 }
@@ -353,14 +634,73 @@ func (db *bandwidthDB) GetDailySatelliteRollups(ctx context.Context, satelliteID
 	since, _ := date.DayBoundary(from.UTC())
 	_, before := date.DayBoundary(to.UTC())
 
-	return db.getDailyUsageRollups(ctx,
+	return db.getDailyUsageRollups(ctx, since, before,
+		func(id storj.NodeID) bool { return id == satelliteID },
 		"WHERE satellite_id = ? AND datetime(?) <= interval_start AND interval_start <= datetime(?)",
 		satelliteID, since, before)
 }
 
 // getDailyUsageRollups returns slice of grouped by date bandwidth usage rollups
-// sorted in ascending order and applied condition if any.
-func (db *bandwidthDB) getDailyUsageRollups(ctx context.Context, cond string, args ...interface{}) (_ []bandwidth.UsageRollup, err error) {
+// sorted in ascending order and applied condition if any. since, before and
+// includeSatellite select the usage kept in memory matching the condition.
+func (db *bandwidthDB) getDailyUsageRollups(ctx context.Context, since, before time.Time, includeSatellite func(storj.NodeID) bool, cond string, args ...interface{}) (_ []bandwidth.UsageRollup, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	db.persistMu.RLock()
+	defer db.persistMu.RUnlock()
+
+	var dates []time.Time
+	usageRollupsByDate := make(map[time.Time]*bandwidth.UsageRollup)
+
+	rollupOf := func(intervalStart time.Time) *bandwidth.UsageRollup {
+		rollup, ok := usageRollupsByDate[intervalStart]
+		if !ok {
+			rollup = &bandwidth.UsageRollup{
+				IntervalStart: intervalStart,
+			}
+
+			dates = append(dates, intervalStart)
+			usageRollupsByDate[intervalStart] = rollup
+		}
+		return rollup
+	}
+
+	ok, err := db.eachPersistedDaily(ctx, since, before, func(key dailyUsageKey, amount int64) {
+		if includeSatellite(key.SatelliteID) {
+			includeRollup(rollupOf(key.Day), key.Action, amount)
+		}
+	})
+	if err != nil {
+		return nil, err
+	}
+	if !ok {
+		if err := db.persistedDailyUsageRollups(ctx, rollupOf, cond, args...); err != nil {
+			return nil, err
+		}
+	}
+
+	db.eachUnpersisted(func(key bandwidthUsageKey, amount int64) {
+		if !includeSatellite(key.SatelliteID) || !key.within(since, before) {
+			return
+		}
+		includeRollup(rollupOf(getBeginningOfDay(key.IntervalStart)), key.Action, amount)
+	})
+
+	sort.Slice(dates, func(i, k int) bool {
+		return dates[i].Before(dates[k])
+	})
+
+	var usageRollups []bandwidth.UsageRollup
+	for _, d := range dates {
+		usageRollups = append(usageRollups, *usageRollupsByDate[d])
+	}
+
+	return usageRollups, nil
+}
+
+// persistedDailyUsageRollups adds the persisted usage matching the condition
+// to the rollups by date.
+func (db *bandwidthDB) persistedDailyUsageRollups(ctx context.Context, rollupOf func(date time.Time) *bandwidth.UsageRollup, cond string, args ...interface{}) (err error) {
 	defer mon.Task()(&ctx)(&err)
 
 	query := `SELECT action, sum(a) as amount, DATETIME(DATE(interval_start)) as date FROM (
@@ -381,15 +721,12 @@ func (db *bandwidthDB) getDailyUsageRollups(ctx context.Context, cond string, ar
 
 	rows, err := db.QueryContext(ctx, query, args...)
 	if err != nil {
-		return nil, ErrBandwidth.Wrap(err)
+		return ErrBandwidth.Wrap(err)
 	}
 	defer func() {
 		err = ErrBandwidth.Wrap(errs.Combine(err, rows.Close()))
 	}()
 
-	var dates []time.Time
-	usageRollupsByDate := make(map[time.Time]*bandwidth.UsageRollup)
-
 	for rows.Next() {
 		var action int32
 		var amount int64
@@ -397,46 +734,38 @@ func (db *bandwidthDB) getDailyUsageRollups(ctx context.Context, cond string, ar
 
 		err = rows.Scan(&action, &amount, &intervalStartN)
 		if err != nil {
-			return nil, err
-		}
-
-		intervalStart := intervalStartN.Time
-
-		rollup, ok := usageRollupsByDate[intervalStart]
-		if !ok {
-			rollup = &bandwidth.UsageRollup{
-				IntervalStart: intervalStart,
-			}
-
-			dates = append(dates, intervalStart)
-			usageRollupsByDate[intervalStart] = rollup
+			return err
 		}
 
-		switch pb.PieceAction(action) {
-		case pb.PieceAction_GET:
-			rollup.Egress.Usage = amount
-		case pb.PieceAction_GET_AUDIT:
-			rollup.Egress.Audit = amount
-		case pb.PieceAction_GET_REPAIR:
-			rollup.Egress.Repair = amount
-		case pb.PieceAction_PUT:
-			rollup.Ingress.Usage = amount
-		case pb.PieceAction_PUT_REPAIR:
-			rollup.Ingress.Repair = amount
-		case pb.PieceAction_DELETE:
-			rollup.Delete = amount
-		}
+		includeRollup(rollupOf(intervalStartN.Time), pb.PieceAction(action), amount)
 	}
+	return rows.Err()
+}
 
-	var usageRollups []bandwidth.UsageRollup
-	for _, d := range dates {
-		usageRollups = append(usageRollups, *usageRollupsByDate[d])
+// includeRollup adds the amount of the action to the rollup.
+func includeRollup(rollup *bandwidth.UsageRollup, action pb.PieceAction, amount int64) {
+	switch action {
+	case pb.PieceAction_GET:
+		rollup.Egress.Usage += amount
+	case pb.PieceAction_GET_AUDIT:
+		rollup.Egress.Audit += amount
+	case pb.PieceAction_GET_REPAIR:
+		rollup.Egress.Repair += amount
+	case pb.PieceAction_PUT:
+		rollup.Ingress.Usage += amount
+	case pb.PieceAction_PUT_REPAIR:
+		rollup.Ingress.Repair += amount
+	case pb.PieceAction_DELETE:
+		rollup.Delete += amount
 	}
-
-	return usageRollups, ErrBandwidth.Wrap(rows.Err())
 }
 
 func getBeginningOfMonth(now time.Time) time.Time {
 	y, m, _ := now.UTC().Date()
 	return time.Date(y, m, 1, 0, 0, 0, 0, time.UTC)
 }
+
+func getBeginningOfDay(t time.Time) time.Time {
+	y, m, d := t.UTC().Date()
+	return time.Date(y, m, d, 0, 0, 0, 0, time.UTC)
+}
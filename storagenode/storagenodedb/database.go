@@ -83,6 +83,10 @@ type Config struct {
 	Driver    string // if unset, uses sqlite3
 	Pieces    string
 	Filestore filestore.Config
+
+	// CommitInterval is how long the writes outside of a transaction are
+	// collected to be committed together. Zero disables the batching.
+	CommitInterval time.Duration
 }
 
 // DB contains access to different database tables.
@@ -94,6 +98,10 @@ type DB struct {
 
 	dbDirectory string
 
+	// groupCommit commits the writes of all the databases together, when
+	// the commit interval is set.
+	groupCommit *groupCommitter
+
 	deprecatedInfoDB  *deprecatedInfoDB
 	v0PieceInfoDB     *v0PieceInfoDB
 	bandwidthDB       *bandwidthDB
@@ -119,7 +127,10 @@ func OpenNew(ctx context.Context, log *zap.Logger, config Config) (*DB, error) {
 		return nil, err
 	}
 
-	pieces := filestore.New(log, piecesDir, config.Filestore)
+	pieces, err := openPieces(ctx, log, piecesDir, config.Filestore)
+	if err != nil {
+		return nil, err
+	}
 
 	deprecatedInfoDB := &deprecatedInfoDB{}
 	v0PieceInfoDB := &v0PieceInfoDB{}
@@ -144,6 +155,8 @@ func OpenNew(ctx context.Context, log *zap.Logger, config Config) (*DB, error) {
 
 		dbDirectory: filepath.Dir(config.Info2),
 
+		groupCommit: openGroupCommitter(config),
+
 		deprecatedInfoDB:  deprecatedInfoDB,
 		v0PieceInfoDB:     v0PieceInfoDB,
 		bandwidthDB:       bandwidthDB,
@@ -187,7 +200,10 @@ func OpenExisting(ctx context.Context, log *zap.Logger, config Config) (*DB, err
 		return nil, err
 	}
 
-	pieces := filestore.New(log, piecesDir, config.Filestore)
+	pieces, err := openPieces(ctx, log, piecesDir, config.Filestore)
+	if err != nil {
+		return nil, err
+	}
 
 	deprecatedInfoDB := &deprecatedInfoDB{}
 	v0PieceInfoDB := &v0PieceInfoDB{}
@@ -212,6 +228,8 @@ func OpenExisting(ctx context.Context, log *zap.Logger, config Config) (*DB, err
 
 		dbDirectory: filepath.Dir(config.Info2),
 
+		groupCommit: openGroupCommitter(config),
+
 		deprecatedInfoDB:  deprecatedInfoDB,
 		v0PieceInfoDB:     v0PieceInfoDB,
 		bandwidthDB:       bandwidthDB,
@@ -253,6 +271,26 @@ func OpenExisting(ctx context.Context, log *zap.Logger, config Config) (*DB, err
 	return db, nil
 }
 
+// openPieces returns the blob store of the pieces, which spreads them across
+// the extra paths, when they are configured.
+func openPieces(ctx context.Context, log *zap.Logger, piecesDir *filestore.Dir, config filestore.Config) (storage.Blobs, error) {
+	if len(config.ExtraPaths) == 0 {
+		return filestore.New(log, piecesDir, config), nil
+	}
+
+	dirs := []*filestore.Dir{piecesDir}
+	for _, path := range config.ExtraPaths {
+		// the extra paths are created, so that a disk can be added to an
+		// existing node.
+		dir, err := filestore.NewDir(log, path)
+		if err != nil {
+			return nil, err
+		}
+		dirs = append(dirs, dir)
+	}
+	return filestore.NewMulti(ctx, log, dirs, config)
+}
+
 // openDatabases opens all the SQLite3 storage node databases and returns if any fails to open successfully.
 func (db *DB) openDatabases(ctx context.Context) error {
 	// These objects have a Configure method to allow setting the underlining SQLDB connection
@@ -305,14 +343,28 @@ func (db *DB) openExistingDatabase(ctx context.Context, dbName string) error {
 	return db.openDatabase(ctx, dbName)
 }
 
+// openGroupCommitter returns the committer of the writes of the databases,
+// when it's enabled.
+func openGroupCommitter(config Config) *groupCommitter {
+	if config.CommitInterval <= 0 {
+		return nil
+	}
+	return newGroupCommitter(sqliteDriver(config), config.CommitInterval)
+}
+
+// sqliteDriver returns the name of the driver of the databases.
+func sqliteDriver(config Config) string {
+	if config.Driver == "" {
+		return "sqlite3"
+	}
+	return config.Driver
+}
+
 // openDatabase opens or creates a database at the specified path.
 func (db *DB) openDatabase(ctx context.Context, dbName string) error {
 	path := db.filepathFromDBName(dbName)
 
-	driver := db.config.Driver
-	if driver == "" {
-		driver = "sqlite3"
-	}
+	driver := sqliteDriver(db.config)
 
 	if err := db.closeDatabase(dbName); err != nil {
 		return ErrDatabase.Wrap(err)
@@ -324,7 +376,11 @@ func (db *DB) openDatabase(ctx context.Context, dbName string) error {
 	}
 
 	mDB := db.SQLDBs[dbName]
-	mDB.Configure(sqlDB)
+	if db.groupCommit != nil {
+		mDB.Configure(db.groupCommit.register(dbName, path, sqlDB))
+	} else {
+		mDB.Configure(sqlDB)
+	}
 
 	dbutil.Configure(ctx, sqlDB, dbName, mon)
 
@@ -343,7 +399,13 @@ func (db *DB) filepathFromDBName(dbName string) string {
 // MigrateToLatest creates any necessary tables.
 func (db *DB) MigrateToLatest(ctx context.Context) error {
 	migration := db.Migration(ctx)
-	return migration.Run(ctx, db.log.Named("migration"))
+	err := migration.Run(ctx, db.log.Named("migration"))
+	if db.groupCommit != nil {
+		// the migrations change the tables in transactions, which aren't
+		// seen by the committer.
+		db.groupCommit.resetTables()
+	}
+	return err
 }
 
 // Preflight conducts a pre-flight check to ensure correct schemas and minimal read+write functionality of the database tables.
@@ -456,7 +518,9 @@ func (db *DB) preflight(ctx context.Context, dbName string, dbContainer DBContai
 
 // Close closes any resources.
 func (db *DB) Close() error {
-	return db.closeDatabases()
+	// the bandwidth usage kept in memory would be lost otherwise.
+	persistErr := db.bandwidthDB.Persist(context.Background())
+	return errs.Combine(persistErr, db.closeDatabases())
 }
 
 // closeDatabases closes all the SQLite database connections and removes them from the associated maps.
@@ -0,0 +1,469 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package storagenodedb
+
+import (
+	"context"
+	"database/sql"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/zeebo/errs"
+
+	"storj.io/common/context2"
+	"storj.io/private/tagsql"
+)
+
+// groupCommitMaxFiles is the number of databases which can be attached to a
+// single SQLite connection (SQLITE_MAX_ATTACHED).
+const groupCommitMaxFiles = 10
+
+// groupCommitter collects the statements, which the databases of the node
+// execute outside of a transaction, and commits them together in a single
+// transaction.
+//
+// Every commit of a SQLite database in WAL mode syncs the write-ahead log, so
+// the many small writes of the node (bandwidth, expirations, used serials,
+// ...) would otherwise cost a sync each. The databases stay separate files
+// with their own migrations, but the committer has a single connection to
+// which all of them are attached, so the writes of the different subsystems
+// share one transaction and each touched file is synced once per batch.
+//
+// The statements are collected for the commit interval and each one runs in
+// its own savepoint, so a failing statement doesn't affect the others in the
+// batch.
+type groupCommitter struct {
+	// commits is at the top of the struct for the atomic operations on
+	// 32-bit platforms.
+	commits int64
+
+	driver   string
+	interval time.Duration
+
+	mu         sync.Mutex
+	files      []*groupCommitDB
+	tables     map[*groupCommitDB]map[string]bool
+	generation int
+	pending    []*groupCommitExec
+	committing bool
+
+	// connMu is held while the shared connection is used, so that the files
+	// aren't closed or removed while they are attached.
+	connMu         sync.Mutex
+	connDB         tagsql.DB
+	conn           tagsql.Conn
+	connGeneration int
+}
+
+// groupCommitDB is a database whose writes outside of a transaction are
+// committed by the group committer.
+type groupCommitDB struct {
+	tagsql.DB
+	name      string
+	path      string
+	committer *groupCommitter
+}
+
+// groupCommitExec is a statement waiting to be committed.
+type groupCommitExec struct {
+	ctx   context.Context
+	query string
+	args  []interface{}
+
+	result sql.Result
+	err    error
+	done   chan struct{}
+}
+
+// newGroupCommitter returns a committer which commits the statements executed
+// outside of a transaction every interval.
+func newGroupCommitter(driver string, interval time.Duration) *groupCommitter {
+	return &groupCommitter{
+		driver:   driver,
+		interval: interval,
+		tables:   map[*groupCommitDB]map[string]bool{},
+	}
+}
+
+// register adds the database at path to the committer. The returned database
+// executes the writes which can be group committed through the committer.
+func (committer *groupCommitter) register(name, path string, db tagsql.DB) *groupCommitDB {
+	gdb := &groupCommitDB{
+		DB:        db,
+		name:      name,
+		path:      path,
+		committer: committer,
+	}
+
+	committer.mu.Lock()
+	defer committer.mu.Unlock()
+
+	// the databases which don't fit on the connection commit their writes
+	// directly.
+	if len(committer.files) < groupCommitMaxFiles {
+		committer.files = append(committer.files, gdb)
+		committer.generation++
+	}
+	return gdb
+}
+
+// unregister removes db from the committer and detaches it from the shared
+// connection.
+func (committer *groupCommitter) unregister(db *groupCommitDB) error {
+	committer.mu.Lock()
+	found := false
+	for i, file := range committer.files {
+		if file == db {
+			committer.files = append(committer.files[:i], committer.files[i+1:]...)
+			found = true
+			break
+		}
+	}
+	if found {
+		delete(committer.tables, db)
+		committer.generation++
+	}
+	committer.mu.Unlock()
+
+	if !found {
+		return nil
+	}
+
+	committer.connMu.Lock()
+	defer committer.connMu.Unlock()
+	return committer.closeConn()
+}
+
+// resetTables forgets the tables of the databases, after their schema has
+// changed.
+func (committer *groupCommitter) resetTables() {
+	committer.mu.Lock()
+	defer committer.mu.Unlock()
+	committer.tables = map[*groupCommitDB]map[string]bool{}
+}
+
+// ExecContext executes query in the next batch of the committer, when it can
+// be group committed, and waits for the batch to be committed.
+func (db *groupCommitDB) ExecContext(ctx context.Context, query string, args ...interface{}) (_ sql.Result, err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	table, ok := groupCommitTable(query)
+	if !ok {
+		result, err := db.DB.ExecContext(ctx, query, args...)
+		if !isDML(query) {
+			// the statement may have changed the tables of the database.
+			db.committer.mu.Lock()
+			delete(db.committer.tables, db)
+			db.committer.mu.Unlock()
+		}
+		return result, err
+	}
+
+	ok, err = db.committer.owns(ctx, db, table)
+	if err != nil {
+		return nil, err
+	}
+	if !ok {
+		return db.DB.ExecContext(ctx, query, args...)
+	}
+
+	return db.committer.exec(ctx, &groupCommitExec{
+		ctx:   ctx,
+		query: query,
+		args:  args,
+		done:  make(chan struct{}),
+	})
+}
+
+// Close removes the database from the committer and closes it.
+func (db *groupCommitDB) Close() error {
+	return errs.Combine(db.committer.unregister(db), db.DB.Close())
+}
+
+// owns returns whether db is attached to the shared connection and is the
+// only attached database with table, so that the unqualified table name
+// resolves to db.
+func (committer *groupCommitter) owns(ctx context.Context, db *groupCommitDB, table string) (_ bool, err error) {
+	committer.mu.Lock()
+	defer committer.mu.Unlock()
+
+	owned := false
+	for _, file := range committer.files {
+		tables, ok := committer.tables[file]
+		if !ok {
+			tables, err = queryTables(ctx, file.DB)
+			if err != nil {
+				return false, err
+			}
+			committer.tables[file] = tables
+		}
+
+		if !tables[table] {
+			continue
+		}
+		if file != db {
+			return false, nil
+		}
+		owned = true
+	}
+	return owned, nil
+}
+
+// exec queues the statement and waits for its batch to be committed.
+func (committer *groupCommitter) exec(ctx context.Context, exec *groupCommitExec) (sql.Result, error) {
+	committer.mu.Lock()
+	committer.pending = append(committer.pending, exec)
+	start := !committer.committing
+	committer.committing = true
+	committer.mu.Unlock()
+
+	if start {
+		// the batch is committed on behalf of all the callers, so it must not
+		// be canceled with the context of the first one.
+		go committer.commitPending(context2.WithoutCancellation(ctx))
+	}
+
+	select {
+	case <-exec.done:
+		return exec.result, exec.err
+	case <-ctx.Done():
+		// the statement runs with the canceled context, so it fails and is
+		// rolled back in its savepoint, when the batch hasn't run it yet.
+		return nil, ctx.Err()
+	}
+}
+
+// commitPending commits the pending statements until there are none left.
+func (committer *groupCommitter) commitPending(ctx context.Context) {
+	// wait for the interval to collect the statements of the concurrent
+	// writers; the statements arriving while a batch is committed are
+	// committed in the next one without waiting again.
+	time.Sleep(committer.interval)
+
+	for {
+		committer.mu.Lock()
+		batch := committer.pending
+		committer.pending = nil
+		if len(batch) == 0 {
+			committer.committing = false
+			committer.mu.Unlock()
+			return
+		}
+		committer.mu.Unlock()
+
+		committer.commitBatch(ctx, batch)
+	}
+}
+
+// commitBatch executes the statements of batch in a single transaction on the
+// shared connection.
+func (committer *groupCommitter) commitBatch(ctx context.Context, batch []*groupCommitExec) {
+	var err error
+	defer mon.Task()(&ctx)(&err)
+
+	mon.IntVal("group_commit_batch_size").Observe(int64(len(batch)))
+
+	committer.connMu.Lock()
+	err = committer.withConnTx(ctx, func(tx tagsql.Tx) error {
+		for _, exec := range batch {
+			if err := exec.run(ctx, tx); err != nil {
+				return err
+			}
+		}
+		return nil
+	})
+	if err != nil {
+		// the connection is opened again for the next batch.
+		err = errs.Combine(err, committer.closeConn())
+	}
+	committer.connMu.Unlock()
+	atomic.AddInt64(&committer.commits, 1)
+
+	for _, exec := range batch {
+		if err != nil && exec.err == nil {
+			exec.result, exec.err = nil, err
+		}
+		close(exec.done)
+	}
+}
+
+// withConnTx executes cb in a transaction on the shared connection, which is
+// opened when the attached databases have changed. connMu must be held.
+func (committer *groupCommitter) withConnTx(ctx context.Context, cb func(tx tagsql.Tx) error) (err error) {
+	committer.mu.Lock()
+	generation := committer.generation
+	files := append([]*groupCommitDB(nil), committer.files...)
+	committer.mu.Unlock()
+
+	if committer.conn == nil || committer.connGeneration != generation {
+		if err := committer.closeConn(); err != nil {
+			return err
+		}
+		if err := committer.openConn(ctx, files); err != nil {
+			return errs.Combine(err, committer.closeConn())
+		}
+		committer.connGeneration = generation
+	}
+
+	tx, err := committer.conn.BeginTx(ctx, nil)
+	if err != nil {
+		return err
+	}
+	defer func() {
+		if err != nil {
+			err = errs.Combine(err, tx.Rollback())
+			return
+		}
+
+		err = tx.Commit()
+	}()
+	return cb(tx)
+}
+
+// openConn opens the shared connection and attaches files to it. The main
+// database of the connection is empty, so the unqualified table names resolve
+// to the attached databases. connMu must be held.
+func (committer *groupCommitter) openConn(ctx context.Context, files []*groupCommitDB) (err error) {
+	committer.connDB, err = tagsql.Open(ctx, committer.driver, ":memory:?_busy_timeout=10000")
+	if err != nil {
+		return err
+	}
+
+	committer.conn, err = committer.connDB.Conn(ctx)
+	if err != nil {
+		return err
+	}
+
+	for _, file := range files {
+		_, err = committer.conn.ExecContext(ctx, `ATTACH DATABASE ? AS "`+file.name+`"`, file.path)
+		if err != nil {
+			return ErrDatabase.New("attaching %q: %v", file.name, err)
+		}
+	}
+	return nil
+}
+
+// closeConn closes the shared connection. connMu must be held.
+func (committer *groupCommitter) closeConn() error {
+	var group errs.Group
+	if committer.conn != nil {
+		group.Add(committer.conn.Close())
+		committer.conn = nil
+	}
+	if committer.connDB != nil {
+		group.Add(committer.connDB.Close())
+		committer.connDB = nil
+	}
+	return group.Err()
+}
+
+// run executes the statement in a savepoint of tx. The statement errors are
+// returned to the caller of ExecContext, while the returned error fails the
+// whole transaction.
+func (exec *groupCommitExec) run(ctx context.Context, tx tagsql.Tx) error {
+	if _, err := tx.ExecContext(ctx, "SAVEPOINT group_commit"); err != nil {
+		return err
+	}
+
+	exec.result, exec.err = tx.ExecContext(exec.ctx, exec.query, exec.args...)
+	if exec.err != nil {
+		// ROLLBACK TO keeps the savepoint, so it still needs to be released.
+		if _, err := tx.ExecContext(ctx, "ROLLBACK TO group_commit"); err != nil {
+			return errs.Combine(exec.err, err)
+		}
+	}
+
+	_, err := tx.ExecContext(ctx, "RELEASE group_commit")
+	return err
+}
+
+// queryTables returns the names of the tables of db.
+func queryTables(ctx context.Context, db tagsql.DB) (_ map[string]bool, err error) {
+	rows, err := db.QueryContext(ctx, `SELECT name FROM sqlite_master WHERE type = 'table'`)
+	if err != nil {
+		return nil, err
+	}
+	defer func() { err = errs.Combine(err, rows.Close()) }()
+
+	tables := map[string]bool{}
+	for rows.Next() {
+		var name string
+		if err := rows.Scan(&name); err != nil {
+			return nil, err
+		}
+		tables[strings.ToLower(name)] = true
+	}
+	return tables, rows.Err()
+}
+
+// isDML returns whether query only changes rows.
+func isDML(query string) bool {
+	fields := strings.Fields(query)
+	if len(fields) == 0 {
+		return false
+	}
+
+	switch strings.ToUpper(fields[0]) {
+	case "INSERT", "REPLACE", "UPDATE", "DELETE":
+		return true
+	default:
+		return false
+	}
+}
+
+// groupCommitTable returns the table changed by query, when query can be
+// group committed: it must be a single INSERT, REPLACE, UPDATE or DELETE of
+// an unqualified table.
+func groupCommitTable(query string) (table string, ok bool) {
+	if strings.Contains(strings.TrimRight(strings.TrimSpace(query), ";"), ";") {
+		return "", false
+	}
+
+	fields := strings.Fields(strings.ReplaceAll(query, "(", " ("))
+	next := func() string {
+		if len(fields) == 0 {
+			return ""
+		}
+		field := strings.ToUpper(fields[0])
+		fields = fields[1:]
+		return field
+	}
+
+	switch next() {
+	case "INSERT":
+		if len(fields) > 0 && strings.ToUpper(fields[0]) == "OR" {
+			next()
+			next()
+		}
+		if next() != "INTO" {
+			return "", false
+		}
+	case "REPLACE":
+		if next() != "INTO" {
+			return "", false
+		}
+	case "UPDATE":
+		if len(fields) > 0 && strings.ToUpper(fields[0]) == "OR" {
+			next()
+			next()
+		}
+	case "DELETE":
+		if next() != "FROM" {
+			return "", false
+		}
+	default:
+		return "", false
+	}
+
+	if len(fields) == 0 {
+		return "", false
+	}
+	table = strings.ToLower(strings.Trim(fields[0], "\"`[]"))
+	if table == "" || strings.Contains(table, ".") {
+		return "", false
+	}
+	return table, true
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package storagenodedb
+
+import (
+	"context"
+	"sync"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/require"
+
+	"storj.io/common/testcontext"
+	"storj.io/private/tagsql"
+)
+
+// openGroupCommitDBs opens two databases, which share the versions table, and
+// registers them to a committer, when interval isn't zero.
+func openGroupCommitDBs(ctx *testcontext.Context, t testing.TB, interval time.Duration) (committer *groupCommitter, bandwidth, expiration tagsql.DB) {
+	committer = newGroupCommitter("sqlite3", interval)
+
+	open := func(name, table string) tagsql.DB {
+		path := ctx.File(name + ".db")
+		sqlDB, err := tagsql.Open(ctx, "sqlite3", "file:"+path+"?_journal=WAL&_busy_timeout=10000")
+		require.NoError(t, err)
+
+		for _, query := range []string{
+			`CREATE TABLE versions (version INTEGER NOT NULL)`,
+			`CREATE TABLE ` + table + ` (id INTEGER NOT NULL, value INTEGER NOT NULL, PRIMARY KEY (id))`,
+		} {
+			_, err := sqlDB.ExecContext(ctx, query)
+			require.NoError(t, err)
+		}
+
+		if interval == 0 {
+			return sqlDB
+		}
+		return committer.register(name, path, sqlDB)
+	}
+
+	return committer, open("bandwidth", "bandwidth"), open("expiration", "expiration")
+}
+
+func TestGroupCommit(t *testing.T) {
+	ctx := testcontext.New(t)
+	defer ctx.Cleanup()
+
+	committer, bandwidth, expiration := openGroupCommitDBs(ctx, t, 10*time.Millisecond)
+	defer ctx.Check(bandwidth.Close)
+	defer ctx.Check(expiration.Close)
+
+	const writers = 50
+
+	var wg sync.WaitGroup
+	errors := make([]error, 2*writers)
+	for i := 0; i < writers; i++ {
+		i := i
+		wg.Add(2)
+		go func() {
+			defer wg.Done()
+			// the last writer conflicts with the first one.
+			_, errors[i] = bandwidth.ExecContext(ctx, `INSERT INTO bandwidth (id, value) VALUES (?, ?)`, i%(writers-1), i)
+		}()
+		go func() {
+			defer wg.Done()
+			_, errors[writers+i] = expiration.ExecContext(ctx, `INSERT INTO expiration (id, value) VALUES (?, ?)`, i, i)
+		}()
+	}
+	wg.Wait()
+
+	var failed int
+	for _, err := range errors {
+		if err != nil {
+			failed++
+		}
+	}
+	require.Equal(t, 1, failed)
+	// the writes to both databases share the commits.
+	require.Less(t, atomic.LoadInt64(&committer.commits), int64(writers))
+
+	var count int
+	require.NoError(t, bandwidth.QueryRowContext(ctx, `SELECT COUNT(*) FROM bandwidth`).Scan(&count))
+	require.Equal(t, writers-1, count)
+	require.NoError(t, expiration.QueryRowContext(ctx, `SELECT COUNT(*) FROM expiration`).Scan(&count))
+	require.Equal(t, writers, count)
+
+	// the tables of several databases are written directly, so that they
+	// aren't written to the wrong database.
+	commits := atomic.LoadInt64(&committer.commits)
+	_, err := expiration.ExecContext(ctx, `INSERT INTO versions (version) VALUES (1)`)
+	require.NoError(t, err)
+	require.Equal(t, commits, atomic.LoadInt64(&committer.commits))
+
+	require.NoError(t, bandwidth.QueryRowContext(ctx, `SELECT COUNT(*) FROM versions`).Scan(&count))
+	require.Zero(t, count)
+	require.NoError(t, expiration.QueryRowContext(ctx, `SELECT COUNT(*) FROM versions`).Scan(&count))
+	require.Equal(t, 1, count)
+
+	// a table created later is group committed.
+	_, err = bandwidth.ExecContext(ctx, `CREATE TABLE rollups (id INTEGER NOT NULL)`)
+	require.NoError(t, err)
+	_, err = bandwidth.ExecContext(ctx, `INSERT INTO rollups (id) VALUES (1)`)
+	require.NoError(t, err)
+	require.Equal(t, commits+1, atomic.LoadInt64(&committer.commits))
+
+	// the callers don't wait for the batch after their context is canceled.
+	canceled, cancel := context.WithCancel(ctx)
+	cancel()
+	_, err = bandwidth.ExecContext(canceled, `INSERT INTO bandwidth (id, value) VALUES (?, ?)`, writers, 0)
+	require.ErrorIs(t, err, context.Canceled)
+
+	// statements which can't run in a transaction are executed directly.
+	_, err = bandwidth.ExecContext(ctx, `VACUUM`)
+	require.NoError(t, err)
+}
+
+func BenchmarkGroupCommit(b *testing.B) {
+	for _, interval := range []time.Duration{0, time.Millisecond, 5 * time.Millisecond} {
+		interval := interval
+		b.Run("interval="+interval.String(), func(b *testing.B) {
+			ctx := testcontext.New(b)
+			defer ctx.Cleanup()
+
+			committer, bandwidth, expiration := openGroupCommitDBs(ctx, b, interval)
+			defer ctx.Check(bandwidth.Close)
+			defer ctx.Check(expiration.Close)
+
+			exec := func(db tagsql.DB, query string, args ...interface{}) error {
+				_, err := db.ExecContext(ctx, query, args...)
+				if interval == 0 {
+					atomic.AddInt64(&committer.commits, 1)
+				}
+				return err
+			}
+
+			var next, latency int64
+			b.SetParallelism(16)
+			b.ResetTimer()
+			start := time.Now()
+
+			// a mixed load of inserts and updates of the two databases.
+			b.RunParallel(func(pb *testing.PB) {
+				for pb.Next() {
+					id := atomic.AddInt64(&next, 1)
+
+					var err error
+					writeStart := time.Now()
+					switch id % 3 {
+					case 0:
+						err = exec(bandwidth, `INSERT INTO bandwidth (id, value) VALUES (?, ?)`, id, id)
+					case 1:
+						err = exec(expiration, `INSERT INTO expiration (id, value) VALUES (?, ?)`, id, id)
+					default:
+						err = exec(bandwidth, `UPDATE bandwidth SET value = value + ? WHERE id = ?`, id, id-2)
+					}
+					atomic.AddInt64(&latency, int64(time.Since(writeStart)))
+					if err != nil {
+						b.Error(err)
+						return
+					}
+				}
+			})
+
+			elapsed := time.Since(start)
+			b.StopTimer()
+
+			// every commit syncs the write-ahead log of each database it
+			// changes once.
+			b.ReportMetric(float64(atomic.LoadInt64(&committer.commits))/elapsed.Seconds(), "commits/s")
+			b.ReportMetric(float64(latency)/float64(b.N), "latency-ns/op")
+			b.ReportMetric(float64(b.N)/elapsed.Seconds(), "writes/s")
+		})
+	}
+}
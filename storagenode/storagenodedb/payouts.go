@@ -24,13 +24,47 @@ var ErrPayout = errs.Class("payouts")
 const HeldAmountDBName = "heldamount"
 
 // payoutDB works with node payouts DB.
+//
+// The payouts are only written by the payout chore, so the query results are
+// cached until the next write.
 type payoutDB struct {
+	cache queryCache
+
 	dbContainerImpl
 }
 
+// cachedInt64 returns the cached result of a query, which returns an int64.
+func (db *payoutDB) cachedInt64(key queryKey, load func() (int64, error)) (int64, error) {
+	result, err := db.cache.get(key, func() (interface{}, error) {
+		return load()
+	})
+	if err != nil {
+		return 0, err
+	}
+	return result.(int64), nil
+}
+
+// cachedPayStub returns a copy of the cached result of a query, which
+// returns a paystub.
+func (db *payoutDB) cachedPayStub(key queryKey, load func() (*payouts.PayStub, error)) (*payouts.PayStub, error) {
+	result, err := db.cache.get(key, func() (interface{}, error) {
+		paystub, err := load()
+		if err != nil {
+			return nil, err
+		}
+		return *paystub, nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	copied := result.(payouts.PayStub)
+	return &copied, nil
+}
+
 // StorePayStub inserts or updates paystub data into the db.
 func (db *payoutDB) StorePayStub(ctx context.Context, paystub payouts.PayStub) (err error) {
 	defer mon.Task()(&ctx)(&err)
+	defer db.cache.invalidate()
 
 	query := `INSERT OR REPLACE INTO paystubs (
 			period,
@@ -89,6 +123,14 @@ func (db *payoutDB) StorePayStub(ctx context.Context, paystub payouts.PayStub) (
 func (db *payoutDB) GetPayStub(ctx context.Context, satelliteID storj.NodeID, period string) (_ *payouts.PayStub, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedPayStub(newPeriodQueryKey("GetPayStub", satelliteID, period), func() (*payouts.PayStub, error) {
+		return db.getPayStub(ctx, satelliteID, period)
+	})
+}
+
+func (db *payoutDB) getPayStub(ctx context.Context, satelliteID storj.NodeID, period string) (_ *payouts.PayStub, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	result := payouts.PayStub{
 		SatelliteID: satelliteID,
 		Period:      period,
@@ -155,6 +197,18 @@ func (db *payoutDB) GetPayStub(ctx context.Context, satelliteID storj.NodeID, pe
 func (db *payoutDB) AllPayStubs(ctx context.Context, period string) (_ []payouts.PayStub, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("AllPayStubs", storj.NodeID{}, period), func() (interface{}, error) {
+		return db.allPayStubs(ctx, period)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]payouts.PayStub(nil), result.([]payouts.PayStub)...), nil
+}
+
+func (db *payoutDB) allPayStubs(ctx context.Context, period string) (_ []payouts.PayStub, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT
 			satellite_id,
 			created_at,
@@ -230,6 +284,18 @@ func (db *payoutDB) AllPayStubs(ctx context.Context, period string) (_ []payouts
 func (db *payoutDB) SatellitesHeldbackHistory(ctx context.Context, id storj.NodeID) (_ []payouts.HeldForPeriod, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("SatellitesHeldbackHistory", id, ""), func() (interface{}, error) {
+		return db.satellitesHeldbackHistory(ctx, id)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]payouts.HeldForPeriod(nil), result.([]payouts.HeldForPeriod)...), nil
+}
+
+func (db *payoutDB) satellitesHeldbackHistory(ctx context.Context, id storj.NodeID) (_ []payouts.HeldForPeriod, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT
 			period,
 			held
@@ -264,6 +330,18 @@ func (db *payoutDB) SatellitesHeldbackHistory(ctx context.Context, id storj.Node
 func (db *payoutDB) SatellitePeriods(ctx context.Context, satelliteID storj.NodeID) (_ []string, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("SatellitePeriods", satelliteID, ""), func() (interface{}, error) {
+		return db.satellitePeriods(ctx, satelliteID)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]string(nil), result.([]string)...), nil
+}
+
+func (db *payoutDB) satellitePeriods(ctx context.Context, satelliteID storj.NodeID) (_ []string, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT distinct period FROM paystubs WHERE satellite_id = ? ORDER BY created_at`
 
 	rows, err := db.QueryContext(ctx, query, satelliteID[:])
@@ -294,6 +372,18 @@ func (db *payoutDB) SatellitePeriods(ctx context.Context, satelliteID storj.Node
 func (db *payoutDB) AllPeriods(ctx context.Context) (_ []string, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("AllPeriods", storj.NodeID{}, ""), func() (interface{}, error) {
+		return db.allPeriods(ctx)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]string(nil), result.([]string)...), nil
+}
+
+func (db *payoutDB) allPeriods(ctx context.Context) (_ []string, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT distinct period FROM paystubs ORDER BY created_at`
 
 	rows, err := db.QueryContext(ctx, query)
@@ -323,6 +413,7 @@ func (db *payoutDB) AllPeriods(ctx context.Context) (_ []string, err error) {
 // StorePayment inserts or updates payment data into the db.
 func (db *payoutDB) StorePayment(ctx context.Context, payment payouts.Payment) (err error) {
 	defer mon.Task()(&ctx)(&err)
+	defer db.cache.invalidate()
 
 	query := `INSERT OR REPLACE INTO payments (
 			id,
@@ -351,6 +442,14 @@ func (db *payoutDB) StorePayment(ctx context.Context, payment payouts.Payment) (
 func (db *payoutDB) SatellitesDisposedHistory(ctx context.Context, satelliteID storj.NodeID) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedInt64(newPeriodQueryKey("SatellitesDisposedHistory", satelliteID, ""), func() (int64, error) {
+		return db.satellitesDisposedHistory(ctx, satelliteID)
+	})
+}
+
+func (db *payoutDB) satellitesDisposedHistory(ctx context.Context, satelliteID storj.NodeID) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT
 			disposed
 		FROM paystubs WHERE satellite_id = ? ORDER BY period ASC`
@@ -384,6 +483,18 @@ func (db *payoutDB) SatellitesDisposedHistory(ctx context.Context, satelliteID s
 func (db *payoutDB) GetReceipt(ctx context.Context, satelliteID storj.NodeID, period string) (receipt string, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("GetReceipt", satelliteID, period), func() (interface{}, error) {
+		return db.getReceipt(ctx, satelliteID, period)
+	})
+	if err != nil {
+		return "", err
+	}
+	return result.(string), nil
+}
+
+func (db *payoutDB) getReceipt(ctx context.Context, satelliteID storj.NodeID, period string) (receipt string, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	rowPayment := db.QueryRowContext(ctx,
 		`SELECT receipt FROM payments WHERE satellite_id = ? AND period = ?`,
 		satelliteID, period,
@@ -404,6 +515,14 @@ func (db *payoutDB) GetReceipt(ctx context.Context, satelliteID storj.NodeID, pe
 func (db *payoutDB) GetTotalEarned(ctx context.Context) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedInt64(newPeriodQueryKey("GetTotalEarned", storj.NodeID{}, ""), func() (int64, error) {
+		return db.getTotalEarned(ctx)
+	})
+}
+
+func (db *payoutDB) getTotalEarned(ctx context.Context) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT comp_at_rest, comp_get, comp_get_repair, comp_get_audit FROM paystubs`
 
 	rows, err := db.QueryContext(ctx, query)
@@ -435,6 +554,14 @@ func (db *payoutDB) GetTotalEarned(ctx context.Context) (_ int64, err error) {
 func (db *payoutDB) GetEarnedAtSatellite(ctx context.Context, id storj.NodeID) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedInt64(newPeriodQueryKey("GetEarnedAtSatellite", id, ""), func() (int64, error) {
+		return db.getEarnedAtSatellite(ctx, id)
+	})
+}
+
+func (db *payoutDB) getEarnedAtSatellite(ctx context.Context, id storj.NodeID) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT comp_at_rest, comp_get, comp_get_repair, comp_get_audit FROM paystubs WHERE satellite_id = ?`
 
 	rows, err := db.QueryContext(ctx, query, id)
@@ -467,6 +594,18 @@ func (db *payoutDB) GetEarnedAtSatellite(ctx context.Context, id storj.NodeID) (
 func (db *payoutDB) GetPayingSatellitesIDs(ctx context.Context) (_ []storj.NodeID, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("GetPayingSatellitesIDs", storj.NodeID{}, ""), func() (interface{}, error) {
+		return db.getPayingSatellitesIDs(ctx)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]storj.NodeID(nil), result.([]storj.NodeID)...), nil
+}
+
+func (db *payoutDB) getPayingSatellitesIDs(ctx context.Context) (_ []storj.NodeID, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT DISTINCT (satellite_id) FROM paystubs`
 
 	rows, err := db.QueryContext(ctx, query)
@@ -502,6 +641,20 @@ func (db *payoutDB) GetPayingSatellitesIDs(ctx context.Context) (_ []storj.NodeI
 func (db *payoutDB) GetSatelliteSummary(ctx context.Context, satelliteID storj.NodeID) (_, _ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("GetSatelliteSummary", satelliteID, ""), func() (interface{}, error) {
+		paid, held, err := db.getSatelliteSummary(ctx, satelliteID)
+		return [2]int64{paid, held}, err
+	})
+	if err != nil {
+		return 0, 0, err
+	}
+	amounts := result.([2]int64)
+	return amounts[0], amounts[1], nil
+}
+
+func (db *payoutDB) getSatelliteSummary(ctx context.Context, satelliteID storj.NodeID) (_, _ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT paid, held FROM paystubs WHERE satellite_id = ?`
 
 	rows, err := db.QueryContext(ctx, query, satelliteID)
@@ -538,6 +691,20 @@ func (db *payoutDB) GetSatelliteSummary(ctx context.Context, satelliteID storj.N
 func (db *payoutDB) GetSatellitePeriodSummary(ctx context.Context, satelliteID storj.NodeID, period string) (_, _ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("GetSatellitePeriodSummary", satelliteID, period), func() (interface{}, error) {
+		paid, held, err := db.getSatellitePeriodSummary(ctx, satelliteID, period)
+		return [2]int64{paid, held}, err
+	})
+	if err != nil {
+		return 0, 0, err
+	}
+	amounts := result.([2]int64)
+	return amounts[0], amounts[1], nil
+}
+
+func (db *payoutDB) getSatellitePeriodSummary(ctx context.Context, satelliteID storj.NodeID, period string) (_, _ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT paid, held FROM paystubs WHERE satellite_id = ? AND period = ?`
 
 	rows, err := db.QueryContext(ctx, query, satelliteID, period)
@@ -569,6 +736,14 @@ func (db *payoutDB) GetSatellitePeriodSummary(ctx context.Context, satelliteID s
 func (db *payoutDB) GetUndistributed(ctx context.Context) (_ int64, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedInt64(newPeriodQueryKey("GetUndistributed", storj.NodeID{}, ""), func() (int64, error) {
+		return db.getUndistributed(ctx)
+	})
+}
+
+func (db *payoutDB) getUndistributed(ctx context.Context) (_ int64, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	var distributed, paid int64
 
 	rowPayment := db.QueryRowContext(ctx,
@@ -590,6 +765,14 @@ func (db *payoutDB) GetUndistributed(ctx context.Context) (_ int64, err error) {
 func (db *payoutDB) GetSatellitePaystubs(ctx context.Context, satelliteID storj.NodeID) (_ *payouts.PayStub, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedPayStub(newPeriodQueryKey("GetSatellitePaystubs", satelliteID, ""), func() (*payouts.PayStub, error) {
+		return db.getSatellitePaystubs(ctx, satelliteID)
+	})
+}
+
+func (db *payoutDB) getSatellitePaystubs(ctx context.Context, satelliteID storj.NodeID) (_ *payouts.PayStub, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	rowPayment := db.QueryRowContext(ctx,
 		`SELECT COALESCE(SUM(usage_at_rest),0), COALESCE(SUM(usage_get),0), COALESCE(SUM(usage_get_repair),0), COALESCE(SUM(usage_get_audit),0),
 			COALESCE(SUM(comp_at_rest),0), COALESCE(SUM(comp_get),0), COALESCE(SUM(comp_get_repair),0), COALESCE(SUM(comp_get_audit),0), 
@@ -622,6 +805,14 @@ func (db *payoutDB) GetSatellitePaystubs(ctx context.Context, satelliteID storj.
 func (db *payoutDB) GetPaystubs(ctx context.Context) (_ *payouts.PayStub, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedPayStub(newPeriodQueryKey("GetPaystubs", storj.NodeID{}, ""), func() (*payouts.PayStub, error) {
+		return db.getPaystubs(ctx)
+	})
+}
+
+func (db *payoutDB) getPaystubs(ctx context.Context) (_ *payouts.PayStub, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	rowPayment := db.QueryRowContext(ctx,
 		`SELECT COALESCE(SUM(usage_at_rest),0), COALESCE(SUM(usage_get),0), COALESCE(SUM(usage_get_repair),0), COALESCE(SUM(usage_get_audit),0),
 			COALESCE(SUM(comp_at_rest),0), COALESCE(SUM(comp_get),0), COALESCE(SUM(comp_get_repair),0), COALESCE(SUM(comp_get_audit),0), 
@@ -654,6 +845,14 @@ func (db *payoutDB) GetPaystubs(ctx context.Context) (_ *payouts.PayStub, err er
 func (db *payoutDB) GetPeriodPaystubs(ctx context.Context, period string) (_ *payouts.PayStub, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedPayStub(newPeriodQueryKey("GetPeriodPaystubs", storj.NodeID{}, period), func() (*payouts.PayStub, error) {
+		return db.getPeriodPaystubs(ctx, period)
+	})
+}
+
+func (db *payoutDB) getPeriodPaystubs(ctx context.Context, period string) (_ *payouts.PayStub, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	rowPayment := db.QueryRowContext(ctx,
 		`SELECT COALESCE(SUM(usage_at_rest),0), COALESCE(SUM(usage_get),0), COALESCE(SUM(usage_get_repair),0), COALESCE(SUM(usage_get_audit),0),
 			COALESCE(SUM(comp_at_rest),0), COALESCE(SUM(comp_get),0), COALESCE(SUM(comp_get_repair),0), COALESCE(SUM(comp_get_audit),0), 
@@ -686,6 +885,14 @@ func (db *payoutDB) GetPeriodPaystubs(ctx context.Context, period string) (_ *pa
 func (db *payoutDB) GetSatellitePeriodPaystubs(ctx context.Context, period string, satelliteID storj.NodeID) (_ *payouts.PayStub, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	return db.cachedPayStub(newPeriodQueryKey("GetSatellitePeriodPaystubs", satelliteID, period), func() (*payouts.PayStub, error) {
+		return db.getSatellitePeriodPaystubs(ctx, period, satelliteID)
+	})
+}
+
+func (db *payoutDB) getSatellitePeriodPaystubs(ctx context.Context, period string, satelliteID storj.NodeID) (_ *payouts.PayStub, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	rowPayment := db.QueryRowContext(ctx,
 		`SELECT COALESCE(SUM(usage_at_rest),0), COALESCE(SUM(usage_get),0), COALESCE(SUM(usage_get_repair),0), COALESCE(SUM(usage_get_audit),0),
 			COALESCE(SUM(comp_at_rest),0), COALESCE(SUM(comp_get),0), COALESCE(SUM(comp_get_repair),0), COALESCE(SUM(comp_get_audit),0), 
@@ -718,6 +925,18 @@ func (db *payoutDB) GetSatellitePeriodPaystubs(ctx context.Context, period strin
 func (db *payoutDB) HeldAmountHistory(ctx context.Context) (_ []payouts.HeldAmountHistory, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	result, err := db.cache.get(newPeriodQueryKey("HeldAmountHistory", storj.NodeID{}, ""), func() (interface{}, error) {
+		return db.heldAmountHistory(ctx)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]payouts.HeldAmountHistory(nil), result.([]payouts.HeldAmountHistory)...), nil
+}
+
+func (db *payoutDB) heldAmountHistory(ctx context.Context) (_ []payouts.HeldAmountHistory, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `
 		SELECT
 			satellite_id,
@@ -10,6 +10,7 @@ import (
 	"github.com/zeebo/errs"
 
 	"storj.io/common/storj"
+	"storj.io/private/tagsql"
 	"storj.io/storj/storagenode/pieces"
 )
 
@@ -85,6 +86,73 @@ func (db *pieceExpirationDB) DeleteExpiration(ctx context.Context, satelliteID s
 	return numRows > 0, nil
 }
 
+// SetExpirations sets the expiration times of several pieces in a single
+// transaction. Pieces which already have an expiration time are left as is.
+func (db *pieceExpirationDB) SetExpirations(ctx context.Context, expirations []pieces.ExpirationInfo) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(expirations) == 0 {
+		return nil
+	}
+
+	return ErrPieceExpiration.Wrap(withTx(ctx, db.GetDB(), func(tx tagsql.Tx) error {
+		for _, expiration := range expirations {
+			_, err := tx.ExecContext(ctx, `
+				INSERT INTO piece_expirations(satellite_id, piece_id, piece_expiration)
+					VALUES (?,?,?)
+					ON CONFLICT DO NOTHING
+			`, expiration.SatelliteID, expiration.PieceID, expiration.PieceExpiration.UTC())
+			if err != nil {
+				return err
+			}
+		}
+		return nil
+	}))
+}
+
+// DeleteExpirations removes the expiration records of several pieces in a
+// single transaction.
+func (db *pieceExpirationDB) DeleteExpirations(ctx context.Context, expired []pieces.ExpiredInfo) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	if len(expired) == 0 {
+		return nil
+	}
+
+	return ErrPieceExpiration.Wrap(withTx(ctx, db.GetDB(), func(tx tagsql.Tx) error {
+		for _, info := range expired {
+			_, err := tx.ExecContext(ctx, `
+				DELETE FROM piece_expirations
+					WHERE satellite_id = ? AND piece_id = ?
+			`, info.SatelliteID, info.PieceID)
+			if err != nil {
+				return err
+			}
+		}
+		return nil
+	}))
+}
+
+// WalkPieceIDs calls fn for every piece which has an expiration record.
+func (db *pieceExpirationDB) WalkPieceIDs(ctx context.Context, fn func(pieceID storj.PieceID)) (err error) {
+	defer mon.Task()(&ctx)(&err)
+
+	rows, err := db.QueryContext(ctx, `SELECT piece_id FROM piece_expirations`)
+	if err != nil {
+		return ErrPieceExpiration.Wrap(err)
+	}
+	defer func() { err = errs.Combine(err, rows.Close()) }()
+
+	for rows.Next() {
+		var pieceID storj.PieceID
+		if err := rows.Scan(&pieceID); err != nil {
+			return ErrPieceExpiration.Wrap(err)
+		}
+		fn(pieceID)
+	}
+	return ErrPieceExpiration.Wrap(rows.Err())
+}
+
 // DeleteFailed marks an expiration record as having experienced a failure in deleting the piece
 // from the disk.
 func (db *pieceExpirationDB) DeleteFailed(ctx context.Context, satelliteID storj.NodeID, pieceID storj.PieceID, when time.Time) (err error) {
@@ -7,6 +7,7 @@ import (
 	"context"
 	"database/sql"
 	"errors"
+	"time"
 
 	"github.com/zeebo/errs"
 
@@ -25,14 +26,20 @@ const PricingDBName = "pricing"
 
 // pricing works with node pricing DB.
 //
+// The pricing is only written by the node stats chore, so the query results
+// are cached until the next write.
+//
 // architecture: Database
 type pricingDB struct {
+	cache queryCache
+
 	dbContainerImpl
 }
 
 // Store inserts or updates pricing model into the db.
 func (db *pricingDB) Store(ctx context.Context, pricing pricing.Pricing) (err error) {
 	defer mon.Task()(&ctx)(&err)
+	defer db.cache.invalidate()
 
 	query := `INSERT OR REPLACE INTO pricing (
 			satellite_id,
@@ -57,6 +64,23 @@ func (db *pricingDB) Store(ctx context.Context, pricing pricing.Pricing) (err er
 func (db *pricingDB) Get(ctx context.Context, satelliteID storj.NodeID) (_ *pricing.Pricing, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	pricingModel, err := db.cache.get(newQueryKey("Get", satelliteID, time.Time{}, time.Time{}), func() (interface{}, error) {
+		pricingModel, err := db.get(ctx, satelliteID)
+		if err != nil {
+			return nil, err
+		}
+		return *pricingModel, nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	copied := pricingModel.(pricing.Pricing)
+	return &copied, nil
+}
+
+func (db *pricingDB) get(ctx context.Context, satelliteID storj.NodeID) (_ *pricing.Pricing, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	pricingModel := pricing.Pricing{
 		SatelliteID: satelliteID,
 	}
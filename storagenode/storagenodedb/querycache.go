@@ -0,0 +1,90 @@
+// Copyright (C) 2021 Storj Labs, Inc.
+// See LICENSE for copying information.
+
+package storagenodedb
+
+import (
+	"sync"
+	"time"
+
+	"storj.io/common/storj"
+)
+
+// queryCacheLimit is the number of results after which the query cache is
+// emptied, in case the queries use many different arguments.
+const queryCacheLimit = 1000
+
+// queryKey identifies a query and its arguments in the query cache.
+type queryKey struct {
+	method      string
+	satelliteID storj.NodeID
+	from, to    time.Time
+	period      string
+}
+
+// newQueryKey returns the key of the query. The times are converted to UTC,
+// which drops the monotonic clock reading, so equal times give equal keys.
+func newQueryKey(method string, satelliteID storj.NodeID, from, to time.Time) queryKey {
+	return queryKey{
+		method:      method,
+		satelliteID: satelliteID,
+		from:        from.UTC(),
+		to:          to.UTC(),
+	}
+}
+
+// newPeriodQueryKey returns the key of a query of a payout period.
+func newPeriodQueryKey(method string, satelliteID storj.NodeID, period string) queryKey {
+	return queryKey{
+		method:      method,
+		satelliteID: satelliteID,
+		period:      period,
+	}
+}
+
+// queryCache keeps the results of the queries of a database, which is only
+// written by a chore, until the next write. The results must not be modified
+// by the callers.
+type queryCache struct {
+	mu         sync.Mutex
+	generation uint64
+	results    map[queryKey]interface{}
+}
+
+// get returns the cached result of the query, or the result of load, which
+// is cached unless the database has been written meanwhile.
+func (cache *queryCache) get(key queryKey, load func() (interface{}, error)) (interface{}, error) {
+	cache.mu.Lock()
+	if result, ok := cache.results[key]; ok {
+		cache.mu.Unlock()
+		mon.Event("query_cache_hit")
+		return result, nil
+	}
+	generation := cache.generation
+	cache.mu.Unlock()
+
+	result, err := load()
+	if err != nil {
+		return nil, err
+	}
+
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	if cache.generation == generation {
+		if cache.results == nil || len(cache.results) >= queryCacheLimit {
+			cache.results = make(map[queryKey]interface{})
+		}
+		cache.results[key] = result
+	}
+	return result, nil
+}
+
+// invalidate drops the cached results after the database has been written.
+func (cache *queryCache) invalidate() {
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	cache.generation++
+	cache.results = nil
+}
@@ -7,6 +7,7 @@ import (
 	"context"
 	"database/sql"
 	"errors"
+	"time"
 
 	"github.com/zeebo/errs"
 
@@ -22,13 +23,19 @@ var ErrReputation = errs.Class("reputation")
 const ReputationDBName = "reputation"
 
 // reputation works with node reputation DB.
+//
+// The reputation is only written by the node stats chore, so the query
+// results are cached until the next write.
 type reputationDB struct {
+	cache queryCache
+
 	dbContainerImpl
 }
 
 // Store inserts or updates reputation stats into the db.
 func (db *reputationDB) Store(ctx context.Context, stats reputation.Stats) (err error) {
 	defer mon.Task()(&ctx)(&err)
+	defer db.cache.invalidate()
 
 	query := `INSERT OR REPLACE INTO reputation (
 			satellite_id,
@@ -105,6 +112,23 @@ func (db *reputationDB) Store(ctx context.Context, stats reputation.Stats) (err
 func (db *reputationDB) Get(ctx context.Context, satelliteID storj.NodeID) (_ *reputation.Stats, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	stats, err := db.cache.get(newQueryKey("Get", satelliteID, time.Time{}, time.Time{}), func() (interface{}, error) {
+		stats, err := db.get(ctx, satelliteID)
+		if err != nil {
+			return nil, err
+		}
+		return *stats, nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	copied := stats.(reputation.Stats)
+	return &copied, nil
+}
+
+func (db *reputationDB) get(ctx context.Context, satelliteID storj.NodeID) (_ *reputation.Stats, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	stats := reputation.Stats{
 		SatelliteID: satelliteID,
 	}
@@ -171,6 +195,18 @@ func (db *reputationDB) Get(ctx context.Context, satelliteID storj.NodeID) (_ *r
 func (db *reputationDB) All(ctx context.Context) (_ []reputation.Stats, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	statsList, err := db.cache.get(newQueryKey("All", storj.NodeID{}, time.Time{}, time.Time{}), func() (interface{}, error) {
+		return db.all(ctx)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]reputation.Stats(nil), statsList.([]reputation.Stats)...), nil
+}
+
+func (db *reputationDB) all(ctx context.Context) (_ []reputation.Stats, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT satellite_id,
 			audit_success_count,
 			audit_total_count,
@@ -19,7 +19,12 @@ import (
 const StorageUsageDBName = "storage_usage"
 
 // storageUsageDB storage usage DB.
+//
+// The storage usage is only written by the node stats chore, so the query
+// results are cached until the next write.
 type storageUsageDB struct {
+	cache queryCache
+
 	dbContainerImpl
 }
 
@@ -31,6 +36,8 @@ func (db *storageUsageDB) Store(ctx context.Context, stamps []storageusage.Stamp
 		return nil
 	}
 
+	defer db.cache.invalidate()
+
 	query := `INSERT OR REPLACE INTO storage_usage(satellite_id, at_rest_total, interval_start)
 			VALUES(?,?,?)`
 
@@ -52,6 +59,18 @@ func (db *storageUsageDB) Store(ctx context.Context, stamps []storageusage.Stamp
 func (db *storageUsageDB) GetDaily(ctx context.Context, satelliteID storj.NodeID, from, to time.Time) (_ []storageusage.Stamp, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	stamps, err := db.cache.get(newQueryKey("GetDaily", satelliteID, from, to), func() (interface{}, error) {
+		return db.getDaily(ctx, satelliteID, from, to)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]storageusage.Stamp(nil), stamps.([]storageusage.Stamp)...), nil
+}
+
+func (db *storageUsageDB) getDaily(ctx context.Context, satelliteID storj.NodeID, from, to time.Time) (_ []storageusage.Stamp, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT satellite_id,
 					SUM(at_rest_total),
 					interval_start
@@ -93,6 +112,18 @@ func (db *storageUsageDB) GetDaily(ctx context.Context, satelliteID storj.NodeID
 func (db *storageUsageDB) GetDailyTotal(ctx context.Context, from, to time.Time) (_ []storageusage.Stamp, err error) {
 	defer mon.Task()(&ctx)(&err)
 
+	stamps, err := db.cache.get(newQueryKey("GetDailyTotal", storj.NodeID{}, from, to), func() (interface{}, error) {
+		return db.getDailyTotal(ctx, from, to)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return append([]storageusage.Stamp(nil), stamps.([]storageusage.Stamp)...), nil
+}
+
+func (db *storageUsageDB) getDailyTotal(ctx context.Context, from, to time.Time) (_ []storageusage.Stamp, err error) {
+	defer mon.Task()(&ctx)(&err)
+
 	query := `SELECT SUM(at_rest_total), interval_start
 				FROM storage_usage
 				WHERE ? <= interval_start AND interval_start <= ?
@@ -129,26 +160,40 @@ func (db *storageUsageDB) GetDailyTotal(ctx context.Context, from, to time.Time)
 // Summary returns aggregated storage usage across all satellites.
 func (db *storageUsageDB) Summary(ctx context.Context, from, to time.Time) (_ float64, err error) {
 	defer mon.Task()(&ctx, from, to)(&err)
-	var summary sql.NullFloat64
 
-	query := `SELECT SUM(at_rest_total)
+	summary, err := db.cache.get(newQueryKey("Summary", storj.NodeID{}, from, to), func() (interface{}, error) {
+		var summary sql.NullFloat64
+
+		query := `SELECT SUM(at_rest_total)
 				FROM storage_usage
 				WHERE ? <= interval_start AND interval_start <= ?`
 
-	err = db.QueryRowContext(ctx, query, from.UTC(), to.UTC()).Scan(&summary)
-	return summary.Float64, err
+		err := db.QueryRowContext(ctx, query, from.UTC(), to.UTC()).Scan(&summary)
+		return summary.Float64, err
+	})
+	if err != nil {
+		return 0, err
+	}
+	return summary.(float64), nil
 }
 
 // SatelliteSummary returns aggregated storage usage for a particular satellite.
 func (db *storageUsageDB) SatelliteSummary(ctx context.Context, satelliteID storj.NodeID, from, to time.Time) (_ float64, err error) {
 	defer mon.Task()(&ctx, satelliteID, from, to)(&err)
-	var summary sql.NullFloat64
 
-	query := `SELECT SUM(at_rest_total)
+	summary, err := db.cache.get(newQueryKey("SatelliteSummary", satelliteID, from, to), func() (interface{}, error) {
+		var summary sql.NullFloat64
+
+		query := `SELECT SUM(at_rest_total)
 				FROM storage_usage
 				WHERE satellite_id = ?
 				AND ? <= interval_start AND interval_start <= ?`
 
-	err = db.QueryRowContext(ctx, query, satelliteID, from.UTC(), to.UTC()).Scan(&summary)
-	return summary.Float64, err
+		err := db.QueryRowContext(ctx, query, satelliteID, from.UTC(), to.UTC()).Scan(&summary)
+		return summary.Float64, err
+	})
+	if err != nil {
+		return 0, err
+	}
+	return summary.(float64), nil
 }